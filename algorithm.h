@@ -2,10 +2,14 @@
 #define MY_ALGORITHM_H
 
 #include <cstring>
+#include <cstdint>
+#include <new>
 #include <type_traits>
 #include <initializer_list>
 #include "utility.h"
 #include "iterator.h"
+#include "numeric.h"
+#include "simd.h"
 
 namespace learnSTL{
 
@@ -35,19 +39,35 @@ namespace learnSTL{
 	};
 
 	template<typename InputIter1, typename InputIter2, typename BinPred> inline
-		bool equal(InputIter1 first1, InputIter2 last1, InputIter2 first2, BinPred pred)
+		bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, BinPred pred)
 	{
 		for (; first1 != last1; ++first1, ++first2)
 			if (!pred(*first1, *first2))
 				return false;
 		return true;
 	}
+	// T* and U* go through the simd kernels: the same integral type of 1, 2, 4
+	// or 8 bytes, so that == compares the bits
+	template<typename T, typename U>
+	struct __simd_comparable
+		: std::integral_constant<bool, std::is_same<typename std::remove_const<T>::type,
+		                                            typename std::remove_const<U>::type>::value &&
+		                               __is_simd_integral<T>::value && !std::is_volatile<T>::value> {};
+
+	// specialize for pointer
+	template<typename T1, typename T2, typename V> inline
+		typename std::enable_if<__simd_comparable<T1, T2>::value, bool>::type
+		equal(T1* first1, T1* last1, T2* first2, __equal_to<V, V>)
+	{
+		size_t n = last1 - first1;
+		return __simd_mismatch<sizeof(T1)>(first1, first2, n) == n;
+	}
 	template<typename InputIter1, typename InputIter2> inline
 		bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2)
 	{
 		typedef typename iterator_traits<InputIter1>::value_type v1;
 		typedef typename iterator_traits<InputIter2>::value_type v2;
-		return equal(first1, last1, first2, __equal_to<v1, v2>());
+		return learnSTL::equal(first1, last1, first2, __equal_to<v1, v2>());
 	}
 
 	// lexicographical_compare
@@ -94,7 +114,7 @@ namespace learnSTL{
 	{
 		typedef typename iterator_traits<InputIter1>::value_type v1;
 		typedef typename iterator_traits<InputIter2>::value_type v2;
-		return lexicographical_compare(first1, last1, first2, last2, __less<v1, v2>());
+		return learnSTL::lexicographical_compare(first1, last1, first2, last2, __less<v1, v2>());
 	}
 	
     // mismatch 
@@ -117,6 +137,15 @@ namespace learnSTL{
         return mismatch(first1, last1, first2, __equal_to<v1, v2>());
     }
 
+    // specialize for pointer
+    template<typename T1, typename T2, typename V> inline
+    typename std::enable_if<__simd_comparable<T1, T2>::value, std::pair<T1*, T2*> >::type
+    mismatch(T1* first1, T1* last1, T2* first2, __equal_to<V, V>)
+    {
+        size_t i = __simd_mismatch<sizeof(T1)>(first1, first2, last1 - first1);
+        return std::make_pair(first1 + i, first2 + i);
+    }
+
     ///~ ------------------ end range compare -----------------------------
     
     ///: ----------------- copy move and assignment -----------------------
@@ -423,6 +452,17 @@ namespace learnSTL{
 				++cn;
 		return cn;
 	}
+	// specialize for pointer
+	// a val that T cannot hold matches nothing, otherwise compare with it as a T
+	template<typename T, typename U> inline
+		typename std::enable_if<__simd_comparable<T, T>::value && std::is_integral<U>::value, ptrdiff_t>::type
+		count(T* first, T* last, const U& val)
+	{
+		typedef typename std::remove_const<T>::type V;
+		if (static_cast<V>(val) != val)
+			return 0;
+		return __simd_count<sizeof(V)>(first, last - first, __simd_bits(static_cast<V>(val)));
+	}
 
 	// count_if
 	template<typename InputIter, typename UnaryPred> inline
@@ -456,6 +496,21 @@ namespace learnSTL{
             typedef typename iterator_traits<ForwardIter>::value_type v;
             return min_element(first, last, __less<v>());
         }
+
+    // specialize for pointer
+    // vector min/max over arithmetic types, the loop above when there is no
+    // kernel for the cpu or the range holds a NaN
+    template<typename T, typename V> inline
+        typename std::enable_if<__is_simd_arithmetic<T>::value && !std::is_volatile<T>::value, T*>::type
+        min_element(T* first, T* last, __less<V, V> comp)
+        {
+            typedef typename __simd_arith_type<T>::type N;
+            size_t imin = 0, imax = 0;
+            if(first != last &&
+               __simd_minmax_element<N, true, false, false>(reinterpret_cast<const N*>(first), last - first, imin, imax))
+                return first + imin;
+            return min_element<T*, __less<V, V>&>(first, last, comp);
+        }
     
     // min
     template<typename T, typename Compare> inline
@@ -501,6 +556,19 @@ namespace learnSTL{
             return max_element(first, last, __less<v>());
         }
 
+    // specialize for pointer
+    template<typename T, typename V> inline
+        typename std::enable_if<__is_simd_arithmetic<T>::value && !std::is_volatile<T>::value, T*>::type
+        max_element(T* first, T* last, __less<V, V> comp)
+        {
+            typedef typename __simd_arith_type<T>::type N;
+            size_t imin = 0, imax = 0;
+            if(first != last &&
+               __simd_minmax_element<N, false, true, false>(reinterpret_cast<const N*>(first), last - first, imin, imax))
+                return first + imax;
+            return max_element<T*, __less<V, V>&>(first, last, comp);
+        }
+
     // max
     template<typename T, typename Compare> inline
         const T& max(const T& a, const T& b, Compare comp)
@@ -542,7 +610,8 @@ namespace learnSTL{
                     while (++first != last){
                         ForwardIter pre = first;
                         if (++first != last) {
-                            if (comp(*pre, *first)) {
+                            // on a tie pre is the min candidate and first the max one
+                            if (!comp(*first, *pre)) {
                                 if (comp(*pre, *(result.first))) {
                                     result.first = pre;
                                 }
@@ -578,6 +647,20 @@ namespace learnSTL{
             return minmax_element(first, last, __less<v>());
         }
 
+    // specialize for pointer
+    // the first smallest and the last largest element, as the loop above
+    template<typename T, typename V> inline
+        typename std::enable_if<__is_simd_arithmetic<T>::value && !std::is_volatile<T>::value, std::pair<T*, T*> >::type
+        minmax_element(T* first, T* last, __less<V, V> comp)
+        {
+            typedef typename __simd_arith_type<T>::type N;
+            size_t imin = 0, imax = 0;
+            if(first != last &&
+               __simd_minmax_element<N, true, true, true>(reinterpret_cast<const N*>(first), last - first, imin, imax))
+                return std::make_pair(first + imin, first + imax);
+            return minmax_element<T*, __less<V, V>&>(first, last, comp);
+        }
+
     // minmax
     template<typename T, typename Compare> inline
         std::pair<const T&, const T&>
@@ -650,6 +733,16 @@ namespace learnSTL{
                     break;
             return first;
         }
+    // specialize for pointer
+    template<typename T, typename U> inline
+        typename std::enable_if<__simd_comparable<T, T>::value && std::is_integral<U>::value, T*>::type
+        find(T* first, T* last, const U& val)
+        {
+            typedef typename std::remove_const<T>::type V;
+            if(static_cast<V>(val) != val)
+                return last;
+            return first + __simd_find<sizeof(V)>(first, last - first, __simd_bits(static_cast<V>(val)));
+        }
 
     // find_if
     template<typename InputIter, typename UnaryPred> inline
@@ -686,6 +779,15 @@ namespace learnSTL{
 		}
 		return last;
 	}
+	// specialize for pointer
+	template<typename T, typename V> inline
+		typename std::enable_if<__simd_comparable<T, T>::value, T*>::type
+		adjacent_find(T* first, T* last, __equal_to<V, V>)
+	{
+		size_t n = last - first;
+		size_t i = __simd_adjacent_find<sizeof(T)>(first, n);
+		return i == n ? last : first + i;
+	}
 	//adjacent_find
 	template<typename ForwardIter> inline
 		ForwardIter adjacent_find(ForwardIter first, ForwardIter last)
@@ -703,11 +805,11 @@ namespace learnSTL{
         ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& val, Compare comp)
         {
             typedef typename iterator_traits<ForwardIter>::difference_type difference_type;
-            difference_type len = distance(first, last);
+            difference_type len = learnSTL::distance(first, last);
             while(len != 0){   // len op is cheaper than distance.  so not while(first != last)
                 difference_type len_half = len / 2;
                 ForwardIter mid = first;
-                advance(mid, len_half);
+                learnSTL::advance(mid, len_half);
                 if(comp(*mid, val)){
                     first = ++mid;
                     len -= len_half + 1;
@@ -729,11 +831,11 @@ namespace learnSTL{
         ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& val, Compare comp)
         {
             typedef typename iterator_traits<ForwardIter>::difference_type difference_type;
-            difference_type len = distance(first, last);
+            difference_type len = learnSTL::distance(first, last);
             while(len != 0){
                 difference_type len_half = len / 2;
                 ForwardIter mid = first;
-                advance(mid, len_half);
+                learnSTL::advance(mid, len_half);
                 if(!comp(val, *mid)){
                     first = ++mid;
                     len -= len_half + 1;
@@ -756,11 +858,11 @@ namespace learnSTL{
         equal_range(ForwardIter first, ForwardIter last, const T& val, Compare comp)
         {
             typedef typename iterator_traits<ForwardIter>::difference_type difference_type;
-            difference_type len = distance(first, last);
+            difference_type len = learnSTL::distance(first, last);
             while(len != 0){
                 difference_type len_half = len / 2;
                 ForwardIter mid = first;
-                advance(mid, len_half);
+                learnSTL::advance(mid, len_half);
                 if(comp(*mid, val)){
                     first = ++mid;
                     len -= len_half + 1;
@@ -1312,7 +1414,7 @@ namespace learnSTL{
             while(first != last){
                 if(first == --last)
                     break;
-                iter_swap(first, last);
+                learnSTL::iter_swap(first, last);
                 ++first;
             }
         }
@@ -1322,7 +1424,7 @@ namespace learnSTL{
         {
             if(first != last){
                 for(; first < --last; ++first)
-                    iter_swap(first, last);
+                    learnSTL::iter_swap(first, last);
             }
         }
 
@@ -1350,7 +1452,7 @@ namespace learnSTL{
 	{
 		typedef typename iterator_traits<ForwardIter>::value_type value_type;
 		value_type temp = std::move(*beg);
-		ForwardIter last = move(next(beg), end, beg);
+		ForwardIter last = learnSTL::move(learnSTL::next(beg), end, beg);
 		*last = std::move(temp);
 		return last;
 	}
@@ -1359,9 +1461,9 @@ namespace learnSTL{
 		BiIter __rotate_right(BiIter beg, BiIter end)
 	{
 		typedef typename iterator_traits<BiIter>::value_type value_type;
-		BiIter last = prev(end);
+		BiIter last = learnSTL::prev(end);
 		value_type temp = std::move(*last);
-		BiIter first = move_backward(beg, last, end);
+		BiIter first = learnSTL::move_backward(beg, last, end);
 		*beg = std::move(temp);
 		return first;
 	}
@@ -1383,10 +1485,10 @@ namespace learnSTL{
 		typedef typename iterator_traits<RandomIter>::value_type value_type;
 		typedef typename iterator_traits<RandomIter>::difference_type difference_type;
 
-		difference_type m1 = distance(beg, new_beg);
-		difference_type m2 = distance(new_beg, end);
+		difference_type m1 = learnSTL::distance(beg, new_beg);
+		difference_type m2 = learnSTL::distance(new_beg, end);
 		if (m1 == m2){
-			swap_ranges(beg, new_beg, new_beg);
+			learnSTL::swap_ranges(beg, new_beg, new_beg);
 			return new_beg;
 		}
 		const difference_type m = __gcd(m1, m2);
@@ -1398,7 +1500,7 @@ namespace learnSTL{
 			do{
 				*p1 = std::move(*p2);
 				p1 = p2;
-				if (p2 + m1 < end)
+				if (end - p2 > m1)
 					p2 += m1;
 				else
 					p2 = beg + m1 - (end - p2);
@@ -1411,10 +1513,9 @@ namespace learnSTL{
 	template<typename ForwardIter> inline
 		ForwardIter __rotate_forward(ForwardIter beg, ForwardIter new_beg, ForwardIter end)
 	{
-		ForwardIter second;
+		ForwardIter second = new_beg;
 		while (true){
-			second = new_beg;
-			swap(*beg, *second);
+			learnSTL::swap(*beg, *second);
 			++beg;
 			++second;
 			if (second == end)
@@ -1426,7 +1527,7 @@ namespace learnSTL{
 		if (beg != new_beg){
 			second = new_beg;
 			while (true){
-				swap(*beg, *second);
+				learnSTL::swap(*beg, *second);
 				++beg;
 				++second;
 				if (second == end){
@@ -1446,10 +1547,10 @@ namespace learnSTL{
 	{
 		typedef typename iterator_traits<RandomIter>::value_type value_type;
 		if (std::is_trivially_move_assignable<value_type>::value){
-			if (next(beg) == new_beg){
+			if (learnSTL::next(beg) == new_beg){
 				return __rotate_left(beg, end);
 			}
-			if (prev(end) == new_beg){
+			if (learnSTL::prev(end) == new_beg){
 				return __rotate_right(beg, end);
 			}
 			return __rotate_gcd(beg, new_beg, end);
@@ -1462,10 +1563,10 @@ namespace learnSTL{
 	{
 		typedef typename iterator_traits<BiIter>::value_type value_type;
 		if (std::is_trivially_move_assignable<value_type>::value){
-			if (next(beg) == new_beg){
+			if (learnSTL::next(beg) == new_beg){
 				return __rotate_left(beg, end);
 			}
-			if (prev(end) == new_beg){
+			if (learnSTL::prev(end) == new_beg){
 				return __rotate_right(beg, end);
 			}
 		}
@@ -1477,7 +1578,7 @@ namespace learnSTL{
 	{
 		typedef typename iterator_traits<ForwardIter>::value_type value_type;
 		if (std::is_trivially_move_assignable<value_type>::value){
-			if (next(beg) == new_beg){
+			if (learnSTL::next(beg) == new_beg){
 				return __rotate_left(beg, end);
 			}
 		}
@@ -1766,14 +1867,14 @@ namespace learnSTL{
 
         if(first1 != last1){
             typedef typename iterator_traits<ForwardIter1>::difference_type DType1;
-            DType1 len1 = distance(first1, last1);
+            DType1 len1 = learnSTL::distance(first1, last1);
             if(len1 == static_cast<DType1>(1))     // only one element left but not equal.
                 return false;
             ForwardIter2 last2 = first2;
-            advance(last2, len1);
+            learnSTL::advance(last2, len1);
             // for each element in two range, compare the times which appears
             for(ForwardIter1 i = first1; i != last1; ++i){
-                if(i != find(first1, i, *i))
+                if(i != learnSTL::find(first1, i, *i))
                     continue;                 // already counted *i before.
                 // count *i in [first2, last2)
                 DType1 count2(0);
@@ -1785,7 +1886,7 @@ namespace learnSTL{
                 // count *i in the [i, last1), because we have make sure that in
                 // [first1, i) has no element equal to *i
                 DType1 count1(1);
-                for(ForwardIter1 j = next(i); j != last1; ++j)
+                for(ForwardIter1 j = learnSTL::next(i); j != last1; ++j)
                     if(comp(*i, *j))
                         ++count1;
                 if(count1 != count2)        // if not equal in count.
@@ -1800,7 +1901,7 @@ namespace learnSTL{
         {
             typedef typename iterator_traits<ForwardIter1>::value_type v1;
             typedef typename iterator_traits<ForwardIter2>::value_type v2;
-            return is_permutation(first1, last1, first2, __equal_to<v1, v2>());
+            return learnSTL::is_permutation(first1, last1, first2, __equal_to<v1, v2>());
         }
 
     // next_permutation
@@ -1906,7 +2007,692 @@ namespace learnSTL{
             return is_sorted(first, last, __less<typename iterator_traits<ForwardIter>::value_type>());
         }
 
-    // sort
+    // temporary buffer used by stable_sort and inplace_merge.
+    // it only owns raw storage, constructing elements is left to the caller.
+    template<typename T>
+    struct __temporary_buffer{
+        T*        __buf;
+        ptrdiff_t __size;
+
+        explicit __temporary_buffer(ptrdiff_t n) : __buf(nullptr), __size(0)
+        {
+            // shrink the request until the allocation succeeds
+            while(n > 0){
+                __buf = static_cast<T*>(::operator new(n * sizeof(T), std::nothrow));
+                if(__buf){
+                    __size = n;
+                    break;
+                }
+                n /= 2;
+            }
+        }
+        ~__temporary_buffer(){
+            if(__buf)
+                ::operator delete(__buf);
+        }
+        __temporary_buffer(const __temporary_buffer&) = delete;
+        __temporary_buffer& operator=(const __temporary_buffer&) = delete;
+    };
+
+    // below this length, insertion sort beats partitioning
+    const ptrdiff_t __sort_threshold = 16;
+
+    // insertion_sort
+    template<typename Compare, typename RandomIter> inline
+        void __insertion_sort(RandomIter first, RandomIter last, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            if(first == last)
+                return;
+            for(RandomIter i = first + 1; i != last; ++i){
+                if(comp(*i, *first)){      // smallest so far, shift the whole prefix
+                    value_type val(std::move(*i));
+                    learnSTL::move_backward(first, i, i + 1);
+                    *first = std::move(val);
+                }
+                else{                      // *first stops the scan, no bound check needed
+                    value_type val(std::move(*i));
+                    RandomIter hole = i;
+                    RandomIter prev = i;
+                    for(--prev; comp(val, *prev); --prev){
+                        *hole = std::move(*prev);
+                        hole = prev;
+                    }
+                    *hole = std::move(val);
+                }
+            }
+        }
+
+    // heap helpers. The children of i are D * i + 1 ... D * i + D: sort
+    // and the heap algorithms use D = 2, priority_queue a wider node, whose
+    // children share a cache line and which makes the tree shallower.
+    // push the hole up while its parent is less than val, then fill it.
+    template<std::size_t D, typename Compare, typename RandomIter, typename Distance, typename T> inline
+        void __heap_sift_up(RandomIter first, Distance hole, Distance top, T&& val, Compare comp)
+        {
+            while(hole > top){
+                const Distance parent = (hole - 1) / Distance(D);
+                if(!comp(*(first + parent), val))
+                    break;
+                *(first + hole) = std::move(*(first + parent));
+                hole = parent;
+            }
+            *(first + hole) = std::move(val);
+        }
+
+    // bottom-up: take the hole down to a leaf through the largest child,
+    // without comparing against val, then push val back up. val usually
+    // comes from the bottom and goes back there, which saves about one
+    // comparison per level over sifting it down.
+    template<std::size_t D, typename Compare, typename RandomIter, typename Distance, typename T> inline
+        void __heap_sift_down(RandomIter first, Distance hole, Distance len, T val, Compare comp)
+        {
+            const Distance top = hole;
+            // nodes with all D children, no bound check on the children
+            while(hole < (len - 1) / Distance(D)){
+                Distance child = Distance(D) * hole + 1, largest = child;
+                for(const Distance end = child + Distance(D); ++child != end; )
+                    largest = comp(*(first + largest), *(first + child)) ? child : largest;
+                *(first + hole) = std::move(*(first + largest));
+                hole = largest;
+            }
+            // at most one node has fewer children
+            if(Distance(D) * hole + 1 < len){
+                Distance child = Distance(D) * hole + 1, largest = child;
+                while(++child < len)
+                    if(comp(*(first + largest), *(first + child)))
+                        largest = child;
+                *(first + hole) = std::move(*(first + largest));
+                hole = largest;
+            }
+            __heap_sift_up<D, Compare>(first, hole, top, std::move(val), comp);
+        }
+
+    template<typename Compare, typename RandomIter, typename Distance, typename T> inline
+        void __adjust_heap(RandomIter first, Distance hole, Distance len, T val, Compare comp)
+        {
+            __heap_sift_down<2, Compare>(first, hole, len, std::move(val), comp);
+        }
+
+    template<std::size_t D, typename Compare, typename RandomIter> inline
+        void __push_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            if(last - first < 2)
+                return;
+            --last;
+            value_type val(std::move(*last));
+            __heap_sift_up<D, Compare>(first, difference_type(last - first), difference_type(0), std::move(val), comp);
+        }
+
+    // the top goes to last - 1 and the old last element fills the hole
+    template<std::size_t D, typename Compare, typename RandomIter> inline
+        void __pop_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            if(last - first < 2)
+                return;
+            --last;
+            value_type val(std::move(*last));
+            *last = std::move(*first);
+            __heap_sift_down<D, Compare>(first, difference_type(0), difference_type(last - first), std::move(val), comp);
+        }
+
+    template<std::size_t D, typename Compare, typename RandomIter> inline
+        void __make_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            difference_type len = last - first;
+            if(len < 2)
+                return;
+            for(difference_type start = (len - 2) / difference_type(D); ; --start){
+                value_type val(std::move(*(first + start)));
+                __heap_sift_down<D, Compare>(first, start, len, std::move(val), comp);
+                if(start == 0)
+                    break;
+            }
+        }
+
+    template<typename Compare, typename RandomIter> inline
+        void __make_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            __make_heap<2, Compare>(first, last, comp);
+        }
+
+    template<typename Compare, typename RandomIter> inline
+        void __sort_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            for(; last - first > 1; --last)
+                __pop_heap<2, Compare>(first, last, comp);
+        }
+
+    template<std::size_t D, typename Compare, typename RandomIter> inline
+        RandomIter __is_heap_until(RandomIter first, RandomIter last, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            const difference_type len = last - first;
+            for(difference_type child = 1; child < len; ++child)
+                if(comp(*(first + (child - 1) / difference_type(D)), *(first + child)))
+                    return first + child;
+            return last;
+        }
+
+    // keep the smallest (middle - first) elements in a max-heap on [first, middle)
+    template<typename Compare, typename RandomIter> inline
+        void __heap_select(RandomIter first, RandomIter middle, RandomIter last, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            __make_heap<Compare>(first, middle, comp);
+            for(RandomIter i = middle; i < last; ++i){
+                if(comp(*i, *first)){
+                    value_type val(std::move(*i));
+                    *i = std::move(*first);
+                    __adjust_heap<Compare>(first, difference_type(0), difference_type(middle - first), std::move(val), comp);
+                }
+            }
+        }
+
+    template<typename Distance> inline
+        Distance __log2(Distance n)
+        {
+            Distance k = 0;
+            for(; n > 1; n >>= 1)
+                ++k;
+            return k;
+        }
+
+    // move the median of *a, *b, *c to *result
+    template<typename Compare, typename RandomIter> inline
+        void __move_median_to_first(RandomIter result, RandomIter a, RandomIter b, RandomIter c, Compare comp)
+        {
+            if(comp(*a, *b)){
+                if(comp(*b, *c))
+                    learnSTL::iter_swap(result, b);
+                else if(comp(*a, *c))
+                    learnSTL::iter_swap(result, c);
+                else
+                    learnSTL::iter_swap(result, a);
+            }
+            else if(comp(*a, *c))
+                learnSTL::iter_swap(result, a);
+            else if(comp(*b, *c))
+                learnSTL::iter_swap(result, c);
+            else
+                learnSTL::iter_swap(result, b);
+        }
+
+    // hoare partition around *pivot. the median of three guarantees
+    // a sentinel on both sides, so the inner loops need no bound check.
+    template<typename Compare, typename RandomIter> inline
+        RandomIter __unguarded_partition(RandomIter first, RandomIter last, RandomIter pivot, Compare comp)
+        {
+            while(true){
+                while(comp(*first, *pivot))
+                    ++first;
+                --last;
+                while(comp(*pivot, *last))
+                    --last;
+                if(!(first < last))
+                    return first;
+                learnSTL::iter_swap(first, last);
+                ++first;
+            }
+        }
+
+    template<typename Compare, typename RandomIter> inline
+        RandomIter __partition_pivot(RandomIter first, RandomIter last, Compare comp)
+        {
+            RandomIter mid = first + (last - first) / 2;
+            __move_median_to_first<Compare>(first, first + 1, mid, last - 1, comp);
+            return __unguarded_partition<Compare>(first + 1, last, first, comp);
+        }
+
+    template<typename Compare, typename RandomIter, typename Distance> inline
+        void __introsort_loop(RandomIter first, RandomIter last, Distance depth_limit, Compare comp)
+        {
+            while(last - first > __sort_threshold){
+                if(depth_limit == 0){     // too many bad pivots, switch to heap sort
+                    __heap_select<Compare>(first, last, last, comp);
+                    __sort_heap<Compare>(first, last, comp);
+                    return;
+                }
+                --depth_limit;
+                RandomIter cut = __partition_pivot<Compare>(first, last, comp);
+                // recurse on the right part, loop on the left part
+                __introsort_loop<Compare>(cut, last, depth_limit, comp);
+                last = cut;
+            }
+        }
+
+    template<typename Compare, typename RandomIter> inline
+        void __sort(RandomIter first, RandomIter last, Compare comp, random_access_iterator_tag)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            difference_type len = last - first;
+            if(len < 2)
+                return;
+            __introsort_loop<Compare>(first, last, __log2(len) * 2, comp);
+            // every partition left is shorter than __sort_threshold now
+            __insertion_sort<Compare>(first, last, comp);
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void sort(RandomIter first, RandomIter last, Compare comp)
+        {
+            __sort<typename std::add_lvalue_reference<Compare>::type>
+                (first, last, comp, typename iterator_traits<RandomIter>::iterator_category());
+        }
+
+    template<typename RandomIter> inline
+        void sort(RandomIter first, RandomIter last)
+        {
+            learnSTL::sort(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    // stable_sort
+    // merge [first, middle) and [middle, last) without any extra memory,
+    // splitting the longer run and rotating the pieces into place.
+    template<typename Compare, typename BiIter, typename Distance> inline
+        void __merge_without_buffer(BiIter first, BiIter middle, BiIter last, Distance len1, Distance len2, Compare comp)
+        {
+            while(len1 != 0 && len2 != 0){
+                if(len1 + len2 == 2){
+                    if(comp(*middle, *first))
+                        learnSTL::iter_swap(first, middle);
+                    return;
+                }
+                BiIter cut1 = first;
+                BiIter cut2 = middle;
+                Distance len11, len22;
+                if(len1 > len2){
+                    len11 = len1 / 2;
+                    learnSTL::advance(cut1, len11);
+                    cut2 = learnSTL::lower_bound(middle, last, *cut1, comp);
+                    len22 = learnSTL::distance(middle, cut2);
+                }
+                else{
+                    len22 = len2 / 2;
+                    learnSTL::advance(cut2, len22);
+                    cut1 = learnSTL::upper_bound(first, middle, *cut2, comp);
+                    len11 = learnSTL::distance(first, cut1);
+                }
+                BiIter new_middle = learnSTL::rotate(cut1, middle, cut2);
+                // recurse on the shorter half, loop on the other
+                if(len11 + len22 < (len1 - len11) + (len2 - len22)){
+                    __merge_without_buffer<Compare>(first, cut1, new_middle, len11, len22, comp);
+                    first = new_middle;
+                    middle = cut2;
+                    len1 -= len11;
+                    len2 -= len22;
+                }
+                else{
+                    __merge_without_buffer<Compare>(new_middle, cut2, last, len1 - len11, len2 - len22, comp);
+                    middle = cut1;
+                    last = new_middle;
+                    len1 = len11;
+                    len2 = len22;
+                }
+            }
+        }
+
+    // merge with the help of buf, which holds at least min(len1, len2) elements,
+    // or fall back to splitting when neither run fits.
+    template<typename Compare, typename BiIter, typename Distance, typename T> inline
+        void __merge_adaptive(BiIter first, BiIter middle, BiIter last, Distance len1, Distance len2,
+                T* buf, Distance buf_size, Compare comp)
+        {
+            if(len1 == 0 || len2 == 0)
+                return;
+            if(len1 <= len2 && len1 <= buf_size){
+                // move the left run out and merge forward
+                T* buf_end = buf;
+                for(BiIter i = first; i != middle; ++i, ++buf_end)
+                    ::new(static_cast<void*>(buf_end)) T(std::move(*i));
+                T* b = buf;
+                BiIter out = first;
+                for(; b != buf_end && middle != last; ++out){
+                    if(comp(*middle, *b)){     // take the right one only when strictly less
+                        *out = std::move(*middle);
+                        ++middle;
+                    }
+                    else{
+                        *out = std::move(*b);
+                        ++b;
+                    }
+                }
+                for(; b != buf_end; ++b, ++out)
+                    *out = std::move(*b);
+                for(b = buf; b != buf_end; ++b)
+                    b->~T();
+            }
+            else if(len2 <= buf_size){
+                // move the right run out and merge backward
+                T* buf_end = buf;
+                for(BiIter i = middle; i != last; ++i, ++buf_end)
+                    ::new(static_cast<void*>(buf_end)) T(std::move(*i));
+                T* b = buf_end;
+                BiIter out = last;
+                while(b != buf && first != middle){
+                    BiIter m = middle;
+                    if(comp(*(b - 1), *--m)){
+                        *--out = std::move(*m);
+                        middle = m;
+                    }
+                    else
+                        *--out = std::move(*--b);
+                }
+                while(b != buf)
+                    *--out = std::move(*--b);
+                for(b = buf; b != buf_end; ++b)
+                    b->~T();
+            }
+            else{
+                BiIter cut1 = first;
+                BiIter cut2 = middle;
+                Distance len11, len22;
+                if(len1 > len2){
+                    len11 = len1 / 2;
+                    learnSTL::advance(cut1, len11);
+                    cut2 = learnSTL::lower_bound(middle, last, *cut1, comp);
+                    len22 = learnSTL::distance(middle, cut2);
+                }
+                else{
+                    len22 = len2 / 2;
+                    learnSTL::advance(cut2, len22);
+                    cut1 = learnSTL::upper_bound(first, middle, *cut2, comp);
+                    len11 = learnSTL::distance(first, cut1);
+                }
+                BiIter new_middle = learnSTL::rotate(cut1, middle, cut2);
+                __merge_adaptive<Compare>(first, cut1, new_middle, len11, len22, buf, buf_size, comp);
+                __merge_adaptive<Compare>(new_middle, cut2, last, len1 - len11, len2 - len22, buf, buf_size, comp);
+            }
+        }
+
+    template<typename Compare, typename RandomIter, typename T> inline
+        void __stable_sort(RandomIter first, RandomIter last, T* buf, ptrdiff_t buf_size, Compare comp)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            difference_type len = last - first;
+            if(len <= __sort_threshold){
+                __insertion_sort<Compare>(first, last, comp);
+                return;
+            }
+            difference_type len1 = len / 2;
+            RandomIter middle = first + len1;
+            __stable_sort<Compare>(first, middle, buf, buf_size, comp);
+            __stable_sort<Compare>(middle, last, buf, buf_size, comp);
+            if(!comp(*middle, *(middle - 1)))      // already in order
+                return;
+            if(buf_size > 0)
+                __merge_adaptive<Compare>(first, middle, last, len1, len - len1, buf, difference_type(buf_size), comp);
+            else
+                __merge_without_buffer<Compare>(first, middle, last, len1, len - len1, comp);
+        }
+
+    template<typename Compare, typename RandomIter> inline
+        void __stable_sort(RandomIter first, RandomIter last, Compare comp, random_access_iterator_tag)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            ptrdiff_t len = last - first;
+            if(len < 2)
+                return;
+            // half of the range is enough for every merge, a smaller buffer
+            // (or none at all) degrades to the rotation based merge.
+            __temporary_buffer<value_type> buf(len > __sort_threshold ? (len + 1) / 2 : 0);
+            __stable_sort<Compare>(first, last, buf.__buf, buf.__size, comp);
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void stable_sort(RandomIter first, RandomIter last, Compare comp)
+        {
+            __stable_sort<typename std::add_lvalue_reference<Compare>::type>
+                (first, last, comp, typename iterator_traits<RandomIter>::iterator_category());
+        }
+
+    template<typename RandomIter> inline
+        void stable_sort(RandomIter first, RandomIter last)
+        {
+            learnSTL::stable_sort(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    // partial_sort
+    template<typename Compare, typename RandomIter> inline
+        void __partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compare comp, random_access_iterator_tag)
+        {
+            if(first == middle)
+                return;
+            __heap_select<Compare>(first, middle, last, comp);
+            __sort_heap<Compare>(first, middle, comp);
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compare comp)
+        {
+            __partial_sort<typename std::add_lvalue_reference<Compare>::type>
+                (first, middle, last, comp, typename iterator_traits<RandomIter>::iterator_category());
+        }
+
+    template<typename RandomIter> inline
+        void partial_sort(RandomIter first, RandomIter middle, RandomIter last)
+        {
+            learnSTL::partial_sort(first, middle, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    // partial_sort_copy
+    template<typename Compare, typename InputIter, typename RandomIter> inline
+        RandomIter __partial_sort_copy(InputIter first, InputIter last, RandomIter result_first, RandomIter result_last,
+                Compare comp, random_access_iterator_tag)
+        {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            RandomIter r = result_first;
+            if(r == result_last)
+                return r;
+            for(; first != last && r != result_last; ++first, ++r)
+                *r = *first;
+            __make_heap<Compare>(result_first, r, comp);
+            difference_type len = r - result_first;
+            for(; first != last; ++first){
+                if(comp(*first, *result_first)){
+                    value_type val(*first);
+                    __adjust_heap<Compare>(result_first, difference_type(0), len, std::move(val), comp);
+                }
+            }
+            __sort_heap<Compare>(result_first, r, comp);
+            return r;
+        }
+
+    template<typename InputIter, typename RandomIter, typename Compare> inline
+        RandomIter partial_sort_copy(InputIter first, InputIter last, RandomIter result_first, RandomIter result_last, Compare comp)
+        {
+            return __partial_sort_copy<typename std::add_lvalue_reference<Compare>::type>
+                (first, last, result_first, result_last, comp, typename iterator_traits<RandomIter>::iterator_category());
+        }
+
+    template<typename InputIter, typename RandomIter> inline
+        RandomIter partial_sort_copy(InputIter first, InputIter last, RandomIter result_first, RandomIter result_last)
+        {
+            typedef typename iterator_traits<InputIter>::value_type v1;
+            typedef typename iterator_traits<RandomIter>::value_type v2;
+            return learnSTL::partial_sort_copy(first, last, result_first, result_last, __less<v1, v2>());
+        }
+
+    // nth_element
+    // introselect: quickselect on the side holding nth, heap select
+    // once the pivots have been bad for too long.
+    template<typename Compare, typename RandomIter> inline
+        void __nth_element(RandomIter first, RandomIter nth, RandomIter last, Compare comp, random_access_iterator_tag)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            if(first == last || nth == last)
+                return;
+            difference_type depth_limit = __log2(last - first) * 2;
+            while(last - first > 3){
+                if(depth_limit == 0){
+                    __heap_select<Compare>(first, nth + 1, last, comp);
+                    learnSTL::iter_swap(first, nth);      // heap top is the nth smallest
+                    return;
+                }
+                --depth_limit;
+                RandomIter cut = __partition_pivot<Compare>(first, last, comp);
+                if(cut <= nth)
+                    first = cut;
+                else
+                    last = cut;
+            }
+            __insertion_sort<Compare>(first, last, comp);
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compare comp)
+        {
+            __nth_element<typename std::add_lvalue_reference<Compare>::type>
+                (first, nth, last, comp, typename iterator_traits<RandomIter>::iterator_category());
+        }
+
+    template<typename RandomIter> inline
+        void nth_element(RandomIter first, RandomIter nth, RandomIter last)
+        {
+            learnSTL::nth_element(first, nth, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+    
+    // radix_sort
+    // __radix_key maps an arithmetic key onto an unsigned integer of the same
+    // width, whose natural order is the order of the key.
+    template<typename T, typename = void>
+    struct __radix_key;
+
+    template<typename T>
+    struct __radix_key<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type>{
+        typedef T type;
+        static type get(T x) { return x; }
+    };
+
+    template<typename T>
+    struct __radix_key<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type>{
+        typedef typename std::make_unsigned<T>::type type;
+        // flip the sign bit so negative numbers come first
+        static type get(T x) { return static_cast<type>(static_cast<type>(x) ^ (type(1) << (sizeof(T) * 8 - 1))); }
+    };
+
+    template<>
+    struct __radix_key<float, void>{
+        typedef std::uint32_t type;
+        // negative: flip all bits, positive: flip the sign bit
+        static type get(float x){
+            type u;
+            std::memcpy(&u, &x, sizeof(u));
+            return (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+        }
+    };
+
+    template<>
+    struct __radix_key<double, void>{
+        typedef std::uint64_t type;
+        static type get(double x){
+            type u;
+            std::memcpy(&u, &x, sizeof(u));
+            return (u & 0x8000000000000000ull) ? ~u : (u | 0x8000000000000000ull);
+        }
+    };
+
+    template<typename T>
+    struct __radix_identity{
+        const T& operator()(const T& x) const { return x; }
+    };
+
+    // compare by the mapped key, so the fallback orders exactly like the radix passes
+    template<typename KeyOf, typename RadixKey>
+    struct __radix_less{
+        KeyOf& key;
+        explicit __radix_less(KeyOf& k) : key(k) {}
+        template<typename T>
+        bool operator()(const T& x, const T& y) const { return RadixKey::get(key(x)) < RadixKey::get(key(y)); }
+    };
+
+    // below this length a comparison sort is cheaper than the histograms
+    const ptrdiff_t __radix_sort_threshold = 256;
+
+    // LSD radix sort, one byte per pass. every histogram is built in a single
+    // read of the input, and a pass is skipped when all keys share its byte.
+    template<typename KeyOf, typename T> inline
+        void __radix_sort(T* first, T* last, KeyOf key)
+        {
+            typedef typename std::decay<decltype(key(*first))>::type key_type;
+            typedef __radix_key<key_type> radix_key;
+            typedef typename radix_key::type unsigned_key;
+            const size_t passes = sizeof(unsigned_key);
+            const ptrdiff_t len = last - first;
+            if(len < 2)
+                return;
+            if(len < __radix_sort_threshold){
+                learnSTL::stable_sort(first, last, __radix_less<KeyOf, radix_key>(key));
+                return;
+            }
+            __temporary_buffer<T> buf(len);
+            if(buf.__size < len){     // not enough memory for the scatter buffer
+                learnSTL::stable_sort(first, last, __radix_less<KeyOf, radix_key>(key));
+                return;
+            }
+
+            size_t count[passes][256];
+            std::memset(count, 0, sizeof(count));
+            for(T* p = first; p != last; ++p){
+                unsigned_key u = radix_key::get(key(*p));
+                for(size_t b = 0; b < passes; ++b)
+                    ++count[b][(u >> (8 * b)) & 0xff];
+            }
+
+            const unsigned_key first_key = radix_key::get(key(*first));
+            T* src = first;
+            T* dst = buf.__buf;
+            bool constructed = false;    // buf holds live objects
+            size_t offset[256];
+            for(size_t b = 0; b < passes; ++b){
+                const size_t shift = 8 * b;
+                if(count[b][(first_key >> shift) & 0xff] == static_cast<size_t>(len))
+                    continue;            // every key has the same byte, nothing to do
+                offset[0] = 0;
+                learnSTL::partial_sum(count[b], count[b] + 255, offset + 1);
+                if(!constructed){
+                    for(T* p = src; p != src + len; ++p)
+                        ::new(static_cast<void*>(dst + offset[(radix_key::get(key(*p)) >> shift) & 0xff]++)) T(std::move(*p));
+                    constructed = true;
+                }
+                else{
+                    for(T* p = src; p != src + len; ++p)
+                        dst[offset[(radix_key::get(key(*p)) >> shift) & 0xff]++] = std::move(*p);
+                }
+                T* t = src;
+                src = dst;
+                dst = t;
+            }
+            if(src != first)
+                learnSTL::move(src, src + len, first);
+            if(constructed){
+                for(T* p = buf.__buf; p != buf.__buf + len; ++p)
+                    p->~T();
+            }
+        }
+
+    // sort arithmetic keys in ascending order
+    template<typename T> inline
+        typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+        radix_sort(T* first, T* last)
+        {
+            __radix_sort(first, last, __radix_identity<T>());
+        }
+
+    // stable sort by key(elem), key must return an arithmetic type
+    template<typename T, typename KeyOf> inline
+        void radix_sort(T* first, T* last, KeyOf key)
+        {
+            __radix_sort<typename std::add_lvalue_reference<KeyOf>::type>(first, last, key);
+        }
     
     ///~ ---------------------- end of sort -----------------------------------------------
     
@@ -1930,9 +2716,9 @@ namespace learnSTL{
                 }
             }
             if(first1 != last1)
-                return copy(first1, last1, result);
+                return learnSTL::copy(first1, last1, result);
             if(first2 != last2)
-                return copy(first2, last2, result);
+                return learnSTL::copy(first2, last2, result);
             return result;
         }
 
@@ -1945,6 +2731,33 @@ namespace learnSTL{
         }
 
     // inplace_merge
+    template<typename Compare, typename BiIter> inline
+        void __inplace_merge(BiIter first, BiIter middle, BiIter last, Compare comp)
+        {
+            typedef typename iterator_traits<BiIter>::value_type value_type;
+            typedef typename iterator_traits<BiIter>::difference_type difference_type;
+            difference_type len1 = learnSTL::distance(first, middle);
+            difference_type len2 = learnSTL::distance(middle, last);
+            if(len1 == 0 || len2 == 0)
+                return;
+            __temporary_buffer<value_type> buf(len1 < len2 ? len1 : len2);
+            if(buf.__size > 0)
+                __merge_adaptive<Compare>(first, middle, last, len1, len2, buf.__buf, difference_type(buf.__size), comp);
+            else
+                __merge_without_buffer<Compare>(first, middle, last, len1, len2, comp);
+        }
+
+    template<typename BiIter, typename Compare> inline
+        void inplace_merge(BiIter first, BiIter middle, BiIter last, Compare comp)
+        {
+            __inplace_merge<typename std::add_lvalue_reference<Compare>::type>(first, middle, last, comp);
+        }
+
+    template<typename BiIter> inline
+        void inplace_merge(BiIter first, BiIter middle, BiIter last)
+        {
+            learnSTL::inplace_merge(first, middle, last, __less<typename iterator_traits<BiIter>::value_type>());
+        }
     
     ///~ ---------------------------------- end merge ----------------------------------------
     //
@@ -1969,9 +2782,9 @@ namespace learnSTL{
                 }
             }
             if(first1 != last1)
-                return copy(first1, last1, result);
+                return learnSTL::copy(first1, last1, result);
             if(first2 != last2)
-                return copy(first2, last2, result);
+                return learnSTL::copy(first2, last2, result);
             return result;
         }
 
@@ -2017,7 +2830,7 @@ namespace learnSTL{
         {
             while(first1 != last1){
                 if(first2 == last2)
-                    return copy(first1, last1, result);
+                    return learnSTL::copy(first1, last1, result);
                 if(comp(*first1, *first2)){
                     *result = *first1;
                     ++result;
@@ -2061,9 +2874,9 @@ namespace learnSTL{
                 }
             }
             if(first1 != last1)
-                return copy(first1, last1, result);
+                return learnSTL::copy(first1, last1, result);
             if(first2 != last2)
-                return copy(first2, last2, result);
+                return learnSTL::copy(first2, last2, result);
             return result;
         }
 
@@ -2076,6 +2889,82 @@ namespace learnSTL{
         }
 
     ///~ ---------------------------------- end set sorted -----------------------------------------
+
+
+    ///: ------------------------------------ heap ----------------------------------------
+    // a max-heap on [first, last) with respect to comp
+    template<typename RandomIter, typename Compare> inline
+        void push_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            __push_heap<2, typename std::add_lvalue_reference<Compare>::type>(first, last, comp);
+        }
+
+    template<typename RandomIter> inline
+        void push_heap(RandomIter first, RandomIter last)
+        {
+            learnSTL::push_heap(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void pop_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            __pop_heap<2, typename std::add_lvalue_reference<Compare>::type>(first, last, comp);
+        }
+
+    template<typename RandomIter> inline
+        void pop_heap(RandomIter first, RandomIter last)
+        {
+            learnSTL::pop_heap(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void make_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            __make_heap<2, typename std::add_lvalue_reference<Compare>::type>(first, last, comp);
+        }
+
+    template<typename RandomIter> inline
+        void make_heap(RandomIter first, RandomIter last)
+        {
+            learnSTL::make_heap(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void sort_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            __sort_heap<typename std::add_lvalue_reference<Compare>::type>(first, last, comp);
+        }
+
+    template<typename RandomIter> inline
+        void sort_heap(RandomIter first, RandomIter last)
+        {
+            learnSTL::sort_heap(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        RandomIter is_heap_until(RandomIter first, RandomIter last, Compare comp)
+        {
+            return __is_heap_until<2, typename std::add_lvalue_reference<Compare>::type>(first, last, comp);
+        }
+
+    template<typename RandomIter> inline
+        RandomIter is_heap_until(RandomIter first, RandomIter last)
+        {
+            return learnSTL::is_heap_until(first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        bool is_heap(RandomIter first, RandomIter last, Compare comp)
+        {
+            return learnSTL::is_heap_until(first, last, comp) == last;
+        }
+
+    template<typename RandomIter> inline
+        bool is_heap(RandomIter first, RandomIter last)
+        {
+            return learnSTL::is_heap_until(first, last) == last;
+        }
+    ///~ ---------------------------------- end heap -----------------------------------------
 }
 
 #endif
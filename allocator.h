@@ -0,0 +1,391 @@
+#ifndef MY_ALLOCATOR_H
+#define MY_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <mutex>
+#include <type_traits>
+
+namespace learnSTL{
+    ///: ------------------------- monotonic_arena --------------------------------
+    // hands out memory by bumping a pointer through a chain of blocks, each one
+    // twice the size of the previous. Nothing is given back one piece at a time:
+    // reset() drops every allocation at once and release() frees the blocks.
+    class monotonic_arena{
+    public:
+        explicit monotonic_arena(std::size_t block_size = 4096)
+            : __blocks(nullptr), __cur(nullptr), __end(nullptr),
+              __next_size(block_size < 2 * sizeof(__block) ? 2 * sizeof(__block) : block_size) {}
+
+        monotonic_arena(const monotonic_arena&) = delete;
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+        ~monotonic_arena(){
+            release();
+        }
+
+        void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)){
+            std::size_t pad = static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(__cur)) & (align - 1);
+            if (pad + bytes > static_cast<std::size_t>(__end - __cur)){
+                __grow(bytes + align);
+                pad = static_cast<std::size_t>(-reinterpret_cast<std::uintptr_t>(__cur)) & (align - 1);
+            }
+            char* p = __cur + pad;
+            __cur = p + bytes;
+            return p;
+        }
+
+        // memory goes back only through reset() or release()
+        void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) {}
+
+        // every allocation becomes invalid. The newest block, which is the
+        // largest, is kept so a reused arena soon stops calling operator new.
+        void reset(){
+            if (__blocks != nullptr){
+                __free_blocks(__blocks->__prev);
+                __blocks->__prev = nullptr;
+                __cur = reinterpret_cast<char*>(__blocks + 1);
+            }
+        }
+
+        // every allocation becomes invalid and all blocks go back to the system
+        void release(){
+            __free_blocks(__blocks);
+            __blocks = nullptr;
+            __cur = __end = nullptr;
+        }
+
+        // bytes left in the current block
+        std::size_t remaining() const{
+            return static_cast<std::size_t>(__end - __cur);
+        }
+
+    private:
+        struct __block{
+            __block*    __prev;
+            std::size_t __size;
+        };
+
+        __block*    __blocks;       // newest first
+        char*       __cur;
+        char*       __end;
+        std::size_t __next_size;
+
+        void __grow(std::size_t bytes){
+            std::size_t size = __next_size;
+            while (size - sizeof(__block) < bytes)
+                size *= 2;
+            __block* b = static_cast<__block*>(::operator new(size));
+            b->__prev = __blocks;
+            b->__size = size;
+            __blocks = b;
+            __cur = reinterpret_cast<char*>(b + 1);
+            __end = reinterpret_cast<char*>(b) + size;
+            __next_size = size * 2;
+        }
+
+        static void __free_blocks(__block* b){
+            while (b != nullptr){
+                __block* prev = b->__prev;
+                ::operator delete(b);
+                b = prev;
+            }
+        }
+    };
+    ///~ ------------------------- end monotonic_arena ----------------------------
+
+
+    ///: ------------------------- arena_allocator --------------------------------
+    // allocator over a monotonic_arena, deallocate does nothing.
+    // The allocator travels with the memory it handed out: copy, move and swap
+    // of a container all propagate it, so a container never ends up holding
+    // nodes of an arena its allocator does not refer to.
+    template<typename T>
+    class arena_allocator{
+    public:
+        typedef T                   value_type;
+        typedef T*                  pointer;
+        typedef const T*            const_pointer;
+        typedef std::size_t         size_type;
+        typedef std::ptrdiff_t      difference_type;
+        typedef std::true_type      propagate_on_container_copy_assignment;
+        typedef std::true_type      propagate_on_container_move_assignment;
+        typedef std::true_type      propagate_on_container_swap;
+
+        template<typename U>
+        struct rebind{
+            typedef arena_allocator<U> other;
+        };
+
+        arena_allocator(monotonic_arena& a) : __arena(&a) {}
+        template<typename U>
+        arena_allocator(const arena_allocator<U>& a) : __arena(a.arena()) {}
+
+        pointer allocate(size_type n){
+            return static_cast<pointer>(__arena->allocate(n * sizeof(T), alignof(T)));
+        }
+        void deallocate(pointer, size_type) {}
+
+        monotonic_arena* arena() const { return __arena; }
+
+    private:
+        monotonic_arena* __arena;
+    };
+
+    template<typename T, typename U> inline
+        bool operator==(const arena_allocator<T>& a1, const arena_allocator<U>& a2)
+    {
+        return a1.arena() == a2.arena();
+    }
+    template<typename T, typename U> inline
+        bool operator!=(const arena_allocator<T>& a1, const arena_allocator<U>& a2)
+    {
+        return !(a1 == a2);
+    }
+    ///~ ------------------------- end arena_allocator ----------------------------
+
+
+    ///: ------------------------- pool_allocator --------------------------------
+    // chunks of one size class, kept on an intrusive free list
+    struct __pool_chunk{
+        __pool_chunk* __next;
+    };
+
+    // all chunks of one size, shared by every thread. Chunks are carved from
+    // 64KB slabs on demand and never go back to the system.
+    class __pool_size_class{
+    public:
+        static const std::size_t __slab_size = 64 * 1024;
+
+        __pool_size_class() : __free(nullptr), __cur(nullptr), __end(nullptr), __chunk(0) {}
+
+        void __init(std::size_t chunk) { __chunk = chunk; }
+
+        void* allocate(){
+            std::lock_guard<std::mutex> lock(__mutex);
+            return __take();
+        }
+        void deallocate(void* p){
+            std::lock_guard<std::mutex> lock(__mutex);
+            __pool_chunk* c = static_cast<__pool_chunk*>(p);
+            c->__next = __free;
+            __free = c;
+        }
+
+        // unlinks n chunks in one locked section
+        __pool_chunk* __take_batch(std::size_t n){
+            std::lock_guard<std::mutex> lock(__mutex);
+            __pool_chunk* first = nullptr;
+            for (; n > 0; --n){
+                __pool_chunk* c = static_cast<__pool_chunk*>(__take());
+                c->__next = first;
+                first = c;
+            }
+            return first;
+        }
+        // links the list [first, last] back in one locked section
+        void __give_batch(__pool_chunk* first, __pool_chunk* last){
+            std::lock_guard<std::mutex> lock(__mutex);
+            last->__next = __free;
+            __free = first;
+        }
+
+    private:
+        std::mutex      __mutex;
+        __pool_chunk*   __free;
+        char*           __cur;      // uncarved part of the newest slab
+        char*           __end;
+        std::size_t     __chunk;
+
+        void* __take(){
+            if (__free != nullptr){
+                __pool_chunk* c = __free;
+                __free = c->__next;
+                return c;
+            }
+            if (__cur == __end){
+                __cur = static_cast<char*>(::operator new(__slab_size));
+                __end = __cur + __slab_size / __chunk * __chunk;
+            }
+            void* p = __cur;
+            __cur += __chunk;
+            return p;
+        }
+    };
+
+    // size classes are multiples of __pool_granule up to __pool_max_bytes,
+    // larger or over-aligned requests go to operator new
+    const std::size_t __pool_granule   = 16;
+    const std::size_t __pool_max_bytes = 256;
+    const std::size_t __pool_classes   = __pool_max_bytes / __pool_granule;
+    const std::size_t __pool_batch     = 32;     // chunks moved between a thread cache and its class
+
+    inline std::size_t __pool_class_of(std::size_t bytes){
+        return (bytes + __pool_granule - 1) / __pool_granule - 1;
+    }
+
+    // the classes are never destroyed, so a chunk can be given back to them
+    // at any time, from any destructor
+    inline __pool_size_class* __pool_classes_instance(){
+        static __pool_size_class* classes = []{
+            __pool_size_class* c = new __pool_size_class[__pool_classes];
+            for (std::size_t i = 0; i < __pool_classes; ++i)
+                c[i].__init((i + 1) * __pool_granule);
+            return c;
+        }();
+        return classes;
+    }
+
+    // per-thread free lists in front of the shared classes. A thread takes and
+    // returns chunks __pool_batch at a time, and hands back all it holds on exit.
+    // The cache itself is trivially destructible and lives as long as its
+    // thread; the hand-back is a separate thread_local registered on first use.
+    // Whatever is destroyed after it, the statics of the main thread too, finds
+    // the cache dead and goes to the locked classes directly.
+    class __pool_thread_cache{
+    public:
+        constexpr __pool_thread_cache() : __classes(nullptr), __free(), __count(), __state(__fresh) {}
+        __pool_thread_cache(const __pool_thread_cache&) = delete;
+        __pool_thread_cache& operator=(const __pool_thread_cache&) = delete;
+
+        static __pool_thread_cache& local(){
+            static thread_local __pool_thread_cache cache;
+            return cache;
+        }
+
+        void* allocate(std::size_t c){
+            if (__state != __live && !__start())
+                return __pool_classes_instance()[c].allocate();
+            if (__free[c] == nullptr){
+                __free[c] = __classes[c].__take_batch(__pool_batch);
+                __count[c] = __pool_batch;
+            }
+            __pool_chunk* p = __free[c];
+            __free[c] = p->__next;
+            --__count[c];
+            return p;
+        }
+        void deallocate(void* p, std::size_t c){
+            if (__state != __live && !__start())
+                return __pool_classes_instance()[c].deallocate(p);
+            __pool_chunk* chunk = static_cast<__pool_chunk*>(p);
+            chunk->__next = __free[c];
+            __free[c] = chunk;
+            // keep at most two batches, give the older one back
+            if (++__count[c] == 2 * __pool_batch){
+                __pool_chunk* last = chunk;
+                for (std::size_t i = 1; i < __pool_batch; ++i)
+                    last = last->__next;
+                __pool_chunk* rest = last->__next;
+                __classes[c].__give_batch(rest, __last(rest));
+                last->__next = nullptr;
+                __count[c] = __pool_batch;
+            }
+        }
+
+    private:
+        enum __cache_state : unsigned char { __fresh, __live, __dead };
+
+        // gives the cache back when its thread ends
+        struct __flush_at_exit{
+            __pool_thread_cache* __cache;
+            ~__flush_at_exit() { __cache->__flush(); }
+        };
+
+        __pool_size_class*  __classes;
+        __pool_chunk*       __free[__pool_classes];
+        std::size_t         __count[__pool_classes];
+        __cache_state       __state;
+
+        // false once the thread's cache is gone
+        bool __start(){
+            if (__state == __dead)
+                return false;
+            __classes = __pool_classes_instance();
+            static thread_local __flush_at_exit flush = { this };
+            __state = __live;
+            return true;
+        }
+
+        void __flush(){
+            for (std::size_t i = 0; i < __pool_classes; ++i){
+                if (__count[i] > 0)
+                    __classes[i].__give_batch(__free[i], __last(__free[i]));
+                __free[i] = nullptr;
+                __count[i] = 0;
+            }
+            __state = __dead;
+        }
+
+        static __pool_chunk* __last(__pool_chunk* c){
+            while (c->__next != nullptr)
+                c = c->__next;
+            return c;
+        }
+    };
+    static_assert(std::is_trivially_destructible<__pool_thread_cache>::value,
+                  "the thread cache must outlive the thread_local destructors");
+
+    // stateless allocator over the shared size classes. With ThreadCache each
+    // thread allocates from its own free lists and takes a lock only once per
+    // __pool_batch chunks; without it every call locks its size class.
+    template<typename T, bool ThreadCache = true>
+    class pool_allocator{
+    public:
+        typedef T                   value_type;
+        typedef T*                  pointer;
+        typedef const T*            const_pointer;
+        typedef std::size_t         size_type;
+        typedef std::ptrdiff_t      difference_type;
+        typedef std::true_type      is_always_equal;
+
+        template<typename U>
+        struct rebind{
+            typedef pool_allocator<U, ThreadCache> other;
+        };
+
+        pool_allocator() {}
+        template<typename U>
+        pool_allocator(const pool_allocator<U, ThreadCache>&) {}
+
+        pointer allocate(size_type n){
+            const std::size_t bytes = n * sizeof(T);
+            if (!__pooled(bytes))
+                return static_cast<pointer>(::operator new(bytes));
+            const std::size_t c = __pool_class_of(bytes);
+            if (ThreadCache)
+                return static_cast<pointer>(__pool_thread_cache::local().allocate(c));
+            return static_cast<pointer>(__pool_classes_instance()[c].allocate());
+        }
+        void deallocate(pointer p, size_type n){
+            const std::size_t bytes = n * sizeof(T);
+            if (!__pooled(bytes))
+                return ::operator delete(p);
+            const std::size_t c = __pool_class_of(bytes);
+            if (ThreadCache)
+                __pool_thread_cache::local().deallocate(p, c);
+            else
+                __pool_classes_instance()[c].deallocate(p);
+        }
+
+    private:
+        static bool __pooled(std::size_t bytes){
+            return bytes != 0 && bytes <= __pool_max_bytes && alignof(T) <= __pool_granule;
+        }
+    };
+
+    template<typename T, typename U, bool C> inline
+        bool operator==(const pool_allocator<T, C>&, const pool_allocator<U, C>&)
+    {
+        return true;
+    }
+    template<typename T, typename U, bool C> inline
+        bool operator!=(const pool_allocator<T, C>&, const pool_allocator<U, C>&)
+    {
+        return false;
+    }
+    ///~ ------------------------- end pool_allocator ----------------------------
+}
+
+#endif
@@ -0,0 +1,1141 @@
+#ifndef MY_BTREE_H
+#define MY_BTREE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "simd.h"
+
+namespace learnSTL{
+    ///: ------------------------- policies --------------------------------
+    // what the tree stores and where the key is. transfer moves an element
+    // to another slot and destroys the old one.
+    template<typename Key>
+    struct __btree_set_policy{
+        using key_type   = Key;
+        using value_type = Key;
+        static const bool const_elements = true;
+        static const bool nothrow_transfer = std::is_nothrow_move_constructible<Key>::value;
+
+        static const key_type& key(const value_type& v) { return v; }
+
+        template<typename Alloc>
+            static void transfer(Alloc& a, value_type* dst, value_type* src){
+                std::allocator_traits<Alloc>::construct(a, dst, learnSTL::move(*src));
+                std::allocator_traits<Alloc>::destroy(a, src);
+            }
+    };
+
+    template<typename Key, typename T>
+    struct __btree_map_policy{
+        using key_type   = Key;
+        using value_type = pair<const Key, T>;
+        static const bool const_elements = false;
+        static const bool nothrow_transfer = std::is_nothrow_move_constructible<Key>::value &&
+                                             std::is_nothrow_move_constructible<T>::value;
+
+        static const key_type& key(const value_type& v) { return v.first; }
+
+        // the source dies right after, so its key may be moved from
+        template<typename Alloc>
+            static void transfer(Alloc& a, value_type* dst, value_type* src){
+                std::allocator_traits<Alloc>::construct(a, dst, learnSTL::move(const_cast<Key&>(src->first)),
+                                                        learnSTL::move(src->second));
+                std::allocator_traits<Alloc>::destroy(a, src);
+            }
+    };
+
+    // values a node holds: as many as fit in four cache lines
+    template<typename T>
+    struct __btree_fanout{
+        static const std::size_t __fit = (256 - 2 * sizeof(void*)) / sizeof(T);
+        static const std::size_t value = __fit < 3 ? 3 : (__fit > 255 ? 255 : __fit);
+    };
+
+    // arithmetic keys under std::less are searched by counting the smaller
+    // keys of a node, a loop without branches the compiler vectorizes
+    template<typename Key, typename Compare>
+    struct __btree_linear_search
+        : std::integral_constant<bool, __is_simd_arithmetic<Key>::value &&
+                                       std::is_same<Compare, std::less<Key> >::value> {};
+    ///~ ------------------------- end policies ----------------------------
+
+
+    ///: ------------------------- btree node --------------------------------
+    // a leaf holds up to N values in place; an internal node adds N + 1
+    // children. Every node knows its parent and its index there, so the
+    // iterators walk the tree without a stack.
+    template<typename T, std::size_t N>
+    struct __btree_node{
+        __btree_node*  __parent;
+        unsigned char  __position;
+        unsigned char  __count;
+        bool           __leaf;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type __slots[N];
+
+        T* __value(std::size_t i) { return reinterpret_cast<T*>(__slots) + i; }
+        const T* __value(std::size_t i) const { return reinterpret_cast<const T*>(__slots) + i; }
+
+        __btree_node* __child(std::size_t i) const;
+        void __set_child(std::size_t i, __btree_node* c);
+    };
+
+    template<typename T, std::size_t N>
+    struct __btree_internal : __btree_node<T, N>{
+        __btree_node<T, N>* __children[N + 1];
+    };
+
+    template<typename T, std::size_t N> inline
+        __btree_node<T, N>* __btree_node<T, N>::__child(std::size_t i) const {
+            return static_cast<const __btree_internal<T, N>*>(this)->__children[i];
+        }
+
+    template<typename T, std::size_t N> inline
+        void __btree_node<T, N>::__set_child(std::size_t i, __btree_node* c){
+            static_cast<__btree_internal<T, N>*>(this)->__children[i] = c;
+            c->__parent = this;
+            c->__position = static_cast<unsigned char>(i);
+        }
+    ///~ ------------------------- end btree node ----------------------------
+
+
+    ///: ------------------------- btree iterator --------------------------------
+    template<typename Policy, typename Compare, typename Allocator, bool Multi> class __btree;
+
+    // a node and a value index. end() is one past the last value of the
+    // rightmost leaf.
+    template<typename Policy, typename Node, bool Const>
+    class __btree_iterator{
+        template<typename, typename, typename, bool> friend class __btree;
+        template<typename, typename, bool> friend class __btree_iterator;
+        static const bool __const_ref = Const || Policy::const_elements;
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = typename Policy::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = typename std::conditional<__const_ref, const value_type&, value_type&>::type;
+        using pointer           = typename std::conditional<__const_ref, const value_type*, value_type*>::type;
+
+        __btree_iterator() : __node(nullptr), __pos(0) {}
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        __btree_iterator(const __btree_iterator<Policy, Node, C>& iter) : __node(iter.__node), __pos(iter.__pos) {}
+
+        reference operator*() const { return *__node->__value(__pos); }
+        pointer operator->() const { return __node->__value(__pos); }
+
+        __btree_iterator& operator++(){
+            __increment();
+            return *this;
+        }
+        __btree_iterator operator++(int){
+            __btree_iterator temp(*this);
+            __increment();
+            return temp;
+        }
+        __btree_iterator& operator--(){
+            __decrement();
+            return *this;
+        }
+        __btree_iterator operator--(int){
+            __btree_iterator temp(*this);
+            __decrement();
+            return temp;
+        }
+
+        template<bool C>
+        bool operator==(const __btree_iterator<Policy, Node, C>& iter) const {
+            return __node == iter.__node && __pos == iter.__pos;
+        }
+        template<bool C>
+        bool operator!=(const __btree_iterator<Policy, Node, C>& iter) const { return !(*this == iter); }
+
+    private:
+        Node*       __node;
+        std::size_t __pos;
+
+        __btree_iterator(Node* n, std::size_t pos) : __node(n), __pos(pos) {}
+
+        void __increment(){
+            if(!__node->__leaf){
+                __node = __node->__child(__pos + 1);
+                while(!__node->__leaf)
+                    __node = __node->__child(0);
+                __pos = 0;
+                return;
+            }
+            if(++__pos < __node->__count)
+                return;
+            // climb while this subtree is the last child; past the last
+            // value the iterator stays at the end of the rightmost leaf
+            Node* n = __node;
+            while(n->__parent != nullptr && n->__position == n->__parent->__count)
+                n = n->__parent;
+            if(n->__parent != nullptr){
+                __pos = n->__position;
+                __node = n->__parent;
+            }
+        }
+
+        void __decrement(){
+            if(!__node->__leaf){
+                __node = __node->__child(__pos);
+                while(!__node->__leaf)
+                    __node = __node->__child(__node->__count);
+                __pos = __node->__count - 1;
+                return;
+            }
+            if(__pos > 0){
+                --__pos;
+                return;
+            }
+            Node* n = __node;
+            while(n->__parent != nullptr && n->__position == 0)
+                n = n->__parent;
+            if(n->__parent != nullptr){
+                __pos = n->__position - 1;
+                __node = n->__parent;
+            }
+        }
+    };
+    ///~ ------------------------- end btree iterator ----------------------------
+
+
+    ///: ------------------------- btree --------------------------------
+    // A B-tree with the values stored in the nodes, sized to a few cache
+    // lines, so a lookup touches one node a level instead of one per
+    // comparison. Values move between nodes on splits and merges, which
+    // invalidates iterators to the moved values.
+    //
+    // Inserting at the end of a node splits it unevenly, keeping the left
+    // node full: inserting a sorted range (insert with an end() hint, or
+    // the range constructor) appends in O(1) amortized and packs the
+    // nodes, which makes building from sorted input O(n).
+    template<typename Policy, typename Compare, typename Allocator, bool Multi>
+    class __btree{
+        static_assert(Policy::nothrow_transfer, "btree containers move their elements between nodes, which must not throw");
+        using __alloc_traits = std::allocator_traits<Allocator>;
+        static const std::size_t __N   = __btree_fanout<typename Policy::value_type>::value;
+        static const std::size_t __min = __N / 2;
+        using __node           = __btree_node<typename Policy::value_type, __N>;
+        using __internal       = __btree_internal<typename Policy::value_type, __N>;
+        using __leaf_alloc     = typename __alloc_traits::template rebind_alloc<__node>;
+        using __leaf_traits    = std::allocator_traits<__leaf_alloc>;
+        using __internal_alloc = typename __alloc_traits::template rebind_alloc<__internal>;
+        using __internal_traits = std::allocator_traits<__internal_alloc>;
+    public:
+        using key_type         = typename Policy::key_type;
+        using value_type       = typename Policy::value_type;
+        using key_compare      = Compare;
+        using allocator_type   = Allocator;
+        using size_type        = std::size_t;
+        using difference_type  = std::ptrdiff_t;
+        using reference        = value_type&;
+        using const_reference  = const value_type&;
+        using pointer          = typename __alloc_traits::pointer;
+        using const_pointer    = typename __alloc_traits::const_pointer;
+
+        using iterator               = __btree_iterator<Policy, __node, false>;
+        using const_iterator         = __btree_iterator<Policy, __node, true>;
+        using reverse_iterator       = learnSTL::reverse_iterator<iterator>;
+        using const_reverse_iterator = learnSTL::reverse_iterator<const_iterator>;
+
+        // what insert returns: the element, and for unique keys whether it is new
+        using __insert_result = typename std::conditional<Multi, iterator, pair<iterator, bool> >::type;
+
+        // iterator
+        iterator begin() { return iterator(__leftmost, 0); }
+        const_iterator begin() const { return const_iterator(__leftmost, 0); }
+        const_iterator cbegin() const { return begin(); }
+        iterator end() { return iterator(__rightmost, __rightmost == nullptr ? 0 : __rightmost->__count); }
+        const_iterator end() const { return const_iterator(__rightmost, __rightmost == nullptr ? 0 : __rightmost->__count); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return rend(); }
+
+        allocator_type get_allocator() const { return __alloc; }
+        key_compare key_comp() const { return __comp; }
+
+        // capacity
+        size_type size() const { return __size; }
+        bool empty() const { return __size == 0; }
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+        // values a node holds
+        static constexpr size_type node_capacity() { return __N; }
+
+        // constructor
+        __btree() : __comp(), __alloc() { __reset(); }
+        explicit __btree(const key_compare& comp, const allocator_type& a = allocator_type()) : __comp(comp), __alloc(a) { __reset(); }
+        explicit __btree(const allocator_type& a) : __comp(), __alloc(a) { __reset(); }
+
+        template<typename InputIter>
+        __btree(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value, InputIter>::type last,
+                const key_compare& comp = key_compare(), const allocator_type& a = allocator_type())
+            : __comp(comp), __alloc(a)
+        {
+            __reset();
+            insert(first, last);
+        }
+        __btree(std::initializer_list<value_type> initlist, const key_compare& comp = key_compare(),
+                const allocator_type& a = allocator_type())
+            : __comp(comp), __alloc(a)
+        {
+            __reset();
+            insert(initlist.begin(), initlist.end());
+        }
+
+        // copy-constructor: the values come in order, so the copy is a bulk load
+        __btree(const __btree& t)
+            : __comp(t.__comp), __alloc(__alloc_traits::select_on_container_copy_construction(t.__alloc))
+        {
+            __reset();
+            insert(t.begin(), t.end());
+        }
+        __btree(const __btree& t, const allocator_type& a) : __comp(t.__comp), __alloc(a)
+        {
+            __reset();
+            insert(t.begin(), t.end());
+        }
+
+        // move-constructor
+        __btree(__btree&& rt) : __comp(learnSTL::move(rt.__comp)), __alloc(learnSTL::move(rt.__alloc))
+        {
+            __steal(rt);
+        }
+        __btree(__btree&& rt, const allocator_type& a) : __comp(learnSTL::move(rt.__comp)), __alloc(a)
+        {
+            if(__alloc == rt.__alloc)
+                __steal(rt);
+            else{
+                __reset();
+                __move_elements(rt);
+            }
+        }
+
+        ~__btree(){
+            clear();
+        }
+
+        // assignment
+        __btree& operator=(const __btree& t){
+            if(this != &t){
+                clear();
+                __copy_assign_alloc(t, std::integral_constant<bool,
+                    __alloc_traits::propagate_on_container_copy_assignment::value>());
+                __comp = t.__comp;
+                insert(t.begin(), t.end());
+            }
+            return *this;
+        }
+
+        __btree& operator=(__btree&& rt){
+            if(this != &rt){
+                clear();
+                __comp = learnSTL::move(rt.__comp);
+                if(__alloc_traits::propagate_on_container_move_assignment::value || __alloc == rt.__alloc){
+                    __move_assign_alloc(rt, std::integral_constant<bool,
+                        __alloc_traits::propagate_on_container_move_assignment::value>());
+                    __steal(rt);
+                }
+                else
+                    __move_elements(rt);
+            }
+            return *this;
+        }
+
+        __btree& operator=(std::initializer_list<value_type> initlist){
+            clear();
+            insert(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        // lookup: one node search a level; the last candidate seen on the
+        // way down is the answer when the leaf has none
+        iterator lower_bound(const key_type& k) { return __make_iterator(__lower_bound(k)); }
+        const_iterator lower_bound(const key_type& k) const { return __make_iterator(__lower_bound(k)); }
+        iterator upper_bound(const key_type& k) { return __make_iterator(__upper_bound(k)); }
+        const_iterator upper_bound(const key_type& k) const { return __make_iterator(__upper_bound(k)); }
+
+        iterator find(const key_type& k){
+            iterator it = lower_bound(k);
+            return it == end() || __comp(k, Policy::key(*it)) ? end() : it;
+        }
+        const_iterator find(const key_type& k) const {
+            const_iterator it = lower_bound(k);
+            return it == end() || __comp(k, Policy::key(*it)) ? end() : it;
+        }
+        bool contains(const key_type& k) const { return find(k) != end(); }
+
+        pair<iterator, iterator> equal_range(const key_type& k){
+            return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+        }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+            return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+        }
+        size_type count(const key_type& k) const {
+            pair<const_iterator, const_iterator> r = equal_range(k);
+            return static_cast<size_type>(learnSTL::distance(r.first, r.second));
+        }
+
+        // modifiers
+        __insert_result insert(const value_type& val) { return __insert(std::integral_constant<bool, Multi>(), val); }
+        __insert_result insert(value_type&& val) { return __insert(std::integral_constant<bool, Multi>(), learnSTL::move(val)); }
+        iterator insert(const_iterator hint, const value_type& val) {
+            return __emplace_hint_key(hint, Policy::key(val), val);
+        }
+        iterator insert(const_iterator hint, value_type&& val) {
+            return __emplace_hint_key(hint, Policy::key(val), learnSTL::move(val));
+        }
+
+        // each value is tried right before end(), so a sorted range is appended
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            insert(InputIter first, InputIter last){
+                for(; first != last; ++first)
+                    __emplace_hint_key(cend(), Policy::key(*first), *first);
+            }
+        void insert(std::initializer_list<value_type> initlist){
+            insert(initlist.begin(), initlist.end());
+        }
+
+        // the key is only known once the element exists, so it is built on
+        // the side and moved into a slot
+        template<typename ...Args>
+            __insert_result emplace(Args&&... args){
+                value_type val(learnSTL::forward<Args>(args)...);
+                return __insert(std::integral_constant<bool, Multi>(), learnSTL::move(val));
+            }
+        template<typename ...Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args){
+                value_type val(learnSTL::forward<Args>(args)...);
+                return __emplace_hint_key(hint, Policy::key(val), learnSTL::move(val));
+            }
+
+        // a value of an internal node is replaced by its predecessor, which
+        // is always on a leaf, and the leaf gives up the slot
+        iterator erase(const_iterator pos){
+            iterator it(pos.__node, pos.__pos);
+            const bool internal = !it.__node->__leaf;
+            __alloc_traits::destroy(__alloc, it.__node->__value(it.__pos));
+            if(internal){
+                iterator pred = it;
+                --pred;
+                Policy::transfer(__alloc, it.__node->__value(it.__pos), pred.__node->__value(pred.__pos));
+                it = pred;
+            }
+            __erase_gap(it.__node, it.__pos, 1);
+            --__size;
+            iterator res = __rebalance_after_erase(it);
+            // res is at the predecessor, which now sits where pos was
+            if(internal)
+                ++res;
+            return res;
+        }
+        iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+        // removes a leaf's share of the range at once and rebalances once a leaf
+        iterator erase(const_iterator first, const_iterator last){
+            size_type n = static_cast<size_type>(learnSTL::distance(first, last));
+            if(n == __size){
+                clear();
+                return end();
+            }
+            iterator it(first.__node, first.__pos);
+            while(n != 0){
+                if(!it.__node->__leaf){
+                    it = erase(it);
+                    --n;
+                    continue;
+                }
+                const size_type k = n < it.__node->__count - it.__pos ? n : it.__node->__count - it.__pos;
+                for(size_type i = 0; i != k; ++i)
+                    __alloc_traits::destroy(__alloc, it.__node->__value(it.__pos + i));
+                __erase_gap(it.__node, it.__pos, k);
+                __size -= k;
+                n -= k;
+                it = __rebalance_after_erase(it);
+            }
+            return it;
+        }
+        size_type erase(const key_type& k){
+            pair<iterator, iterator> r = equal_range(k);
+            const size_type n = static_cast<size_type>(learnSTL::distance(r.first, r.second));
+            erase(r.first, r.second);
+            return n;
+        }
+
+        void clear(){
+            if(__root != nullptr)
+                __destroy_subtree(__root);
+            __reset();
+        }
+
+        void swap(__btree& t){
+            __swap_alloc(__alloc, t.__alloc, std::integral_constant<bool,
+                __alloc_traits::propagate_on_container_swap::value>());
+            learnSTL::swap(__comp, t.__comp);
+            learnSTL::swap(__root, t.__root);
+            learnSTL::swap(__leftmost, t.__leftmost);
+            learnSTL::swap(__rightmost, t.__rightmost);
+            learnSTL::swap(__size, t.__size);
+        }
+
+    protected:
+        // unique keys: the element with key k, built from args only if
+        // there is none yet
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __emplace_key(const K& k, Args&&... args){
+                pair<iterator, bool> r = __find_or_leaf(k);
+                if(r.second)
+                    r.first = __emplace_leaf(r.first, learnSTL::forward<Args>(args)...);
+                return r;
+            }
+
+        // unique keys: the element with key k and false, or the leaf slot
+        // where k goes and true; only __emplace_leaf may use that one
+        template<typename K>
+            pair<iterator, bool> __find_or_leaf(const K& k){
+                if(__root == nullptr)
+                    __init_root();
+                __node* n = __root;
+                size_type i;
+                for(;;){
+                    i = __lower(n, k);
+                    if(i < n->__count && !__comp(k, Policy::key(*n->__value(i))))
+                        return pair<iterator, bool>(iterator(n, i), false);
+                    if(n->__leaf)
+                        break;
+                    n = n->__child(i);
+                }
+                return pair<iterator, bool>(iterator(n, i), true);
+            }
+
+        template<typename ...Args>
+            iterator __emplace_leaf(iterator pos, Args&&... args){
+                return __insert_leaf(pos.__node, pos.__pos, learnSTL::forward<Args>(args)...);
+            }
+
+        // equal keys: after the last one already there
+        template<typename K, typename ...Args>
+            iterator __emplace_multi(const K& k, Args&&... args){
+                if(__root == nullptr)
+                    __init_root();
+                __node* n = __root;
+                size_type i = __upper(n, k);
+                for(; !n->__leaf; i = __upper(n, k))
+                    n = n->__child(i);
+                return __insert_leaf(n, i, learnSTL::forward<Args>(args)...);
+            }
+
+        // k goes right before hint if it belongs there, wherever it belongs otherwise
+        template<typename K, typename ...Args>
+            iterator __emplace_hint_key(const_iterator hint, const K& k, Args&&... args){
+                if(__root != nullptr){
+                    bool fits = hint == end() || (Multi ? !__comp(Policy::key(*hint), k) : __comp(k, Policy::key(*hint)));
+                    if(fits && hint != begin()){
+                        const_iterator prev = hint;
+                        --prev;
+                        fits = Multi ? !__comp(k, Policy::key(*prev)) : __comp(Policy::key(*prev), k);
+                    }
+                    if(fits){
+                        __node* n = hint.__node;
+                        size_type i = hint.__pos;
+                        if(!n->__leaf){
+                            for(n = n->__child(i); !n->__leaf; )
+                                n = n->__child(n->__count);
+                            i = n->__count;
+                        }
+                        return __insert_leaf(n, i, learnSTL::forward<Args>(args)...);
+                    }
+                }
+                return __result_iterator(__insert_key(std::integral_constant<bool, Multi>(), k, learnSTL::forward<Args>(args)...));
+            }
+
+    private:
+        __node*       __root;
+        __node*       __leftmost;
+        __node*       __rightmost;
+        size_type     __size;
+        key_compare   __comp;
+        allocator_type __alloc;
+
+        void __reset(){
+            __root = __leftmost = __rightmost = nullptr;
+            __size = 0;
+        }
+
+        iterator __make_iterator(const_iterator it) const { return iterator(it.__node, it.__pos); }
+
+        static iterator __result_iterator(iterator it) { return it; }
+        static iterator __result_iterator(const pair<iterator, bool>& r) { return r.first; }
+
+        template<typename V>
+            iterator __insert(std::true_type, V&& val){
+                return __emplace_multi(Policy::key(val), learnSTL::forward<V>(val));
+            }
+        template<typename V>
+            pair<iterator, bool> __insert(std::false_type, V&& val){
+                return __emplace_key(Policy::key(val), learnSTL::forward<V>(val));
+            }
+
+        template<typename K, typename ...Args>
+            iterator __insert_key(std::true_type, const K& k, Args&&... args){
+                return __emplace_multi(k, learnSTL::forward<Args>(args)...);
+            }
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __insert_key(std::false_type, const K& k, Args&&... args){
+                return __emplace_key(k, learnSTL::forward<Args>(args)...);
+            }
+
+        // in-node search
+        template<typename K>
+            size_type __lower(const __node* n, const K& k) const {
+                return __lower(n, k, __btree_linear_search<key_type, Compare>());
+            }
+        template<typename K>
+            size_type __upper(const __node* n, const K& k) const {
+                return __upper(n, k, __btree_linear_search<key_type, Compare>());
+            }
+
+        size_type __lower(const __node* n, const key_type& k, std::true_type) const {
+            size_type i = 0;
+            for(size_type j = 0; j != n->__count; ++j)
+                i += Policy::key(*n->__value(j)) < k;
+            return i;
+        }
+        size_type __upper(const __node* n, const key_type& k, std::true_type) const {
+            size_type i = 0;
+            for(size_type j = 0; j != n->__count; ++j)
+                i += !(k < Policy::key(*n->__value(j)));
+            return i;
+        }
+        template<typename K>
+            size_type __lower(const __node* n, const K& k, std::false_type) const {
+                const value_type* first = n->__value(0);
+                const Compare& comp = __comp;
+                return learnSTL::lower_bound(first, first + n->__count, k,
+                    [&comp](const value_type& v, const K& x) { return comp(Policy::key(v), x); }) - first;
+            }
+        template<typename K>
+            size_type __upper(const __node* n, const K& k, std::false_type) const {
+                const value_type* first = n->__value(0);
+                const Compare& comp = __comp;
+                return learnSTL::upper_bound(first, first + n->__count, k,
+                    [&comp](const K& x, const value_type& v) { return comp(x, Policy::key(v)); }) - first;
+            }
+
+        const_iterator __lower_bound(const key_type& k) const {
+            const_iterator res = end();
+            for(__node* n = __root; n != nullptr; ){
+                const size_type i = __lower(n, k);
+                if(i < n->__count)
+                    res = const_iterator(n, i);
+                n = n->__leaf ? nullptr : n->__child(i);
+            }
+            return res;
+        }
+        const_iterator __upper_bound(const key_type& k) const {
+            const_iterator res = end();
+            for(__node* n = __root; n != nullptr; ){
+                const size_type i = __upper(n, k);
+                if(i < n->__count)
+                    res = const_iterator(n, i);
+                n = n->__leaf ? nullptr : n->__child(i);
+            }
+            return res;
+        }
+
+        // node storage
+        __node* __new_node(bool leaf){
+            __node* n;
+            if(leaf){
+                __leaf_alloc a(__alloc);
+                n = std::addressof(*__leaf_traits::allocate(a, 1));
+            }
+            else{
+                __internal_alloc a(__alloc);
+                n = std::addressof(*__internal_traits::allocate(a, 1));
+            }
+            n->__parent = nullptr;
+            n->__position = 0;
+            n->__count = 0;
+            n->__leaf = leaf;
+            return n;
+        }
+
+        void __delete_node(__node* n){
+            if(n->__leaf){
+                __leaf_alloc a(__alloc);
+                __leaf_traits::deallocate(a, std::pointer_traits<typename __leaf_traits::pointer>::pointer_to(*n), 1);
+            }
+            else{
+                __internal_alloc a(__alloc);
+                __internal_traits::deallocate(a, std::pointer_traits<typename __internal_traits::pointer>::pointer_to(
+                    *static_cast<__internal*>(n)), 1);
+            }
+        }
+
+        void __destroy_subtree(__node* n){
+            for(size_type i = 0; i != n->__count; ++i)
+                __alloc_traits::destroy(__alloc, n->__value(i));
+            if(!n->__leaf)
+                for(size_type i = 0; i <= n->__count; ++i)
+                    __destroy_subtree(n->__child(i));
+            __delete_node(n);
+        }
+
+        void __init_root(){
+            __root = __leftmost = __rightmost = __new_node(true);
+        }
+
+        void __transfer(__node* dn, size_type di, __node* sn, size_type si){
+            Policy::transfer(__alloc, dn->__value(di), sn->__value(si));
+        }
+
+        // opens slot i, and child slot i + 1 of an internal node
+        void __open_gap(__node* n, size_type i){
+            for(size_type j = n->__count; j > i; --j)
+                __transfer(n, j, n, j - 1);
+            if(!n->__leaf)
+                for(size_type j = n->__count + 1; j > i + 1; --j)
+                    n->__set_child(j, n->__child(j - 1));
+        }
+
+        // closes k destroyed slots at i of a leaf
+        void __erase_gap(__node* n, size_type i, size_type k){
+            for(size_type j = i + k; j < n->__count; ++j)
+                __transfer(n, j - k, n, j);
+            n->__count = static_cast<unsigned char>(n->__count - k);
+        }
+
+        // a full leaf is split only once the value is built, on the side,
+        // so a constructor that throws leaves the tree as it was
+        template<typename ...Args>
+            iterator __insert_leaf(__node* n, size_type i, Args&&... args){
+                if(n->__count == __N){
+                    typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type buf;
+                    value_type* v = reinterpret_cast<value_type*>(&buf);
+                    __alloc_traits::construct(__alloc, v, learnSTL::forward<Args>(args)...);
+                    try{
+                        __split(n, i);
+                    }
+                    catch(...){
+                        __alloc_traits::destroy(__alloc, v);
+                        throw;
+                    }
+                    __open_gap(n, i);
+                    Policy::transfer(__alloc, n->__value(i), v);
+                }
+                else{
+                    __open_gap(n, i);
+                    try{
+                        __alloc_traits::construct(__alloc, n->__value(i), learnSTL::forward<Args>(args)...);
+                    }
+                    catch(...){
+                        for(size_type j = i; j < n->__count; ++j)
+                            __transfer(n, j, n, j + 1);
+                        throw;
+                    }
+                }
+                ++n->__count;
+                ++__size;
+                return iterator(n, i);
+            }
+
+        // splits the full node n, which is about to take a value at i, and
+        // moves the middle value up; n and i follow the insert position.
+        // At the ends of a node the split is uneven so that runs of
+        // ascending or descending inserts leave full nodes behind.
+        void __split(__node*& n, size_type& i){
+            __node* p = n->__parent;
+            if(p == nullptr){
+                p = __new_node(false);
+                p->__set_child(0, n);
+                __root = p;
+            }
+            else if(p->__count == __N){
+                size_type pi = n->__position;
+                __split(p, pi);
+                p = n->__parent;
+            }
+            const size_type pos = n->__position;
+            const size_type mid = i == __N ? __N - 1 : (i == 0 ? 1 : __N / 2);
+            const size_type moved = __N - mid - 1;
+            __node* s = __new_node(n->__leaf);
+            for(size_type j = 0; j != moved; ++j)
+                __transfer(s, j, n, mid + 1 + j);
+            if(!n->__leaf)
+                for(size_type j = 0; j <= moved; ++j)
+                    s->__set_child(j, n->__child(mid + 1 + j));
+            s->__count = static_cast<unsigned char>(moved);
+            __open_gap(p, pos);
+            __transfer(p, pos, n, mid);
+            p->__set_child(pos + 1, s);
+            ++p->__count;
+            n->__count = static_cast<unsigned char>(mid);
+            if(n == __rightmost)
+                __rightmost = s;
+            if(i > mid){
+                n = s;
+                i -= mid + 1;
+            }
+        }
+
+        // walks up from a node that lost values, merging or borrowing while
+        // it is under half full. res follows the position it was given.
+        iterator __rebalance_after_erase(iterator it){
+            iterator res = it;
+            bool first = true;
+            for(;;){
+                if(it.__node == __root){
+                    __shrink_root();
+                    if(__root == nullptr)
+                        return end();
+                    break;
+                }
+                if(it.__node->__count >= __min)
+                    break;
+                const bool merged = __merge_or_rebalance(it);
+                if(first){
+                    res = it;
+                    first = false;
+                }
+                if(!merged)
+                    break;
+                it.__pos = it.__node->__position;
+                it.__node = it.__node->__parent;
+            }
+            if(res.__pos == res.__node->__count){
+                res.__pos = res.__node->__count - 1;
+                ++res;
+            }
+            return res;
+        }
+
+        bool __merge_or_rebalance(iterator& it){
+            __node* n = it.__node;
+            __node* p = n->__parent;
+            const size_type pos = n->__position;
+            if(pos > 0){
+                __node* l = p->__child(pos - 1);
+                if(size_type(l->__count) + n->__count + 1 <= __N){
+                    it.__pos += l->__count + 1;
+                    it.__node = l;
+                    __merge(l, n);
+                    return true;
+                }
+            }
+            if(pos < p->__count){
+                __node* r = p->__child(pos + 1);
+                if(size_type(n->__count) + r->__count + 1 <= __N){
+                    __merge(n, r);
+                    return true;
+                }
+                const size_type k = (r->__count - n->__count) / 2;
+                if(k != 0)
+                    __rebalance_right_to_left(n, r, k);
+                return false;
+            }
+            __node* l = p->__child(pos - 1);
+            const size_type k = (l->__count - n->__count) / 2;
+            if(k != 0){
+                __rebalance_left_to_right(l, n, k);
+                it.__pos += k;
+            }
+            return false;
+        }
+
+        // r and the value between l and r join l
+        void __merge(__node* l, __node* r){
+            __node* p = l->__parent;
+            const size_type pos = l->__position;
+            __transfer(l, l->__count, p, pos);
+            for(size_type j = 0; j != r->__count; ++j)
+                __transfer(l, l->__count + 1 + j, r, j);
+            if(!l->__leaf)
+                for(size_type j = 0; j <= r->__count; ++j)
+                    l->__set_child(l->__count + 1 + j, r->__child(j));
+            l->__count = static_cast<unsigned char>(l->__count + r->__count + 1);
+            for(size_type j = pos + 1; j < p->__count; ++j)
+                __transfer(p, j - 1, p, j);
+            for(size_type j = pos + 2; j <= p->__count; ++j)
+                p->__set_child(j - 1, p->__child(j));
+            --p->__count;
+            if(r == __rightmost)
+                __rightmost = l;
+            __delete_node(r);
+        }
+
+        // k values rotate from r through the parent into l
+        void __rebalance_right_to_left(__node* l, __node* r, size_type k){
+            __node* p = l->__parent;
+            const size_type pos = l->__position;
+            __transfer(l, l->__count, p, pos);
+            for(size_type j = 0; j + 1 < k; ++j)
+                __transfer(l, l->__count + 1 + j, r, j);
+            __transfer(p, pos, r, k - 1);
+            for(size_type j = k; j < r->__count; ++j)
+                __transfer(r, j - k, r, j);
+            if(!l->__leaf){
+                for(size_type j = 0; j != k; ++j)
+                    l->__set_child(l->__count + 1 + j, r->__child(j));
+                for(size_type j = k; j <= r->__count; ++j)
+                    r->__set_child(j - k, r->__child(j));
+            }
+            l->__count = static_cast<unsigned char>(l->__count + k);
+            r->__count = static_cast<unsigned char>(r->__count - k);
+        }
+
+        // k values rotate from l through the parent into r
+        void __rebalance_left_to_right(__node* l, __node* r, size_type k){
+            __node* p = l->__parent;
+            const size_type pos = l->__position;
+            for(size_type j = r->__count; j-- > 0; )
+                __transfer(r, j + k, r, j);
+            if(!r->__leaf)
+                for(size_type j = r->__count + 1; j-- > 0; )
+                    r->__set_child(j + k, r->__child(j));
+            __transfer(r, k - 1, p, pos);
+            for(size_type j = 0; j + 1 < k; ++j)
+                __transfer(r, j, l, l->__count - k + 1 + j);
+            __transfer(p, pos, l, l->__count - k);
+            if(!r->__leaf)
+                for(size_type j = 0; j != k; ++j)
+                    r->__set_child(j, l->__child(l->__count - k + 1 + j));
+            l->__count = static_cast<unsigned char>(l->__count - k);
+            r->__count = static_cast<unsigned char>(r->__count + k);
+        }
+
+        // an empty root goes away, an internal one hands over to its only child
+        void __shrink_root(){
+            if(__root->__count != 0)
+                return;
+            __node* old = __root;
+            if(old->__leaf)
+                __reset();
+            else{
+                __root = old->__child(0);
+                __root->__parent = nullptr;
+                __root->__position = 0;
+            }
+            __delete_node(old);
+        }
+
+        void __move_elements(__btree& rt){
+            for(iterator it = rt.begin(); it != rt.end(); ++it)
+                __emplace_hint_key(cend(), Policy::key(*it), learnSTL::move(*it));
+            rt.clear();
+        }
+
+        void __steal(__btree& rt){
+            __root = rt.__root;
+            __leftmost = rt.__leftmost;
+            __rightmost = rt.__rightmost;
+            __size = rt.__size;
+            rt.__reset();
+        }
+
+        void __copy_assign_alloc(const __btree& t, std::true_type){
+            __alloc = t.__alloc;
+        }
+        void __copy_assign_alloc(const __btree&, std::false_type) {}
+
+        void __move_assign_alloc(__btree& rt, std::true_type){
+            __alloc = learnSTL::move(rt.__alloc);
+        }
+        void __move_assign_alloc(__btree&, std::false_type) {}
+
+        void __swap_alloc(allocator_type& a1, allocator_type& a2, std::true_type){
+            learnSTL::swap(a1, a2);
+        }
+        void __swap_alloc(allocator_type&, allocator_type&, std::false_type) {}
+    };
+
+    // comparisons of all four containers, in key order
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        bool operator==(const __btree<Policy, Compare, Alloc, Multi>& t1, const __btree<Policy, Compare, Alloc, Multi>& t2){
+            return t1.size() == t2.size() && learnSTL::equal(t1.begin(), t1.end(), t2.begin());
+        }
+
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        bool operator!=(const __btree<Policy, Compare, Alloc, Multi>& t1, const __btree<Policy, Compare, Alloc, Multi>& t2){
+            return !(t1 == t2);
+        }
+
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        bool operator<(const __btree<Policy, Compare, Alloc, Multi>& t1, const __btree<Policy, Compare, Alloc, Multi>& t2){
+            return learnSTL::lexicographical_compare(t1.begin(), t1.end(), t2.begin(), t2.end());
+        }
+
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        bool operator>(const __btree<Policy, Compare, Alloc, Multi>& t1, const __btree<Policy, Compare, Alloc, Multi>& t2){
+            return t2 < t1;
+        }
+
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        bool operator<=(const __btree<Policy, Compare, Alloc, Multi>& t1, const __btree<Policy, Compare, Alloc, Multi>& t2){
+            return !(t2 < t1);
+        }
+
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        bool operator>=(const __btree<Policy, Compare, Alloc, Multi>& t1, const __btree<Policy, Compare, Alloc, Multi>& t2){
+            return !(t1 < t2);
+        }
+
+    template<typename Policy, typename Compare, typename Alloc, bool Multi>
+        void swap(__btree<Policy, Compare, Alloc, Multi>& t1, __btree<Policy, Compare, Alloc, Multi>& t2){
+            t1.swap(t2);
+        }
+    ///~ ------------------------- end btree ----------------------------
+
+
+    ///: ------------------------- btree_set --------------------------------
+    template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key> >
+    class btree_set : public __btree<__btree_set_policy<Key>, Compare, Allocator, false>{
+        using __base = __btree<__btree_set_policy<Key>, Compare, Allocator, false>;
+    public:
+        using value_compare = Compare;
+
+        using __base::__base;
+        using __base::operator=;
+
+        btree_set() = default;
+        btree_set(std::initializer_list<Key> initlist) : __base(initlist) {}
+
+        value_compare value_comp() const { return this->key_comp(); }
+    };
+
+    template<typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key> >
+    class btree_multiset : public __btree<__btree_set_policy<Key>, Compare, Allocator, true>{
+        using __base = __btree<__btree_set_policy<Key>, Compare, Allocator, true>;
+    public:
+        using value_compare = Compare;
+
+        using __base::__base;
+        using __base::operator=;
+
+        btree_multiset() = default;
+        btree_multiset(std::initializer_list<Key> initlist) : __base(initlist) {}
+
+        value_compare value_comp() const { return this->key_comp(); }
+    };
+    ///~ ------------------------- end btree_set ----------------------------
+
+
+    ///: ------------------------- btree_map --------------------------------
+    template<typename Key, typename T, typename Compare>
+    class __btree_value_compare{
+    public:
+        bool operator()(const pair<const Key, T>& x, const pair<const Key, T>& y) const { return __comp(x.first, y.first); }
+
+        explicit __btree_value_compare(const Compare& comp) : __comp(comp) {}
+
+    private:
+        Compare __comp;
+    };
+
+    template<typename Key, typename T, typename Compare = std::less<Key>,
+             typename Allocator = std::allocator<pair<const Key, T> > >
+    class btree_map : public __btree<__btree_map_policy<Key, T>, Compare, Allocator, false>{
+        using __base = __btree<__btree_map_policy<Key, T>, Compare, Allocator, false>;
+    public:
+        using mapped_type    = T;
+        using key_type       = typename __base::key_type;
+        using value_type     = typename __base::value_type;
+        using iterator       = typename __base::iterator;
+        using const_iterator = typename __base::const_iterator;
+        using value_compare  = __btree_value_compare<Key, T, Compare>;
+
+        using __base::__base;
+        using __base::operator=;
+
+        btree_map() = default;
+        btree_map(std::initializer_list<value_type> initlist) : __base(initlist) {}
+
+        value_compare value_comp() const { return value_compare(this->key_comp()); }
+
+        // access
+        mapped_type& operator[](const key_type& k) { return try_emplace(k).first->second; }
+        mapped_type& operator[](key_type&& k) { return try_emplace(learnSTL::move(k)).first->second; }
+
+        mapped_type& at(const key_type& k){
+            iterator it = this->find(k);
+            if(it == this->end())
+                throw std::out_of_range("btree_map::at");
+            return it->second;
+        }
+        const mapped_type& at(const key_type& k) const {
+            const_iterator it = this->find(k);
+            if(it == this->end())
+                throw std::out_of_range("btree_map::at");
+            return it->second;
+        }
+
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+                return __try_emplace(k, k, learnSTL::forward<Args>(args)...);
+            }
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+                return __try_emplace(k, learnSTL::move(k), learnSTL::forward<Args>(args)...);
+            }
+
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(const key_type& k, M&& m){
+                pair<iterator, bool> r = try_emplace(k, learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(key_type&& k, M&& m){
+                pair<iterator, bool> r = try_emplace(learnSTL::move(k), learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+
+    private:
+        // one descent finds k or the leaf slot it goes in
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __try_emplace(const key_type& k, K&& key, Args&&... args){
+                pair<iterator, bool> r = this->__find_or_leaf(k);
+                if(r.second)
+                    r.first = this->__emplace_leaf(r.first, learnSTL::forward<K>(key),
+                                                   mapped_type(learnSTL::forward<Args>(args)...));
+                return r;
+            }
+    };
+
+    template<typename Key, typename T, typename Compare = std::less<Key>,
+             typename Allocator = std::allocator<pair<const Key, T> > >
+    class btree_multimap : public __btree<__btree_map_policy<Key, T>, Compare, Allocator, true>{
+        using __base = __btree<__btree_map_policy<Key, T>, Compare, Allocator, true>;
+    public:
+        using mapped_type   = T;
+        using value_type    = typename __base::value_type;
+        using value_compare = __btree_value_compare<Key, T, Compare>;
+
+        using __base::__base;
+        using __base::operator=;
+
+        btree_multimap() = default;
+        btree_multimap(std::initializer_list<value_type> initlist) : __base(initlist) {}
+
+        value_compare value_comp() const { return value_compare(this->key_comp()); }
+    };
+    ///~ ------------------------- end btree_map ----------------------------
+}
+
+#endif
@@ -0,0 +1,380 @@
+#ifndef MY_CONCURRENT_QUEUE_H
+#define MY_CONCURRENT_QUEUE_H
+
+#include <cstddef>
+#include <atomic>
+#include <new>
+#include <memory>
+#include <type_traits>
+#include "iterator.h"
+#include "utility.h"
+#include "array.h"
+
+namespace learnSTL{
+    // counters written by different threads are kept this far apart
+    const std::size_t __cache_line = 64;
+
+    ///: ------------------------- mpmc_ring --------------------------------
+    // a slot of the ring. __seq tells whose turn it is: a producer may fill
+    // the slot for position p when __seq == p, a consumer may empty it when
+    // __seq == p + 1. Emptying sets __seq to p + Capacity, the next lap.
+    template<typename T>
+    struct __ring_slot{
+        std::atomic<std::size_t> __seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type __storage;
+
+        T* __ptr() { return reinterpret_cast<T*>(&__storage); }
+    };
+
+    // bounded lock-free queue for any number of producers and consumers
+    // (Vyukov). A push or pop claims positions with one CAS on its counter
+    // and then waits on nobody: the slot's sequence number tells whether it
+    // is free or full. The batch calls claim as many neighbouring slots as
+    // are ready with a single CAS and report how many they got.
+    // Constructing an element in a claimed slot must not throw, there is no
+    // way to hand the slot back: try_push_n insists on it, the single pushes
+    // fall back to a temporary.
+    template<typename T, std::size_t Capacity>
+    class mpmc_ring{
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "mpmc_ring capacity must be a power of two");
+        static_assert(std::is_nothrow_move_constructible<T>::value, "mpmc_ring needs a nothrow move constructor");
+    public:
+        typedef T               value_type;
+        typedef std::size_t     size_type;
+        typedef T&              reference;
+        typedef const T&        const_reference;
+
+        mpmc_ring() : __head(0), __tail(0) {
+            for(size_type i = 0; i < Capacity; ++i)
+                __slots[i].__seq.store(i, std::memory_order_relaxed);
+        }
+
+        mpmc_ring(const mpmc_ring&) = delete;
+        mpmc_ring& operator=(const mpmc_ring&) = delete;
+
+        // no other thread may use the ring any more
+        ~mpmc_ring(){
+            size_type t = __tail.load(std::memory_order_relaxed);
+            size_type h = __head.load(std::memory_order_relaxed);
+            for(; t != h; ++t)
+                __slots[t & __mask].__ptr()->~T();
+        }
+
+        static constexpr size_type capacity() { return Capacity; }
+
+        // a snapshot, stale as soon as it is taken
+        size_type size_approx() const {
+            size_type t = __tail.load(std::memory_order_relaxed);
+            size_type h = __head.load(std::memory_order_relaxed);
+            return h > t ? h - t : 0;
+        }
+        bool empty_approx() const { return size_approx() == 0; }
+
+        // push, false when the ring is full. A constructor that may throw
+        // runs on a temporary before a slot is claimed.
+        bool try_push(const_reference val){
+            return try_emplace(val);
+        }
+        bool try_push(value_type&& val){
+            return try_emplace(learnSTL::move(val));
+        }
+
+        template<typename ...Args>
+            bool try_emplace(Args&&... args){
+                return __try_emplace(std::is_nothrow_constructible<T, Args&&...>(), learnSTL::forward<Args>(args)...);
+            }
+
+        // pop, false when the ring is empty
+        bool try_pop(reference out){
+            static_assert(std::is_nothrow_move_assignable<T>::value,
+                          "mpmc_ring moves out of a claimed slot, which must not throw");
+            size_type pos;
+            if(__claim(__tail, 1, 1, pos) == 0)
+                return false;
+            __ring_slot<T>& s = __slots[pos & __mask];
+            out = learnSTL::move(*s.__ptr());
+            __release(s, pos);
+            return true;
+        }
+
+        // pushes up to n elements from first; returns how many went in and
+        // where the input stopped. Pass move_iterators to move the elements.
+        template<typename InputIter>
+            pair<size_type, InputIter> try_push_n(InputIter first, size_type n){
+                static_assert(std::is_nothrow_constructible<T, typename iterator_traits<InputIter>::reference>::value,
+                              "mpmc_ring constructs in a claimed slot, which must not throw");
+                size_type pos;
+                const size_type k = __claim(__head, 0, n, pos);
+                for(size_type i = 0; i < k; ++i, ++first){
+                    __ring_slot<T>& s = __slots[(pos + i) & __mask];
+                    ::new(static_cast<void*>(s.__ptr())) T(*first);
+                    s.__seq.store(pos + i + 1, std::memory_order_release);
+                }
+                return pair<size_type, InputIter>(k, first);
+            }
+
+        // pops up to n elements into out; returns how many came out and the
+        // end of the output. When writing to out throws, the elements claimed
+        // and not yet written are dropped, so their slots still go back.
+        template<typename OutputIter>
+            pair<size_type, OutputIter> try_pop_n(OutputIter out, size_type n){
+                size_type pos;
+                const size_type k = __claim(__tail, 1, n, pos);
+                size_type i = 0;
+                try{
+                    for(; i < k; ++i, ++out){
+                        __ring_slot<T>& s = __slots[(pos + i) & __mask];
+                        *out = learnSTL::move(*s.__ptr());
+                        __release(s, pos + i);
+                    }
+                }
+                catch(...){
+                    for(; i < k; ++i)
+                        __release(__slots[(pos + i) & __mask], pos + i);
+                    throw;
+                }
+                return pair<size_type, OutputIter>(k, out);
+            }
+
+    private:
+        static const size_type __mask = Capacity - 1;
+
+        // head and tail each get a cache line, away from the slots and
+        // from whatever is next to the ring
+        char                        __pad0[__cache_line];
+        std::atomic<size_type>      __head;         // next position to push
+        char                        __pad1[__cache_line - sizeof(std::atomic<size_type>)];
+        std::atomic<size_type>      __tail;         // next position to pop
+        char                        __pad2[__cache_line - sizeof(std::atomic<size_type>)];
+        array<__ring_slot<T>, Capacity> __slots;
+        char                        __pad3[__cache_line];
+
+        // claims up to n positions starting at counter, all of them ready:
+        // a slot for position p is ready when its __seq is p + lag. Returns
+        // the number claimed, the first one goes to pos.
+        size_type __claim(std::atomic<size_type>& counter, size_type lag, size_type n, size_type& pos){
+            if(n == 0)
+                return 0;
+            pos = counter.load(std::memory_order_relaxed);
+            for(;;){
+                size_type k = 0;
+                for(; k < n && k < Capacity; ++k){
+                    size_type seq = __slots[(pos + k) & __mask].__seq.load(std::memory_order_acquire);
+                    if(seq != pos + k + lag)
+                        break;
+                }
+                if(k == 0){
+                    // the slot is a lap behind (ring full or empty) or another
+                    // thread took the position: reload and look again
+                    size_type seq = __slots[pos & __mask].__seq.load(std::memory_order_acquire);
+                    const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + lag));
+                    if(diff < 0)
+                        return 0;
+                    pos = counter.load(std::memory_order_relaxed);
+                    continue;
+                }
+                if(counter.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+                    return k;
+            }
+        }
+
+        // ends the element in the slot of position pos, free for the next lap
+        void __release(__ring_slot<T>& s, size_type pos){
+            s.__ptr()->~T();
+            s.__seq.store(pos + Capacity, std::memory_order_release);
+        }
+
+        template<typename ...Args>
+            bool __try_emplace(std::true_type, Args&&... args){
+                size_type pos;
+                if(__claim(__head, 0, 1, pos) == 0)
+                    return false;
+                __ring_slot<T>& s = __slots[pos & __mask];
+                ::new(static_cast<void*>(s.__ptr())) T(learnSTL::forward<Args>(args)...);
+                s.__seq.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        template<typename ...Args>
+            bool __try_emplace(std::false_type, Args&&... args){
+                value_type tmp(learnSTL::forward<Args>(args)...);
+                return __try_emplace(std::true_type(), learnSTL::move(tmp));
+            }
+    };
+
+    template<typename T, std::size_t Capacity>
+        const std::size_t mpmc_ring<T, Capacity>::__mask;
+    ///~ ------------------------- end mpmc_ring ----------------------------
+
+
+    ///: ------------------------- spsc_queue --------------------------------
+    // bounded queue for one producer thread and one consumer thread that
+    // hands out the buffer itself instead of copying through it. The
+    // producer asks reserve(n) for writable slots, fills them in place and
+    // publishes them with commit(n); the consumer reads what peek(n) gives
+    // and hands the slots back with release(n).
+    // The slots always hold live objects (default constructed up front), so
+    // a producer overwrites a record and keeps its capacity, e.g. of a string.
+    // Each side caches the other's index and only reloads it when the cached
+    // value says there is no room, so most calls touch no shared line.
+    template<typename T, typename Allocator = std::allocator<T> >
+    class spsc_queue{
+        typedef std::allocator_traits<Allocator> __alloc_traits;
+    public:
+        typedef T               value_type;
+        typedef Allocator       allocator_type;
+        typedef std::size_t     size_type;
+        typedef T&              reference;
+        typedef const T&        const_reference;
+
+        // contiguous slots of the buffer, never wrapping around its end
+        class span{
+        public:
+            typedef T*  iterator;
+
+            span() : __data(nullptr), __size(0) {}
+            span(T* data, size_type size) : __data(data), __size(size) {}
+
+            T* data() const { return __data; }
+            size_type size() const { return __size; }
+            bool empty() const { return __size == 0; }
+            T& operator[](size_type i) const { return __data[i]; }
+            iterator begin() const { return __data; }
+            iterator end() const { return __data + __size; }
+        private:
+            T*          __data;
+            size_type   __size;
+        };
+
+        // capacity is rounded up to a power of two
+        explicit spsc_queue(size_type capacity, const allocator_type& a = allocator_type())
+            : __alloc(a), __buf(nullptr), __cap(__round_up(capacity)), __mask(__cap - 1),
+              __write(0), __read_cache(0), __read(0), __write_cache(0) {
+            __buf = __alloc_traits::allocate(__alloc, __cap);
+            size_type i = 0;
+            try{
+                for(; i < __cap; ++i)
+                    __alloc_traits::construct(__alloc, __buf + i);
+            }
+            catch(...){
+                __destroy(i);
+                throw;
+            }
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        ~spsc_queue() { __destroy(__cap); }
+
+        size_type capacity() const { return __cap; }
+        allocator_type get_allocator() const { return __alloc; }
+
+        // a snapshot, exact only on a quiet queue. __read is loaded first:
+        // __write only grows and was never behind it, so the difference
+        // cannot wrap below zero
+        size_type size_approx() const {
+            const size_type r = __read.load(std::memory_order_acquire);
+            return __write.load(std::memory_order_acquire) - r;
+        }
+        bool empty_approx() const { return size_approx() == 0; }
+
+        // producer: up to n free slots that follow each other in memory.
+        // Fewer come back when the queue is nearly full or the free room
+        // wraps around the end of the buffer; ask again after commit.
+        span reserve(size_type n){
+            const size_type w = __write.load(std::memory_order_relaxed);
+            size_type room = __cap - (w - __read_cache);
+            if(room < n){
+                __read_cache = __read.load(std::memory_order_acquire);
+                room = __cap - (w - __read_cache);
+            }
+            const size_type i = w & __mask;
+            return span(__buf + i, __fit(n, room, __cap - i));
+        }
+        span reserve() { return reserve(__cap); }
+
+        // producer: publishes the first n slots of the last reserve, n must not
+        // be more than it returned
+        void commit(size_type n){
+            __write.store(__write.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        // consumer: up to n published elements, with the same limits as reserve
+        span peek(size_type n){
+            const size_type r = __read.load(std::memory_order_relaxed);
+            size_type ready = __write_cache - r;
+            if(ready < n){
+                __write_cache = __write.load(std::memory_order_acquire);
+                ready = __write_cache - r;
+            }
+            const size_type i = r & __mask;
+            return span(__buf + i, __fit(n, ready, __cap - i));
+        }
+        span peek() { return peek(__cap); }
+
+        // consumer: hands the first n slots of the last peek back to the producer.
+        // The objects stay alive until the producer overwrites them.
+        void release(size_type n){
+            __read.store(__read.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+        // one element at a time, for callers that do not batch
+        template<typename U>
+            bool try_push(U&& val){
+                span s = reserve(1);
+                if(s.empty())
+                    return false;
+                s[0] = learnSTL::forward<U>(val);
+                commit(1);
+                return true;
+            }
+        bool try_pop(reference out){
+            span s = peek(1);
+            if(s.empty())
+                return false;
+            out = learnSTL::move(s[0]);
+            release(1);
+            return true;
+        }
+
+    private:
+        // read by both sides but never written after construction
+        allocator_type              __alloc;
+        T*                          __buf;
+        const size_type             __cap;
+        const size_type             __mask;
+
+        // producer's line: its index and its copy of the consumer's
+        char                        __pad0[__cache_line];
+        std::atomic<size_type>      __write;
+        size_type                   __read_cache;
+        char                        __pad1[__cache_line];
+
+        // consumer's line
+        std::atomic<size_type>      __read;
+        size_type                   __write_cache;
+        char                        __pad2[__cache_line];
+
+        static size_type __round_up(size_type n){
+            size_type c = 2;
+            while(c < n)
+                c *= 2;
+            return c;
+        }
+
+        static size_type __fit(size_type n, size_type avail, size_type to_end){
+            if(avail < n)
+                n = avail;
+            return to_end < n ? to_end : n;
+        }
+
+        void __destroy(size_type n){
+            for(size_type i = 0; i < n; ++i)
+                __alloc_traits::destroy(__alloc, __buf + i);
+            __alloc_traits::deallocate(__alloc, __buf, __cap);
+        }
+    };
+    ///~ ------------------------- end spsc_queue ----------------------------
+}
+
+#endif
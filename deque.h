@@ -0,0 +1,717 @@
+#ifndef MY_DEQUE_H
+#define MY_DEQUE_H
+
+#include <cstddef>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+
+namespace learnSTL{
+    // elements per block: a 4KB block, and at least 16 elements for large types
+    template<typename T>
+    struct __deque_block_size{
+        static const std::size_t value = sizeof(T) < 256 ? 4096 / sizeof(T) : 16;
+    };
+
+    template<typename T, typename Allocator, std::size_t BlockSize> class deque;
+
+    // an element position: the element, and the map slot of its block
+    template<typename T, std::size_t B, bool Const>
+    class __deque_iterator{
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = typename std::conditional<Const, const T&, T&>::type;
+        using pointer           = typename std::conditional<Const, const T*, T*>::type;
+
+        __deque_iterator() : __cur(nullptr), __first(nullptr), __node(nullptr) {}
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        __deque_iterator(const __deque_iterator<T, B, C>& iter)
+            : __cur(iter.__cur), __first(iter.__first), __node(iter.__node) {}
+
+        reference operator*() const { return *__cur; }
+        pointer operator->() const { return __cur; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        __deque_iterator& operator++(){
+            if(++__cur == __first + B){
+                __set_node(__node + 1);
+                __cur = __first;
+            }
+            return *this;
+        }
+        __deque_iterator operator++(int){
+            __deque_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+        __deque_iterator& operator--(){
+            if(__cur == __first){
+                __set_node(__node - 1);
+                __cur = __first + B;
+            }
+            --__cur;
+            return *this;
+        }
+        __deque_iterator operator--(int){
+            __deque_iterator temp(*this);
+            --*this;
+            return temp;
+        }
+
+        __deque_iterator& operator+=(difference_type n){
+            const difference_type b = static_cast<difference_type>(B);
+            difference_type off = n + (__cur - __first);
+            if(off >= 0 && off < b)
+                __cur += n;
+            else{
+                difference_type node_off = off > 0 ? off / b : -((-off - 1) / b) - 1;
+                __set_node(__node + node_off);
+                __cur = __first + (off - node_off * b);
+            }
+            return *this;
+        }
+        __deque_iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend __deque_iterator operator+(__deque_iterator iter, difference_type n) { return iter += n; }
+        friend __deque_iterator operator+(difference_type n, __deque_iterator iter) { return iter += n; }
+        friend __deque_iterator operator-(__deque_iterator iter, difference_type n) { return iter -= n; }
+
+        friend difference_type operator-(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return static_cast<difference_type>(B) * (iter1.__node - iter2.__node)
+                 + (iter1.__cur - iter1.__first) - (iter2.__cur - iter2.__first);
+        }
+
+        friend bool operator==(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return iter1.__cur == iter2.__cur;
+        }
+        friend bool operator!=(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return iter1.__cur != iter2.__cur;
+        }
+        friend bool operator<(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return iter1.__node == iter2.__node ? iter1.__cur < iter2.__cur : iter1.__node < iter2.__node;
+        }
+        friend bool operator>(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return iter2 < iter1;
+        }
+        friend bool operator<=(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return !(iter2 < iter1);
+        }
+        friend bool operator>=(const __deque_iterator& iter1, const __deque_iterator& iter2){
+            return !(iter1 < iter2);
+        }
+
+    private:
+        T*  __cur;
+        T*  __first;        // start of the block
+        T** __node;         // the block's slot in the map
+
+        __deque_iterator(T* cur, T** node) : __cur(cur), __first(*node), __node(node) {}
+
+        void __set_node(T** node){
+            __node = node;
+            __first = *node;
+        }
+
+        template<typename, std::size_t, bool> friend class __deque_iterator;
+        template<typename, typename, std::size_t> friend class deque;
+    };
+
+    // ------ deque -----------
+    // elements live in blocks of BlockSize, the map holds the block pointers
+    // in order with free slots at both ends. Pushing at either end fills the
+    // end block or adds one; only the map is ever reallocated, so references
+    // to elements stay valid. The block after the last element always exists,
+    // which keeps end() a real position.
+    template<typename T, typename Allocator = std::allocator<T>,
+             std::size_t BlockSize = __deque_block_size<T>::value>
+    class deque{
+        static_assert(BlockSize > 0, "deque needs a block size");
+        static const std::size_t B = BlockSize;
+        using __alloc_traits = std::allocator_traits<Allocator>;
+        using __map_alloc    = typename __alloc_traits::template rebind_alloc<T*>;
+        using __map_traits   = std::allocator_traits<__map_alloc>;
+    public:
+        using value_type       = T;
+        using allocator_type   = Allocator;
+        using size_type        = std::size_t;
+        using difference_type  = std::ptrdiff_t;
+        using reference        = value_type&;
+        using const_reference  = const value_type&;
+        using pointer          = typename __alloc_traits::pointer;
+        using const_pointer    = typename __alloc_traits::const_pointer;
+
+        using iterator               = __deque_iterator<T, BlockSize, false>;
+        using const_iterator         = __deque_iterator<T, BlockSize, true>;
+        using reverse_iterator       = learnSTL::reverse_iterator<iterator>;
+        using const_reverse_iterator = learnSTL::reverse_iterator<const_iterator>;
+
+        static const size_type block_size = BlockSize;
+
+        // iterator
+        iterator begin() { return __start; }
+        const_iterator begin() const { return __start; }
+        const_iterator cbegin() const { return __start; }
+        iterator end() { return __finish; }
+        const_iterator end() const { return __finish; }
+        const_iterator cend() const { return __finish; }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return rend(); }
+
+        allocator_type get_allocator() const { return __alloc; }
+
+        // capacity
+        size_type size() const { return static_cast<size_type>(__finish - __start); }
+        bool empty() const { return __start == __finish; }
+        size_type max_size() const {
+            return std::numeric_limits<difference_type>::max() / sizeof(T);
+        }
+
+        // access
+        reference operator[](size_type n) { return __start[static_cast<difference_type>(n)]; }
+        const_reference operator[](size_type n) const { return begin()[static_cast<difference_type>(n)]; }
+        reference at(size_type n){
+            if(n >= size())
+                throw std::out_of_range("deque::at");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const {
+            if(n >= size())
+                throw std::out_of_range("deque::at");
+            return (*this)[n];
+        }
+        reference front() { return *__start; }
+        const_reference front() const { return *__start; }
+        reference back() { return *(__finish - 1); }
+        const_reference back() const { return *(end() - 1); }
+
+        // constructor
+        deque() : __alloc(), __map(nullptr), __map_size(0) {}
+        explicit deque(const allocator_type& a) : __alloc(a), __map(nullptr), __map_size(0) {}
+
+        explicit deque(size_type n, const allocator_type& a = allocator_type())
+            : __alloc(a), __map(nullptr), __map_size(0)
+        {
+            resize(n);
+        }
+        deque(size_type n, const_reference val, const allocator_type& a = allocator_type())
+            : __alloc(a), __map(nullptr), __map_size(0)
+        {
+            resize(n, val);
+        }
+        template<typename InputIter>
+        deque(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value,
+              InputIter>::type last, const allocator_type& a = allocator_type())
+            : __alloc(a), __map(nullptr), __map_size(0)
+        {
+            __append(first, last);
+        }
+        deque(std::initializer_list<value_type> initlist, const allocator_type& a = allocator_type())
+            : __alloc(a), __map(nullptr), __map_size(0)
+        {
+            __append(initlist.begin(), initlist.end());
+        }
+
+        // copy-constructor
+        deque(const deque& d)
+            : __alloc(__alloc_traits::select_on_container_copy_construction(d.__alloc)), __map(nullptr), __map_size(0)
+        {
+            __append(d.begin(), d.end());
+        }
+        deque(const deque& d, const allocator_type& a) : __alloc(a), __map(nullptr), __map_size(0)
+        {
+            __append(d.begin(), d.end());
+        }
+
+        // move-constructor
+        deque(deque&& rd) : __alloc(learnSTL::move(rd.__alloc)), __map(nullptr), __map_size(0)
+        {
+            __steal(rd);
+        }
+        deque(deque&& rd, const allocator_type& a) : __alloc(a), __map(nullptr), __map_size(0)
+        {
+            if(__alloc == rd.__alloc)
+                __steal(rd);
+            else{
+                using moveIter = move_iterator<iterator>;
+                __append(moveIter(rd.begin()), moveIter(rd.end()));
+            }
+        }
+
+        ~deque(){
+            __release();
+        }
+
+        // assignment
+        deque& operator=(const deque& d){
+            if(this != &d){
+                __copy_assign_alloc(d, std::integral_constant<bool,
+                    __alloc_traits::propagate_on_container_copy_assignment::value>());
+                assign(d.begin(), d.end());
+            }
+            return *this;
+        }
+
+        deque& operator=(deque&& rd){
+            if(this != &rd){
+                if(__alloc_traits::propagate_on_container_move_assignment::value || __alloc == rd.__alloc){
+                    __release();
+                    __move_assign_alloc(rd, std::integral_constant<bool,
+                        __alloc_traits::propagate_on_container_move_assignment::value>());
+                    __steal(rd);
+                }
+                else{
+                    using moveIter = move_iterator<iterator>;
+                    assign(moveIter(rd.begin()), moveIter(rd.end()));
+                }
+            }
+            return *this;
+        }
+
+        deque& operator=(std::initializer_list<value_type> initlist){
+            assign(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        void assign(size_type n, const_reference val){
+            value_type copy(val);
+            iterator b = begin();
+            for(; b != end() && n > 0; ++b, --n)
+                *b = copy;
+            __erase_at_end(b);
+            for(; n > 0; --n)
+                push_back(copy);
+        }
+
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            assign(InputIter first, InputIter last){
+                iterator b = begin();
+                for(; b != end() && first != last; ++b, ++first)
+                    *b = *first;
+                __erase_at_end(b);
+                __append(first, last);
+            }
+
+        void assign(std::initializer_list<value_type> initlist){
+            assign(initlist.begin(), initlist.end());
+        }
+
+        // push and pop
+        void push_back(const_reference val){
+            emplace_back(val);
+        }
+        void push_back(value_type&& val){
+            emplace_back(learnSTL::move(val));
+        }
+        void push_front(const_reference val){
+            emplace_front(val);
+        }
+        void push_front(value_type&& val){
+            emplace_front(learnSTL::move(val));
+        }
+
+        template<typename ...Args>
+            void emplace_back(Args&&... args){
+                if(__map == nullptr)
+                    __create_map();
+                if(__finish.__cur != __finish.__first + (B - 1)){
+                    __alloc_traits::construct(__alloc, __finish.__cur, learnSTL::forward<Args>(args)...);
+                    ++__finish.__cur;
+                    return;
+                }
+                // the last free slot of the block: the next block must exist first
+                __reserve_map_at_back(1);
+                __finish.__node[1] = __alloc_traits::allocate(__alloc, B);
+                try{
+                    __alloc_traits::construct(__alloc, __finish.__cur, learnSTL::forward<Args>(args)...);
+                }
+                catch(...){
+                    __alloc_traits::deallocate(__alloc, __finish.__node[1], B);
+                    throw;
+                }
+                __finish.__set_node(__finish.__node + 1);
+                __finish.__cur = __finish.__first;
+            }
+
+        template<typename ...Args>
+            void emplace_front(Args&&... args){
+                if(__map == nullptr)
+                    __create_map();
+                if(__start.__cur != __start.__first){
+                    __alloc_traits::construct(__alloc, __start.__cur - 1, learnSTL::forward<Args>(args)...);
+                    --__start.__cur;
+                    return;
+                }
+                __reserve_map_at_front(1);
+                __start.__node[-1] = __alloc_traits::allocate(__alloc, B);
+                try{
+                    __alloc_traits::construct(__alloc, __start.__node[-1] + (B - 1), learnSTL::forward<Args>(args)...);
+                }
+                catch(...){
+                    __alloc_traits::deallocate(__alloc, __start.__node[-1], B);
+                    throw;
+                }
+                __start.__set_node(__start.__node - 1);
+                __start.__cur = __start.__first + (B - 1);
+            }
+
+        void pop_back(){
+            if(__finish.__cur == __finish.__first){
+                __alloc_traits::deallocate(__alloc, __finish.__first, B);
+                __finish.__set_node(__finish.__node - 1);
+                __finish.__cur = __finish.__first + B;
+            }
+            --__finish.__cur;
+            __alloc_traits::destroy(__alloc, __finish.__cur);
+        }
+
+        void pop_front(){
+            __alloc_traits::destroy(__alloc, __start.__cur);
+            if(++__start.__cur == __start.__first + B){
+                __alloc_traits::deallocate(__alloc, __start.__first, B);
+                __start.__set_node(__start.__node + 1);
+                __start.__cur = __start.__first;
+            }
+        }
+
+        // insert, the elements on the shorter side of pos are moved
+        template<typename ...Args>
+            iterator emplace(const_iterator pos, Args&&... args){
+                const difference_type idx = pos - cbegin();
+                if(idx == 0){
+                    emplace_front(learnSTL::forward<Args>(args)...);
+                    return begin();
+                }
+                if(idx == static_cast<difference_type>(size())){
+                    emplace_back(learnSTL::forward<Args>(args)...);
+                    return end() - 1;
+                }
+                value_type temp(learnSTL::forward<Args>(args)...);
+                if(static_cast<size_type>(idx) < size() / 2){
+                    emplace_front(learnSTL::move(front()));
+                    iterator p = begin() + idx;
+                    learnSTL::move(begin() + 2, p + 1, begin() + 1);
+                    *p = learnSTL::move(temp);
+                    return p;
+                }
+                emplace_back(learnSTL::move(back()));
+                iterator p = begin() + idx;
+                learnSTL::move_backward(p, end() - 2, end() - 1);
+                *p = learnSTL::move(temp);
+                return p;
+            }
+
+        iterator insert(const_iterator pos, const_reference val){
+            return emplace(pos, val);
+        }
+        iterator insert(const_iterator pos, value_type&& val){
+            return emplace(pos, learnSTL::move(val));
+        }
+
+        // the new elements are added at the nearer end and rotated into place
+        iterator insert(const_iterator pos, size_type n, const_reference val){
+            const difference_type idx = pos - cbegin();
+            value_type copy(val);
+            if(static_cast<size_type>(idx) < size() / 2){
+                for(size_type i = 0; i < n; ++i)
+                    push_front(copy);
+                learnSTL::rotate(begin(), begin() + n, begin() + (n + idx));
+            }
+            else{
+                const size_type old = size();
+                for(size_type i = 0; i < n; ++i)
+                    push_back(copy);
+                learnSTL::rotate(begin() + idx, begin() + old, end());
+            }
+            return begin() + idx;
+        }
+
+        template<typename InputIter>
+            typename std::enable_if<__is_input_iterator<InputIter>::value, iterator>::type
+            insert(const_iterator pos, InputIter first, InputIter last){
+                const difference_type idx = pos - cbegin();
+                if(static_cast<size_type>(idx) < size() / 2){
+                    const size_type old = size();
+                    for(; first != last; ++first)
+                        push_front(*first);
+                    const difference_type n = static_cast<difference_type>(size() - old);
+                    learnSTL::reverse(begin(), begin() + n);
+                    learnSTL::rotate(begin(), begin() + n, begin() + (n + idx));
+                }
+                else{
+                    const size_type old = size();
+                    __append(first, last);
+                    learnSTL::rotate(begin() + idx, begin() + old, end());
+                }
+                return begin() + idx;
+            }
+
+        iterator insert(const_iterator pos, std::initializer_list<value_type> initlist){
+            return insert(pos, initlist.begin(), initlist.end());
+        }
+
+        // erase, the elements on the shorter side close the gap
+        iterator erase(const_iterator pos){
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            const difference_type idx = first - cbegin();
+            const difference_type n = last - first;
+            if(n == 0)
+                return begin() + idx;
+            iterator f = begin() + idx;
+            iterator l = f + n;
+            if(static_cast<size_type>(idx) < (size() - n) / 2){
+                learnSTL::move_backward(begin(), f, l);
+                __erase_at_begin(begin() + n);
+            }
+            else{
+                learnSTL::move(l, end(), f);
+                __erase_at_end(end() - n);
+            }
+            return begin() + idx;
+        }
+
+        // clear keeps the map and one block
+        void clear(){
+            __erase_at_end(begin());
+        }
+
+        void resize(size_type n){
+            const size_type s = size();
+            if(n < s)
+                __erase_at_end(begin() + n);
+            else
+                for(n -= s; n > 0; --n)
+                    emplace_back();
+        }
+
+        void resize(size_type n, const_reference val){
+            const size_type s = size();
+            if(n < s)
+                __erase_at_end(begin() + n);
+            else
+                insert(cend(), n - s, val);
+        }
+
+        // frees the map slots and blocks that hold no elements
+        void shrink_to_fit(){
+            if(empty()){
+                __release();
+                __map = nullptr;
+                __map_size = 0;
+                __start = __finish = iterator();
+            }
+            else if(__map_size > static_cast<size_type>(__finish.__node - __start.__node + 1))
+                __reallocate_map(0, false, true);
+        }
+
+        void swap(deque& d){
+            __swap_alloc(__alloc, d.__alloc, std::integral_constant<bool,
+                __alloc_traits::propagate_on_container_swap::value>());
+            learnSTL::swap(__map, d.__map);
+            learnSTL::swap(__map_size, d.__map_size);
+            learnSTL::swap(__start, d.__start);
+            learnSTL::swap(__finish, d.__finish);
+        }
+
+    private:
+        allocator_type __alloc;
+        T**            __map;
+        size_type      __map_size;
+        iterator       __start;
+        iterator       __finish;
+
+        // the first block, in the middle of an 8 slot map, with the first
+        // element in the middle of the block so both ends have room
+        void __create_map(){
+            static const size_type __initial_map_size = 8;
+            __map_alloc ma(__alloc);
+            __map = __map_traits::allocate(ma, __initial_map_size);
+            __map_size = __initial_map_size;
+            T** node = __map + __initial_map_size / 2;
+            try{
+                *node = __alloc_traits::allocate(__alloc, B);
+            }
+            catch(...){
+                __map_traits::deallocate(ma, __map, __map_size);
+                __map = nullptr;
+                __map_size = 0;
+                throw;
+            }
+            __start = __finish = iterator(*node + B / 2, node);
+        }
+
+        void __reserve_map_at_back(size_type n){
+            if(n + 1 > __map_size - static_cast<size_type>(__finish.__node - __map))
+                __reallocate_map(n, false, false);
+        }
+
+        void __reserve_map_at_front(size_type n){
+            if(n > static_cast<size_type>(__start.__node - __map))
+                __reallocate_map(n, true, false);
+        }
+
+        // makes room for n more block slots at one end. The used slots are
+        // centred again in the map, which is reallocated, doubling at least,
+        // only when it is more than half full. With exact the new map holds
+        // just the used slots.
+        void __reallocate_map(size_type n, bool at_front, bool exact){
+            const size_type old_nodes = static_cast<size_type>(__finish.__node - __start.__node) + 1;
+            const size_type new_nodes = old_nodes + n;
+            T** new_start;
+            if(!exact && __map_size > 2 * new_nodes){
+                new_start = __map + (__map_size - new_nodes) / 2 + (at_front ? n : 0);
+                if(new_start < __start.__node)
+                    learnSTL::copy(__start.__node, __finish.__node + 1, new_start);
+                else
+                    learnSTL::copy_backward(__start.__node, __finish.__node + 1, new_start + old_nodes);
+            }
+            else{
+                const size_type new_map_size = exact ? new_nodes : __map_size + (__map_size > n ? __map_size : n) + 2;
+                __map_alloc ma(__alloc);
+                T** new_map = __map_traits::allocate(ma, new_map_size);
+                new_start = new_map + (new_map_size - new_nodes) / 2 + (at_front ? n : 0);
+                learnSTL::copy(__start.__node, __finish.__node + 1, new_start);
+                __map_traits::deallocate(ma, __map, __map_size);
+                __map = new_map;
+                __map_size = new_map_size;
+            }
+            __start.__node = new_start;
+            __finish.__node = new_start + (old_nodes - 1);
+        }
+
+        template<typename InputIter>
+            void __append(InputIter first, InputIter last){
+                for(; first != last; ++first)
+                    emplace_back(*first);
+            }
+
+        void __destroy(iterator first, iterator last){
+            if(!std::is_trivially_destructible<value_type>::value)
+                for(; first != last; ++first)
+                    __alloc_traits::destroy(__alloc, std::addressof(*first));
+        }
+
+        // drops [pos, end()), the blocks after pos's block are freed
+        void __erase_at_end(iterator pos){
+            if(pos == __finish)
+                return;
+            __destroy(pos, __finish);
+            for(T** node = pos.__node + 1; node <= __finish.__node; ++node)
+                __alloc_traits::deallocate(__alloc, *node, B);
+            __finish = pos;
+        }
+
+        // drops [begin(), pos), the blocks before pos's block are freed
+        void __erase_at_begin(iterator pos){
+            __destroy(__start, pos);
+            for(T** node = __start.__node; node < pos.__node; ++node)
+                __alloc_traits::deallocate(__alloc, *node, B);
+            __start = pos;
+        }
+
+        // frees everything, the members are left dangling
+        void __release(){
+            if(__map != nullptr){
+                clear();
+                __alloc_traits::deallocate(__alloc, __start.__first, B);
+                __map_alloc ma(__alloc);
+                __map_traits::deallocate(ma, __map, __map_size);
+            }
+        }
+
+        // this holds nothing: take the storage of d
+        void __steal(deque& d){
+            __map = d.__map;
+            __map_size = d.__map_size;
+            __start = d.__start;
+            __finish = d.__finish;
+            d.__map = nullptr;
+            d.__map_size = 0;
+            d.__start = d.__finish = iterator();
+        }
+
+        void __copy_assign_alloc(const deque& d, std::true_type){
+            if(__alloc != d.__alloc){
+                __release();
+                __map = nullptr;
+                __map_size = 0;
+                __start = __finish = iterator();
+            }
+            __alloc = d.__alloc;
+        }
+        void __copy_assign_alloc(const deque&, std::false_type) {}
+
+        void __move_assign_alloc(deque& rd, std::true_type){
+            __alloc = learnSTL::move(rd.__alloc);
+        }
+        void __move_assign_alloc(deque&, std::false_type) {}
+
+        void __swap_alloc(allocator_type& a1, allocator_type& a2, std::true_type){
+            learnSTL::swap(a1, a2);
+        }
+        void __swap_alloc(allocator_type&, allocator_type&, std::false_type) {}
+    };
+
+    template<typename T, typename Allocator, std::size_t BlockSize>
+        const std::size_t deque<T, Allocator, BlockSize>::B;
+    template<typename T, typename Allocator, std::size_t BlockSize>
+        const typename deque<T, Allocator, BlockSize>::size_type deque<T, Allocator, BlockSize>::block_size;
+
+    // swap
+    template<typename T, typename Alloc, std::size_t B>
+        void swap(deque<T, Alloc, B>& d1, deque<T, Alloc, B>& d2){
+            d1.swap(d2);
+        }
+
+    // compare
+    template<typename T, typename Alloc, std::size_t B>
+        bool operator==(const deque<T, Alloc, B>& d1, const deque<T, Alloc, B>& d2)
+        {
+            return d1.size() == d2.size() && learnSTL::equal(d1.begin(), d1.end(), d2.begin());
+        }
+
+    template<typename T, typename Alloc, std::size_t B>
+        bool operator!=(const deque<T, Alloc, B>& d1, const deque<T, Alloc, B>& d2){
+            return !(d1 == d2);
+        }
+
+    template<typename T, typename Alloc, std::size_t B>
+        bool operator<(const deque<T, Alloc, B>& d1, const deque<T, Alloc, B>& d2)
+        {
+            return learnSTL::lexicographical_compare(d1.begin(), d1.end(), d2.begin(), d2.end());
+        }
+
+    template<typename T, typename Alloc, std::size_t B>
+        bool operator>(const deque<T, Alloc, B>& d1, const deque<T, Alloc, B>& d2)
+        {
+            return d2 < d1;
+        }
+
+    template<typename T, typename Alloc, std::size_t B>
+        bool operator<=(const deque<T, Alloc, B>& d1, const deque<T, Alloc, B>& d2)
+        {
+            return !(d2 < d1);
+        }
+
+    template<typename T, typename Alloc, std::size_t B>
+        bool operator>=(const deque<T, Alloc, B>& d1, const deque<T, Alloc, B>& d2)
+        {
+            return !(d1 < d2);
+        }
+}
+#endif
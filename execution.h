@@ -0,0 +1,820 @@
+#ifndef MY_EXECUTION_H
+#define MY_EXECUTION_H
+
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <atomic>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "numeric.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+namespace learnSTL{
+    ///: ------------------------- execution policy --------------------------------
+    namespace execution{
+        class sequenced_policy {};
+        class parallel_policy {};
+        class parallel_unsequenced_policy {};
+
+        const sequenced_policy            seq{};
+        const parallel_policy             par{};
+        const parallel_unsequenced_policy par_unseq{};
+    }
+
+    template<typename T> struct is_execution_policy : std::false_type {};
+    template<> struct is_execution_policy<execution::sequenced_policy> : std::true_type {};
+    template<> struct is_execution_policy<execution::parallel_policy> : std::true_type {};
+    template<> struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type {};
+
+    // the return type R, if ExecutionPolicy is a policy
+    template<typename ExecutionPolicy, typename R>
+    struct __enable_if_execution_policy
+        : std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, R> {};
+
+    template<typename... Iters> struct __all_random_access;
+    template<> struct __all_random_access<> : std::true_type {};
+    template<typename Iter, typename... Rest>
+    struct __all_random_access<Iter, Rest...>
+        : std::integral_constant<bool, std::is_convertible<typename iterator_traits<Iter>::iterator_category,
+                                                           random_access_iterator_tag>::value &&
+                                       __all_random_access<Rest...>::value> {};
+
+    // true_type if the call should run in parallel: a parallel policy
+    // and random access iterators, everything else runs sequentially.
+    template<typename ExecutionPolicy, typename... Iters>
+    struct __use_parallel
+        : std::integral_constant<bool, !std::is_same<typename std::decay<ExecutionPolicy>::type,
+                                                     execution::sequenced_policy>::value &&
+                                       __all_random_access<Iters...>::value> {};
+    ///~ ------------------------- end execution policy ----------------------------
+
+
+    ///: ------------------------- parallel backend --------------------------------
+    // below this many elements a range is not worth splitting
+    const size_t __parallel_grain = 2048;
+
+    // more chunks than threads, so that the pool can balance chunks
+    // of uneven cost by stealing
+    const size_t __chunks_per_thread = 4;
+
+    inline size_t __parallel_chunk_count(size_t n){
+        if(n < 2 * __parallel_grain)
+            return 1;
+        size_t chunks = n / __parallel_grain;
+        size_t limit = thread_pool::instance().concurrency() * __chunks_per_thread;
+        return chunks < limit ? chunks : limit;
+    }
+
+    // bounds of chunk c when n elements are split in chunks pieces
+    inline size_t __chunk_begin(size_t n, size_t chunks, size_t c){
+        return n / chunks * c + (c < n % chunks ? c : n % chunks);
+    }
+
+    // call body(c, begin, end) for the chunks of [0, n), in parallel
+    template<typename Body> inline
+        void __parallel_for(size_t n, size_t chunks, Body body)
+        {
+            if(chunks == 1){
+                body(0, 0, n);
+                return;
+            }
+            thread_pool::instance().parallel_for(0, chunks, 1, [&](size_t lo, size_t hi){
+                for(size_t c = lo; c != hi; ++c)
+                    body(c, __chunk_begin(n, chunks, c), __chunk_begin(n, chunks, c + 1));
+            });
+        }
+    ///~ ------------------------- end parallel backend ----------------------------
+
+
+    ///: ------------------------- parallel algorithm --------------------------------
+    // for_each
+    template<typename RandomIter, typename UnaryOP> inline
+        void __for_each(RandomIter first, RandomIter last, UnaryOP op, std::true_type)
+        {
+            size_t n = last - first;
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                learnSTL::for_each(first + b, first + e, op);
+            });
+        }
+
+    template<typename ForwardIter, typename UnaryOP> inline
+        void __for_each(ForwardIter first, ForwardIter last, UnaryOP op, std::false_type)
+        {
+            learnSTL::for_each(first, last, op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+        for_each(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryOP op)
+        {
+            __for_each(first, last, op, __use_parallel<ExecutionPolicy, ForwardIter>());
+        }
+
+    // transform
+    template<typename RandomIter, typename OutputIter, typename UnaryOP> inline
+        OutputIter __transform(RandomIter first, RandomIter last, OutputIter result, UnaryOP op, std::true_type)
+        {
+            size_t n = last - first;
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                learnSTL::transform(first + b, first + e, result + b, op);
+            });
+            return result + n;
+        }
+
+    template<typename ForwardIter, typename OutputIter, typename UnaryOP> inline
+        OutputIter __transform(ForwardIter first, ForwardIter last, OutputIter result, UnaryOP op, std::false_type)
+        {
+            return learnSTL::transform(first, last, result, op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename UnaryOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        transform(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result, UnaryOP op)
+        {
+            return __transform(first, last, result, op, __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+
+    template<typename RandomIter1, typename RandomIter2, typename OutputIter, typename BinOP> inline
+        OutputIter __transform(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, OutputIter result, BinOP op, std::true_type)
+        {
+            size_t n = last1 - first1;
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                learnSTL::transform(first1 + b, first1 + e, first2 + b, result + b, op);
+            });
+            return result + n;
+        }
+
+    template<typename ForwardIter1, typename ForwardIter2, typename OutputIter, typename BinOP> inline
+        OutputIter __transform(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, OutputIter result, BinOP op, std::false_type)
+        {
+            return learnSTL::transform(first1, last1, first2, result, op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename OutputIter, typename BinOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        transform(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, OutputIter result, BinOP op)
+        {
+            return __transform(first1, last1, first2, result, op,
+                               __use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2, OutputIter>());
+        }
+
+    // copy
+    template<typename RandomIter, typename OutputIter> inline
+        OutputIter __copy(RandomIter first, RandomIter last, OutputIter result, std::true_type)
+        {
+            size_t n = last - first;
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                learnSTL::copy(first + b, first + e, result + b);
+            });
+            return result + n;
+        }
+
+    template<typename ForwardIter, typename OutputIter> inline
+        OutputIter __copy(ForwardIter first, ForwardIter last, OutputIter result, std::false_type)
+        {
+            return learnSTL::copy(first, last, result);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        copy(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result)
+        {
+            return __copy(first, last, result, __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+
+    // fill
+    template<typename RandomIter, typename T> inline
+        void __fill(RandomIter first, RandomIter last, const T& val, std::true_type)
+        {
+            size_t n = last - first;
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                learnSTL::fill(first + b, first + e, val);
+            });
+        }
+
+    template<typename ForwardIter, typename T> inline
+        void __fill(ForwardIter first, ForwardIter last, const T& val, std::false_type)
+        {
+            learnSTL::fill(first, last, val);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+        fill(ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& val)
+        {
+            __fill(first, last, val, __use_parallel<ExecutionPolicy, ForwardIter>());
+        }
+
+    // count_if
+    template<typename RandomIter, typename UnaryPred> inline
+        typename iterator_traits<RandomIter>::difference_type
+        __count_if(RandomIter first, RandomIter last, UnaryPred pred, std::true_type)
+        {
+            typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+            size_t n = last - first;
+            std::atomic<difference_type> cn(0);
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                cn.fetch_add(learnSTL::count_if(first + b, first + e, pred));
+            });
+            return cn.load();
+        }
+
+    template<typename ForwardIter, typename UnaryPred> inline
+        typename iterator_traits<ForwardIter>::difference_type
+        __count_if(ForwardIter first, ForwardIter last, UnaryPred pred, std::false_type)
+        {
+            return learnSTL::count_if(first, last, pred);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIter>::difference_type>::type
+        count_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryPred pred)
+        {
+            return __count_if(first, last, pred, __use_parallel<ExecutionPolicy, ForwardIter>());
+        }
+
+    // count
+    template<typename ExecutionPolicy, typename ForwardIter, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIter>::difference_type>::type
+        count(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, const T& val)
+        {
+            typedef typename iterator_traits<ForwardIter>::reference reference;
+            return learnSTL::count_if(policy, first, last, [&val](reference x){ return x == val; });
+        }
+
+    // find_if
+    template<typename RandomIter, typename UnaryPred> inline
+        RandomIter __find_if(RandomIter first, RandomIter last, UnaryPred pred, std::true_type)
+        {
+            size_t n = last - first;
+            std::atomic<size_t> found(n);     // smallest matching index so far
+            __parallel_for(n, __parallel_chunk_count(n), [&](size_t, size_t b, size_t e){
+                if(found.load() < b)          // an earlier chunk already matched
+                    return;
+                RandomIter i = learnSTL::find_if(first + b, first + e, pred);
+                if(i != first + e){
+                    size_t pos = i - first;
+                    size_t old = found.load();
+                    while(pos < old && !found.compare_exchange_weak(old, pos));
+                }
+            });
+            return first + found.load();
+        }
+
+    template<typename InputIter, typename UnaryPred> inline
+        InputIter __find_if(InputIter first, InputIter last, UnaryPred pred, std::false_type)
+        {
+            return learnSTL::find_if(first, last, pred);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+        find_if(ExecutionPolicy&&, ForwardIter first, ForwardIter last, UnaryPred pred)
+        {
+            return __find_if(first, last, pred, __use_parallel<ExecutionPolicy, ForwardIter>());
+        }
+
+    // find_if_not
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+        find_if_not(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPred pred)
+        {
+            typedef typename iterator_traits<ForwardIter>::reference reference;
+            return learnSTL::find_if(policy, first, last, [&pred](reference x){ return !pred(x); });
+        }
+
+    // find
+    template<typename ExecutionPolicy, typename ForwardIter, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, ForwardIter>::type
+        find(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, const T& val)
+        {
+            typedef typename iterator_traits<ForwardIter>::reference reference;
+            return learnSTL::find_if(policy, first, last, [&val](reference x){ return x == val; });
+        }
+
+    // all_of
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, bool>::type
+        all_of(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPred pred)
+        {
+            return learnSTL::find_if_not(policy, first, last, pred) == last;
+        }
+
+    // any_of
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, bool>::type
+        any_of(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPred pred)
+        {
+            return learnSTL::find_if(policy, first, last, pred) != last;
+        }
+
+    // none_of
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, bool>::type
+        none_of(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, UnaryPred pred)
+        {
+            return learnSTL::find_if(policy, first, last, pred) == last;
+        }
+
+    // merge
+    // split the longer input at evenly spaced points, find the matching split
+    // point in the other input by binary search, and merge the pieces in parallel.
+    template<typename RandomIter1, typename RandomIter2, typename OutputIter, typename Compare> inline
+        OutputIter __merge(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                OutputIter result, Compare comp, std::true_type)
+        {
+            size_t n1 = last1 - first1;
+            size_t n2 = last2 - first2;
+            size_t chunks = __parallel_chunk_count(n1 + n2);
+            __parallel_for(n1 > n2 ? n1 : n2, chunks, [&](size_t c, size_t b, size_t e){
+                RandomIter1 b1, e1;
+                RandomIter2 b2, e2;
+                if(n1 >= n2){
+                    b1 = first1 + b;
+                    e1 = first1 + e;
+                    // elements of the second range equal to *b1 go after it
+                    b2 = c == 0 ? first2 : learnSTL::lower_bound(first2, last2, *b1, comp);
+                    e2 = e1 == last1 ? last2 : learnSTL::lower_bound(first2, last2, *e1, comp);
+                }
+                else{
+                    b2 = first2 + b;
+                    e2 = first2 + e;
+                    // elements of the first range equal to *b2 go before it
+                    b1 = c == 0 ? first1 : learnSTL::upper_bound(first1, last1, *b2, comp);
+                    e1 = e2 == last2 ? last1 : learnSTL::upper_bound(first1, last1, *e2, comp);
+                }
+                learnSTL::merge(b1, e1, b2, e2, result + ((b1 - first1) + (b2 - first2)), comp);
+            });
+            return result + (n1 + n2);
+        }
+
+    template<typename InputIter1, typename InputIter2, typename OutputIter, typename Compare> inline
+        OutputIter __merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                OutputIter result, Compare comp, std::false_type)
+        {
+            return learnSTL::merge(first1, last1, first2, last2, result, comp);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename OutputIter, typename Compare> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        merge(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                OutputIter result, Compare comp)
+        {
+            return __merge(first1, last1, first2, last2, result, comp,
+                           __use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2, OutputIter>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename OutputIter> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        merge(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                OutputIter result)
+        {
+            typedef typename iterator_traits<ForwardIter1>::value_type v1;
+            typedef typename iterator_traits<ForwardIter2>::value_type v2;
+            return learnSTL::merge(policy, first1, last1, first2, last2, result, __less<v1, v2>());
+        }
+
+    // sort
+    // merge sort on the fork/join pool: both halves are sorted in parallel,
+    // then merged in place, down to ranges small enough for the serial sort.
+    template<typename RandomIter, typename Compare> inline
+        void __parallel_sort(RandomIter first, RandomIter last, Compare& comp, size_t grain)
+        {
+            size_t n = last - first;
+            if(n <= grain){
+                learnSTL::sort(first, last, comp);
+                return;
+            }
+            RandomIter middle = first + n / 2;
+            thread_pool::instance().parallel_invoke(
+                [&]{ __parallel_sort(first, middle, comp, grain); },
+                [&]{ __parallel_sort(middle, last, comp, grain); });
+            learnSTL::inplace_merge(first, middle, last, comp);
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void __sort(RandomIter first, RandomIter last, Compare comp, std::true_type)
+        {
+            size_t n = last - first;
+            size_t chunks = __parallel_chunk_count(n);
+            __parallel_sort(first, last, comp, (n + chunks - 1) / chunks);
+        }
+
+    template<typename RandomIter, typename Compare> inline
+        void __sort(RandomIter first, RandomIter last, Compare comp, std::false_type)
+        {
+            learnSTL::sort(first, last, comp);
+        }
+
+    template<typename ExecutionPolicy, typename RandomIter, typename Compare> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+        sort(ExecutionPolicy&&, RandomIter first, RandomIter last, Compare comp)
+        {
+            __sort(first, last, comp, __use_parallel<ExecutionPolicy, RandomIter>());
+        }
+
+    template<typename ExecutionPolicy, typename RandomIter> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, void>::type
+        sort(ExecutionPolicy&& policy, RandomIter first, RandomIter last)
+        {
+            learnSTL::sort(policy, first, last, __less<typename iterator_traits<RandomIter>::value_type>());
+        }
+    ///~ ------------------------- end parallel algorithm ----------------------------
+
+
+    ///: ------------------------- parallel numeric --------------------------------
+    // reduce
+    template<typename RandomIter, typename T, typename BinOP> inline
+        T __reduce(RandomIter first, RandomIter last, T val, BinOP binary_op, std::true_type)
+        {
+            size_t n = last - first;
+            size_t chunks = __parallel_chunk_count(n);
+            learnSTL::vector<T> partial(chunks, val);
+            __parallel_for(n, chunks, [&](size_t c, size_t b, size_t e){
+                T sum = *(first + b);
+                for(RandomIter i = first + b + 1; i != first + e; ++i)
+                    sum = binary_op(sum, *i);
+                partial[c] = learnSTL::move(sum);
+            });
+            for(size_t c = 0; c < chunks; ++c)
+                val = binary_op(val, partial[c]);
+            return val;
+        }
+
+    template<typename InputIter, typename T, typename BinOP> inline
+        T __reduce(InputIter first, InputIter last, T val, BinOP binary_op, std::false_type)
+        {
+            return learnSTL::reduce(first, last, val, binary_op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T, typename BinOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+        reduce(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T val, BinOP binary_op)
+        {
+            if(first == last)
+                return val;
+            return __reduce(first, last, val, binary_op, __use_parallel<ExecutionPolicy, ForwardIter>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+        reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, T val)
+        {
+            return learnSTL::reduce(policy, first, last, val, __plus<T>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>::type
+        reduce(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last)
+        {
+            typedef typename iterator_traits<ForwardIter>::value_type value_type;
+            return learnSTL::reduce(policy, first, last, value_type(), __plus<value_type>());
+        }
+
+    // transform_reduce
+    template<typename RandomIter, typename T, typename BinOP, typename UnaryOP> inline
+        T __transform_reduce(RandomIter first, RandomIter last, T val, BinOP reduce_op, UnaryOP transform_op, std::true_type)
+        {
+            size_t n = last - first;
+            size_t chunks = __parallel_chunk_count(n);
+            learnSTL::vector<T> partial(chunks, val);
+            __parallel_for(n, chunks, [&](size_t c, size_t b, size_t e){
+                T sum = transform_op(*(first + b));
+                for(RandomIter i = first + b + 1; i != first + e; ++i)
+                    sum = reduce_op(sum, transform_op(*i));
+                partial[c] = learnSTL::move(sum);
+            });
+            for(size_t c = 0; c < chunks; ++c)
+                val = reduce_op(val, partial[c]);
+            return val;
+        }
+
+    template<typename InputIter, typename T, typename BinOP, typename UnaryOP> inline
+        T __transform_reduce(InputIter first, InputIter last, T val, BinOP reduce_op, UnaryOP transform_op, std::false_type)
+        {
+            return learnSTL::transform_reduce(first, last, val, reduce_op, transform_op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T, typename BinOP, typename UnaryOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+        transform_reduce(ExecutionPolicy&&, ForwardIter first, ForwardIter last, T val, BinOP reduce_op, UnaryOP transform_op)
+        {
+            if(first == last)
+                return val;
+            return __transform_reduce(first, last, val, reduce_op, transform_op, __use_parallel<ExecutionPolicy, ForwardIter>());
+        }
+
+    template<typename RandomIter1, typename RandomIter2, typename T, typename BinOP1, typename BinOP2> inline
+        T __transform_reduce(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T val,
+                BinOP1 reduce_op, BinOP2 transform_op, std::true_type)
+        {
+            size_t n = last1 - first1;
+            size_t chunks = __parallel_chunk_count(n);
+            learnSTL::vector<T> partial(chunks, val);
+            __parallel_for(n, chunks, [&](size_t c, size_t b, size_t e){
+                T sum = transform_op(*(first1 + b), *(first2 + b));
+                RandomIter2 j = first2 + b + 1;
+                for(RandomIter1 i = first1 + b + 1; i != first1 + e; ++i, ++j)
+                    sum = reduce_op(sum, transform_op(*i, *j));
+                partial[c] = learnSTL::move(sum);
+            });
+            for(size_t c = 0; c < chunks; ++c)
+                val = reduce_op(val, partial[c]);
+            return val;
+        }
+
+    template<typename InputIter1, typename InputIter2, typename T, typename BinOP1, typename BinOP2> inline
+        T __transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val,
+                BinOP1 reduce_op, BinOP2 transform_op, std::false_type)
+        {
+            return learnSTL::transform_reduce(first1, last1, first2, val, reduce_op, transform_op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename T, typename BinOP1, typename BinOP2> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+        transform_reduce(ExecutionPolicy&&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T val,
+                BinOP1 reduce_op, BinOP2 transform_op)
+        {
+            if(first1 == last1)
+                return val;
+            return __transform_reduce(first1, last1, first2, val, reduce_op, transform_op,
+                                      __use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, T>::type
+        transform_reduce(ExecutionPolicy&& policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T val)
+        {
+            return learnSTL::transform_reduce(policy, first1, last1, first2, val, __plus<T>(), __multiplies<T>());
+        }
+
+    // inclusive_scan, exclusive_scan, transform_inclusive_scan
+    // the unary op of a plain scan
+    struct __scan_identity{
+        template<typename T>
+        T&& operator()(T&& x) const { return learnSTL::forward<T>(x); }
+    };
+
+    // sum of one chunk, chunks of arithmetic values summed with + go to fast_accumulate
+    template<typename T, typename RandomIter, typename BinOP, typename UnaryOP> inline
+        T __chunk_reduce(RandomIter first, RandomIter last, BinOP binary_op, UnaryOP unary_op)
+        {
+            T sum = unary_op(*first);
+            for(++first; first != last; ++first)
+                sum = binary_op(sum, unary_op(*first));
+            return sum;
+        }
+
+    template<typename T, typename U> inline
+        typename std::enable_if<__simd_scannable<U, T>::value, T>::type
+        __chunk_reduce(U* first, U* last, __plus<T>, __scan_identity)
+        {
+            return learnSTL::fast_accumulate(first + 1, last, T(*first));
+        }
+
+    // scan of one chunk, a plain scan keeps the vector kernels of numeric.h
+    template<typename RandomIter, typename OutputIter, typename BinOP, typename T> inline
+        void __chunk_scan(RandomIter first, RandomIter last, OutputIter result, BinOP binary_op, __scan_identity,
+                const T* init, bool inclusive)
+        {
+            if(!inclusive)
+                learnSTL::exclusive_scan(first, last, result, *init, binary_op);
+            else if(init)
+                learnSTL::inclusive_scan(first, last, result, binary_op, *init);
+            else
+                learnSTL::inclusive_scan(first, last, result, binary_op);
+        }
+
+    template<typename RandomIter, typename OutputIter, typename BinOP, typename UnaryOP, typename T> inline
+        void __chunk_scan(RandomIter first, RandomIter last, OutputIter result, BinOP binary_op, UnaryOP unary_op,
+                const T* init, bool inclusive)
+        {
+            if(!inclusive)
+                learnSTL::transform_exclusive_scan(first, last, result, *init, binary_op, unary_op);
+            else if(init)
+                learnSTL::transform_inclusive_scan(first, last, result, binary_op, unary_op, *init);
+            else
+                learnSTL::transform_inclusive_scan(first, last, result, binary_op, unary_op);
+        }
+
+    // two passes over the chunks: the first one sums every chunk, the carries
+    // are scanned in order, then the second one scans every chunk from its carry.
+    template<typename RandomIter, typename OutputIter, typename BinOP, typename UnaryOP, typename T> inline
+        OutputIter __parallel_scan(RandomIter first, RandomIter last, OutputIter result, BinOP binary_op,
+                UnaryOP unary_op, const T* init, bool inclusive)
+        {
+            size_t n = last - first;
+            size_t chunks = __parallel_chunk_count(n);
+            if(chunks == 1){
+                __chunk_scan(first, last, result, binary_op, unary_op, init, inclusive);
+                return result + n;
+            }
+            // pass 1: sum of every chunk but the last
+            learnSTL::vector<T> carry(chunks, T(unary_op(*first)));
+            __parallel_for(n, chunks, [&](size_t c, size_t b, size_t e){
+                if(c + 1 != chunks)
+                    carry[c] = __chunk_reduce<T>(first + b, first + e, binary_op, unary_op);
+            });
+            // turn the sums into the carry of the next chunk
+            for(size_t c = chunks - 1; c > 0; --c)
+                carry[c] = carry[c - 1];
+            if(init)
+                carry[0] = *init;
+            for(size_t c = 2; c < chunks; ++c)
+                carry[c] = binary_op(carry[c - 1], carry[c]);
+            if(init){
+                for(size_t c = 1; c < chunks; ++c)
+                    carry[c] = binary_op(carry[0], carry[c]);
+            }
+            // pass 2: every chunk starts from its carry
+            __parallel_for(n, chunks, [&](size_t c, size_t b, size_t e){
+                __chunk_scan(first + b, first + e, result + b, binary_op, unary_op,
+                             c == 0 && !init ? static_cast<const T*>(nullptr) : &carry[c], inclusive);
+            });
+            return result + n;
+        }
+
+    template<typename RandomIter, typename OutputIter, typename BinOP, typename T> inline
+        OutputIter __inclusive_scan(RandomIter first, RandomIter last, OutputIter result, BinOP binary_op,
+                const T* init, std::true_type)
+        {
+            return __parallel_scan(first, last, result, binary_op, __scan_identity(), init, true);
+        }
+
+    template<typename InputIter, typename OutputIter, typename BinOP, typename T> inline
+        OutputIter __inclusive_scan(InputIter first, InputIter last, OutputIter result, BinOP binary_op,
+                const T* init, std::false_type)
+        {
+            if(init)
+                return learnSTL::inclusive_scan(first, last, result, binary_op, *init);
+            return learnSTL::inclusive_scan(first, last, result, binary_op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename BinOP, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result, BinOP binary_op, T val)
+        {
+            if(first == last)
+                return result;
+            return __inclusive_scan(first, last, result, binary_op, &val,
+                                    __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename BinOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result, BinOP binary_op)
+        {
+            typedef typename iterator_traits<ForwardIter>::value_type value_type;
+            if(first == last)
+                return result;
+            return __inclusive_scan(first, last, result, binary_op, static_cast<const value_type*>(nullptr),
+                                    __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        inclusive_scan(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, OutputIter result)
+        {
+            typedef typename iterator_traits<ForwardIter>::value_type value_type;
+            return learnSTL::inclusive_scan(policy, first, last, result, __plus<value_type>());
+        }
+
+    template<typename RandomIter, typename OutputIter, typename T, typename BinOP> inline
+        OutputIter __exclusive_scan(RandomIter first, RandomIter last, OutputIter result, const T& val, BinOP binary_op,
+                std::true_type)
+        {
+            return __parallel_scan(first, last, result, binary_op, __scan_identity(), &val, false);
+        }
+
+    template<typename InputIter, typename OutputIter, typename T, typename BinOP> inline
+        OutputIter __exclusive_scan(InputIter first, InputIter last, OutputIter result, const T& val, BinOP binary_op,
+                std::false_type)
+        {
+            return learnSTL::exclusive_scan(first, last, result, val, binary_op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename T, typename BinOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        exclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result, T val, BinOP binary_op)
+        {
+            if(first == last)
+                return result;
+            return __exclusive_scan(first, last, result, val, binary_op,
+                                    __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        exclusive_scan(ExecutionPolicy&& policy, ForwardIter first, ForwardIter last, OutputIter result, T val)
+        {
+            return learnSTL::exclusive_scan(policy, first, last, result, val, __plus<T>());
+        }
+    template<typename RandomIter, typename OutputIter, typename BinOP, typename UnaryOP, typename T> inline
+        OutputIter __transform_inclusive_scan(RandomIter first, RandomIter last, OutputIter result, BinOP binary_op,
+                UnaryOP unary_op, const T* init, std::true_type)
+        {
+            return __parallel_scan(first, last, result, binary_op, unary_op, init, true);
+        }
+
+    template<typename InputIter, typename OutputIter, typename BinOP, typename UnaryOP, typename T> inline
+        OutputIter __transform_inclusive_scan(InputIter first, InputIter last, OutputIter result, BinOP binary_op,
+                UnaryOP unary_op, const T* init, std::false_type)
+        {
+            if(init)
+                return learnSTL::transform_inclusive_scan(first, last, result, binary_op, unary_op, *init);
+            return learnSTL::transform_inclusive_scan(first, last, result, binary_op, unary_op);
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename BinOP, typename UnaryOP, typename T> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        transform_inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+                BinOP binary_op, UnaryOP unary_op, T val)
+        {
+            if(first == last)
+                return result;
+            return __transform_inclusive_scan(first, last, result, binary_op, unary_op, &val,
+                                              __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename OutputIter, typename BinOP, typename UnaryOP> inline
+        typename __enable_if_execution_policy<ExecutionPolicy, OutputIter>::type
+        transform_inclusive_scan(ExecutionPolicy&&, ForwardIter first, ForwardIter last, OutputIter result,
+                BinOP binary_op, UnaryOP unary_op)
+        {
+            typedef typename std::decay<decltype(unary_op(*first))>::type value_type;
+            if(first == last)
+                return result;
+            return __transform_inclusive_scan(first, last, result, binary_op, unary_op, static_cast<const value_type*>(nullptr),
+                                              __use_parallel<ExecutionPolicy, ForwardIter, OutputIter>());
+        }
+    ///~ ------------------------- end parallel numeric ----------------------------
+
+
+    ///: ------------------------- parallel forward_list sort --------------------------------
+    // forward_list::sort with a parallel policy. The list is cut into
+    // detached sublists, each is sorted on the pool and neighbours are
+    // merged back pairwise; forward_list.h only names the policies, so the
+    // pool is pulled in by those who use it.
+    template<typename List, typename Compare>
+        void __forward_list_parallel_sort(List& l, Compare& comp)
+        {
+            typedef typename List::__node_pointer node_pointer;
+            node_pointer head = l.__before_begin()->__next;
+            size_t n = 0;
+            for(node_pointer p = head; p != nullptr; p = p->__next)
+                ++n;
+            size_t chunks = __parallel_chunk_count(n);
+            if(chunks == 1){
+                l.sort(comp);
+                return;
+            }
+            learnSTL::vector<node_pointer> lists(chunks);
+            for(size_t c = 0; c < chunks; ++c){
+                lists[c] = head;
+                size_t len = __chunk_begin(n, chunks, c + 1) - __chunk_begin(n, chunks, c);
+                for(; len > 1; --len)
+                    head = head->__next;
+                node_pointer next = head->__next;
+                head->__next = nullptr;
+                head = next;
+            }
+            thread_pool& pool = thread_pool::instance();
+            try{
+                pool.parallel_for(0, chunks, 1, [&](size_t lo, size_t hi){
+                    for(size_t c = lo; c != hi; ++c)
+                        l.__sort(lists[c], comp);
+                });
+                // merge neighbours, lists[c] and lists[c + width] are adjacent pieces
+                for(size_t width = 1; width < chunks; width *= 2){
+                    size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+                    pool.parallel_for(0, pairs, 1, [&](size_t lo, size_t hi){
+                        for(size_t k = lo; k != hi; ++k){
+                            size_t c = 2 * width * k;
+                            if(c + width < chunks)
+                                l.__merge(lists[c], lists[c + width], comp);
+                        }
+                    });
+                }
+            }
+            catch(...){
+                // a sort or merge that throws keeps its nodes in its own
+                // sublists, so chaining them all gives the list back
+                node_pointer* tail = &l.__before_begin()->__next;
+                for(size_t c = 0; c < chunks; ++c){
+                    *tail = lists[c];
+                    while(*tail != nullptr)
+                        tail = &(*tail)->__next;
+                }
+                l.__track.__find_tail(l.__before_begin()->__next);
+                throw;
+            }
+            l.__before_begin()->__next = lists[0];
+            l.__track.__find_tail(lists[0]);
+        }
+    ///~ ------------------------- end parallel forward_list sort ----------------------------
+}
+
+#endif
@@ -0,0 +1,878 @@
+#ifndef MY_FLAT_HASH_MAP_H
+#define MY_FLAT_HASH_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "iterator.h"
+#include "utility.h"
+#include "simd.h"
+
+namespace learnSTL{
+    ///: ------------------------- control bytes --------------------------------
+    // one byte per slot: 7 bits of the hash when the slot is full, the sign
+    // bit alone when it is empty. There are no tombstones, an erase shifts
+    // the rest of the probe run back instead.
+    typedef signed char __ctrl_t;
+    const __ctrl_t      __ctrl_empty = -128;
+    const std::size_t   __group_width = 16;
+
+    // the 16 control bytes from p on. Probing is linear, so a group starts at
+    // any slot; the table repeats its first 15 bytes after the last one.
+    struct __ctrl_group{
+#ifdef MY_SIMD_X86
+        __m128i __v;
+
+        explicit __ctrl_group(const __ctrl_t* p) : __v(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        // bit i is set when byte i is tag
+        unsigned match(__ctrl_t tag) const {
+            return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), __v)));
+        }
+        unsigned match_empty() const {
+            return static_cast<unsigned>(_mm_movemask_epi8(__v));
+        }
+        static unsigned lowest(unsigned m) { return static_cast<unsigned>(__builtin_ctz(m)); }
+#else
+        const __ctrl_t* __p;
+
+        explicit __ctrl_group(const __ctrl_t* p) : __p(p) {}
+
+        unsigned match(__ctrl_t tag) const {
+            unsigned m = 0;
+            for(std::size_t i = 0; i < __group_width; ++i)
+                m |= static_cast<unsigned>(__p[i] == tag) << i;
+            return m;
+        }
+        unsigned match_empty() const { return match(__ctrl_empty); }
+        static unsigned lowest(unsigned m){
+            unsigned i = 0;
+            for(; !(m & 1u); m >>= 1)
+                ++i;
+            return i;
+        }
+#endif
+    };
+
+    // std::hash of an integer is the integer itself; the slot index and the
+    // tag both need well mixed bits. One wide multiply, both halves folded.
+    inline std::size_t __hash_mix(std::size_t h){
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 __uint128;
+        const __uint128 p = static_cast<__uint128>(h) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64));
+#else
+        const std::uint64_t x = static_cast<std::uint64_t>(h) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<std::size_t>(x ^ x >> 32);
+#endif
+    }
+    ///~ ------------------------- end control bytes ----------------------------
+
+
+    ///: ------------------------- policies --------------------------------
+    // what the table stores and where the key is. transfer moves an element
+    // to another slot and destroys the old one.
+    template<typename Key>
+    struct __flat_set_policy{
+        using key_type   = Key;
+        using value_type = Key;
+        static const bool const_elements = true;
+        static const bool nothrow_transfer = std::is_nothrow_move_constructible<Key>::value;
+
+        static const key_type& key(const value_type& v) { return v; }
+
+        template<typename Alloc>
+            static void transfer(Alloc& a, value_type* dst, value_type* src){
+                std::allocator_traits<Alloc>::construct(a, dst, learnSTL::move(*src));
+                std::allocator_traits<Alloc>::destroy(a, src);
+            }
+    };
+
+    template<typename Key, typename T>
+    struct __flat_map_policy{
+        using key_type   = Key;
+        using value_type = pair<const Key, T>;
+        static const bool const_elements = false;
+        static const bool nothrow_transfer = std::is_nothrow_move_constructible<Key>::value &&
+                                             std::is_nothrow_move_constructible<T>::value;
+
+        static const key_type& key(const value_type& v) { return v.first; }
+
+        // the source dies right after, so its key may be moved from
+        template<typename Alloc>
+            static void transfer(Alloc& a, value_type* dst, value_type* src){
+                std::allocator_traits<Alloc>::construct(a, dst, learnSTL::move(const_cast<Key&>(src->first)),
+                                                        learnSTL::move(src->second));
+                std::allocator_traits<Alloc>::destroy(a, src);
+            }
+    };
+    ///~ ------------------------- end policies ----------------------------
+
+
+    ///: ------------------------- flat hash table --------------------------------
+    template<typename Policy, typename Hash, typename KeyEqual, typename Allocator> class __flat_hash_table;
+
+    // a slot position counted from the table's start slot, so that walking
+    // forward never wraps inside a probe run (see __flat_hash_table)
+    template<typename Table, bool Const>
+    class __flat_hash_iterator{
+        template<typename, typename, typename, typename> friend class __flat_hash_table;
+        template<typename, bool> friend class __flat_hash_iterator;
+        using __size_type = typename Table::size_type;
+        static const bool __const_ref = Const || Table::__policy::const_elements;
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type        = typename Table::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = typename std::conditional<__const_ref, const value_type&, value_type&>::type;
+        using pointer           = typename std::conditional<__const_ref, const value_type*, value_type*>::type;
+
+        __flat_hash_iterator() : __t(nullptr), __i(0) {}
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        __flat_hash_iterator(const __flat_hash_iterator<Table, C>& iter) : __t(iter.__t), __i(iter.__i) {}
+
+        reference operator*() const { return __t->__slots[__i & (__t->__cap - 1)]; }
+        pointer operator->() const { return &**this; }
+
+        __flat_hash_iterator& operator++(){
+            __i = __t->__skip_empty(__i + 1);
+            return *this;
+        }
+        __flat_hash_iterator operator++(int){
+            __flat_hash_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        template<bool C>
+        bool operator==(const __flat_hash_iterator<Table, C>& iter) const { return __i == iter.__i; }
+        template<bool C>
+        bool operator!=(const __flat_hash_iterator<Table, C>& iter) const { return __i != iter.__i; }
+
+    private:
+        const Table*    __t;
+        __size_type     __i;
+
+        __flat_hash_iterator(const Table* t, __size_type i) : __t(t), __i(i) {}
+    };
+
+    // open addressing with linear probing over one control byte per slot;
+    // a lookup compares 16 control bytes at once and only looks at the
+    // slots whose tag matches, and stops at the first group with an empty
+    // slot. Slots and control bytes are two flat arrays from the allocator.
+    // An erase closes the gap by moving the later elements of the probe run
+    // back (backward shift), so there are no tombstones and a lookup never
+    // walks over dead slots. The table is kept at most 7/8 full.
+    // Iteration starts at an empty slot, __start, and goes round once: no
+    // probe run crosses an empty slot, so the elements an erase moves always
+    // come from later in the iteration, and erasing while iterating visits
+    // every element once.
+    // Inserting invalidates iterators and references, erasing invalidates
+    // those to the erased element and to the elements that were moved.
+    template<typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+    class __flat_hash_table{
+        template<typename, bool> friend class __flat_hash_iterator;
+        using __policy       = Policy;
+        using __alloc_traits = std::allocator_traits<Allocator>;
+        using __ctrl_alloc   = typename __alloc_traits::template rebind_alloc<__ctrl_t>;
+        using __ctrl_traits  = std::allocator_traits<__ctrl_alloc>;
+    public:
+        using key_type         = typename Policy::key_type;
+        using value_type       = typename Policy::value_type;
+        using hasher           = Hash;
+        using key_equal        = KeyEqual;
+        using allocator_type   = Allocator;
+        using size_type        = std::size_t;
+        using difference_type  = std::ptrdiff_t;
+        using reference        = value_type&;
+        using const_reference  = const value_type&;
+        using pointer          = value_type*;
+        using const_pointer    = const value_type*;
+        using iterator         = __flat_hash_iterator<__flat_hash_table, false>;
+        using const_iterator   = __flat_hash_iterator<__flat_hash_table, true>;
+
+        static_assert(Policy::nothrow_transfer, "flat hash containers move their elements, which must not throw");
+
+        // iterator
+        iterator begin() { return iterator(this, __skip_empty(__start)); }
+        const_iterator begin() const { return const_iterator(this, __skip_empty(__start)); }
+        const_iterator cbegin() const { return begin(); }
+        iterator end() { return iterator(this, __start + __cap); }
+        const_iterator end() const { return const_iterator(this, __start + __cap); }
+        const_iterator cend() const { return end(); }
+
+        allocator_type get_allocator() const { return __alloc; }
+        hasher hash_function() const { return __hash; }
+        key_equal key_eq() const { return __eq; }
+
+        // capacity
+        size_type size() const { return __size; }
+        bool empty() const { return __size == 0; }
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+        // buckets are slots here
+        size_type bucket_count() const { return __cap; }
+        float load_factor() const { return __cap == 0 ? 0.0f : static_cast<float>(__size) / __cap; }
+        float max_load_factor() const { return 0.875f; }
+
+        // constructor
+        __flat_hash_table() : __hash(), __eq(), __alloc() { __reset(); }
+        explicit __flat_hash_table(size_type n, const hasher& h = hasher(), const key_equal& eq = key_equal(),
+                                   const allocator_type& a = allocator_type())
+            : __hash(h), __eq(eq), __alloc(a)
+        {
+            __reset();
+            rehash(n);
+        }
+        explicit __flat_hash_table(const allocator_type& a) : __hash(), __eq(), __alloc(a) { __reset(); }
+
+        template<typename InputIter>
+        __flat_hash_table(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value,
+                          InputIter>::type last, size_type n = 0, const hasher& h = hasher(),
+                          const key_equal& eq = key_equal(), const allocator_type& a = allocator_type())
+            : __hash(h), __eq(eq), __alloc(a)
+        {
+            __reset();
+            rehash(n);
+            insert(first, last);
+        }
+        __flat_hash_table(std::initializer_list<value_type> initlist, size_type n = 0, const hasher& h = hasher(),
+                          const key_equal& eq = key_equal(), const allocator_type& a = allocator_type())
+            : __hash(h), __eq(eq), __alloc(a)
+        {
+            __reset();
+            reserve(n < initlist.size() ? initlist.size() : n);
+            insert(initlist.begin(), initlist.end());
+        }
+
+        // copy-constructor: the same hash puts every element in the same slot
+        __flat_hash_table(const __flat_hash_table& t)
+            : __hash(t.__hash), __eq(t.__eq), __alloc(__alloc_traits::select_on_container_copy_construction(t.__alloc))
+        {
+            __reset();
+            __copy_slots(t);
+        }
+        __flat_hash_table(const __flat_hash_table& t, const allocator_type& a) : __hash(t.__hash), __eq(t.__eq), __alloc(a)
+        {
+            __reset();
+            __copy_slots(t);
+        }
+
+        // move-constructor
+        __flat_hash_table(__flat_hash_table&& rt)
+            : __hash(learnSTL::move(rt.__hash)), __eq(learnSTL::move(rt.__eq)), __alloc(learnSTL::move(rt.__alloc))
+        {
+            __steal(rt);
+        }
+        __flat_hash_table(__flat_hash_table&& rt, const allocator_type& a)
+            : __hash(learnSTL::move(rt.__hash)), __eq(learnSTL::move(rt.__eq)), __alloc(a)
+        {
+            if(__alloc == rt.__alloc)
+                __steal(rt);
+            else{
+                __reset();
+                __move_elements(rt);
+            }
+        }
+
+        ~__flat_hash_table(){
+            __release();
+        }
+
+        // assignment
+        __flat_hash_table& operator=(const __flat_hash_table& t){
+            if(this != &t){
+                clear();
+                __copy_assign_alloc(t, std::integral_constant<bool,
+                    __alloc_traits::propagate_on_container_copy_assignment::value>());
+                __hash = t.__hash;
+                __eq = t.__eq;
+                if(__cap != t.__cap){
+                    __release();
+                    __reset();
+                }
+                __copy_slots(t);
+            }
+            return *this;
+        }
+
+        __flat_hash_table& operator=(__flat_hash_table&& rt){
+            if(this != &rt){
+                __hash = learnSTL::move(rt.__hash);
+                __eq = learnSTL::move(rt.__eq);
+                if(__alloc_traits::propagate_on_container_move_assignment::value || __alloc == rt.__alloc){
+                    __release();
+                    __move_assign_alloc(rt, std::integral_constant<bool,
+                        __alloc_traits::propagate_on_container_move_assignment::value>());
+                    __steal(rt);
+                }
+                else{
+                    clear();
+                    __move_elements(rt);
+                }
+            }
+            return *this;
+        }
+
+        __flat_hash_table& operator=(std::initializer_list<value_type> initlist){
+            clear();
+            insert(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        // lookup
+        iterator find(const key_type& k) { return __make_iterator(__find(k, __hash_of(k))); }
+        const_iterator find(const key_type& k) const { return __make_iterator(__find(k, __hash_of(k))); }
+        size_type count(const key_type& k) const { return __find(k, __hash_of(k)) != __npos; }
+        bool contains(const key_type& k) const { return __find(k, __hash_of(k)) != __npos; }
+        pair<iterator, iterator> equal_range(const key_type& k) { return __equal_range<iterator>(find(k)); }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+            return __equal_range<const_iterator>(find(k));
+        }
+
+        // heterogeneous lookup, when both the hasher and key_equal say they
+        // can take other types than key_type (is_transparent)
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                 typename = typename H::is_transparent, typename = typename E::is_transparent>
+            iterator find(const K& k) { return __make_iterator(__find(k, __hash_of(k))); }
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                 typename = typename H::is_transparent, typename = typename E::is_transparent>
+            const_iterator find(const K& k) const { return __make_iterator(__find(k, __hash_of(k))); }
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                 typename = typename H::is_transparent, typename = typename E::is_transparent>
+            size_type count(const K& k) const { return __find(k, __hash_of(k)) != __npos; }
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                 typename = typename H::is_transparent, typename = typename E::is_transparent>
+            bool contains(const K& k) const { return __find(k, __hash_of(k)) != __npos; }
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                 typename = typename H::is_transparent, typename = typename E::is_transparent>
+            pair<iterator, iterator> equal_range(const K& k) { return __equal_range<iterator>(find(k)); }
+        template<typename K, typename H = Hash, typename E = KeyEqual,
+                 typename = typename H::is_transparent, typename = typename E::is_transparent>
+            pair<const_iterator, const_iterator> equal_range(const K& k) const {
+                return __equal_range<const_iterator>(find(k));
+            }
+
+        // modifiers
+        pair<iterator, bool> insert(const value_type& val) { return __emplace_key(Policy::key(val), val); }
+        pair<iterator, bool> insert(value_type&& val) { return __emplace_key(Policy::key(val), learnSTL::move(val)); }
+        iterator insert(const_iterator, const value_type& val) { return insert(val).first; }
+        iterator insert(const_iterator, value_type&& val) { return insert(learnSTL::move(val)).first; }
+
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            insert(InputIter first, InputIter last){
+                for(; first != last; ++first)
+                    insert(*first);
+            }
+        void insert(std::initializer_list<value_type> initlist){
+            insert(initlist.begin(), initlist.end());
+        }
+
+        // the key is only known once the element exists, so it is built on
+        // the side and moved into a slot when the key is new
+        template<typename ...Args>
+            pair<iterator, bool> emplace(Args&&... args){
+                value_type val(learnSTL::forward<Args>(args)...);
+                return __emplace_key(Policy::key(val), learnSTL::move(val));
+            }
+        template<typename ...Args>
+            iterator emplace_hint(const_iterator, Args&&... args){
+                return emplace(learnSTL::forward<Args>(args)...).first;
+            }
+
+        // returns the next element in iteration order; it may be one the
+        // erase moved into the freed slot
+        iterator erase(const_iterator pos){
+            __erase_slot(pos.__i & (__cap - 1));
+            __close_gap((pos.__i + 1) & (__cap - 1));
+            return iterator(this, __skip_empty(pos.__i));
+        }
+        iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+        // empties the range first and then closes the whole gap in one pass
+        iterator erase(const_iterator first, const_iterator last){
+            if(first == last)
+                return iterator(this, first.__i);
+            for(size_type i = first.__i; i != last.__i; ++i)
+                if(__ctrl[i & (__cap - 1)] != __ctrl_empty)
+                    __erase_slot(i & (__cap - 1));
+            __close_gap(last.__i & (__cap - 1));
+            return iterator(this, __skip_empty(first.__i));
+        }
+
+        size_type erase(const key_type& k){
+            const size_type i = __find(k, __hash_of(k));
+            if(i == __npos)
+                return 0;
+            __erase_slot(i);
+            __close_gap((i + 1) & (__cap - 1));
+            return 1;
+        }
+
+        void clear(){
+            if(__size == 0)
+                return;
+            for(size_type i = 0; i < __cap; ++i)
+                if(__ctrl[i] != __ctrl_empty)
+                    __alloc_traits::destroy(__alloc, __slots + i);
+            std::memset(__ctrl, __ctrl_empty, __cap + __group_width - 1);
+            __size = 0;
+            __start = 0;
+        }
+
+        void swap(__flat_hash_table& t){
+            __swap_alloc(__alloc, t.__alloc, std::integral_constant<bool,
+                __alloc_traits::propagate_on_container_swap::value>());
+            learnSTL::swap(__hash, t.__hash);
+            learnSTL::swap(__eq, t.__eq);
+            learnSTL::swap(__ctrl, t.__ctrl);
+            learnSTL::swap(__slots, t.__slots);
+            learnSTL::swap(__cap, t.__cap);
+            learnSTL::swap(__size, t.__size);
+            learnSTL::swap(__start, t.__start);
+        }
+
+        // room for n elements without growing
+        void reserve(size_type n){
+            if(__cap_for(n) > __cap)
+                __resize(__cap_for(n));
+        }
+
+        // at least n slots and room for the elements; may shrink the table
+        void rehash(size_type n){
+            size_type c = __cap_for(__size);
+            while(c < n)
+                c *= 2;
+            if(__size == 0 && n == 0){
+                __release();
+                __reset();
+            }
+            else if(c != __cap)
+                __resize(c);
+        }
+
+    protected:
+        // the slot of an element with this key, a new one if there is none
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __emplace_key(const K& k, Args&&... args){
+                const pair<size_type, bool> r = __find_or_prepare(k);
+                if(r.second)
+                    __construct_at(r.first, learnSTL::forward<Args>(args)...);
+                return pair<iterator, bool>(__make_iterator(r.first), r.second);
+            }
+
+        // the slot of the element with this key and false, or a claimed empty
+        // slot and true: then __construct_at has to fill it before anything else
+        template<typename K>
+            pair<size_type, bool> __find_or_prepare(const K& k){
+                const size_type h = __hash_of(k);
+                const size_type i = __find(k, h);
+                if(i != __npos)
+                    return pair<size_type, bool>(i, false);
+                return pair<size_type, bool>(__prepare_insert(h), true);
+            }
+
+        // the element of claimed slot i; the slot is given back if it throws
+        template<typename ...Args>
+            void __construct_at(size_type i, Args&&... args){
+                try{
+                    __alloc_traits::construct(__alloc, __slots + i, learnSTL::forward<Args>(args)...);
+                }
+                catch(...){
+                    __set_ctrl(i, __ctrl_empty);
+                    throw;
+                }
+                ++__size;
+            }
+
+        template<typename K>
+            size_type __find(const K& k, size_type h) const {
+                if(__size == 0)
+                    return __npos;
+                const size_type mask = __cap - 1;
+                const __ctrl_t tag = __tag(h);
+                size_type pos = h >> 7 & mask;
+                for(;;){
+                    const __ctrl_group g(__ctrl + pos);
+                    for(unsigned m = g.match(tag); m != 0; m &= m - 1){
+                        const size_type i = (pos + __ctrl_group::lowest(m)) & mask;
+                        if(__eq(Policy::key(__slots[i]), k))
+                            return i;
+                    }
+                    if(g.match_empty() != 0)
+                        return __npos;
+                    pos = (pos + __group_width) & mask;
+                }
+            }
+
+        iterator __make_iterator(size_type i){
+            return i == __npos ? end() : iterator(this, i < __start ? i + __cap : i);
+        }
+        const_iterator __make_iterator(size_type i) const {
+            return i == __npos ? end() : const_iterator(this, i < __start ? i + __cap : i);
+        }
+
+        static const size_type __npos = static_cast<size_type>(-1);
+
+    private:
+        hasher          __hash;
+        key_equal       __eq;
+        allocator_type  __alloc;
+        __ctrl_t*       __ctrl;     // __cap + 15 bytes, the first 15 repeated at the end
+        value_type*     __slots;
+        size_type       __cap;      // 0 or a power of two, at least 16
+        size_type       __size;
+        size_type       __start;    // an empty slot, where iteration begins
+
+        template<typename K>
+            size_type __hash_of(const K& k) const { return __hash_mix(__hash(k)); }
+        static __ctrl_t __tag(size_type h) { return static_cast<__ctrl_t>(h & 0x7f); }
+        size_type __home(const value_type& v) const { return __hash_of(Policy::key(v)) >> 7 & (__cap - 1); }
+
+        // slots for n elements at 7/8 load
+        static size_type __cap_for(size_type n){
+            size_type c = __group_width;
+            while(c - c / 8 < n)
+                c *= 2;
+            return c;
+        }
+
+        void __set_ctrl(size_type i, __ctrl_t c){
+            __ctrl[i] = c;
+            if(i < __group_width - 1)
+                __ctrl[__cap + i] = c;
+        }
+
+        static size_type __first_empty(const __ctrl_t* ctrl, size_type mask, size_type pos){
+            for(;;){
+                const unsigned m = __ctrl_group(ctrl + pos).match_empty();
+                if(m != 0)
+                    return (pos + __ctrl_group::lowest(m)) & mask;
+                pos = (pos + __group_width) & mask;
+            }
+        }
+
+        // the first full slot at or after logical position i, or end
+        size_type __skip_empty(size_type i) const {
+            const size_type e = __start + __cap;
+            while(i != e && __ctrl[i & (__cap - 1)] == __ctrl_empty)
+                ++i;
+            return i;
+        }
+
+        template<typename It>
+            pair<It, It> __equal_range(It it) const {
+                It last = it;
+                if(it != end())
+                    ++last;
+                return pair<It, It>(it, last);
+            }
+
+        // claims the first empty slot of the probe run of h, growing first
+        size_type __prepare_insert(size_type h){
+            if(__size + 1 > __cap - __cap / 8)
+                __resize(__cap_for(__size + 1));
+            const size_type mask = __cap - 1;
+            const size_type i = __first_empty(__ctrl, mask, h >> 7 & mask);
+            __set_ctrl(i, __tag(h));
+            if(i == __start)
+                __start = __first_empty(__ctrl, mask, (i + 1) & mask);
+            return i;
+        }
+
+        void __erase_slot(size_type i){
+            __alloc_traits::destroy(__alloc, __slots + i);
+            __set_ctrl(i, __ctrl_empty);
+            --__size;
+        }
+
+        // the slots just before j were emptied: every later element of the
+        // probe run moves back to the first empty slot on its own probe path,
+        // which leaves no empty slot between any element and its home
+        void __close_gap(size_type j){
+            const size_type mask = __cap - 1;
+            for(; __ctrl[j] != __ctrl_empty; j = (j + 1) & mask){
+                const size_type home = __home(__slots[j]);
+                const size_type e = __first_empty(__ctrl, mask, home);
+                if(((e - home) & mask) < ((j - home) & mask)){
+                    __set_ctrl(e, __ctrl[j]);
+                    __set_ctrl(j, __ctrl_empty);
+                    Policy::transfer(__alloc, __slots + e, __slots + j);
+                }
+            }
+        }
+
+        void __reset(){
+            __ctrl = nullptr;
+            __slots = nullptr;
+            __cap = __size = __start = 0;
+        }
+
+        // both arrays for cap slots, all empty; the table is not touched, so
+        // a throw leaves it as it was
+        void __allocate(size_type cap, __ctrl_t*& ctrl, value_type*& slots){
+            __ctrl_alloc ca(__alloc);
+            ctrl = __ctrl_traits::allocate(ca, cap + __group_width - 1);
+            try{
+                slots = __alloc_traits::allocate(__alloc, cap);
+            }
+            catch(...){
+                __ctrl_traits::deallocate(ca, ctrl, cap + __group_width - 1);
+                throw;
+            }
+            std::memset(ctrl, __ctrl_empty, cap + __group_width - 1);
+        }
+        void __allocate(size_type cap){
+            __allocate(cap, __ctrl, __slots);
+            __cap = cap;
+        }
+
+        void __release(){
+            if(__ctrl == nullptr)
+                return;
+            for(size_type i = 0; i < __cap; ++i)
+                if(__ctrl[i] != __ctrl_empty)
+                    __alloc_traits::destroy(__alloc, __slots + i);
+            __ctrl_alloc ca(__alloc);
+            __ctrl_traits::deallocate(ca, __ctrl, __cap + __group_width - 1);
+            __alloc_traits::deallocate(__alloc, __slots, __cap);
+        }
+
+        // moves every element into a table of cap slots. The new arrays are
+        // filled first and only then replace the old ones, so a failed
+        // allocation leaves the table as it was.
+        void __resize(size_type cap){
+            __ctrl_t* ctrl;
+            value_type* slots;
+            __allocate(cap, ctrl, slots);
+            const size_type mask = cap - 1;
+            for(size_type i = 0; i < __cap; ++i){
+                if(__ctrl[i] == __ctrl_empty)
+                    continue;
+                const size_type j = __first_empty(ctrl, mask, __hash_of(Policy::key(__slots[i])) >> 7 & mask);
+                ctrl[j] = __ctrl[i];
+                if(j < __group_width - 1)
+                    ctrl[cap + j] = __ctrl[i];
+                Policy::transfer(__alloc, slots + j, __slots + i);
+            }
+            if(__ctrl != nullptr){
+                __ctrl_alloc ca(__alloc);
+                __ctrl_traits::deallocate(ca, __ctrl, __cap + __group_width - 1);
+                __alloc_traits::deallocate(__alloc, __slots, __cap);
+            }
+            __ctrl = ctrl;
+            __slots = slots;
+            __cap = cap;
+            __start = __first_empty(__ctrl, mask, 0);
+        }
+
+        // into an empty table with no slots or t's number of slots
+        void __copy_slots(const __flat_hash_table& t){
+            if(t.__size == 0)
+                return;
+            if(__cap == 0)
+                __allocate(t.__cap);
+            size_type i = 0;
+            try{
+                for(; i < __cap; ++i)
+                    if(t.__ctrl[i] != __ctrl_empty)
+                        __alloc_traits::construct(__alloc, __slots + i, t.__slots[i]);
+            }
+            catch(...){
+                while(i-- > 0)
+                    if(t.__ctrl[i] != __ctrl_empty)
+                        __alloc_traits::destroy(__alloc, __slots + i);
+                throw;
+            }
+            std::memcpy(__ctrl, t.__ctrl, __cap + __group_width - 1);
+            __size = t.__size;
+            __start = t.__start;
+        }
+
+        void __move_elements(__flat_hash_table& rt){
+            reserve(rt.__size);
+            for(size_type i = 0; i < rt.__cap; ++i)
+                if(rt.__ctrl[i] != __ctrl_empty)
+                    __emplace_key(Policy::key(rt.__slots[i]), learnSTL::move(rt.__slots[i]));
+            rt.clear();
+        }
+
+        void __steal(__flat_hash_table& rt){
+            __ctrl = rt.__ctrl;
+            __slots = rt.__slots;
+            __cap = rt.__cap;
+            __size = rt.__size;
+            __start = rt.__start;
+            rt.__reset();
+        }
+
+        void __copy_assign_alloc(const __flat_hash_table& t, std::true_type){
+            if(__alloc != t.__alloc){
+                __release();
+                __reset();
+            }
+            __alloc = t.__alloc;
+        }
+        void __copy_assign_alloc(const __flat_hash_table&, std::false_type) {}
+
+        void __move_assign_alloc(__flat_hash_table& rt, std::true_type){
+            __alloc = learnSTL::move(rt.__alloc);
+        }
+        void __move_assign_alloc(__flat_hash_table&, std::false_type) {}
+
+        void __swap_alloc(allocator_type& a1, allocator_type& a2, std::true_type){
+            learnSTL::swap(a1, a2);
+        }
+        void __swap_alloc(allocator_type&, allocator_type&, std::false_type) {}
+    };
+
+    template<typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+        const typename __flat_hash_table<Policy, Hash, KeyEqual, Allocator>::size_type
+        __flat_hash_table<Policy, Hash, KeyEqual, Allocator>::__npos;
+    ///~ ------------------------- end flat hash table ----------------------------
+
+
+    ///: ------------------------- flat_hash_set --------------------------------
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<Key> >
+    class flat_hash_set : public __flat_hash_table<__flat_set_policy<Key>, Hash, KeyEqual, Allocator>{
+        using __base = __flat_hash_table<__flat_set_policy<Key>, Hash, KeyEqual, Allocator>;
+    public:
+        using __base::__base;
+        using __base::operator=;
+
+        flat_hash_set() = default;
+        flat_hash_set(std::initializer_list<Key> initlist) : __base(initlist) {}
+    };
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        void swap(flat_hash_set<Key, Hash, KeyEqual, Alloc>& s1, flat_hash_set<Key, Hash, KeyEqual, Alloc>& s2){
+            s1.swap(s2);
+        }
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator==(const flat_hash_set<Key, Hash, KeyEqual, Alloc>& s1,
+                        const flat_hash_set<Key, Hash, KeyEqual, Alloc>& s2)
+        {
+            if(s1.size() != s2.size())
+                return false;
+            for(const Key& k : s1)
+                if(!s2.contains(k))
+                    return false;
+            return true;
+        }
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator!=(const flat_hash_set<Key, Hash, KeyEqual, Alloc>& s1,
+                        const flat_hash_set<Key, Hash, KeyEqual, Alloc>& s2){
+            return !(s1 == s2);
+        }
+    ///~ ------------------------- end flat_hash_set ----------------------------
+
+
+    ///: ------------------------- flat_hash_map --------------------------------
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<pair<const Key, T> > >
+    class flat_hash_map : public __flat_hash_table<__flat_map_policy<Key, T>, Hash, KeyEqual, Allocator>{
+        using __base = __flat_hash_table<__flat_map_policy<Key, T>, Hash, KeyEqual, Allocator>;
+    public:
+        using mapped_type    = T;
+        using key_type       = typename __base::key_type;
+        using value_type     = typename __base::value_type;
+        using size_type      = typename __base::size_type;
+        using iterator       = typename __base::iterator;
+        using const_iterator = typename __base::const_iterator;
+
+        using __base::__base;
+        using __base::operator=;
+
+        flat_hash_map() = default;
+        flat_hash_map(std::initializer_list<value_type> initlist) : __base(initlist) {}
+
+        // access
+        mapped_type& operator[](const key_type& k) { return try_emplace(k).first->second; }
+        mapped_type& operator[](key_type&& k) { return try_emplace(learnSTL::move(k)).first->second; }
+
+        mapped_type& at(const key_type& k){
+            iterator it = this->find(k);
+            if(it == this->end())
+                throw std::out_of_range("flat_hash_map::at");
+            return it->second;
+        }
+        const mapped_type& at(const key_type& k) const {
+            const_iterator it = this->find(k);
+            if(it == this->end())
+                throw std::out_of_range("flat_hash_map::at");
+            return it->second;
+        }
+
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+                return __try_emplace(k, k, learnSTL::forward<Args>(args)...);
+            }
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+                return __try_emplace(k, learnSTL::move(k), learnSTL::forward<Args>(args)...);
+            }
+
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(const key_type& k, M&& m){
+                pair<iterator, bool> r = try_emplace(k, learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(key_type&& k, M&& m){
+                pair<iterator, bool> r = try_emplace(learnSTL::move(k), learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+
+    private:
+        // one probe finds k or claims the slot it goes in
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __try_emplace(const key_type& k, K&& key, Args&&... args){
+                const pair<size_type, bool> r = this->__find_or_prepare(k);
+                if(r.second)
+                    this->__construct_at(r.first, learnSTL::forward<K>(key), mapped_type(learnSTL::forward<Args>(args)...));
+                return pair<iterator, bool>(this->__make_iterator(r.first), r.second);
+            }
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& m1, flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& m2){
+            m1.swap(m2);
+        }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator==(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& m1,
+                        const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& m2)
+        {
+            if(m1.size() != m2.size())
+                return false;
+            for(const auto& v : m1){
+                auto it = m2.find(v.first);
+                if(it == m2.end() || !(it->second == v.second))
+                    return false;
+            }
+            return true;
+        }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator!=(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& m1,
+                        const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& m2){
+            return !(m1 == m2);
+        }
+    ///~ ------------------------- end flat_hash_map ----------------------------
+}
+
+#endif
@@ -0,0 +1,673 @@
+#ifndef MY_FLAT_MAP_H
+#define MY_FLAT_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "numeric.h"
+#include "vector.h"
+
+namespace learnSTL{
+    ///: ------------------------- sorted columns --------------------------------
+    // the input is sorted and has no repeated keys
+    struct sorted_unique_t {};
+    const sorted_unique_t sorted_unique{};
+
+    // the order of the positions after a bulk insert. [0, n) of keys is
+    // sorted and unique, [n, size) was appended: the tail is sorted, its
+    // repeated keys and the keys the head has already are dropped (the
+    // first one stays), and set_union merges it with the head.
+    template<typename KeyContainer, typename Compare>
+        vector<std::size_t> __flat_merge_order(const KeyContainer& keys, std::size_t n, const Compare& comp)
+        {
+            vector<std::size_t> head(n), tail(keys.size() - n), order;
+            learnSTL::iota(head.begin(), head.end(), std::size_t(0));
+            learnSTL::iota(tail.begin(), tail.end(), n);
+            auto less = [&keys, &comp](std::size_t a, std::size_t b) { return comp(keys[a], keys[b]); };
+            learnSTL::stable_sort(tail.begin(), tail.end(), less);
+            tail.erase(learnSTL::unique(tail.begin(), tail.end(),
+                [&keys, &comp](std::size_t a, std::size_t b) { return !comp(keys[a], keys[b]); }), tail.end());
+            order.reserve(n + tail.size());
+            learnSTL::set_union(head.begin(), head.end(), tail.begin(), tail.end(), learnSTL::back_inserter(order), less);
+            return order;
+        }
+
+    // true when the merge left every element where it was
+    inline bool __flat_in_place(const vector<std::size_t>& order, std::size_t size){
+        if(order.size() != size)
+            return false;
+        for(std::size_t i = 0; i != size; ++i)
+            if(order[i] != i)
+                return false;
+        return true;
+    }
+
+    // builds column c in the given order into out. An element whose move
+    // may throw is copied, so c is whole when this throws.
+    template<typename Container>
+        void __flat_gather(Container& out, Container& c, const vector<std::size_t>& order)
+        {
+            typedef typename Container::value_type T;
+            typedef typename std::conditional<std::is_nothrow_move_constructible<T>::value, T&&, const T&>::type R;
+            out.reserve(order.size());
+            for(std::size_t i : order)
+                out.push_back(static_cast<R>(c[i]));
+        }
+
+    // moves back into c what __flat_gather moved out of it
+    template<typename Container>
+        void __flat_scatter(Container& c, Container& out, const vector<std::size_t>& order)
+        {
+            if(std::is_nothrow_move_constructible<typename Container::value_type>::value)
+                for(std::size_t j = 0; j != out.size(); ++j)
+                    c[order[j]] = learnSTL::move(out[j]);
+        }
+    ///~ ------------------------- end sorted columns ----------------------------
+
+
+    ///: ------------------------- flat_set --------------------------------
+    // a sorted vector of unique keys: binary search over contiguous keys
+    // and no per-element node. An insert or erase moves the elements after
+    // it, a range insert is one sort and one merge.
+    template<typename Key, typename Compare = std::less<Key>, typename KeyContainer = vector<Key> >
+    class flat_set{
+    public:
+        using key_type               = Key;
+        using value_type             = Key;
+        using key_compare            = Compare;
+        using value_compare          = Compare;
+        using reference              = value_type&;
+        using const_reference        = const value_type&;
+        using size_type              = std::size_t;
+        using difference_type        = std::ptrdiff_t;
+        using container_type         = KeyContainer;
+        using iterator               = typename KeyContainer::const_iterator;
+        using const_iterator         = typename KeyContainer::const_iterator;
+        using reverse_iterator       = learnSTL::reverse_iterator<const_iterator>;
+        using const_reverse_iterator = learnSTL::reverse_iterator<const_iterator>;
+
+        // iterator
+        const_iterator begin() const { return __keys.begin(); }
+        const_iterator cbegin() const { return __keys.begin(); }
+        const_iterator end() const { return __keys.end(); }
+        const_iterator cend() const { return __keys.end(); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return rend(); }
+
+        // capacity
+        size_type size() const { return __keys.size(); }
+        bool empty() const { return __keys.empty(); }
+        size_type max_size() const { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+        key_compare key_comp() const { return __comp; }
+        value_compare value_comp() const { return __comp; }
+
+        // constructor
+        flat_set() : __keys(), __comp() {}
+        explicit flat_set(const key_compare& comp) : __keys(), __comp(comp) {}
+        explicit flat_set(container_type cont, const key_compare& comp = key_compare())
+            : __keys(learnSTL::move(cont)), __comp(comp)
+        {
+            __merge_tail(0);
+        }
+        flat_set(sorted_unique_t, container_type cont, const key_compare& comp = key_compare())
+            : __keys(learnSTL::move(cont)), __comp(comp) {}
+
+        template<typename InputIter, typename = typename std::enable_if<__is_input_iterator<InputIter>::value>::type>
+        flat_set(InputIter first, InputIter last, const key_compare& comp = key_compare()) : __keys(), __comp(comp)
+        {
+            insert(first, last);
+        }
+        flat_set(std::initializer_list<value_type> initlist, const key_compare& comp = key_compare()) : __keys(), __comp(comp)
+        {
+            insert(initlist.begin(), initlist.end());
+        }
+
+        flat_set& operator=(std::initializer_list<value_type> initlist){
+            clear();
+            insert(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        // lookup
+        const_iterator lower_bound(const key_type& k) const { return learnSTL::lower_bound(begin(), end(), k, __comp); }
+        const_iterator upper_bound(const key_type& k) const { return learnSTL::upper_bound(begin(), end(), k, __comp); }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+            const_iterator it = lower_bound(k);
+            return pair<const_iterator, const_iterator>(it, it == end() || __comp(k, *it) ? it : it + 1);
+        }
+        const_iterator find(const key_type& k) const {
+            const_iterator it = lower_bound(k);
+            return it == end() || __comp(k, *it) ? end() : it;
+        }
+        size_type count(const key_type& k) const { return find(k) == end() ? 0 : 1; }
+        bool contains(const key_type& k) const { return find(k) != end(); }
+
+        // modifiers
+        pair<iterator, bool> insert(const value_type& val) { return __insert_at(lower_bound(val), val); }
+        pair<iterator, bool> insert(value_type&& val) { return __insert_at(lower_bound(val), learnSTL::move(val)); }
+        // a right hint saves the search
+        iterator insert(const_iterator hint, const value_type& val) { return __insert_at(__position(hint, val), val).first; }
+        iterator insert(const_iterator hint, value_type&& val) {
+            return __insert_at(__position(hint, val), learnSTL::move(val)).first;
+        }
+
+        // appended at the end, then sorted and merged in one pass
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            insert(InputIter first, InputIter last){
+                const size_type n = size();
+                try{
+                    for(; first != last; ++first)
+                        __keys.push_back(*first);
+                    __merge_tail(n);
+                }
+                catch(...){
+                    __keys.erase(__keys.begin() + n, __keys.end());
+                    throw;
+                }
+            }
+        void insert(std::initializer_list<value_type> initlist){
+            insert(initlist.begin(), initlist.end());
+        }
+
+        template<typename ...Args>
+            pair<iterator, bool> emplace(Args&&... args){
+                value_type val(learnSTL::forward<Args>(args)...);
+                return insert(learnSTL::move(val));
+            }
+        template<typename ...Args>
+            iterator emplace_hint(const_iterator hint, Args&&... args){
+                value_type val(learnSTL::forward<Args>(args)...);
+                return insert(hint, learnSTL::move(val));
+            }
+
+        iterator erase(const_iterator pos) { return __keys.erase(pos); }
+        iterator erase(const_iterator first, const_iterator last) { return __keys.erase(first, last); }
+        size_type erase(const key_type& k){
+            const_iterator it = find(k);
+            if(it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+
+        void clear() { __keys.clear(); }
+        void swap(flat_set& s){
+            __keys.swap(s.__keys);
+            learnSTL::swap(__comp, s.__comp);
+        }
+
+        // the keys, handed out or replaced as a whole
+        const container_type& keys() const { return __keys; }
+        container_type extract(){
+            container_type out(learnSTL::move(__keys));
+            __keys.clear();
+            return out;
+        }
+        void replace(container_type&& cont) { __keys = learnSTL::move(cont); }
+
+    private:
+        container_type __keys;
+        key_compare    __comp;
+
+        const_iterator __position(const_iterator hint, const value_type& val) const {
+            if((hint == end() || __comp(val, *hint)) && (hint == begin() || !__comp(val, *(hint - 1))))
+                return hint;
+            return lower_bound(val);
+        }
+
+        template<typename V>
+            pair<iterator, bool> __insert_at(const_iterator pos, V&& val){
+                if(pos != end() && !__comp(val, *pos))
+                    return pair<iterator, bool>(pos, false);
+                if(pos != begin() && !__comp(*(pos - 1), val))
+                    return pair<iterator, bool>(pos - 1, false);
+                return pair<iterator, bool>(__keys.insert(pos, learnSTL::forward<V>(val)), true);
+            }
+
+        void __merge_tail(size_type n){
+            if(n == size())
+                return;
+            vector<size_type> order = __flat_merge_order(__keys, n, __comp);
+            if(!__flat_in_place(order, size())){
+                container_type keys(__keys.get_allocator());
+                __flat_gather(keys, __keys, order);
+                __keys.swap(keys);
+            }
+        }
+    };
+
+    template<typename Key, typename Compare, typename KeyContainer>
+        void swap(flat_set<Key, Compare, KeyContainer>& s1, flat_set<Key, Compare, KeyContainer>& s2){
+            s1.swap(s2);
+        }
+
+    template<typename Key, typename Compare, typename KeyContainer>
+        bool operator==(const flat_set<Key, Compare, KeyContainer>& s1, const flat_set<Key, Compare, KeyContainer>& s2){
+            return s1.size() == s2.size() && learnSTL::equal(s1.begin(), s1.end(), s2.begin());
+        }
+
+    template<typename Key, typename Compare, typename KeyContainer>
+        bool operator!=(const flat_set<Key, Compare, KeyContainer>& s1, const flat_set<Key, Compare, KeyContainer>& s2){
+            return !(s1 == s2);
+        }
+
+    template<typename Key, typename Compare, typename KeyContainer>
+        bool operator<(const flat_set<Key, Compare, KeyContainer>& s1, const flat_set<Key, Compare, KeyContainer>& s2){
+            return learnSTL::lexicographical_compare(s1.begin(), s1.end(), s2.begin(), s2.end());
+        }
+    ///~ ------------------------- end flat_set ----------------------------
+
+
+    ///: ------------------------- flat_map iterator --------------------------------
+    // walks the key and the mapped column side by side. Dereferencing
+    // gives a pair of references into the two columns.
+    template<typename KeyIter, typename MappedIter>
+    class __flat_map_iterator{
+        template<typename, typename> friend class __flat_map_iterator;
+        using __key_ref    = typename iterator_traits<KeyIter>::reference;
+        using __mapped_ref = typename iterator_traits<MappedIter>::reference;
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = pair<typename iterator_traits<KeyIter>::value_type,
+                                       typename iterator_traits<MappedIter>::value_type>;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = pair<__key_ref, __mapped_ref>;
+
+        // holds the pair, so that it->second works
+        struct pointer{
+            reference __ref;
+            const reference* operator->() const { return std::addressof(__ref); }
+        };
+
+        __flat_map_iterator() : __key(), __mapped() {}
+        __flat_map_iterator(KeyIter k, MappedIter m) : __key(k), __mapped(m) {}
+        template<typename K, typename M, typename = typename std::enable_if<std::is_convertible<K, KeyIter>::value &&
+                                                                            std::is_convertible<M, MappedIter>::value>::type>
+        __flat_map_iterator(const __flat_map_iterator<K, M>& iter) : __key(iter.__key), __mapped(iter.__mapped) {}
+
+        reference operator*() const { return reference(*__key, *__mapped); }
+        pointer operator->() const { return pointer{**this}; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        __flat_map_iterator& operator++(){
+            ++__key;
+            ++__mapped;
+            return *this;
+        }
+        __flat_map_iterator operator++(int){
+            __flat_map_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+        __flat_map_iterator& operator--(){
+            --__key;
+            --__mapped;
+            return *this;
+        }
+        __flat_map_iterator operator--(int){
+            __flat_map_iterator temp(*this);
+            --*this;
+            return temp;
+        }
+        __flat_map_iterator& operator+=(difference_type n){
+            __key += n;
+            __mapped += n;
+            return *this;
+        }
+        __flat_map_iterator& operator-=(difference_type n) { return *this += -n; }
+        __flat_map_iterator operator+(difference_type n) const { return __flat_map_iterator(*this) += n; }
+        __flat_map_iterator operator-(difference_type n) const { return __flat_map_iterator(*this) -= n; }
+        friend __flat_map_iterator operator+(difference_type n, const __flat_map_iterator& iter) { return iter + n; }
+
+        template<typename K, typename M>
+        difference_type operator-(const __flat_map_iterator<K, M>& iter) const { return __key - iter.__key; }
+        template<typename K, typename M>
+        bool operator==(const __flat_map_iterator<K, M>& iter) const { return __key == iter.__key; }
+        template<typename K, typename M>
+        bool operator!=(const __flat_map_iterator<K, M>& iter) const { return __key != iter.__key; }
+        template<typename K, typename M>
+        bool operator<(const __flat_map_iterator<K, M>& iter) const { return __key < iter.__key; }
+        template<typename K, typename M>
+        bool operator>(const __flat_map_iterator<K, M>& iter) const { return __key > iter.__key; }
+        template<typename K, typename M>
+        bool operator<=(const __flat_map_iterator<K, M>& iter) const { return __key <= iter.__key; }
+        template<typename K, typename M>
+        bool operator>=(const __flat_map_iterator<K, M>& iter) const { return __key >= iter.__key; }
+
+        KeyIter __key_iter() const { return __key; }
+        MappedIter __mapped_iter() const { return __mapped; }
+
+    private:
+        KeyIter    __key;
+        MappedIter __mapped;
+    };
+    ///~ ------------------------- end flat_map iterator ----------------------------
+
+
+    ///: ------------------------- flat_map --------------------------------
+    // keys and mapped values in two sorted columns: a lookup bisects the
+    // keys alone, which stay dense in cache whatever the mapped type is.
+    template<typename Key, typename T, typename Compare = std::less<Key>,
+             typename KeyContainer = vector<Key>, typename MappedContainer = vector<T> >
+    class flat_map{
+    public:
+        using key_type               = Key;
+        using mapped_type            = T;
+        using value_type             = pair<Key, T>;
+        using key_compare            = Compare;
+        using reference              = pair<const Key&, T&>;
+        using const_reference        = pair<const Key&, const T&>;
+        using size_type              = std::size_t;
+        using difference_type        = std::ptrdiff_t;
+        using key_container_type     = KeyContainer;
+        using mapped_container_type  = MappedContainer;
+        using iterator               = __flat_map_iterator<typename KeyContainer::const_iterator,
+                                                           typename MappedContainer::iterator>;
+        using const_iterator         = __flat_map_iterator<typename KeyContainer::const_iterator,
+                                                           typename MappedContainer::const_iterator>;
+        using reverse_iterator       = learnSTL::reverse_iterator<iterator>;
+        using const_reverse_iterator = learnSTL::reverse_iterator<const_iterator>;
+
+        struct containers{
+            key_container_type    keys;
+            mapped_container_type values;
+        };
+
+        class value_compare{
+        public:
+            template<typename P1, typename P2>
+                bool operator()(const P1& x, const P2& y) const { return __comp(x.first, y.first); }
+
+            explicit value_compare(const key_compare& comp) : __comp(comp) {}
+
+        private:
+            key_compare __comp;
+        };
+
+        // iterator
+        iterator begin() { return iterator(__c.keys.begin(), __c.values.begin()); }
+        const_iterator begin() const { return const_iterator(__c.keys.begin(), __c.values.begin()); }
+        const_iterator cbegin() const { return begin(); }
+        iterator end() { return iterator(__c.keys.end(), __c.values.end()); }
+        const_iterator end() const { return const_iterator(__c.keys.end(), __c.values.end()); }
+        const_iterator cend() const { return end(); }
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return rend(); }
+
+        // capacity
+        size_type size() const { return __c.keys.size(); }
+        bool empty() const { return __c.keys.empty(); }
+        size_type max_size() const {
+            return std::numeric_limits<difference_type>::max() / (sizeof(key_type) + sizeof(mapped_type));
+        }
+
+        key_compare key_comp() const { return __comp; }
+        value_compare value_comp() const { return value_compare(__comp); }
+
+        // constructor
+        flat_map() : __c(), __comp() {}
+        explicit flat_map(const key_compare& comp) : __c(), __comp(comp) {}
+        // sorts the columns together; of repeated keys the first one stays
+        flat_map(key_container_type keys, mapped_container_type values, const key_compare& comp = key_compare())
+            : __c{learnSTL::move(keys), learnSTL::move(values)}, __comp(comp)
+        {
+            __merge_tail(0);
+        }
+        flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values,
+                 const key_compare& comp = key_compare())
+            : __c{learnSTL::move(keys), learnSTL::move(values)}, __comp(comp) {}
+
+        template<typename InputIter, typename = typename std::enable_if<__is_input_iterator<InputIter>::value>::type>
+        flat_map(InputIter first, InputIter last, const key_compare& comp = key_compare()) : __c(), __comp(comp)
+        {
+            insert(first, last);
+        }
+        flat_map(std::initializer_list<value_type> initlist, const key_compare& comp = key_compare()) : __c(), __comp(comp)
+        {
+            insert(initlist.begin(), initlist.end());
+        }
+
+        flat_map& operator=(std::initializer_list<value_type> initlist){
+            clear();
+            insert(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        // access
+        mapped_type& operator[](const key_type& k) { return try_emplace(k).first->second; }
+        mapped_type& operator[](key_type&& k) { return try_emplace(learnSTL::move(k)).first->second; }
+
+        mapped_type& at(const key_type& k){
+            iterator it = find(k);
+            if(it == end())
+                throw std::out_of_range("flat_map::at");
+            return it->second;
+        }
+        const mapped_type& at(const key_type& k) const {
+            const_iterator it = find(k);
+            if(it == end())
+                throw std::out_of_range("flat_map::at");
+            return it->second;
+        }
+
+        // lookup: only the key column is searched
+        iterator lower_bound(const key_type& k) { return __at(__lower(k)); }
+        const_iterator lower_bound(const key_type& k) const { return __at(__lower(k)); }
+        iterator upper_bound(const key_type& k) {
+            return __at(learnSTL::upper_bound(__c.keys.begin(), __c.keys.end(), k, __comp) - __c.keys.begin());
+        }
+        const_iterator upper_bound(const key_type& k) const {
+            return __at(learnSTL::upper_bound(__c.keys.begin(), __c.keys.end(), k, __comp) - __c.keys.begin());
+        }
+        pair<iterator, iterator> equal_range(const key_type& k){
+            const size_type i = __lower(k);
+            return pair<iterator, iterator>(__at(i), __at(__found(i, k) ? i + 1 : i));
+        }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+            const size_type i = __lower(k);
+            return pair<const_iterator, const_iterator>(__at(i), __at(__found(i, k) ? i + 1 : i));
+        }
+        iterator find(const key_type& k){
+            const size_type i = __lower(k);
+            return __found(i, k) ? __at(i) : end();
+        }
+        const_iterator find(const key_type& k) const {
+            const size_type i = __lower(k);
+            return __found(i, k) ? __at(i) : end();
+        }
+        size_type count(const key_type& k) const { return __found(__lower(k), k) ? 1 : 0; }
+        bool contains(const key_type& k) const { return __found(__lower(k), k); }
+
+        // modifiers
+        pair<iterator, bool> insert(const value_type& val) { return try_emplace(val.first, val.second); }
+        pair<iterator, bool> insert(value_type&& val) {
+            return try_emplace(learnSTL::move(val.first), learnSTL::move(val.second));
+        }
+        iterator insert(const_iterator, const value_type& val) { return insert(val).first; }
+        iterator insert(const_iterator, value_type&& val) { return insert(learnSTL::move(val)).first; }
+
+        // appended to both columns, then sorted and merged in one pass
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            insert(InputIter first, InputIter last){
+                const size_type n = size();
+                try{
+                    for(; first != last; ++first){
+                        __c.keys.push_back((*first).first);
+                        __c.values.push_back((*first).second);
+                    }
+                    __merge_tail(n);
+                }
+                catch(...){
+                    __c.keys.erase(__c.keys.begin() + n, __c.keys.end());
+                    __c.values.erase(__c.values.begin() + n, __c.values.end());
+                    throw;
+                }
+            }
+        void insert(std::initializer_list<value_type> initlist){
+            insert(initlist.begin(), initlist.end());
+        }
+
+        template<typename ...Args>
+            pair<iterator, bool> emplace(Args&&... args){
+                value_type val(learnSTL::forward<Args>(args)...);
+                return insert(learnSTL::move(val));
+            }
+        template<typename ...Args>
+            iterator emplace_hint(const_iterator, Args&&... args){
+                return emplace(learnSTL::forward<Args>(args)...).first;
+            }
+
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+                return __try_emplace(k, k, learnSTL::forward<Args>(args)...);
+            }
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+                return __try_emplace(k, learnSTL::move(k), learnSTL::forward<Args>(args)...);
+            }
+
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(const key_type& k, M&& m){
+                pair<iterator, bool> r = try_emplace(k, learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(key_type&& k, M&& m){
+                pair<iterator, bool> r = try_emplace(learnSTL::move(k), learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+
+        iterator erase(const_iterator pos){
+            const size_type i = pos - begin();
+            __c.keys.erase(__c.keys.begin() + i);
+            __c.values.erase(__c.values.begin() + i);
+            return __at(i);
+        }
+        iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+        iterator erase(const_iterator first, const_iterator last){
+            const size_type i = first - begin(), j = last - begin();
+            __c.keys.erase(__c.keys.begin() + i, __c.keys.begin() + j);
+            __c.values.erase(__c.values.begin() + i, __c.values.begin() + j);
+            return __at(i);
+        }
+        size_type erase(const key_type& k){
+            const_iterator it = find(k);
+            if(it == end())
+                return 0;
+            erase(it);
+            return 1;
+        }
+
+        void clear(){
+            __c.keys.clear();
+            __c.values.clear();
+        }
+        void swap(flat_map& m){
+            __c.keys.swap(m.__c.keys);
+            __c.values.swap(m.__c.values);
+            learnSTL::swap(__comp, m.__comp);
+        }
+
+        // the columns, handed out or replaced as a whole
+        const key_container_type& keys() const { return __c.keys; }
+        const mapped_container_type& values() const { return __c.values; }
+        containers extract(){
+            containers out{learnSTL::move(__c.keys), learnSTL::move(__c.values)};
+            clear();
+            return out;
+        }
+        void replace(key_container_type&& keys, mapped_container_type&& values){
+            __c.keys = learnSTL::move(keys);
+            __c.values = learnSTL::move(values);
+        }
+
+    private:
+        containers  __c;
+        key_compare __comp;
+
+        size_type __lower(const key_type& k) const {
+            return learnSTL::lower_bound(__c.keys.begin(), __c.keys.end(), k, __comp) - __c.keys.begin();
+        }
+        bool __found(size_type i, const key_type& k) const {
+            return i != size() && !__comp(k, __c.keys[i]);
+        }
+        iterator __at(size_type i) { return iterator(__c.keys.begin() + i, __c.values.begin() + i); }
+        const_iterator __at(size_type i) const { return const_iterator(__c.keys.begin() + i, __c.values.begin() + i); }
+
+        // the value goes in first and comes back out if the key throws
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __try_emplace(const key_type& k, K&& key, Args&&... args){
+                const size_type i = __lower(k);
+                if(__found(i, k))
+                    return pair<iterator, bool>(__at(i), false);
+                __c.values.emplace(__c.values.begin() + i, learnSTL::forward<Args>(args)...);
+                try{
+                    __c.keys.insert(__c.keys.begin() + i, learnSTL::forward<K>(key));
+                }
+                catch(...){
+                    __c.values.erase(__c.values.begin() + i);
+                    throw;
+                }
+                return pair<iterator, bool>(__at(i), true);
+            }
+
+        void __merge_tail(size_type n){
+            if(n == size())
+                return;
+            vector<size_type> order = __flat_merge_order(__c.keys, n, __comp);
+            if(!__flat_in_place(order, size())){
+                // both columns are built before either is swapped in
+                key_container_type keys(__c.keys.get_allocator());
+                mapped_container_type values(__c.values.get_allocator());
+                __flat_gather(keys, __c.keys, order);
+                try{
+                    __flat_gather(values, __c.values, order);
+                }
+                catch(...){
+                    __flat_scatter(__c.keys, keys, order);
+                    throw;
+                }
+                __c.keys.swap(keys);
+                __c.values.swap(values);
+            }
+        }
+    };
+
+    template<typename Key, typename T, typename Compare, typename KC, typename MC>
+        void swap(flat_map<Key, T, Compare, KC, MC>& m1, flat_map<Key, T, Compare, KC, MC>& m2){
+            m1.swap(m2);
+        }
+
+    template<typename Key, typename T, typename Compare, typename KC, typename MC>
+        bool operator==(const flat_map<Key, T, Compare, KC, MC>& m1, const flat_map<Key, T, Compare, KC, MC>& m2){
+            return m1.size() == m2.size() && learnSTL::equal(m1.keys().begin(), m1.keys().end(), m2.keys().begin()) &&
+                   learnSTL::equal(m1.values().begin(), m1.values().end(), m2.values().begin());
+        }
+
+    template<typename Key, typename T, typename Compare, typename KC, typename MC>
+        bool operator!=(const flat_map<Key, T, Compare, KC, MC>& m1, const flat_map<Key, T, Compare, KC, MC>& m2){
+            return !(m1 == m2);
+        }
+    ///~ ------------------------- end flat_map ----------------------------
+}
+
+#endif
@@ -32,7 +32,26 @@ namespace learnSTL{
         T __data;
     };
 
-    template<typename T, typename Allocator> class forward_list;
+    // list policies: a track_size_and_tail list keeps its element count and
+    // its last node, which makes size, push_back and whole-list splice O(1)
+    struct no_tracking {};
+    struct track_size_and_tail {};
+
+    // the policies of execution.h, named here without including it: a
+    // parallel sort needs execution.h, which defines the policy objects
+    namespace execution{
+        class sequenced_policy;
+        class parallel_policy;
+        class parallel_unsequenced_policy;
+    }
+
+    template<typename T>
+    struct __is_forward_list_policy
+        : std::integral_constant<bool, std::is_same<T, execution::sequenced_policy>::value ||
+                                       std::is_same<T, execution::parallel_policy>::value ||
+                                       std::is_same<T, execution::parallel_unsequenced_policy>::value> {};
+
+    template<typename T, typename Allocator, typename TrackPolicy> class forward_list;
     template<typename ConstNodePtr> class __forward_list_const_iterator;
 
     template<typename NodePtr>
@@ -69,7 +88,7 @@ namespace learnSTL{
         NodePtr __ptr;
 
         explicit __forward_list_iterator(NodePtr p) : __ptr(p) {}
-        template<typename ,typename> friend class forward_list;      // only for forward_list
+        template<typename, typename, typename> friend class forward_list;      // only for forward_list
         template<typename> friend class __forward_list_const_iterator;
     };
 
@@ -111,10 +130,75 @@ namespace learnSTL{
         ConstNodePtr __ptr;
 
         explicit __forward_list_const_iterator(ConstNodePtr p) : __ptr(p) {}
-        template<typename, typename> friend class forward_list; 
+        template<typename, typename, typename> friend class forward_list;
     };
 
-    template<typename T, typename Allocator=std::allocator<T> >
+    // size and tail bookkeeping of a list, nothing unless the list tracks them.
+    // Every change of the links reports to it after the relinking is done.
+    template<typename NodePtr, typename SizeType, typename TrackPolicy>
+    struct __forward_list_track{
+        static const bool __tracks = false;
+
+        void __reset() {}
+        void __added(NodePtr, SizeType) {}
+        void __removed(NodePtr, NodePtr, SizeType) {}
+        void __take_all(__forward_list_track&, NodePtr) {}
+        void __merged(__forward_list_track&) {}
+        void __find_tail(NodePtr) {}
+        NodePtr __last(NodePtr first) const {
+            while(first->__next != nullptr)
+                first = first->__next;
+            return first;
+        }
+    };
+
+    template<typename NodePtr, typename SizeType>
+    struct __forward_list_track<NodePtr, SizeType, track_size_and_tail>{
+        static const bool __tracks = true;
+
+        SizeType __size;
+        NodePtr  __tail;        // last node, nullptr when the list is empty
+
+        __forward_list_track() : __size(0), __tail(nullptr) {}
+
+        void __reset(){
+            __size = 0;
+            __tail = nullptr;
+        }
+        // n nodes were linked in, last is the last of them
+        void __added(NodePtr last, SizeType n){
+            __size += n;
+            if(last->__next == nullptr)
+                __tail = last;
+        }
+        // n nodes were unlinked after before, bb is the list's before_begin
+        void __removed(NodePtr before, NodePtr bb, SizeType n){
+            __size -= n;
+            if(before->__next == nullptr)
+                __tail = before == bb ? nullptr : before;
+        }
+        // all nodes of other, ending at last, were linked in
+        void __take_all(__forward_list_track& other, NodePtr last){
+            __size += other.__size;
+            if(last != nullptr && last->__next == nullptr)
+                __tail = last;
+            other.__reset();
+        }
+        // other was merged in, so its tail or ours is the last node
+        void __merged(__forward_list_track& other){
+            __take_all(other, other.__tail);
+        }
+        // the order changed, the tail is found walking from first
+        void __find_tail(NodePtr first){
+            __tail = first;
+            if(__tail != nullptr)
+                while(__tail->__next != nullptr)
+                    __tail = __tail->__next;
+        }
+        NodePtr __last(NodePtr) const { return __tail; }
+    };
+
+    template<typename T, typename Allocator=std::allocator<T>, typename TrackPolicy = no_tracking>
     class __forward_list_base{
     protected:
         using value_type = T;
@@ -131,9 +215,12 @@ namespace learnSTL{
 
         using iterator       = __forward_list_iterator<__node_pointer>;
         using const_iterator = __forward_list_const_iterator<__node_pointer>;
+        using __track_type   = __forward_list_track<__node_pointer,
+                                   typename std::allocator_traits<allocator_type>::size_type, TrackPolicy>;
 
         __head_node_type __head;
         __node_alloc __alloc;
+        __track_type __track;
 
         __node_pointer __before_begin(){
             return static_cast<__node_pointer>(std::pointer_traits<__head_node_pointer>::pointer_to(__head));
@@ -144,8 +231,8 @@ namespace learnSTL{
         }
 
         // constructor
-        __forward_list_base() : __head(), __alloc() {}
-        __forward_list_base(const allocator_type& a) : __head(), __alloc(a) {}
+        __forward_list_base() : __head(), __alloc(), __track() {}
+        __forward_list_base(const allocator_type& a) : __head(), __alloc(a), __track() {}
 
         void clear(){
             for(__node_pointer p = __before_begin()->__next; p != nullptr;){
@@ -155,6 +242,7 @@ namespace learnSTL{
                 p = nextPtr;
             }
             __before_begin()->__next = nullptr;
+            __track.__reset();
         }
 
         ~__forward_list_base(){
@@ -172,6 +260,7 @@ namespace learnSTL{
         void swap(__forward_list_base& f2){
             __swap_alloc(__alloc, f2.__alloc, std::integral_constant<bool, __node_traits::propagate_on_container_swap::value>());
             learnSTL::swap(__before_begin()->__next, (f2.__before_begin())->__next);
+            learnSTL::swap(__track, f2.__track);
         }
         
     private:
@@ -189,20 +278,21 @@ namespace learnSTL{
         void __move_assign_alloc(__forward_list_base&, std::false_type) {}
 
         void __swap_alloc(__node_alloc& a1, __node_alloc& a2, std::true_type){
-            swap(a1, a2);
+            learnSTL::swap(a1, a2);
         }
-        void __swap_alloc(__node_alloc&, __node_alloc, std::false_type) {}
+        void __swap_alloc(__node_alloc&, __node_alloc&, std::false_type) {}
     };
 
     // ------ forward_list -----------
-    template<typename T, typename Allocator = std::allocator<T> >
-    class forward_list : private __forward_list_base<T, Allocator>
+    template<typename T, typename Allocator = std::allocator<T>, typename TrackPolicy = no_tracking>
+    class forward_list : private __forward_list_base<T, Allocator, TrackPolicy>
     {
-        using base = __forward_list_base<T, Allocator>;
+        using base = __forward_list_base<T, Allocator, TrackPolicy>;
         using __node_type = typename base::__node_type;
         using __node_pointer = typename base::__node_pointer;
         using __node_alloc = typename base::__node_alloc;
         using __node_traits = typename base::__node_traits;
+        using __track_type = typename base::__track_type;
     public:
         using value_type       = T;
         using allocator_type   = Allocator;
@@ -248,6 +338,25 @@ namespace learnSTL{
             return std::numeric_limits<size_type>::max();
         }
 
+        // size, back, push_back and append need track_size_and_tail
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, size_type>::type
+            size() const {
+                return this->__track.__size;
+            }
+
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, reference>::type
+            back() {
+                return this->__track.__tail->__data;
+            }
+
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, const_reference>::type
+            back() const {
+                return this->__track.__tail->__data;
+            }
+
         // resize
         void resize(size_type n){
             iterator bb = before_begin();
@@ -332,6 +441,8 @@ namespace learnSTL{
         {
             base::__before_begin()->__next = rf.__before_begin()->__next;   
             rf.__before_begin()->__next = nullptr;
+            this->__track = rf.__track;
+            rf.__track.__reset();
         }
         forward_list(forward_list&& rf, const allocator_type& a) : base(a)
         {
@@ -339,6 +450,12 @@ namespace learnSTL{
                 using moveIter = move_iterator<iterator>;
                 insert_after(before_begin(), moveIter(rf.begin()), moveIter(rf.end()));
             }
+            else{
+                base::__before_begin()->__next = rf.__before_begin()->__next;
+                rf.__before_begin()->__next = nullptr;
+                this->__track = rf.__track;
+                rf.__track.__reset();
+            }
         }
 
         // assignment
@@ -347,6 +464,7 @@ namespace learnSTL{
                 return *this;
             base::__copy_assign_alloc(f2);
             assign(f2.begin(), f2.end());
+            return *this;
         }
 
         forward_list& operator=(forward_list&& rf){
@@ -395,13 +513,15 @@ namespace learnSTL{
             __node_traits::construct(this->__alloc, std::addressof(node_up->__data), val);
             node_up->__next = base::__before_begin()->__next;
             base::__before_begin()->__next = node_up.release();
+            this->__track.__added(base::__before_begin()->__next, 1);
         }
 
         void push_front(value_type&& val){
             std::unique_ptr<__node_type> node_up(__node_traits::allocate(this->__alloc, 1));
-            __node_traits::construct(this->__alloc, std::addressof(node_up->__data), move(val));
+            __node_traits::construct(this->__alloc, std::addressof(node_up->__data), learnSTL::move(val));
             node_up->__next = base::__before_begin()->__next;
             base::__before_begin()->__next = node_up.release();
+            this->__track.__added(base::__before_begin()->__next, 1);
         }
 
         template<typename ...Args>
@@ -410,6 +530,25 @@ namespace learnSTL{
                 __node_traits::construct(this->__alloc, std::addressof(node_up->__data), learnSTL::forward<Args>(args)...);
                 node_up->__next = base::__before_begin()->__next;
                 base::__before_begin()->__next = node_up.release();
+                this->__track.__added(base::__before_begin()->__next, 1);
+            }
+
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, void>::type
+            push_back(const_reference val){
+                insert_after(const_iterator(__last_node()), val);
+            }
+
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, void>::type
+            push_back(value_type&& val){
+                insert_after(const_iterator(__last_node()), learnSTL::move(val));
+            }
+
+        template<typename ...Args>
+            void emplace_back(Args&&... args){
+                static_assert(__track_type::__tracks, "emplace_back needs track_size_and_tail");
+                emplace_after(const_iterator(__last_node()), learnSTL::forward<Args>(args)...);
             }
 
         // insert_after
@@ -419,6 +558,7 @@ namespace learnSTL{
             __node_traits::construct(this->__alloc, std::addressof(node_up->__data), val);
             node_up->__next = p->__next;
             p->__next = node_up.release();
+            this->__track.__added(p->__next, 1);
             return iterator(p->__next);
         }
 
@@ -428,12 +568,14 @@ namespace learnSTL{
             __node_traits::construct(this->__alloc, std::addressof(node_up->__data), learnSTL::move(rval));
             node_up->__next = p->__next;
             p->__next = node_up.release();
+            this->__track.__added(p->__next, 1);
             return iterator(p->__next);
         }
 
         iterator insert_after(const_iterator pos, size_type n, const_reference val){
             __node_pointer p = pos.__ptr;
             if(n > 0){
+                size_type count = n;
                 std::unique_ptr<__node_type> node_up(__node_traits::allocate(this->__alloc, 1));
                 __node_traits::construct(this->__alloc, std::addressof(node_up->__data), val);
                 __node_pointer first = node_up.release();
@@ -446,6 +588,7 @@ namespace learnSTL{
                 last->__next = p->__next;
                 p->__next = first;
                 p = last;
+                this->__track.__added(last, count);
             }
             return iterator(p);
         }
@@ -459,7 +602,8 @@ namespace learnSTL{
                     __node_traits::construct(this->__alloc, std::addressof(node_up->__data), *first);
                     __node_pointer first_node_p = node_up.release();
                     __node_pointer last_node_p = first_node_p;
-                    for(++first; first != last; ++first, last_node_p = last_node_p->__next){
+                    size_type count = 1;
+                    for(++first; first != last; ++first, last_node_p = last_node_p->__next, ++count){
                         node_up.reset(__node_traits::allocate(this->__alloc, 1));
                         __node_traits::construct(this->__alloc, std::addressof(node_up->__data), *first);
                         last_node_p->__next = node_up.release();
@@ -467,12 +611,13 @@ namespace learnSTL{
                     last_node_p->__next = p->__next;
                     p->__next = first_node_p;
                     p = last_node_p;
+                    this->__track.__added(last_node_p, count);
                 }
                 return iterator(p);
             }
 
-        iterator insert_after(std::initializer_list<value_type> initlist){
-            return insert_after(initlist.begin(), initlist.end());
+        iterator insert_after(const_iterator pos, std::initializer_list<value_type> initlist){
+            return insert_after(pos, initlist.begin(), initlist.end());
         }
 
         // emplace_after
@@ -483,6 +628,7 @@ namespace learnSTL{
                 __node_traits::construct(this->__alloc, std::addressof(node_up->__data), learnSTL::forward<Args>(args)...);
                 node_up->__next = p->__next;
                 p->__next = node_up.release();
+                this->__track.__added(p->__next, 1);
                 return iterator(p->__next);
             }
 
@@ -497,6 +643,7 @@ namespace learnSTL{
             base::__before_begin()->__next = firstPtr->__next;
             __node_traits::destroy(this->__alloc, std::addressof(firstPtr->__data));
             __node_traits::deallocate(this->__alloc, firstPtr, 1);
+            this->__track.__removed(base::__before_begin(), base::__before_begin(), 1);
         }
 
         // erase_after
@@ -506,6 +653,7 @@ namespace learnSTL{
             p->__next = nextPtr->__next;
             __node_traits::destroy(this->__alloc, std::addressof(nextPtr->__data));
             __node_traits::deallocate(this->__alloc, nextPtr, 1);
+            this->__track.__removed(p, base::__before_begin(), 1);
             return iterator(p->__next);
         }
 
@@ -518,12 +666,15 @@ namespace learnSTL{
                     // modify the link
                     p->__next = e;
                     // deallocate
+                    size_type count = 0;
                     do{
                         p = nextPtr->__next;
                         __node_traits::destroy(this->__alloc, std::addressof(nextPtr->__data));
                         __node_traits::deallocate(this->__alloc, nextPtr, 1);
                         nextPtr = p;
+                        ++count;
                     }while(nextPtr != e);
+                    this->__track.__removed(first.__ptr, base::__before_begin(), count);
                 }
             }
             return iterator(e);
@@ -537,11 +688,14 @@ namespace learnSTL{
         template<typename Compare>
         void merge(forward_list& f2, Compare comp)
         {
-            this->__before_begin()->__next =
-                __merge(this->__before_begin()->__next,
-                        f2.__before_begin()->__next,
-                        comp);
-            f2.__before_begin()->__next = nullptr;
+            try{
+                __merge(this->__before_begin()->__next, f2.__before_begin()->__next, comp);
+            }
+            catch(...){
+                this->__track.__merged(f2.__track);
+                throw;
+            }
+            this->__track.__merged(f2.__track);
         }
 
         template<typename Compare>
@@ -562,15 +716,15 @@ namespace learnSTL{
             if(this != &f2){
                 if(!f2.empty()){
                     __node_pointer p = pos.__ptr;
-                    if(p->__next != nullptr){
-                        // find the last elem in f2
-                        __node_pointer p2 = f2.__before_begin()->__next;
-                        while(p2->__next != nullptr)
-                            p2 = p2->__next;
+                    __node_pointer p2 = nullptr;
+                    if(p->__next != nullptr || __track_type::__tracks){
+                        // find the last elem in f2, a tracked list knows it
+                        p2 = f2.__track.__last(f2.__before_begin()->__next);
                         p2->__next = p->__next;
                     }
                     p->__next = f2.__before_begin()->__next;
                     f2.__before_begin()->__next = nullptr;
+                    this->__track.__take_all(f2.__track, p2);
                 }
             }
         }
@@ -585,6 +739,8 @@ namespace learnSTL{
                 pos2.__ptr->__next = n->__next;
                 n->__next = pos.__ptr->__next;
                 pos.__ptr->__next = n;
+                f2.__track.__removed(pos2.__ptr, f2.__before_begin(), 1);
+                this->__track.__added(n, 1);
             }
         }
 
@@ -597,13 +753,16 @@ namespace learnSTL{
             if(first != last && pos != first){
                 // find previous node of last
                 __node_pointer p = first.__ptr;
-                while(p->__next != last.__ptr)
+                size_type count = 0;
+                for(; p->__next != last.__ptr; ++count)
                     p = p->__next;
                 if(first.__ptr != p)  // first->next = last, no elem to move
                 {
                     p->__next = pos.__ptr->__next;
                     pos.__ptr->__next = first.__ptr->__next;
                     first.__ptr->__next = last.__ptr;   // relink in f2;
+                    f2.__track.__removed(first.__ptr, f2.__before_begin(), count);
+                    this->__track.__added(p, count);
                 }
             }
         }
@@ -611,6 +770,19 @@ namespace learnSTL{
             splice_after(pos, f2, first, last);
         }
 
+        // moves all of f2 to the end
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, void>::type
+            append(forward_list& f2){
+                splice_after(const_iterator(__last_node()), f2);
+            }
+
+        template<typename P = TrackPolicy>
+        typename std::enable_if<std::is_same<P, track_size_and_tail>::value, void>::type
+            append(forward_list&& f2){
+                append(f2);
+            }
+
         // remove
         void remove(const_reference val){
             auto e = end();
@@ -675,28 +847,59 @@ namespace learnSTL{
                     f = n;
                     n = r;
                 }
+                this->__track.__find_tail(base::__before_begin()->__next);   // the old front
                 base::__before_begin()->__next = f;
             }
         }
 
-        // sort
+        // sort, stable
         template<typename Compare>
-            void sort(Compare comp){
-                base::__before_begin()->__next = 
-                    __sort(base::__before_begin()->__next, learnSTL::distance(begin(), end()), comp);
+            typename std::enable_if<!__is_forward_list_policy<typename std::decay<Compare>::type>::value, void>::type
+            sort(Compare comp){
+                try{
+                    __sort(base::__before_begin()->__next, comp);
+                }
+                catch(...){
+                    this->__track.__find_tail(base::__before_begin()->__next);
+                    throw;
+                }
+                this->__track.__find_tail(base::__before_begin()->__next);
             }
 
         void sort(){
             sort(__less<value_type>());
         }
 
+        // with a parallel policy the list is cut into detached sublists,
+        // sorted on the thread_pool and merged back pairwise, see
+        // __forward_list_parallel_sort in execution.h
+        template<typename ExecutionPolicy, typename Compare>
+            typename std::enable_if<__is_forward_list_policy<typename std::decay<ExecutionPolicy>::type>::value, void>::type
+            sort(ExecutionPolicy&&, Compare comp){
+                __sort_policy(comp, std::integral_constant<bool, !std::is_same<typename std::decay<ExecutionPolicy>::type,
+                                                                               execution::sequenced_policy>::value>());
+            }
+
+        template<typename ExecutionPolicy>
+            typename std::enable_if<__is_forward_list_policy<typename std::decay<ExecutionPolicy>::type>::value, void>::type
+            sort(ExecutionPolicy&& policy){
+                sort(policy, __less<value_type>());
+            }
+
         ~forward_list() = default;
     private:
+        // the last node, before_begin when empty; only for tracked lists
+        __node_pointer __last_node() const {
+            return this->__track.__tail != nullptr ? this->__track.__tail : base::__before_begin();
+        }
+
         void __move_assign(forward_list& f2, typename std::true_type){
             clear();
             base::__move_assign_alloc(f2);
             base::__before_begin()->__next = f2.__before_begin()->__next;
             f2.__before_begin()->__next = nullptr;
+            this->__track = f2.__track;
+            f2.__track.__reset();
         }
         void __move_assign(forward_list& f2, typename std::false_type) {
             if(f2.__alloc == this->__alloc)
@@ -707,84 +910,168 @@ namespace learnSTL{
             }
         }
         
+        // merges the chain other into head and leaves other empty, splicing
+        // whole runs of it at a time. Nothing is relinked until comp has
+        // answered, so when it throws the rest of other goes after the last
+        // node and head still holds every node.
         template<typename Compare>
-        __node_pointer __merge(__node_pointer f1, __node_pointer f2, Compare& comp)
+        void __merge(__node_pointer& head, __node_pointer& other, Compare& comp)
         {
-            if(f1 == nullptr)
-                return f2;
+            __node_pointer f1 = head, f2 = other;
+            other = nullptr;
+            if(f1 == nullptr){
+                head = f2;
+                return;
+            }
             if(f2 == nullptr)
-                return f1;
+                return;
             __node_pointer ret = nullptr;
-            // step 1
-            if(comp(f2->__data, f1->__data)){
-                __node_pointer t2 = f2;
-                while(t2->__next && comp(t2->__next->__data, f1->__data)) // traverse f2
-                    t2 = t2->__next;
-                ret = f2;
-                f2 = t2->__next;    // store the first elem bigger than f1
-                t2->__next = f1;
-            }
-            else // first elem in f2 bigger than f1
-                ret = f1;
-            // step 2, 3, 4, 5
-            __node_pointer t1 = f1->__next; // step 2
-            while(t1 != nullptr && f2 != nullptr){
-                if(comp(f2->__data, t1->__data)){  // step 3 found
+            try{
+                // step 1
+                if(comp(f2->__data, f1->__data)){
                     __node_pointer t2 = f2;
-                    while(t2->__next && comp(t2->__next->__data, t1->__data))
+                    while(t2->__next && comp(t2->__next->__data, f1->__data)) // traverse f2
                         t2 = t2->__next;
-                    // step 4 relink
-                    f1->__next = f2;  // merge f2 to f1;
-                    f2 = t2->__next;  // store the first elem bigger than t1
-                    t2->__next = t1;
+                    ret = f2;
+                    f2 = t2->__next;    // store the first elem bigger than f1
+                    t2->__next = f1;
+                }
+                else // first elem in f2 bigger than f1
+                    ret = f1;
+                // step 2, 3, 4, 5
+                __node_pointer t1 = f1->__next; // step 2
+                while(t1 != nullptr && f2 != nullptr){
+                    if(comp(f2->__data, t1->__data)){  // step 3 found
+                        __node_pointer t2 = f2;
+                        while(t2->__next && comp(t2->__next->__data, t1->__data))
+                            t2 = t2->__next;
+                        // step 4 relink
+                        f1->__next = f2;  // merge f2 to f1;
+                        f2 = t2->__next;  // store the first elem bigger than t1
+                        t2->__next = t1;
+                    }
+                    // step 3 not found
+                    f1 = t1;
+                    t1 = t1->__next;
+                    // step 5 repeat
                 }
-                // step 3 not found
-                f1 = t1;
-                t1 = t1->__next;
-                // step 5 repeat
+            }
+            catch(...){
+                if(ret != nullptr)
+                    head = ret;
+                while(f1->__next != nullptr)
+                    f1 = f1->__next;
+                f1->__next = f2;
+                throw;
             }
             if(f2 != nullptr)   // step 6
                 f1->__next = f2;
-            return ret;
+            head = ret;
         }
 
+        // cuts the natural run at the front of head off the chain into run
+        // and moves head past it. A strictly descending run is reversed,
+        // which keeps the sort stable as it holds no equal elements. Every
+        // node stays in run or head when comp throws.
+        template<typename Compare>
+            void __take_run(__node_pointer& head, __node_pointer& run, Compare& comp)
+            {
+                __node_pointer cur = head->__next;
+                if(cur != nullptr && comp(cur->__data, head->__data)){
+                    run = head;
+                    head = cur;
+                    run->__next = nullptr;
+                    while(head != nullptr && comp(head->__data, run->__data)){
+                        __node_pointer n = head->__next;
+                        head->__next = run;
+                        run = head;
+                        head = n;
+                    }
+                }
+                else{
+                    __node_pointer last = head;
+                    while(last->__next != nullptr && !comp(last->__next->__data, last->__data))
+                        last = last->__next;
+                    run = head;
+                    head = last->__next;
+                    last->__next = nullptr;
+                }
+            }
+
+        // bottom-up merge sort without recursion or a counting pass.
+        // slots[i] holds the merge of 2^i runs; a new run is carried up
+        // through the occupied slots like a binary counter. Older runs are
+        // always the first argument of __merge, so equal elements keep
+        // their order. Each node is in one of slots, run and head at any
+        // time, so when comp throws they are chained back onto head.
+        static const size_t __sort_slots = 64;
+
         template<typename Compare>
-            __node_pointer __sort(__node_pointer f1, difference_type sz, Compare& comp)
+            void __sort(__node_pointer& head, Compare& comp)
             {
-                switch(sz){    // base case
-                case 0:
-                case 1:
-                    return f1;
-                case 2:
-                    if(comp(f1->__next->__data, f1->__data)){
-                        __node_pointer temp = f1->__next;
-                        temp->__next = f1;
-                        f1->__next = nullptr;
-                        f1 = temp;
+                __node_pointer slots[__sort_slots];
+                __node_pointer run = nullptr;
+                size_t used = 0;
+                try{
+                    while(head != nullptr){
+                        __take_run(head, run, comp);
+                        size_t i = 0;
+                        for(; i < used && slots[i] != nullptr && i + 1 < __sort_slots; ++i){
+                            __merge(slots[i], run, comp);
+                            learnSTL::swap(slots[i], run);
+                        }
+                        if(i == used)
+                            slots[used++] = nullptr;
+                        if(slots[i] != nullptr){    // only the last slot can still be taken
+                            __merge(slots[i], run, comp);
+                            learnSTL::swap(slots[i], run);
+                        }
+                        learnSTL::swap(slots[i], run);
+                    }
+                    for(size_t i = 0; i < used; ++i)
+                        if(slots[i] != nullptr){
+                            __merge(slots[i], run, comp);
+                            learnSTL::swap(slots[i], run);
+                        }
+                }
+                catch(...){
+                    __node_pointer* tail = &head;
+                    while(*tail != nullptr)
+                        tail = &(*tail)->__next;
+                    *tail = run;
+                    for(size_t i = 0; i < used; ++i){
+                        while(*tail != nullptr)
+                            tail = &(*tail)->__next;
+                        *tail = slots[i];
                     }
-                    return f1;
+                    throw;
                 }
+                head = run;
+            }
 
-                auto sz1 = sz / 2;
-                auto sz2 = sz - sz1;
-                auto e1 = f1;
-                // find end in left_half
-                for(auto n = sz1 -1; n > 0; e1 = e1->__next, --n);
-                __node_pointer f2 = e1->__next;
-                e1->__next = nullptr;
-                return __merge(__sort(f1, sz1, comp), __sort(f2, sz2, comp), comp);
+        template<typename Compare>
+            void __sort_policy(Compare& comp, std::false_type){
+                sort(comp);
             }
+
+        template<typename Compare>
+            void __sort_policy(Compare& comp, std::true_type){
+                __forward_list_parallel_sort(*this, comp);
+            }
+
+        template<typename List, typename Compare>
+            friend void __forward_list_parallel_sort(List& l, Compare& comp);
     };
 
     // swap
-    template<typename T, typename Alloc>
-        void swap(forward_list<T, Alloc>& f1, forward_list<T, Alloc>& f2){
+    template<typename T, typename Alloc, typename P>
+        void swap(forward_list<T, Alloc, P>& f1, forward_list<T, Alloc, P>& f2){
             f1.swap(f2);
         }
 
     // compare
-    template<typename T, typename Alloc>
-        bool operator==(const forward_list<T, Alloc>& f1, const forward_list<T, Alloc>& f2)
+    template<typename T, typename Alloc, typename P>
+        bool operator==(const forward_list<T, Alloc, P>& f1, const forward_list<T, Alloc, P>& f2)
         {
             auto b1 = f1.begin();
             auto e1 = f1.end();
@@ -796,31 +1083,31 @@ namespace learnSTL{
             return (b1 == e1) == (b2 == e2);
         }
 
-    template<typename T, typename Alloc>
-        bool operator!=(const forward_list<T, Alloc>& f1, const forward_list<T, Alloc>& f2){
+    template<typename T, typename Alloc, typename P>
+        bool operator!=(const forward_list<T, Alloc, P>& f1, const forward_list<T, Alloc, P>& f2){
             return !(f1 == f2);
         }
 
-    template<typename T, typename Alloc>
-        bool operator<(const forward_list<T, Alloc>& f1, const forward_list<T, Alloc>& f2)
+    template<typename T, typename Alloc, typename P>
+        bool operator<(const forward_list<T, Alloc, P>& f1, const forward_list<T, Alloc, P>& f2)
         {
             return learnSTL::lexicographical_compare(f1.begin(), f1.end(), f2.begin(), f2.end());
         }
 
-    template<typename T, typename Alloc>
-        bool operator>(const forward_list<T, Alloc>& f1, const forward_list<T, Alloc>& f2)
+    template<typename T, typename Alloc, typename P>
+        bool operator>(const forward_list<T, Alloc, P>& f1, const forward_list<T, Alloc, P>& f2)
         {
             return f2 < f1;
         }
 
-    template<typename T, typename Alloc>
-        bool operator<=(const forward_list<T, Alloc>& f1, const forward_list<T, Alloc>& f2)
+    template<typename T, typename Alloc, typename P>
+        bool operator<=(const forward_list<T, Alloc, P>& f1, const forward_list<T, Alloc, P>& f2)
         {
             return !(f2 < f1);
         }
 
-    template<typename T, typename Alloc>
-        bool operator>=(const forward_list<T, Alloc>& f1, const forward_list<T, Alloc>& f2)
+    template<typename T, typename Alloc, typename P>
+        bool operator>=(const forward_list<T, Alloc, P>& f1, const forward_list<T, Alloc, P>& f2)
         {
             return !(f1 < f2);
         }
@@ -0,0 +1,792 @@
+#ifndef MY_HASH_TABLE_H
+#define MY_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <limits>
+#include <type_traits>
+#include <initializer_list>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "forward_list.h"
+
+namespace learnSTL{
+    ///: ------------------------- hash node --------------------------------
+    // a forward_list node that also keeps the hash of its key, so a rehash
+    // never calls the hasher
+    template<typename T, typename VoidPtr> struct __hash_node;
+
+    template<typename T, typename VoidPtr>
+    struct __hash_head_of{
+        using __NodePtr = typename std::pointer_traits<VoidPtr>::template rebind<__hash_node<T, VoidPtr> >;
+        using type = __forward_head_node<__NodePtr>;
+    };
+
+    template<typename T, typename VoidPtr>
+    struct __hash_node : __hash_head_of<T, VoidPtr>::type{
+        using value_type = T;
+        std::size_t __hash;
+        T __data;
+    };
+
+    // what the table stores and where the key is
+    template<typename Key>
+    struct __hash_set_policy{
+        using key_type   = Key;
+        using value_type = Key;
+        static const bool const_elements = true;
+
+        static const key_type& key(const value_type& v) { return v; }
+    };
+
+    template<typename Key, typename T>
+    struct __hash_map_policy{
+        using key_type   = Key;
+        using value_type = pair<const Key, T>;
+        static const bool const_elements = false;
+
+        static const key_type& key(const value_type& v) { return v.first; }
+    };
+
+    // bucket counts: the first prime after each power of two
+    inline std::size_t __hash_bucket_count(std::size_t n){
+        static const std::uint64_t primes[] = {
+            11ULL, 17ULL, 37ULL, 67ULL, 131ULL, 257ULL, 521ULL, 1031ULL, 2053ULL, 4099ULL, 8209ULL, 16411ULL,
+            32771ULL, 65537ULL, 131101ULL, 262147ULL, 524309ULL, 1048583ULL, 2097169ULL, 4194319ULL,
+            8388617ULL, 16777259ULL, 33554467ULL, 67108879ULL, 134217757ULL, 268435459ULL, 536870923ULL,
+            1073741827ULL, 2147483659ULL, 4294967311ULL, 8589934609ULL, 17179869209ULL, 34359738421ULL,
+            68719476767ULL, 137438953481ULL, 274877906951ULL, 549755813911ULL, 1099511627791ULL,
+            2199023255579ULL, 4398046511119ULL, 8796093022237ULL, 17592186044423ULL, 35184372088891ULL,
+            70368744177679ULL, 140737488355333ULL, 281474976710677ULL, 562949953421381ULL,
+            1125899906842679ULL, 2251799813685269ULL, 4503599627370517ULL, 9007199254740997ULL,
+            18014398509482143ULL, 36028797018963971ULL, 72057594037928017ULL, 144115188075855881ULL,
+            288230376151711813ULL, 576460752303423619ULL, 1152921504606847009ULL, 2305843009213693967ULL,
+            4611686018427388039ULL, 9223372036854775837ULL
+        };
+        const std::uint64_t* p = learnSTL::lower_bound(primes, primes + sizeof(primes) / sizeof(primes[0]),
+                                                       static_cast<std::uint64_t>(n));
+        return static_cast<std::size_t>(*p);
+    }
+
+    inline std::size_t __constrain_hash(std::size_t h, std::size_t count){
+        return h < count ? h : h % count;
+    }
+    ///~ ------------------------- end hash node ----------------------------
+
+
+    ///: ------------------------- hash iterators --------------------------------
+    template<typename Policy, typename Hash, typename KeyEqual, typename Allocator, bool Multi> class __hash_table;
+
+    // walks the one list that holds every node
+    template<typename Policy, typename NodePtr, bool Const>
+    class __hash_iterator{
+        template<typename, typename, typename, typename, bool> friend class __hash_table;
+        template<typename, typename, bool> friend class __hash_iterator;
+        using __node = typename std::pointer_traits<NodePtr>::element_type;
+        static const bool __const_ref = Const || Policy::const_elements;
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type        = typename __node::value_type;
+        using difference_type   = typename std::pointer_traits<NodePtr>::difference_type;
+        using reference         = typename std::conditional<__const_ref, const value_type&, value_type&>::type;
+        using pointer           = typename std::conditional<__const_ref, const value_type*, value_type*>::type;
+
+        __hash_iterator() : __ptr(nullptr) {}
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        __hash_iterator(const __hash_iterator<Policy, NodePtr, C>& iter) : __ptr(iter.__ptr) {}
+
+        reference operator*() const { return __ptr->__data; }
+        pointer operator->() const { return std::addressof(__ptr->__data); }
+
+        __hash_iterator& operator++(){
+            __ptr = __ptr->__next;
+            return *this;
+        }
+        __hash_iterator operator++(int){
+            __hash_iterator temp(*this);
+            __ptr = __ptr->__next;
+            return temp;
+        }
+
+        template<bool C>
+        bool operator==(const __hash_iterator<Policy, NodePtr, C>& iter) const { return __ptr == iter.__ptr; }
+        template<bool C>
+        bool operator!=(const __hash_iterator<Policy, NodePtr, C>& iter) const { return __ptr != iter.__ptr; }
+
+    private:
+        NodePtr __ptr;
+
+        explicit __hash_iterator(NodePtr p) : __ptr(p) {}
+    };
+
+    // walks one bucket: its nodes follow each other in the list, so it stops
+    // at the first node that hashes elsewhere
+    template<typename Policy, typename NodePtr, bool Const>
+    class __hash_local_iterator{
+        template<typename, typename, typename, typename, bool> friend class __hash_table;
+        template<typename, typename, bool> friend class __hash_local_iterator;
+        using __node = typename std::pointer_traits<NodePtr>::element_type;
+        static const bool __const_ref = Const || Policy::const_elements;
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type        = typename __node::value_type;
+        using difference_type   = typename std::pointer_traits<NodePtr>::difference_type;
+        using reference         = typename std::conditional<__const_ref, const value_type&, value_type&>::type;
+        using pointer           = typename std::conditional<__const_ref, const value_type*, value_type*>::type;
+
+        __hash_local_iterator() : __ptr(nullptr), __bucket(0), __count(0) {}
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        __hash_local_iterator(const __hash_local_iterator<Policy, NodePtr, C>& iter)
+            : __ptr(iter.__ptr), __bucket(iter.__bucket), __count(iter.__count) {}
+
+        reference operator*() const { return __ptr->__data; }
+        pointer operator->() const { return std::addressof(__ptr->__data); }
+
+        __hash_local_iterator& operator++(){
+            __ptr = __ptr->__next;
+            if(__ptr != nullptr && __constrain_hash(__ptr->__hash, __count) != __bucket)
+                __ptr = nullptr;
+            return *this;
+        }
+        __hash_local_iterator operator++(int){
+            __hash_local_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        template<bool C>
+        bool operator==(const __hash_local_iterator<Policy, NodePtr, C>& iter) const { return __ptr == iter.__ptr; }
+        template<bool C>
+        bool operator!=(const __hash_local_iterator<Policy, NodePtr, C>& iter) const { return __ptr != iter.__ptr; }
+
+    private:
+        NodePtr     __ptr;
+        std::size_t __bucket;
+        std::size_t __count;
+
+        __hash_local_iterator(NodePtr p, std::size_t bucket, std::size_t count) : __ptr(p), __bucket(bucket), __count(count) {}
+    };
+
+    ///~ ------------------------- end hash iterators ----------------------------
+
+
+    ///: ------------------------- hash table --------------------------------
+    // separate chaining with every node on one singly linked list, as in
+    // libc++: the nodes of a bucket follow each other, and a bucket holds
+    // the node before its first one (the list head for the first bucket).
+    // So begin() is O(1), a bucket is found in one step, and a rehash only
+    // relinks nodes: no node is allocated, moved or hashed again.
+    // Multi tables keep equal keys next to each other.
+    // The nodes come from Allocator rebound to the node type, so a
+    // pool_allocator or arena_allocator serves them directly.
+    template<typename Policy, typename Hash, typename KeyEqual, typename Allocator, bool Multi>
+    class __hash_table{
+        using __alloc_traits  = std::allocator_traits<Allocator>;
+        using void_pointer    = typename __alloc_traits::void_pointer;
+        using __node_type     = __hash_node<typename Policy::value_type, void_pointer>;
+        using __head_type     = typename __hash_head_of<typename Policy::value_type, void_pointer>::type;
+        using __node_alloc    = typename __alloc_traits::template rebind_alloc<__node_type>;
+        using __node_traits   = std::allocator_traits<__node_alloc>;
+        using __node_pointer  = typename __node_traits::pointer;
+        using __head_alloc    = typename __alloc_traits::template rebind_alloc<__head_type>;
+        using __head_pointer  = typename std::allocator_traits<__head_alloc>::pointer;
+        using __bucket_alloc  = typename __alloc_traits::template rebind_alloc<__node_pointer>;
+        using __bucket_traits = std::allocator_traits<__bucket_alloc>;
+        using __bucket_pointer = typename __bucket_traits::pointer;
+    public:
+        using key_type         = typename Policy::key_type;
+        using value_type       = typename Policy::value_type;
+        using hasher           = Hash;
+        using key_equal        = KeyEqual;
+        using allocator_type   = Allocator;
+        using size_type        = std::size_t;
+        using difference_type  = std::ptrdiff_t;
+        using reference        = value_type&;
+        using const_reference  = const value_type&;
+        using pointer          = typename __alloc_traits::pointer;
+        using const_pointer    = typename __alloc_traits::const_pointer;
+
+        using iterator             = __hash_iterator<Policy, __node_pointer, false>;
+        using const_iterator       = __hash_iterator<Policy, __node_pointer, true>;
+        using local_iterator       = __hash_local_iterator<Policy, __node_pointer, false>;
+        using const_local_iterator = __hash_local_iterator<Policy, __node_pointer, true>;
+
+        // what insert returns: the element, and for unique keys whether it is new
+        using __insert_result = typename std::conditional<Multi, iterator, pair<iterator, bool> >::type;
+
+        // iterator
+        iterator begin() { return iterator(__first()); }
+        const_iterator begin() const { return const_iterator(__first()); }
+        const_iterator cbegin() const { return begin(); }
+        iterator end() { return iterator(nullptr); }
+        const_iterator end() const { return const_iterator(nullptr); }
+        const_iterator cend() const { return end(); }
+
+        allocator_type get_allocator() const { return allocator_type(__alloc); }
+        hasher hash_function() const { return __hash; }
+        key_equal key_eq() const { return __eq; }
+
+        // capacity
+        size_type size() const { return __size; }
+        bool empty() const { return __size == 0; }
+        size_type max_size() const {
+            return std::numeric_limits<difference_type>::max() / sizeof(__node_type);
+        }
+
+        // bucket interface
+        size_type bucket_count() const { return __bucket_count; }
+        size_type max_bucket_count() const { return std::numeric_limits<difference_type>::max() / sizeof(__node_pointer); }
+        size_type bucket(const key_type& k) const { return __constrain_hash(__hash(k), __bucket_count); }
+        size_type bucket_size(size_type n) const {
+            size_type c = 0;
+            for(const_local_iterator it = begin(n); it != end(n); ++it)
+                ++c;
+            return c;
+        }
+        local_iterator begin(size_type n) { return local_iterator(__bucket_first(n), n, __bucket_count); }
+        const_local_iterator begin(size_type n) const { return const_local_iterator(__bucket_first(n), n, __bucket_count); }
+        const_local_iterator cbegin(size_type n) const { return begin(n); }
+        local_iterator end(size_type n) { return local_iterator(nullptr, n, __bucket_count); }
+        const_local_iterator end(size_type n) const { return const_local_iterator(nullptr, n, __bucket_count); }
+        const_local_iterator cend(size_type n) const { return end(n); }
+
+        // hash policy
+        float load_factor() const {
+            return __bucket_count == 0 ? 0.0f : static_cast<float>(__size) / static_cast<float>(__bucket_count);
+        }
+        float max_load_factor() const { return __max_load; }
+        void max_load_factor(float ml){
+            __max_load = ml > 0.0f ? ml : __max_load;
+            if(__size > __bucket_count * __max_load)
+                rehash(0);
+        }
+
+        // at least n buckets and no more than max_load_factor elements a
+        // bucket; a smaller table is fine too
+        void rehash(size_type n){
+            const size_type need = static_cast<size_type>(std::ceil(static_cast<float>(__size) / __max_load));
+            if(n < need)
+                n = need;
+            if(n == 0){
+                if(__size == 0)
+                    __rehash(0);
+                return;
+            }
+            n = __hash_bucket_count(n);
+            if(n != __bucket_count)
+                __rehash(n);
+        }
+        // room for n elements without a rehash
+        void reserve(size_type n){
+            const size_type buckets = static_cast<size_type>(std::ceil(static_cast<float>(n) / __max_load));
+            if(buckets > __bucket_count)
+                __rehash(__hash_bucket_count(buckets));
+        }
+
+        // constructor
+        __hash_table() : __head(), __hash(), __eq(), __alloc(), __buckets(nullptr), __bucket_count(0), __size(0), __max_load(1.0f) {}
+        explicit __hash_table(size_type n, const hasher& h = hasher(), const key_equal& eq = key_equal(),
+                              const allocator_type& a = allocator_type())
+            : __head(), __hash(h), __eq(eq), __alloc(a), __buckets(nullptr), __bucket_count(0), __size(0), __max_load(1.0f)
+        {
+            rehash(n);
+        }
+        explicit __hash_table(const allocator_type& a)
+            : __head(), __hash(), __eq(), __alloc(a), __buckets(nullptr), __bucket_count(0), __size(0), __max_load(1.0f) {}
+
+        template<typename InputIter>
+        __hash_table(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value,
+                     InputIter>::type last, size_type n = 0, const hasher& h = hasher(),
+                     const key_equal& eq = key_equal(), const allocator_type& a = allocator_type())
+            : __head(), __hash(h), __eq(eq), __alloc(a), __buckets(nullptr), __bucket_count(0), __size(0), __max_load(1.0f)
+        {
+            rehash(n);
+            insert(first, last);
+        }
+        __hash_table(std::initializer_list<value_type> initlist, size_type n = 0, const hasher& h = hasher(),
+                     const key_equal& eq = key_equal(), const allocator_type& a = allocator_type())
+            : __head(), __hash(h), __eq(eq), __alloc(a), __buckets(nullptr), __bucket_count(0), __size(0), __max_load(1.0f)
+        {
+            rehash(n);
+            insert(initlist.begin(), initlist.end());
+        }
+
+        // copy-constructor
+        __hash_table(const __hash_table& t)
+            : __head(), __hash(t.__hash), __eq(t.__eq), __alloc(__node_traits::select_on_container_copy_construction(t.__alloc)),
+              __buckets(nullptr), __bucket_count(0), __size(0), __max_load(t.__max_load)
+        {
+            __copy_nodes(t);
+        }
+        __hash_table(const __hash_table& t, const allocator_type& a)
+            : __head(), __hash(t.__hash), __eq(t.__eq), __alloc(a),
+              __buckets(nullptr), __bucket_count(0), __size(0), __max_load(t.__max_load)
+        {
+            __copy_nodes(t);
+        }
+
+        // move-constructor
+        __hash_table(__hash_table&& rt)
+            : __head(), __hash(learnSTL::move(rt.__hash)), __eq(learnSTL::move(rt.__eq)), __alloc(learnSTL::move(rt.__alloc)),
+              __buckets(nullptr), __bucket_count(0), __size(0), __max_load(rt.__max_load)
+        {
+            __steal(rt);
+        }
+        __hash_table(__hash_table&& rt, const allocator_type& a)
+            : __head(), __hash(learnSTL::move(rt.__hash)), __eq(learnSTL::move(rt.__eq)), __alloc(a),
+              __buckets(nullptr), __bucket_count(0), __size(0), __max_load(rt.__max_load)
+        {
+            if(__alloc == rt.__alloc)
+                __steal(rt);
+            else
+                __move_nodes(rt);
+        }
+
+        ~__hash_table(){
+            clear();
+            __free_buckets();
+        }
+
+        // assignment
+        __hash_table& operator=(const __hash_table& t){
+            if(this != &t){
+                clear();
+                __copy_assign_alloc(t, std::integral_constant<bool,
+                    __node_traits::propagate_on_container_copy_assignment::value>());
+                __hash = t.__hash;
+                __eq = t.__eq;
+                __max_load = t.__max_load;
+                __copy_nodes(t);
+            }
+            return *this;
+        }
+
+        __hash_table& operator=(__hash_table&& rt){
+            if(this != &rt){
+                clear();
+                __hash = learnSTL::move(rt.__hash);
+                __eq = learnSTL::move(rt.__eq);
+                __max_load = rt.__max_load;
+                if(__node_traits::propagate_on_container_move_assignment::value || __alloc == rt.__alloc){
+                    __free_buckets();
+                    __move_assign_alloc(rt, std::integral_constant<bool,
+                        __node_traits::propagate_on_container_move_assignment::value>());
+                    __steal(rt);
+                }
+                else
+                    __move_nodes(rt);
+            }
+            return *this;
+        }
+
+        __hash_table& operator=(std::initializer_list<value_type> initlist){
+            clear();
+            insert(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        // lookup
+        iterator find(const key_type& k) { return iterator(__find(k)); }
+        const_iterator find(const key_type& k) const { return const_iterator(__find(k)); }
+        bool contains(const key_type& k) const { return __find(k) != nullptr; }
+
+        size_type count(const key_type& k) const {
+            const_iterator first = find(k);
+            size_type n = 0;
+            for(; first != end() && __eq(Policy::key(*first), k); ++first)
+                ++n;
+            return n;
+        }
+
+        pair<iterator, iterator> equal_range(const key_type& k){
+            iterator first = find(k), last = first;
+            while(last != end() && __eq(Policy::key(*last), k))
+                ++last;
+            return pair<iterator, iterator>(first, last);
+        }
+        pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+            const_iterator first = find(k), last = first;
+            while(last != end() && __eq(Policy::key(*last), k))
+                ++last;
+            return pair<const_iterator, const_iterator>(first, last);
+        }
+
+        // modifiers
+        __insert_result insert(const value_type& val) { return __insert(std::integral_constant<bool, Multi>(), val); }
+        __insert_result insert(value_type&& val) { return __insert(std::integral_constant<bool, Multi>(), learnSTL::move(val)); }
+        iterator insert(const_iterator, const value_type& val) { return __result_iterator(insert(val)); }
+        iterator insert(const_iterator, value_type&& val) { return __result_iterator(insert(learnSTL::move(val))); }
+
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            insert(InputIter first, InputIter last){
+                for(; first != last; ++first)
+                    insert(*first);
+            }
+        void insert(std::initializer_list<value_type> initlist){
+            insert(initlist.begin(), initlist.end());
+        }
+
+        // the node is built first, its key decides where it goes
+        template<typename ...Args>
+            __insert_result emplace(Args&&... args){
+                __node_pointer n = __make_node(learnSTL::forward<Args>(args)...);
+                return __insert_node(n, std::integral_constant<bool, Multi>());
+            }
+        template<typename ...Args>
+            iterator emplace_hint(const_iterator, Args&&... args){
+                return __result_iterator(emplace(learnSTL::forward<Args>(args)...));
+            }
+
+        iterator erase(const_iterator pos){
+            __node_pointer n = pos.__ptr;
+            __node_pointer next = n->__next;
+            __unlink(__before(n), n);
+            __free_node(n);
+            return iterator(next);
+        }
+        iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+        iterator erase(const_iterator first, const_iterator last){
+            while(first != last)
+                first = erase(first);
+            return iterator(last.__ptr);
+        }
+        size_type erase(const key_type& k){
+            pair<iterator, iterator> r = equal_range(k);
+            size_type n = 0;
+            for(; r.first != r.second; ++n)
+                r.first = erase(r.first);
+            return n;
+        }
+
+        void clear(){
+            for(__node_pointer p = __first(); p != nullptr;){
+                __node_pointer next = p->__next;
+                __free_node(p);
+                p = next;
+            }
+            __head.__next = nullptr;
+            for(size_type i = 0; i < __bucket_count; ++i)
+                __buckets[i] = nullptr;
+            __size = 0;
+        }
+
+        void swap(__hash_table& t){
+            __swap_alloc(__alloc, t.__alloc, std::integral_constant<bool,
+                __node_traits::propagate_on_container_swap::value>());
+            learnSTL::swap(__hash, t.__hash);
+            learnSTL::swap(__eq, t.__eq);
+            learnSTL::swap(__head.__next, t.__head.__next);
+            learnSTL::swap(__buckets, t.__buckets);
+            learnSTL::swap(__bucket_count, t.__bucket_count);
+            learnSTL::swap(__size, t.__size);
+            learnSTL::swap(__max_load, t.__max_load);
+            __fix_head();
+            t.__fix_head();
+        }
+
+    protected:
+        // unique keys: the element with key k, built from args only if
+        // there is none yet
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __emplace_key(const K& k, Args&&... args){
+                const size_type h = __hash(k);
+                __node_pointer n = __find(k, h);
+                if(n != nullptr)
+                    return pair<iterator, bool>(iterator(n), false);
+                return pair<iterator, bool>(__emplace_new(learnSTL::forward<Args>(args)...), true);
+            }
+
+        // unique keys: a node built from args, whose key is not in the table
+        template<typename ...Args>
+            iterator __emplace_new(Args&&... args){
+                __grow_for_one();
+                __node_pointer n = __make_node(learnSTL::forward<Args>(args)...);
+                __link_front(n);
+                return iterator(n);
+            }
+
+    private:
+        __head_type     __head;         // before the first node
+        hasher          __hash;
+        key_equal       __eq;
+        __node_alloc    __alloc;
+        __bucket_pointer __buckets;     // the node before each bucket's first one
+        size_type       __bucket_count;
+        size_type       __size;
+        float           __max_load;
+
+        __node_pointer __before_begin() const {
+            return static_cast<__node_pointer>(std::pointer_traits<__head_pointer>::pointer_to(const_cast<__head_type&>(__head)));
+        }
+        __node_pointer __first() const { return __head.__next; }
+        size_type __bucket_of(__node_pointer n) const { return __constrain_hash(n->__hash, __bucket_count); }
+
+        __node_pointer __bucket_first(size_type b) const {
+            __node_pointer p = __buckets[b];
+            return p == nullptr ? nullptr : p->__next;
+        }
+
+        template<typename ...Args>
+            __node_pointer __make_node(Args&&... args){
+                __node_pointer n = __node_traits::allocate(__alloc, 1);
+                try{
+                    __node_traits::construct(__alloc, std::addressof(n->__data), learnSTL::forward<Args>(args)...);
+                }
+                catch(...){
+                    __node_traits::deallocate(__alloc, n, 1);
+                    throw;
+                }
+                n->__next = nullptr;
+                n->__hash = __hash(Policy::key(n->__data));
+                return n;
+            }
+
+        void __free_node(__node_pointer n){
+            __node_traits::destroy(__alloc, std::addressof(n->__data));
+            __node_traits::deallocate(__alloc, n, 1);
+        }
+
+        // the first node with key k, which has hash h
+        template<typename K>
+            __node_pointer __find(const K& k, size_type h) const {
+                if(__size == 0)
+                    return nullptr;
+                const size_type b = __constrain_hash(h, __bucket_count);
+                for(__node_pointer n = __bucket_first(b); n != nullptr; n = n->__next){
+                    if(n->__hash == h){
+                        if(__eq(Policy::key(n->__data), k))
+                            return n;
+                    }
+                    else if(__bucket_of(n) != b)
+                        break;
+                }
+                return nullptr;
+            }
+        template<typename K>
+            __node_pointer __find(const K& k) const { return __find(k, __hash(k)); }
+
+        // the node before n, found from the start of n's bucket
+        __node_pointer __before(__node_pointer n) const {
+            __node_pointer p = __buckets[__bucket_of(n)];
+            while(p->__next != n)
+                p = p->__next;
+            return p;
+        }
+
+        // grows the table so one more element stays under the load factor
+        void __grow_for_one(){
+            if(__bucket_count == 0 || static_cast<float>(__size + 1) > __bucket_count * __max_load){
+                size_type n = static_cast<size_type>(std::ceil(static_cast<float>(__size + 1) / __max_load));
+                if(n < 2 * __bucket_count)
+                    n = 2 * __bucket_count;
+                __rehash(__hash_bucket_count(n));
+            }
+        }
+
+        void __grow_or_free(__node_pointer n){
+            try{
+                __grow_for_one();
+            }
+            catch(...){
+                __free_node(n);
+                throw;
+            }
+        }
+
+        // links n at the front of its bucket
+        void __link_front(__node_pointer n){
+            const size_type b = __bucket_of(n);
+            __node_pointer p = __buckets[b];
+            if(p == nullptr){
+                // a new bucket goes first in the list
+                p = __before_begin();
+                n->__next = p->__next;
+                p->__next = n;
+                __buckets[b] = p;
+                if(n->__next != nullptr)
+                    __buckets[__bucket_of(n->__next)] = n;
+            }
+            else{
+                n->__next = p->__next;
+                p->__next = n;
+            }
+            ++__size;
+        }
+
+        // takes n out of the list, p is the node before it
+        void __unlink(__node_pointer p, __node_pointer n){
+            const size_type b = __bucket_of(n);
+            __node_pointer next = n->__next;
+            // n was the only node of its bucket
+            if(p == __buckets[b] && (next == nullptr || __bucket_of(next) != b))
+                __buckets[b] = nullptr;
+            // the next bucket started after n
+            if(next != nullptr && __bucket_of(next) != b)
+                __buckets[__bucket_of(next)] = p;
+            p->__next = next;
+            --__size;
+        }
+
+        template<typename V>
+            iterator __insert(std::true_type, V&& val){
+                return emplace(learnSTL::forward<V>(val));
+            }
+        template<typename V>
+            pair<iterator, bool> __insert(std::false_type, V&& val){
+                return __emplace_key(Policy::key(val), learnSTL::forward<V>(val));
+            }
+
+        pair<iterator, bool> __insert_node(__node_pointer n, std::false_type){
+            __node_pointer e = __find(Policy::key(n->__data), n->__hash);
+            if(e != nullptr){
+                __free_node(n);
+                return pair<iterator, bool>(iterator(e), false);
+            }
+            __grow_or_free(n);
+            __link_front(n);
+            return pair<iterator, bool>(iterator(n), true);
+        }
+        // an equal key already there gets the new node right in front of it
+        iterator __insert_node(__node_pointer n, std::true_type){
+            __grow_or_free(n);
+            __node_pointer e = __find(Policy::key(n->__data), n->__hash);
+            if(e == nullptr)
+                __link_front(n);
+            else{
+                __node_pointer p = __before(e);
+                n->__next = e;
+                p->__next = n;
+                ++__size;
+            }
+            return iterator(n);
+        }
+
+        static iterator __result_iterator(iterator it) { return it; }
+        static iterator __result_iterator(const pair<iterator, bool>& r) { return r.first; }
+
+        // relinks every node for n buckets. Walking the list, a node whose
+        // bucket is already started moves behind that bucket's head, taking
+        // the run of equal keys after it along.
+        void __rehash(size_type n){
+            if(n == 0){
+                __free_buckets();
+                return;
+            }
+            __bucket_alloc ba(__alloc);
+            __bucket_pointer buckets = __bucket_traits::allocate(ba, n);
+            __free_buckets();
+            __buckets = buckets;
+            __bucket_count = n;
+            for(size_type i = 0; i < n; ++i)
+                __buckets[i] = nullptr;
+            __node_pointer pp = __before_begin();
+            __node_pointer cp = pp->__next;
+            if(cp == nullptr)
+                return;
+            size_type phash = __bucket_of(cp);
+            __buckets[phash] = pp;
+            for(pp = cp, cp = cp->__next; cp != nullptr; cp = pp->__next){
+                const size_type chash = __bucket_of(cp);
+                if(chash == phash)
+                    pp = cp;
+                else if(__buckets[chash] == nullptr){
+                    __buckets[chash] = pp;
+                    pp = cp;
+                    phash = chash;
+                }
+                else{
+                    __node_pointer np = cp;
+                    while(Multi && np->__next != nullptr && __eq(Policy::key(cp->__data), Policy::key(np->__next->__data)))
+                        np = np->__next;
+                    pp->__next = np->__next;
+                    np->__next = __buckets[chash]->__next;
+                    __buckets[chash]->__next = cp;
+                }
+            }
+        }
+
+        void __free_buckets(){
+            if(__buckets != nullptr){
+                __bucket_alloc ba(__alloc);
+                __bucket_traits::deallocate(ba, __buckets, __bucket_count);
+            }
+            __buckets = nullptr;
+            __bucket_count = 0;
+        }
+
+        // the first bucket points at the list head, which lives in the table
+        void __fix_head(){
+            if(__head.__next != nullptr)
+                __buckets[__bucket_of(__head.__next)] = __before_begin();
+        }
+
+        void __copy_nodes(const __hash_table& t){
+            reserve(t.__size);
+            for(__node_pointer p = t.__first(); p != nullptr; p = p->__next)
+                __insert_node(__make_node(p->__data), std::integral_constant<bool, Multi>());
+        }
+
+        void __move_nodes(__hash_table& rt){
+            reserve(rt.__size);
+            for(__node_pointer p = rt.__first(); p != nullptr; p = p->__next)
+                __insert_node(__make_node(learnSTL::move(p->__data)), std::integral_constant<bool, Multi>());
+            rt.clear();
+        }
+
+        void __steal(__hash_table& rt){
+            __head.__next = rt.__head.__next;
+            __buckets = rt.__buckets;
+            __bucket_count = rt.__bucket_count;
+            __size = rt.__size;
+            __fix_head();
+            rt.__head.__next = nullptr;
+            rt.__buckets = nullptr;
+            rt.__bucket_count = 0;
+            rt.__size = 0;
+        }
+
+        void __copy_assign_alloc(const __hash_table& t, std::true_type){
+            if(__alloc != t.__alloc)
+                __free_buckets();
+            __alloc = t.__alloc;
+        }
+        void __copy_assign_alloc(const __hash_table&, std::false_type) {}
+
+        void __move_assign_alloc(__hash_table& rt, std::true_type){
+            __alloc = learnSTL::move(rt.__alloc);
+        }
+        void __move_assign_alloc(__hash_table&, std::false_type) {}
+
+        void __swap_alloc(__node_alloc& a1, __node_alloc& a2, std::true_type){
+            learnSTL::swap(a1, a2);
+        }
+        void __swap_alloc(__node_alloc&, __node_alloc&, std::false_type) {}
+    };
+
+    // equal as sets of elements; equal keys are next to each other, so the
+    // groups are compared as permutations
+    template<typename Policy, typename Hash, typename KeyEqual, typename Allocator, bool Multi>
+        bool __hash_table_equal(const __hash_table<Policy, Hash, KeyEqual, Allocator, Multi>& t1,
+                                const __hash_table<Policy, Hash, KeyEqual, Allocator, Multi>& t2)
+        {
+            if(t1.size() != t2.size())
+                return false;
+            for(auto it = t1.begin(); it != t1.end(); ){
+                auto r1 = t1.equal_range(Policy::key(*it));
+                auto r2 = t2.equal_range(Policy::key(*it));
+                if(learnSTL::distance(r1.first, r1.second) != learnSTL::distance(r2.first, r2.second) ||
+                   !learnSTL::is_permutation(r1.first, r1.second, r2.first))
+                    return false;
+                it = r1.second;
+            }
+            return true;
+        }
+    ///~ ------------------------- end hash table ----------------------------
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef MY_INDEXED_HEAP_H
+#define MY_INDEXED_HEAP_H
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include "utility.h"
+#include "vector.h"
+#include "flat_hash_map.h"
+
+namespace learnSTL{
+    ///: ------------------------- indexed_heap --------------------------------
+    // a heap entry: the priority, kept here so the sifts compare without
+    // an indirection, and the slot of its key
+    template<typename Priority>
+    struct __indexed_heap_entry{
+        Priority    __priority;
+        std::size_t __slot;
+    };
+
+    // a heap of keys, each at most once, whose priorities can change in
+    // place. Every key has a slot: __pos[slot] is where its entry is in the
+    // heap, and the sifts keep it right, so a key is found, re-prioritized
+    // or erased in O(log n) without a second entry for it.
+    // As for priority_queue, top() is the largest priority under Compare:
+    // the default std::greater gives the smallest one, as a scheduler wants.
+    template<typename Key, typename Priority, typename Compare = std::greater<Priority>,
+             typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, std::size_t Arity = 4>
+    class indexed_heap{
+        static_assert(Arity >= 2, "indexed_heap needs at least two children per node");
+        using __entry = __indexed_heap_entry<Priority>;
+    public:
+        using key_type       = Key;
+        using priority_type  = Priority;
+        using value_compare  = Compare;
+        using hasher         = Hash;
+        using key_equal      = KeyEqual;
+        using size_type      = std::size_t;
+
+        static const std::size_t arity = Arity;
+
+        // constructor
+        indexed_heap() : __heap(), __pos(), __keys(), __free(), __slots(), __comp() {}
+        explicit indexed_heap(const Compare& comp) : __heap(), __pos(), __keys(), __free(), __slots(), __comp(comp) {}
+
+        // capacity
+        bool empty() const { return __heap.empty(); }
+        size_type size() const { return __heap.size(); }
+        void reserve(size_type n){
+            __heap.reserve(n);
+            __pos.reserve(n);
+            __keys.reserve(n);
+            __slots.reserve(n);
+        }
+
+        // access
+        const key_type& top() const { return __keys[__heap.front().__slot]; }
+        const priority_type& top_priority() const { return __heap.front().__priority; }
+
+        bool contains(const key_type& k) const { return __slots.contains(k); }
+        const priority_type& priority(const key_type& k) const {
+            return __heap[__pos[__slot_of(k, "indexed_heap::priority")]].__priority;
+        }
+
+        // modifiers
+        // false, and nothing changes, when k is in the heap already
+        bool push(const key_type& k, const priority_type& p){
+            if(__slots.contains(k))
+                return false;
+            __heap.push_back(__entry{p, size_type(0)});
+            size_type slot;
+            try{
+                slot = __new_slot(k);
+            }
+            catch(...){
+                __heap.pop_back();
+                throw;
+            }
+            __sift_up(__heap.size() - 1, __entry{p, slot});
+            return true;
+        }
+
+        void pop(){
+            __release(__heap.front().__slot);
+            __entry last = learnSTL::move(__heap.back());
+            __heap.pop_back();
+            if(!__heap.empty())
+                __sift_down(0, learnSTL::move(last));
+        }
+
+        // moves k up or down, whichever way p sends it
+        void update_priority(const key_type& k, const priority_type& p){
+            const size_type slot = __slot_of(k, "indexed_heap::update_priority");
+            __place(__pos[slot], __entry{p, slot});
+        }
+
+        // p must not be lower than k's priority under Compare, so k can only
+        // move towards the top: one comparison per level on the way up
+        void decrease_key(const key_type& k, const priority_type& p){
+            const size_type slot = __slot_of(k, "indexed_heap::decrease_key");
+            __sift_up(__pos[slot], __entry{p, slot});
+        }
+
+        size_type erase(const key_type& k){
+            auto it = __slots.find(k);
+            if(it == __slots.end())
+                return 0;
+            const size_type slot = it->second, i = __pos[slot];
+            __release(slot);
+            __entry last = learnSTL::move(__heap.back());
+            __heap.pop_back();
+            if(i != __heap.size())
+                __place(i, learnSTL::move(last));
+            return 1;
+        }
+
+        void clear(){
+            __heap.clear();
+            __pos.clear();
+            __keys.clear();
+            __free.clear();
+            __slots.clear();
+        }
+
+        void swap(indexed_heap& h){
+            __heap.swap(h.__heap);
+            __pos.swap(h.__pos);
+            __keys.swap(h.__keys);
+            __free.swap(h.__free);
+            __slots.swap(h.__slots);
+            learnSTL::swap(__comp, h.__comp);
+        }
+
+        value_compare value_comp() const { return __comp; }
+
+    private:
+        vector<__entry>   __heap;
+        vector<size_type> __pos;        // slot -> index in __heap
+        vector<key_type>  __keys;       // slot -> key
+        vector<size_type> __free;       // slots of erased keys, used again first
+        flat_hash_map<key_type, size_type, hasher, key_equal> __slots;
+        value_compare     __comp;
+
+        size_type __slot_of(const key_type& k, const char* what) const {
+            auto it = __slots.find(k);
+            if(it == __slots.end())
+                throw std::out_of_range(what);
+            return it->second;
+        }
+
+        size_type __new_slot(const key_type& k){
+            size_type slot;
+            if(!__free.empty()){
+                slot = __free.back();
+                __keys[slot] = k;
+                __free.pop_back();
+            }
+            else{
+                slot = __keys.size();
+                __pos.push_back(0);
+                try{
+                    __keys.push_back(k);
+                }
+                catch(...){
+                    __pos.pop_back();
+                    throw;
+                }
+            }
+            try{
+                __slots.try_emplace(k, slot);
+            }
+            catch(...){
+                __free.push_back(slot);
+                throw;
+            }
+            return slot;
+        }
+
+        void __release(size_type slot){
+            __slots.erase(__keys[slot]);
+            __free.push_back(slot);
+        }
+
+        void __put(size_type i, __entry&& e){
+            __pos[e.__slot] = i;
+            __heap[i] = learnSTL::move(e);
+        }
+
+        // the hole at i goes up while its parent is below e
+        void __sift_up(size_type i, __entry&& e){
+            while(i > 0){
+                const size_type parent = (i - 1) / Arity;
+                if(!__comp(__heap[parent].__priority, e.__priority))
+                    break;
+                __put(i, learnSTL::move(__heap[parent]));
+                i = parent;
+            }
+            __put(i, learnSTL::move(e));
+        }
+
+        // bottom-up, as for the heap algorithms: the hole goes down to a leaf
+        // through the largest child, then e goes up from there
+        void __sift_down(size_type i, __entry&& e){
+            const size_type top = i, len = __heap.size();
+            for(size_type child; (child = Arity * i + 1) < len; ){
+                size_type largest = child;
+                const size_type end = child + Arity < len ? child + Arity : len;
+                while(++child < end)
+                    largest = __comp(__heap[largest].__priority, __heap[child].__priority) ? child : largest;
+                __put(i, learnSTL::move(__heap[largest]));
+                i = largest;
+            }
+            while(i > top){
+                const size_type parent = (i - 1) / Arity;
+                if(!__comp(__heap[parent].__priority, e.__priority))
+                    break;
+                __put(i, learnSTL::move(__heap[parent]));
+                i = parent;
+            }
+            __put(i, learnSTL::move(e));
+        }
+
+        // e at i, which may have to go either way
+        void __place(size_type i, __entry&& e){
+            if(i > 0 && __comp(__heap[(i - 1) / Arity].__priority, e.__priority))
+                __sift_up(i, learnSTL::move(e));
+            else
+                __sift_down(i, learnSTL::move(e));
+        }
+    };
+
+    template<typename Key, typename Priority, typename Compare, typename Hash, typename KeyEqual, std::size_t Arity>
+        const std::size_t indexed_heap<Key, Priority, Compare, Hash, KeyEqual, Arity>::arity;
+
+    template<typename Key, typename Priority, typename Compare, typename Hash, typename KeyEqual, std::size_t Arity>
+        void swap(indexed_heap<Key, Priority, Compare, Hash, KeyEqual, Arity>& h1,
+                  indexed_heap<Key, Priority, Compare, Hash, KeyEqual, Arity>& h2){
+            h1.swap(h2);
+        }
+    ///~ ------------------------- end indexed_heap ----------------------------
+}
+
+#endif
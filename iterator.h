@@ -5,6 +5,7 @@
 #include <istream>
 #include <ostream>
 #include <memory>
+#include <iterator>
 
 namespace learnSTL{
 	struct input_iterator_tag {};
@@ -26,6 +27,15 @@ namespace learnSTL{
 		static const bool value = sizeof(test<Tp>(nullptr)) == 1;
 	};
 
+	// the tag of an iterator from namespace std, so that the iterators of
+	// the std containers work with the algorithms here as well
+	template<typename Tag> struct __iterator_tag { typedef Tag type; };
+	template<> struct __iterator_tag<std::input_iterator_tag> { typedef input_iterator_tag type; };
+	template<> struct __iterator_tag<std::output_iterator_tag> { typedef output_iterator_tag type; };
+	template<> struct __iterator_tag<std::forward_iterator_tag> { typedef forward_iterator_tag type; };
+	template<> struct __iterator_tag<std::bidirectional_iterator_tag> { typedef bidirectional_iterator_tag type; };
+	template<> struct __iterator_tag<std::random_access_iterator_tag> { typedef random_access_iterator_tag type; };
+
 	// if Iter is iterator
 	template<typename Iter, bool> struct __iterator_traits_impl {};
 	template<typename Iter>
@@ -35,7 +45,7 @@ namespace learnSTL{
 		typedef typename Iter::difference_type     difference_type;
 		typedef typename Iter::pointer             pointer;
 		typedef typename Iter::reference           reference;
-		typedef typename Iter::iterator_category   iterator_category;
+		typedef typename __iterator_tag<typename Iter::iterator_category>::type   iterator_category;
 	};
 
 
@@ -47,7 +57,9 @@ namespace learnSTL{
 		: __iterator_traits_impl
 		< Iter,
 		std::is_convertible<typename Iter::iterator_category, input_iterator_tag>::value ||
-		std::is_convertible<typename Iter::iterator_category, output_iterator_tag>::value
+		std::is_convertible<typename Iter::iterator_category, output_iterator_tag>::value ||
+		std::is_convertible<typename Iter::iterator_category, std::input_iterator_tag>::value ||
+		std::is_convertible<typename Iter::iterator_category, std::output_iterator_tag>::value
 		>
 	{};
 
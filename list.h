@@ -0,0 +1,1045 @@
+#ifndef MY_LIST_H
+#define MY_LIST_H
+
+#include <type_traits>
+#include <initializer_list>
+#include <memory>
+#include <limits>
+#include <new>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+
+namespace learnSTL{
+    template<typename T, typename VoidPtr> struct __list_node;
+
+    // the links of a node. They point at the base, as __end is a bare base
+    // and not a node: a link is cast down to the node only to reach __data,
+    // and never when it is __end.
+    template<typename T, typename VoidPtr>
+    struct __list_node_base{
+        using __link_pointer = typename std::pointer_traits<VoidPtr>::template rebind<__list_node_base>;
+        using __node_pointer = typename std::pointer_traits<VoidPtr>::template rebind<__list_node<T, VoidPtr> >;
+
+        __link_pointer __prev;
+        __link_pointer __next;
+
+        __list_node_base() : __prev(nullptr), __next(nullptr) {}
+
+        static __node_pointer __as_node(__link_pointer p) { return static_cast<__node_pointer>(p); }
+        static __link_pointer __as_link(__node_pointer n){
+            return std::pointer_traits<__link_pointer>::pointer_to(static_cast<__list_node_base&>(*n));
+        }
+    };
+
+    template<typename T, typename VoidPtr>
+    struct __list_node : __list_node_base<T, VoidPtr>{
+        using value_type = T;
+        T __data;
+    };
+
+    template<typename T, typename Allocator> class list;
+    template<typename ConstNodePtr> class __list_const_iterator;
+
+    template<typename NodePtr>
+    class __list_iterator{
+        using __node_type    = typename std::pointer_traits<NodePtr>::element_type;
+        using __link_pointer = typename __node_type::__link_pointer;
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = typename std::pointer_traits<NodePtr>::element_type::value_type;
+        using difference_type   = typename std::pointer_traits<NodePtr>::difference_type;
+        using reference         = value_type&;
+        using pointer           = typename std::pointer_traits<NodePtr>:: template rebind<value_type>;
+
+        __list_iterator() : __ptr(nullptr) {}
+
+        reference operator*() const { return __node_type::__as_node(__ptr)->__data; }
+        pointer operator->() const { return std::pointer_traits<pointer>::pointer_to(operator*()); }
+
+        __list_iterator& operator++(){
+            __ptr = __ptr->__next;
+            return *this;
+        }
+        __list_iterator operator++(int){
+            __list_iterator temp(*this);
+            __ptr = __ptr->__next;
+            return temp;
+        }
+        __list_iterator& operator--(){
+            __ptr = __ptr->__prev;
+            return *this;
+        }
+        __list_iterator operator--(int){
+            __list_iterator temp(*this);
+            __ptr = __ptr->__prev;
+            return temp;
+        }
+        friend bool operator==(const __list_iterator& iter1, const __list_iterator& iter2){
+            return iter1.__ptr == iter2.__ptr;
+        }
+        friend bool operator!=(const __list_iterator& iter1, const __list_iterator& iter2){
+            return iter1.__ptr != iter2.__ptr;
+        }
+
+    private:
+        __link_pointer __ptr;
+
+        explicit __list_iterator(__link_pointer p) : __ptr(p) {}
+        template<typename, typename> friend class list;
+        template<typename> friend class __list_const_iterator;
+    };
+
+    template<typename ConstNodePtr>
+    class __list_const_iterator{
+        using __node_type = typename std::remove_const<typename std::pointer_traits<ConstNodePtr>::element_type>::type;
+        using __NodePtr = typename std::pointer_traits<ConstNodePtr>:: template rebind<__node_type>;
+        using __link_pointer = typename __node_type::__link_pointer;
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type        = typename __node_type::value_type;
+        using difference_type   = typename std::pointer_traits<ConstNodePtr>::difference_type;
+        using reference         = const value_type&;
+        using pointer           = typename std::pointer_traits<ConstNodePtr>:: template rebind<const value_type>;
+
+        __list_const_iterator() : __ptr(nullptr) {}
+        __list_const_iterator(__list_iterator<__NodePtr> iter) : __ptr(iter.__ptr) {}
+
+        reference operator*() const { return __node_type::__as_node(__ptr)->__data; }
+        pointer operator->() const { return std::pointer_traits<pointer>::pointer_to(operator*()); }
+
+        __list_const_iterator& operator++(){
+            __ptr = __ptr->__next;
+            return *this;
+        }
+        __list_const_iterator operator++(int){
+            __list_const_iterator temp(*this);
+            __ptr = __ptr->__next;
+            return temp;
+        }
+        __list_const_iterator& operator--(){
+            __ptr = __ptr->__prev;
+            return *this;
+        }
+        __list_const_iterator operator--(int){
+            __list_const_iterator temp(*this);
+            __ptr = __ptr->__prev;
+            return temp;
+        }
+
+        friend bool operator==(const __list_const_iterator& iter1, const __list_const_iterator& iter2){
+            return iter1.__ptr == iter2.__ptr;
+        }
+        friend bool operator!=(const __list_const_iterator& iter1, const __list_const_iterator& iter2){
+            return iter1.__ptr != iter2.__ptr;
+        }
+
+    private:
+        __link_pointer __ptr;
+
+        explicit __list_const_iterator(__link_pointer p) : __ptr(p) {}
+        template<typename, typename> friend class list;
+    };
+
+    // owns one node taken out of a list with extract(), together with a copy
+    // of the allocator it came from. insert() links the node into a list whose
+    // allocator compares equal, so a node moves between lists without being
+    // freed and allocated again.
+    template<typename NodeAlloc>
+    class __list_node_handle{
+        using __node_traits  = std::allocator_traits<NodeAlloc>;
+        using __node_pointer = typename __node_traits::pointer;
+    public:
+        using value_type     = typename __node_traits::value_type::value_type;
+        using allocator_type = typename __node_traits::template rebind_alloc<value_type>;
+
+        __list_node_handle() : __ptr(nullptr) {}
+        __list_node_handle(const __list_node_handle&) = delete;
+        __list_node_handle& operator=(const __list_node_handle&) = delete;
+
+        __list_node_handle(__list_node_handle&& nh) : __ptr(nullptr){
+            __take(nh);
+        }
+        __list_node_handle& operator=(__list_node_handle&& nh){
+            if(this != &nh){
+                __destroy();
+                __take(nh);
+            }
+            return *this;
+        }
+
+        ~__list_node_handle(){
+            __destroy();
+        }
+
+        bool empty() const { return __ptr == nullptr; }
+        explicit operator bool() const { return __ptr != nullptr; }
+
+        value_type& value() const { return __ptr->__data; }
+        allocator_type get_allocator() const { return allocator_type(*__alloc()); }
+
+        void swap(__list_node_handle& nh){
+            __list_node_handle temp(learnSTL::move(nh));
+            nh = learnSTL::move(*this);
+            *this = learnSTL::move(temp);
+        }
+
+    private:
+        __node_pointer __ptr;
+        // the allocator, constructed only while there is a node
+        typename std::aligned_storage<sizeof(NodeAlloc), alignof(NodeAlloc)>::type __alloc_buf;
+
+        __list_node_handle(__node_pointer p, const NodeAlloc& a) : __ptr(p){
+            ::new(static_cast<void*>(&__alloc_buf)) NodeAlloc(a);
+        }
+
+        NodeAlloc* __alloc() { return reinterpret_cast<NodeAlloc*>(&__alloc_buf); }
+        const NodeAlloc* __alloc() const { return reinterpret_cast<const NodeAlloc*>(&__alloc_buf); }
+
+        void __take(__list_node_handle& nh){
+            if(nh.__ptr != nullptr){
+                ::new(static_cast<void*>(&__alloc_buf)) NodeAlloc(learnSTL::move(*nh.__alloc()));
+                __ptr = nh.__release();
+            }
+        }
+
+        // gives up the node, which is still alive
+        __node_pointer __release(){
+            __node_pointer p = __ptr;
+            __alloc()->~NodeAlloc();
+            __ptr = nullptr;
+            return p;
+        }
+
+        void __destroy(){
+            if(__ptr != nullptr){
+                NodeAlloc& a = *__alloc();
+                __node_traits::destroy(a, std::addressof(__ptr->__data));
+                __node_traits::deallocate(a, __ptr, 1);
+                __release();
+            }
+        }
+
+        template<typename, typename> friend class list;
+    };
+
+    template<typename NodeAlloc> inline
+        void swap(__list_node_handle<NodeAlloc>& nh1, __list_node_handle<NodeAlloc>& nh2){
+            nh1.swap(nh2);
+        }
+
+    template<typename T, typename Allocator = std::allocator<T> >
+    class __list_base{
+    protected:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type  = typename std::allocator_traits<allocator_type>::size_type;
+
+        using void_pointer       = typename std::allocator_traits<allocator_type>::void_pointer;
+        using __node_type        = __list_node<T, void_pointer>;
+        using __node_base        = __list_node_base<T, void_pointer>;
+        using __node_alloc       = typename std::allocator_traits<allocator_type>::template rebind_alloc<__node_type>;
+        using __node_traits      = std::allocator_traits<__node_alloc>;
+        using __node_pointer     = typename __node_traits::pointer;
+        using __link_pointer     = typename __node_base::__link_pointer;
+
+        using iterator       = __list_iterator<__node_pointer>;
+        using const_iterator = __list_const_iterator<__node_pointer>;
+
+        // the list is a ring through __end, which stands before the first
+        // node and after the last
+        __node_base __end;
+        __node_alloc __alloc;
+        size_type __size;
+
+        __link_pointer __end_link() const {
+            return std::pointer_traits<__link_pointer>::pointer_to(const_cast<__node_base&>(__end));
+        }
+
+        // constructor
+        __list_base() : __end(), __alloc(), __size(0) {
+            __end.__prev = __end.__next = __end_link();
+        }
+        __list_base(const allocator_type& a) : __end(), __alloc(a), __size(0) {
+            __end.__prev = __end.__next = __end_link();
+        }
+        __list_base(const __node_alloc& a) : __end(), __alloc(a), __size(0) {
+            __end.__prev = __end.__next = __end_link();
+        }
+
+        void clear(){
+            __link_pointer e = __end_link();
+            for(__link_pointer p = __end.__next; p != e;){
+                __link_pointer nextPtr = p->__next;
+                __node_pointer n = __node_base::__as_node(p);
+                __node_traits::destroy(__alloc, std::addressof(n->__data));
+                __node_traits::deallocate(__alloc, n, 1);
+                p = nextPtr;
+            }
+            __end.__prev = __end.__next = e;
+            __size = 0;
+        }
+
+        ~__list_base(){
+            clear();
+        }
+
+        // this is empty: take over all nodes of l
+        void __take_nodes(__list_base& l){
+            if(l.__size != 0){
+                __end.__next = l.__end.__next;
+                __end.__prev = l.__end.__prev;
+                __end.__next->__prev = __end.__prev->__next = __end_link();
+                __size = l.__size;
+                l.__end.__prev = l.__end.__next = l.__end_link();
+                l.__size = 0;
+            }
+        }
+
+        void __copy_assign_alloc(const __list_base& l){
+            __copy_assign_alloc(l, std::integral_constant<bool, __node_traits::propagate_on_container_copy_assignment::value>());
+        }
+
+        void __move_assign_alloc(__list_base& rl){
+            __move_assign_alloc(rl, std::integral_constant<bool, __node_traits::propagate_on_container_move_assignment::value>());
+        }
+
+        void swap(__list_base& l){
+            __swap_alloc(__alloc, l.__alloc, std::integral_constant<bool, __node_traits::propagate_on_container_swap::value>());
+            learnSTL::swap(__end.__next, l.__end.__next);
+            learnSTL::swap(__end.__prev, l.__end.__prev);
+            learnSTL::swap(__size, l.__size);
+            __fix_ring();
+            l.__fix_ring();
+        }
+
+    private:
+        // after __end's links were swapped: point the ends back at __end
+        void __fix_ring(){
+            if(__size == 0)
+                __end.__prev = __end.__next = __end_link();
+            else
+                __end.__next->__prev = __end.__prev->__next = __end_link();
+        }
+
+        void __copy_assign_alloc(const __list_base& l, std::true_type){
+            if(__alloc != l.__alloc)
+                clear();
+            __alloc = l.__alloc;
+        }
+        void __copy_assign_alloc(const __list_base&, std::false_type) {}
+
+        void __move_assign_alloc(__list_base& rl, std::true_type){
+            __alloc = learnSTL::move(rl.__alloc);
+        }
+        void __move_assign_alloc(__list_base&, std::false_type) {}
+
+        void __swap_alloc(__node_alloc& a1, __node_alloc& a2, std::true_type){
+            learnSTL::swap(a1, a2);
+        }
+        void __swap_alloc(__node_alloc&, __node_alloc&, std::false_type) {}
+    };
+
+    // ------ list -----------
+    // doubly linked, with the element count kept so size() is O(1).
+    // Splicing never touches the elements: a whole list or a single node is
+    // relinked in O(1), a range from another list costs a walk to count it.
+    template<typename T, typename Allocator = std::allocator<T> >
+    class list : private __list_base<T, Allocator>
+    {
+        using base = __list_base<T, Allocator>;
+        using __node_type = typename base::__node_type;
+        using __node_pointer = typename base::__node_pointer;
+        using __node_base = typename base::__node_base;
+        using __link_pointer = typename base::__link_pointer;
+        using __node_alloc = typename base::__node_alloc;
+        using __node_traits = typename base::__node_traits;
+    public:
+        using value_type       = T;
+        using allocator_type   = Allocator;
+        using size_type        = typename std::allocator_traits<allocator_type>::size_type;
+        using difference_type  = typename std::allocator_traits<allocator_type>::difference_type;
+        using reference        = value_type&;
+        using const_reference  = const value_type&;
+        using pointer          = typename std::allocator_traits<allocator_type>::pointer;
+        using const_pointer    = typename std::allocator_traits<allocator_type>::const_pointer;
+
+        using iterator               = typename base::iterator;
+        using const_iterator         = typename base::const_iterator;
+        using reverse_iterator       = learnSTL::reverse_iterator<iterator>;
+        using const_reverse_iterator = learnSTL::reverse_iterator<const_iterator>;
+        using node_type              = __list_node_handle<__node_alloc>;
+
+        // iterator
+        iterator begin() { return iterator(this->__end.__next); }
+        const_iterator begin() const { return const_iterator(this->__end.__next); }
+        const_iterator cbegin() const { return begin(); }
+
+        iterator end() { return iterator(base::__end_link()); }
+        const_iterator end() const { return const_iterator(base::__end_link()); }
+        const_iterator cend() const { return end(); }
+
+        reverse_iterator rbegin() { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+        const_reverse_iterator crbegin() const { return rbegin(); }
+
+        reverse_iterator rend() { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+        const_reverse_iterator crend() const { return rend(); }
+
+        allocator_type get_allocator() const { return allocator_type(this->__alloc); }
+
+        reference front() { return __value(this->__end.__next); }
+        const_reference front() const { return __value(this->__end.__next); }
+        reference back() { return __value(this->__end.__prev); }
+        const_reference back() const { return __value(this->__end.__prev); }
+
+        bool empty() const { return this->__size == 0; }
+        size_type size() const { return this->__size; }
+        size_type max_size() const {
+            return std::numeric_limits<size_type>::max();
+        }
+
+        // constructor
+        list() = default;
+        explicit list(const allocator_type& a) : base(a) {}
+
+        explicit list(size_type n, const allocator_type& a = allocator_type()) : base(a)
+        {
+            for(; n > 0; --n)
+                emplace_back();
+        }
+        list(size_type n, const_reference val, const allocator_type& a = allocator_type()) : base(a)
+        {
+            for(; n > 0; --n)
+                emplace_back(val);
+        }
+        template<typename InputIter>
+            list(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value, InputIter>::type last,
+                 const allocator_type& a = allocator_type()) : base(a)
+            {
+                for(; first != last; ++first)
+                    emplace_back(*first);
+            }
+        list(std::initializer_list<value_type> initlist, const allocator_type& a = allocator_type()) : base(a)
+        {
+            insert(end(), initlist.begin(), initlist.end());
+        }
+
+        // copy-constructor
+        list(const list& l)
+            : base(__node_traits::select_on_container_copy_construction(l.__alloc))
+        {
+            insert(end(), l.begin(), l.end());
+        }
+        list(const list& l, const allocator_type& a) : base(a)
+        {
+            insert(end(), l.begin(), l.end());
+        }
+
+        // move-constructor
+        list(list&& rl) : base(learnSTL::move(rl.__alloc))
+        {
+            base::__take_nodes(rl);
+        }
+        list(list&& rl, const allocator_type& a) : base(a)
+        {
+            if(this->__alloc == rl.__alloc)
+                base::__take_nodes(rl);
+            else{
+                using moveIter = move_iterator<iterator>;
+                insert(end(), moveIter(rl.begin()), moveIter(rl.end()));
+            }
+        }
+
+        ~list() = default;
+
+        // assignment
+        list& operator=(const list& l){
+            if(this == &l)
+                return *this;
+            base::__copy_assign_alloc(l);
+            assign(l.begin(), l.end());
+            return *this;
+        }
+
+        list& operator=(list&& rl){
+            if(this != &rl)
+                __move_assign(rl, std::integral_constant<bool, __node_traits::propagate_on_container_move_assignment::value>());
+            return *this;
+        }
+
+        list& operator=(std::initializer_list<value_type> initlist){
+            assign(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        void assign(size_type n, const_reference val){
+            iterator b = begin();
+            iterator e = end();
+            for(; b != e && n > 0; --n, ++b)
+                *b = val;
+            if(b != e)
+                erase(b, e);
+            else
+                insert(e, n, val);
+        }
+
+        template<typename InputIter>
+        void assign(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value, InputIter>::type last)
+        {
+            iterator b = begin();
+            iterator e = end();
+            for(; b != e && first != last; ++b, ++first)
+                *b = *first;
+            if(b != e)
+                erase(b, e);
+            else
+                insert(e, first, last);
+        }
+
+        void assign(std::initializer_list<value_type> initlist){
+            assign(initlist.begin(), initlist.end());
+        }
+
+        // push and pop at both ends
+        void push_front(const_reference val){
+            emplace(begin(), val);
+        }
+        void push_front(value_type&& val){
+            emplace(begin(), learnSTL::move(val));
+        }
+        void push_back(const_reference val){
+            emplace(end(), val);
+        }
+        void push_back(value_type&& val){
+            emplace(end(), learnSTL::move(val));
+        }
+
+        template<typename ...Args>
+            void emplace_front(Args&&... args){
+                emplace(begin(), learnSTL::forward<Args>(args)...);
+            }
+        template<typename ...Args>
+            void emplace_back(Args&&... args){
+                emplace(end(), learnSTL::forward<Args>(args)...);
+            }
+
+        void pop_front(){
+            erase(begin());
+        }
+        void pop_back(){
+            erase(iterator(this->__end.__prev));
+        }
+
+        // insert before pos
+        template<typename ...Args>
+            iterator emplace(const_iterator pos, Args&&... args){
+                __link_pointer n = __node_base::__as_link(__create_node(learnSTL::forward<Args>(args)...));
+                __link_nodes(pos.__ptr, n, n);
+                ++this->__size;
+                return iterator(n);
+            }
+
+        iterator insert(const_iterator pos, const_reference val){
+            return emplace(pos, val);
+        }
+        iterator insert(const_iterator pos, value_type&& val){
+            return emplace(pos, learnSTL::move(val));
+        }
+
+        // the new nodes are built in a list of their own first, so an
+        // exception leaves this list as it was
+        iterator insert(const_iterator pos, size_type n, const_reference val){
+            list temp(n, val, get_allocator());
+            return __splice_all(pos, temp);
+        }
+        template<typename InputIter>
+            typename std::enable_if<__is_input_iterator<InputIter>::value, iterator>::type
+            insert(const_iterator pos, InputIter first, InputIter last){
+                list temp(first, last, get_allocator());
+                return __splice_all(pos, temp);
+            }
+        iterator insert(const_iterator pos, std::initializer_list<value_type> initlist){
+            return insert(pos, initlist.begin(), initlist.end());
+        }
+
+        // node handles. The node of nh must come from an allocator equal to this one's.
+        node_type extract(const_iterator pos){
+            __link_pointer n = pos.__ptr;
+            __unlink_nodes(n, n);
+            --this->__size;
+            return node_type(__node_base::__as_node(n), this->__alloc);
+        }
+
+        iterator insert(const_iterator pos, node_type&& nh){
+            if(nh.empty())
+                return iterator(pos.__ptr);
+            __link_pointer n = __node_base::__as_link(nh.__release());
+            __link_nodes(pos.__ptr, n, n);
+            ++this->__size;
+            return iterator(n);
+        }
+
+        // erase
+        iterator erase(const_iterator pos){
+            __link_pointer n = pos.__ptr;
+            __link_pointer nextPtr = n->__next;
+            __unlink_nodes(n, n);
+            --this->__size;
+            __destroy_node(n);
+            return iterator(nextPtr);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            if(first != last){
+                __unlink_nodes(first.__ptr, last.__ptr->__prev);
+                for(__link_pointer p = first.__ptr; p != last.__ptr;){
+                    __link_pointer nextPtr = p->__next;
+                    __destroy_node(p);
+                    --this->__size;
+                    p = nextPtr;
+                }
+            }
+            return iterator(last.__ptr);
+        }
+
+        void clear(){
+            base::clear();
+        }
+
+        // resize
+        void resize(size_type n){
+            if(n < this->__size)
+                erase(__iterator_at(n), end());
+            else
+                for(n -= this->__size; n > 0; --n)
+                    emplace_back();
+        }
+
+        void resize(size_type n, const_reference val){
+            if(n < this->__size)
+                erase(__iterator_at(n), end());
+            else
+                insert(end(), n - this->__size, val);
+        }
+
+        void swap(list& l){
+            base::swap(l);
+        }
+
+        // splice, moves nodes of l before pos
+        void splice(const_iterator pos, list& l){
+            if(this != &l && !l.empty())
+                __splice_all(pos, l);
+        }
+        void splice(const_iterator pos, list&& l){
+            splice(pos, l);
+        }
+
+        void splice(const_iterator pos, list& l, const_iterator i){
+            __link_pointer n = i.__ptr;
+            if(pos.__ptr != n && pos.__ptr != n->__next){
+                __unlink_nodes(n, n);
+                __link_nodes(pos.__ptr, n, n);
+                --l.__size;
+                ++this->__size;
+            }
+        }
+        void splice(const_iterator pos, list&& l, const_iterator i){
+            splice(pos, l, i);
+        }
+
+        // pos must not be in [first, last)
+        void splice(const_iterator pos, list& l, const_iterator first, const_iterator last){
+            if(first != last){
+                __link_pointer f = first.__ptr;
+                __link_pointer b = last.__ptr->__prev;
+                if(this != &l){
+                    size_type n = static_cast<size_type>(learnSTL::distance(first, last));
+                    l.__size -= n;
+                    this->__size += n;
+                }
+                __unlink_nodes(f, b);
+                __link_nodes(pos.__ptr, f, b);
+            }
+        }
+        void splice(const_iterator pos, list&& l, const_iterator first, const_iterator last){
+            splice(pos, l, first, last);
+        }
+
+        // remove, the matching nodes are gathered in a list of their own and
+        // freed at the end, val may be one of them
+        void remove(const_reference val){
+            list deleted(get_allocator());
+            for(iterator i = begin(), e = end(); i != e;){
+                if(*i == val){
+                    iterator j = learnSTL::next(i);
+                    for(; j != e && *j == val; ++j);
+                    deleted.splice(deleted.end(), *this, i, j);
+                    i = j;
+                }
+                else
+                    ++i;
+            }
+        }
+
+        template<typename UnaryPred>
+            void remove_if(UnaryPred pred){
+                list deleted(get_allocator());
+                for(iterator i = begin(), e = end(); i != e;){
+                    if(pred(*i)){
+                        iterator j = learnSTL::next(i);
+                        for(; j != e && pred(*j); ++j);
+                        deleted.splice(deleted.end(), *this, i, j);
+                        i = j;
+                    }
+                    else
+                        ++i;
+                }
+            }
+
+        // unique
+        template<typename BinPred>
+            void unique(BinPred binaryPred){
+                list deleted(get_allocator());
+                for(iterator i = begin(), e = end(); i != e;){
+                    iterator j = learnSTL::next(i);
+                    iterator k = j;
+                    for(; k != e && binaryPred(*i, *k); ++k);
+                    if(j != k)
+                        deleted.splice(deleted.end(), *this, j, k);
+                    i = k;
+                }
+            }
+
+        void unique(){
+            unique(__equal_to<value_type>());
+        }
+
+        // merge, runs of l that go before an element of this are spliced in whole
+        template<typename Compare>
+        void merge(list& l, Compare comp){
+            if(this == &l)
+                return;
+            iterator f1 = begin(), e1 = end();
+            iterator f2 = l.begin(), e2 = l.end();
+            while(f1 != e1 && f2 != e2){
+                if(comp(*f2, *f1)){
+                    iterator m = learnSTL::next(f2);
+                    size_type n = 1;
+                    for(; m != e2 && comp(*m, *f1); ++m, ++n);
+                    __link_pointer f = f2.__ptr;
+                    __link_pointer b = m.__ptr->__prev;
+                    __unlink_nodes(f, b);
+                    __link_nodes(f1.__ptr, f, b);
+                    l.__size -= n;
+                    this->__size += n;
+                    f2 = m;
+                }
+                ++f1;
+            }
+            splice(e1, l);
+        }
+
+        template<typename Compare>
+        void merge(list&& l, Compare comp){
+            merge(l, learnSTL::move(comp));
+        }
+
+        void merge(list& l){
+            merge(l, __less<value_type>());
+        }
+
+        void merge(list&& l){
+            merge(l, __less<value_type>());
+        }
+
+        // reverse, every node swaps its two links
+        void reverse(){
+            __link_pointer e = base::__end_link();
+            __link_pointer p = e;
+            do{
+                __link_pointer nextPtr = p->__next;
+                learnSTL::swap(p->__prev, p->__next);
+                p = nextPtr;
+            }while(p != e);
+        }
+
+        // sort, stable. The ring is opened and sorted through the next links
+        // alone, then the prev links are set again in one pass. When comp
+        // throws, the nodes go back into the ring in an unspecified order.
+        template<typename Compare>
+            void sort(Compare comp){
+                if(this->__size < 2)
+                    return;
+                this->__end.__prev->__next = nullptr;
+                __link_pointer head = this->__end.__next;
+                try{
+                    __sort(head, comp);
+                }
+                catch(...){
+                    __close_ring(head);
+                    throw;
+                }
+                __close_ring(head);
+            }
+
+        void sort(){
+            sort(__less<value_type>());
+        }
+
+    private:
+        template<typename ...Args>
+            __node_pointer __create_node(Args&&... args){
+                __node_pointer n = __node_traits::allocate(this->__alloc, 1);
+                try{
+                    __node_traits::construct(this->__alloc, std::addressof(n->__data), learnSTL::forward<Args>(args)...);
+                }
+                catch(...){
+                    __node_traits::deallocate(this->__alloc, n, 1);
+                    throw;
+                }
+                return n;
+            }
+
+        void __destroy_node(__link_pointer p){
+            __node_pointer n = __node_base::__as_node(p);
+            __node_traits::destroy(this->__alloc, std::addressof(n->__data));
+            __node_traits::deallocate(this->__alloc, n, 1);
+        }
+
+        // the element of p, which is not __end
+        static reference __value(__link_pointer p) { return __node_base::__as_node(p)->__data; }
+
+        // links the chain [first, last] in before p
+        static void __link_nodes(__link_pointer p, __link_pointer first, __link_pointer last){
+            p->__prev->__next = first;
+            first->__prev = p->__prev;
+            p->__prev = last;
+            last->__next = p;
+        }
+
+        // takes the chain [first, last] out, its own links are left as they are
+        static void __unlink_nodes(__link_pointer first, __link_pointer last){
+            first->__prev->__next = last->__next;
+            last->__next->__prev = first->__prev;
+        }
+
+        // moves all nodes of l before pos, returns the first of them or pos
+        iterator __splice_all(const_iterator pos, list& l){
+            if(l.empty())
+                return iterator(pos.__ptr);
+            __link_pointer f = l.__end.__next;
+            __link_pointer b = l.__end.__prev;
+            __unlink_nodes(f, b);
+            __link_nodes(pos.__ptr, f, b);
+            this->__size += l.__size;
+            l.__size = 0;
+            return iterator(f);
+        }
+
+        // the n-th element, walked to from the nearer end
+        iterator __iterator_at(size_type n){
+            if(n <= this->__size / 2){
+                iterator i = begin();
+                for(; n > 0; --n)
+                    ++i;
+                return i;
+            }
+            iterator i = end();
+            for(n = this->__size - n; n > 0; --n)
+                --i;
+            return i;
+        }
+
+        void __move_assign(list& l, std::true_type){
+            clear();
+            base::__move_assign_alloc(l);
+            base::__take_nodes(l);
+        }
+        void __move_assign(list& l, std::false_type){
+            if(this->__alloc == l.__alloc)
+                __move_assign(l, std::true_type());
+            else{
+                using moveIter = move_iterator<iterator>;
+                assign(moveIter(l.begin()), moveIter(l.end()));
+            }
+        }
+
+        // the chain from head, nullptr-terminated, becomes the ring again
+        void __close_ring(__link_pointer head){
+            __link_pointer prev = base::__end_link();
+            for(__link_pointer p = head; p != nullptr; p = p->__next){
+                p->__prev = prev;
+                prev = p;
+            }
+            prev->__next = base::__end_link();
+            this->__end.__prev = prev;
+            this->__end.__next = head;
+        }
+
+        // merges the nullptr-terminated chain f2 into f1 through their next
+        // links, f1 goes first among equal elements. f2 is nullptr afterwards,
+        // and f1 holds the nodes of both even when comp throws.
+        template<typename Compare>
+            void __merge(__link_pointer& f1, __link_pointer& f2, Compare& comp)
+            {
+                __link_pointer head = nullptr;
+                __link_pointer* tail = &head;
+                __link_pointer a = f1, b = f2;
+                try{
+                    while(a != nullptr && b != nullptr){
+                        if(comp(__value(b), __value(a))){
+                            *tail = b;
+                            b = b->__next;
+                        }
+                        else{
+                            *tail = a;
+                            a = a->__next;
+                        }
+                        tail = &(*tail)->__next;
+                    }
+                }
+                catch(...){
+                    *tail = a;
+                    while(*tail != nullptr)
+                        tail = &(*tail)->__next;
+                    *tail = b;
+                    f1 = head;
+                    f2 = nullptr;
+                    throw;
+                }
+                *tail = a != nullptr ? a : b;
+                f1 = head;
+                f2 = nullptr;
+            }
+
+        // cuts the natural run at the front of head off the chain into run
+        // and moves head past it. A strictly descending run is reversed,
+        // which keeps the sort stable as it holds no equal elements. Every
+        // node stays in run or head when comp throws.
+        template<typename Compare>
+            void __take_run(__link_pointer& head, __link_pointer& run, Compare& comp)
+            {
+                __link_pointer cur = head->__next;
+                if(cur != nullptr && comp(__value(cur), __value(head))){
+                    run = head;
+                    head = cur;
+                    run->__next = nullptr;
+                    while(head != nullptr && comp(__value(head), __value(run))){
+                        __link_pointer n = head->__next;
+                        head->__next = run;
+                        run = head;
+                        head = n;
+                    }
+                }
+                else{
+                    __link_pointer last = head;
+                    while(last->__next != nullptr && !comp(__value(last->__next), __value(last)))
+                        last = last->__next;
+                    run = head;
+                    head = last->__next;
+                    last->__next = nullptr;
+                }
+            }
+
+        // bottom-up merge sort, as in forward_list: slots[i] holds the merge
+        // of 2^i runs and a new run is carried up like a binary counter.
+        // Each node is in one of slots, run and head at any time, so when
+        // comp throws they are chained back onto head.
+        static const size_t __sort_slots = 64;
+
+        template<typename Compare>
+            void __sort(__link_pointer& head, Compare& comp)
+            {
+                __link_pointer slots[__sort_slots];
+                __link_pointer run = nullptr;
+                size_t used = 0;
+                try{
+                    while(head != nullptr){
+                        __take_run(head, run, comp);
+                        size_t i = 0;
+                        for(; i < used && slots[i] != nullptr && i + 1 < __sort_slots; ++i){
+                            __merge(slots[i], run, comp);
+                            learnSTL::swap(slots[i], run);
+                        }
+                        if(i == used)
+                            slots[used++] = nullptr;
+                        if(slots[i] != nullptr){    // only the last slot can still be taken
+                            __merge(slots[i], run, comp);
+                            learnSTL::swap(slots[i], run);
+                        }
+                        learnSTL::swap(slots[i], run);
+                    }
+                    for(size_t i = 0; i < used; ++i)
+                        if(slots[i] != nullptr){
+                            __merge(slots[i], run, comp);
+                            learnSTL::swap(slots[i], run);
+                        }
+                }
+                catch(...){
+                    __link_pointer* tail = &head;
+                    while(*tail != nullptr)
+                        tail = &(*tail)->__next;
+                    *tail = run;
+                    for(size_t i = 0; i < used; ++i){
+                        while(*tail != nullptr)
+                            tail = &(*tail)->__next;
+                        *tail = slots[i];
+                    }
+                    throw;
+                }
+                head = run;
+            }
+    };
+
+    // swap
+    template<typename T, typename Alloc>
+        void swap(list<T, Alloc>& l1, list<T, Alloc>& l2){
+            l1.swap(l2);
+        }
+
+    // compare
+    template<typename T, typename Alloc>
+        bool operator==(const list<T, Alloc>& l1, const list<T, Alloc>& l2)
+        {
+            if(l1.size() != l2.size())
+                return false;
+            auto b2 = l2.begin();
+            for(auto b1 = l1.begin(), e1 = l1.end(); b1 != e1; ++b1, ++b2)
+                if(*b1 != *b2)
+                    return false;
+            return true;
+        }
+
+    template<typename T, typename Alloc>
+        bool operator!=(const list<T, Alloc>& l1, const list<T, Alloc>& l2){
+            return !(l1 == l2);
+        }
+
+    template<typename T, typename Alloc>
+        bool operator<(const list<T, Alloc>& l1, const list<T, Alloc>& l2)
+        {
+            return learnSTL::lexicographical_compare(l1.begin(), l1.end(), l2.begin(), l2.end());
+        }
+
+    template<typename T, typename Alloc>
+        bool operator>(const list<T, Alloc>& l1, const list<T, Alloc>& l2)
+        {
+            return l2 < l1;
+        }
+
+    template<typename T, typename Alloc>
+        bool operator<=(const list<T, Alloc>& l1, const list<T, Alloc>& l2)
+        {
+            return !(l2 < l1);
+        }
+
+    template<typename T, typename Alloc>
+        bool operator>=(const list<T, Alloc>& l1, const list<T, Alloc>& l2)
+        {
+            return !(l1 < l2);
+        }
+}
+#endif
@@ -1,4 +1,9 @@
+#ifndef MY_NUMERIC_H
+#define MY_NUMERIC_H
+
+#include <cstddef>
 #include "iterator.h"
+#include "simd.h"
 
 namespace learnSTL{    
 	//iota      
@@ -72,6 +77,20 @@ namespace learnSTL{
             return result;
         }
 
+    // specialize for pointer
+    // integers only: a vector prefix sum regroups the additions, which changes
+    // the rounding of a floating point partial_sum
+    template<typename U, typename T> inline
+        typename std::enable_if<std::is_same<typename std::remove_const<U>::type, T>::value &&
+                                __has_simd_scan<T>::value && std::is_integral<T>::value, T*>::type
+        partial_sum(U* first, U* last, T* result)
+        {
+            T carry = T();
+            if(__simd_scan<T, false>(first, result, last - first, carry))
+                return result + (last - first);
+            return learnSTL::partial_sum<U*, T*>(first, last, result);
+        }
+
     // adjacent_difference
     template<typename InputIter, typename OutputIter, typename BinOP> inline
         OutputIter adjacent_difference(InputIter first, InputIter last, OutputIter result, BinOP binary_op)
@@ -103,4 +122,448 @@ namespace learnSTL{
             return result;
         
         }
+
+    // specialize for pointer
+    // every difference is rounded on its own, so floating point types qualify too
+    template<typename U, typename T> inline
+        typename std::enable_if<std::is_same<typename std::remove_const<U>::type, T>::value &&
+                                __has_simd_scan<T>::value, T*>::type
+        adjacent_difference(U* first, U* last, T* result)
+        {
+            if(__simd_adjacent_difference<T>(first, result, last - first))
+                return result + (last - first);
+            return learnSTL::adjacent_difference<U*, T*>(first, last, result);
+        }
+
+    ///: ------------------------- reassociating sums --------------------------------
+    // how fast_accumulate and dot may regroup the additions:
+    // strict keeps the left to right order of accumulate, pairwise adds blocks
+    // as a balanced tree with several accumulators in a block (and SIMD for
+    // float, double and 32 bit int), kahan carries the rounding error along.
+    namespace reassociation{
+        class strict_policy {};
+        class pairwise_policy {};
+        class kahan_policy {};
+
+        const strict_policy   strict{};
+        const pairwise_policy pairwise{};
+        const kahan_policy    kahan{};
+    }
+
+    // elements summed in one block before it joins the tree
+    const size_t __pairwise_block = 1024;
+
+    // block sums added as a balanced tree without knowing the length first:
+    // level i holds the sum of 2^i blocks, like the digits of a binary counter
+    template<typename T>
+    class __cascade_sum{
+    public:
+        __cascade_sum() : __top(0) {}
+
+        void push(T x){
+            size_t i = 0;
+            for(; i != __top && __used[i]; ++i){
+                x = __level[i] + x;
+                __used[i] = false;
+            }
+            if(i == __top)
+                ++__top;
+            __level[i] = x;
+            __used[i] = true;
+        }
+
+        // the older, higher levels first, then init in front of it all
+        T result(T init) const {
+            T sum = T();
+            bool any = false;
+            for(size_t i = __top; i-- != 0;){
+                if(__used[i]){
+                    sum = any ? sum + __level[i] : __level[i];
+                    any = true;
+                }
+            }
+            return any ? init + sum : init;
+        }
+
+    private:
+        T      __level[64];
+        bool   __used[64];
+        size_t __top;
+    };
+
+    // fast_accumulate
+    template<typename InputIter, typename T> inline
+        T __fast_accumulate(InputIter first, InputIter last, T val, reassociation::strict_policy)
+        {
+            return learnSTL::accumulate(first, last, val);
+        }
+
+    template<typename InputIter, typename T> inline
+        T __fast_accumulate(InputIter first, InputIter last, T val, reassociation::kahan_policy)
+        {
+            T c = T();
+            for(; first != last; ++first){
+                T y = T(*first) - c;
+                T t = val + y;
+                c = (t - val) - y;
+                val = t;
+            }
+            return val;
+        }
+
+    template<typename InputIter, typename T> inline
+        T __pairwise_accumulate(InputIter first, InputIter last, T val, input_iterator_tag)
+        {
+            __cascade_sum<T> sums;
+            while(first != last){
+                T block = *first;
+                for(size_t k = 1; k != __pairwise_block && ++first != last; ++k)
+                    block = block + *first;
+                if(first != last)
+                    ++first;
+                sums.push(block);
+            }
+            return sums.result(val);
+        }
+
+    // four accumulators, the adds of a block do not wait on each other
+    template<typename RandomIter, typename T> inline
+        T __pairwise_accumulate(RandomIter first, RandomIter last, T val, random_access_iterator_tag)
+        {
+            __cascade_sum<T> sums;
+            while(first != last){
+                size_t n = last - first < static_cast<ptrdiff_t>(__pairwise_block) ? last - first : __pairwise_block;
+                T a0 = T(), a1 = T(), a2 = T(), a3 = T();
+                size_t i = 0;
+                for(; i + 4 <= n; i += 4){
+                    a0 = a0 + first[i];
+                    a1 = a1 + first[i + 1];
+                    a2 = a2 + first[i + 2];
+                    a3 = a3 + first[i + 3];
+                }
+                for(; i != n; ++i)
+                    a0 = a0 + first[i];
+                sums.push((a0 + a1) + (a2 + a3));
+                first += n;
+            }
+            return sums.result(val);
+        }
+
+    template<typename InputIter, typename T> inline
+        T __fast_accumulate(InputIter first, InputIter last, T val, reassociation::pairwise_policy)
+        {
+            return __pairwise_accumulate(first, last, val, typename iterator_traits<InputIter>::iterator_category());
+        }
+
+    // specialize for pointer
+    template<typename U, typename T> inline
+        typename std::enable_if<std::is_same<typename std::remove_const<U>::type, T>::value && __has_simd_sum<T>::value, T>::type
+        __fast_accumulate(U* first, U* last, T val, reassociation::pairwise_policy)
+        {
+            __cascade_sum<T> sums;
+            for(; first != last;){
+                size_t n = last - first < static_cast<ptrdiff_t>(__pairwise_block) ? last - first : __pairwise_block;
+                T block;
+                if(!__simd_sum<T>(first, nullptr, n, block))
+                    return __pairwise_accumulate(first, last, sums.result(val), random_access_iterator_tag());
+                sums.push(block);
+                first += n;
+            }
+            return sums.result(val);
+        }
+
+    template<typename U, typename T> inline
+        typename std::enable_if<std::is_same<typename std::remove_const<U>::type, T>::value &&
+                                std::is_floating_point<T>::value && __has_simd_sum<T>::value, T>::type
+        __fast_accumulate(U* first, U* last, T val, reassociation::kahan_policy)
+        {
+            T c = T();
+            if(!__simd_kahan<T>(first, nullptr, last - first, val, c))
+                return __fast_accumulate<U*, T>(first, last, val, reassociation::kahan);
+            return val;
+        }
+
+    template<typename InputIter, typename T, typename Policy> inline
+        T fast_accumulate(InputIter first, InputIter last, T val, Policy policy)
+        {
+            return __fast_accumulate(first, last, val, policy);
+        }
+
+    template<typename InputIter, typename T> inline
+        T fast_accumulate(InputIter first, InputIter last, T val)
+        {
+            return __fast_accumulate(first, last, val, reassociation::pairwise);
+        }
+
+    // dot
+    template<typename InputIter1, typename InputIter2, typename T> inline
+        T __dot(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val, reassociation::strict_policy)
+        {
+            return learnSTL::inner_product(first1, last1, first2, val);
+        }
+
+    template<typename InputIter1, typename InputIter2, typename T> inline
+        T __dot(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val, reassociation::kahan_policy)
+        {
+            T c = T();
+            for(; first1 != last1; ++first1, ++first2){
+                T y = T(*first1 * (*first2)) - c;
+                T t = val + y;
+                c = (t - val) - y;
+                val = t;
+            }
+            return val;
+        }
+
+    template<typename InputIter1, typename InputIter2, typename T> inline
+        T __dot(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val, reassociation::pairwise_policy)
+        {
+            __cascade_sum<T> sums;
+            while(first1 != last1){
+                T a0 = T(), a1 = T();
+                size_t k = 0;
+                for(; k != __pairwise_block && first1 != last1; ++k, ++first1, ++first2){
+                    if(k & 1)
+                        a1 = a1 + *first1 * (*first2);
+                    else
+                        a0 = a0 + *first1 * (*first2);
+                }
+                sums.push(a0 + a1);
+            }
+            return sums.result(val);
+        }
+
+    // specialize for pointer
+    template<typename U1, typename U2, typename T> inline
+        typename std::enable_if<std::is_same<typename std::remove_const<U1>::type, T>::value &&
+                                std::is_same<typename std::remove_const<U2>::type, T>::value && __has_simd_sum<T>::value, T>::type
+        __dot(U1* first1, U1* last1, U2* first2, T val, reassociation::pairwise_policy)
+        {
+            __cascade_sum<T> sums;
+            for(; first1 != last1;){
+                size_t n = last1 - first1 < static_cast<ptrdiff_t>(__pairwise_block) ? last1 - first1 : __pairwise_block;
+                T block;
+                if(!__simd_sum<T>(first1, first2, n, block))
+                    return __dot<U1*, U2*, T>(first1, last1, first2, sums.result(val), reassociation::pairwise);
+                sums.push(block);
+                first1 += n;
+                first2 += n;
+            }
+            return sums.result(val);
+        }
+
+    template<typename U1, typename U2, typename T> inline
+        typename std::enable_if<std::is_same<typename std::remove_const<U1>::type, T>::value &&
+                                std::is_same<typename std::remove_const<U2>::type, T>::value &&
+                                std::is_floating_point<T>::value && __has_simd_sum<T>::value, T>::type
+        __dot(U1* first1, U1* last1, U2* first2, T val, reassociation::kahan_policy)
+        {
+            T c = T();
+            if(!__simd_kahan<T>(first1, first2, last1 - first1, val, c))
+                return __dot<U1*, U2*, T>(first1, last1, first2, val, reassociation::kahan);
+            return val;
+        }
+
+    template<typename InputIter1, typename InputIter2, typename T, typename Policy> inline
+        T dot(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val, Policy policy)
+        {
+            return __dot(first1, last1, first2, val, policy);
+        }
+
+    template<typename InputIter1, typename InputIter2, typename T> inline
+        T dot(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val)
+        {
+            return __dot(first1, last1, first2, val, reassociation::pairwise);
+        }
+    ///~ ------------------------- end reassociating sums ----------------------------
+
+    // default operations of reduce and transform_reduce
+    template<typename T>
+    struct __plus{
+        T operator()(const T& x, const T& y) const { return x + y; }
+    };
+
+    template<typename T>
+    struct __multiplies{
+        T operator()(const T& x, const T& y) const { return x * y; }
+    };
+
+    // reduce
+    // same as accumulate, but the grouping of the sum is unspecified, which is
+    // what allows the parallel overloads in execution.h to split the range.
+    template<typename InputIter, typename T, typename BinOP> inline
+        T reduce(InputIter first, InputIter last, T val, BinOP binary_op)
+        {
+            return learnSTL::accumulate(first, last, val, binary_op);
+        }
+
+    template<typename InputIter, typename T> inline
+        T reduce(InputIter first, InputIter last, T val)
+        {
+            return learnSTL::accumulate(first, last, val);
+        }
+
+    template<typename InputIter> inline
+        typename iterator_traits<InputIter>::value_type
+        reduce(InputIter first, InputIter last)
+        {
+            return learnSTL::accumulate(first, last, typename iterator_traits<InputIter>::value_type());
+        }
+
+    // transform_reduce
+    template<typename InputIter1, typename InputIter2, typename T> inline
+        T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val)
+        {
+            return learnSTL::inner_product(first1, last1, first2, val);
+        }
+
+    template<typename InputIter1, typename InputIter2, typename T, typename BinOP1, typename BinOP2> inline
+        T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T val, BinOP1 reduce_op, BinOP2 transform_op)
+        {
+            return learnSTL::inner_product(first1, last1, first2, val, reduce_op, transform_op);
+        }
+
+    template<typename InputIter, typename T, typename BinOP, typename UnaryOP> inline
+        T transform_reduce(InputIter first, InputIter last, T val, BinOP reduce_op, UnaryOP transform_op)
+        {
+            for(; first != last; ++first)
+                val = reduce_op(val, transform_op(*first));
+            return val;
+        }
+
+    // inclusive_scan
+    template<typename InputIter, typename OutputIter> inline
+        OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result)
+        {
+            return learnSTL::partial_sum(first, last, result);
+        }
+
+    template<typename InputIter, typename OutputIter, typename BinOP> inline
+        OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinOP binary_op)
+        {
+            return learnSTL::partial_sum(first, last, result, binary_op);
+        }
+
+    template<typename InputIter, typename OutputIter, typename BinOP, typename T> inline
+        OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinOP binary_op, T val)
+        {
+            for(; first != last; ++first, ++result){
+                val = binary_op(val, *first);
+                *result = val;
+            }
+            return result;
+        }
+
+    // exclusive_scan
+    template<typename InputIter, typename OutputIter, typename T, typename BinOP> inline
+        OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T val, BinOP binary_op)
+        {
+            for(; first != last; ++first, ++result){
+                T next_val = binary_op(val, *first);   // read before write, result may alias first
+                *result = val;
+                val = std::move(next_val);
+            }
+            return result;
+        }
+
+    template<typename InputIter, typename OutputIter, typename T> inline
+        OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T val)
+        {
+            for(; first != last; ++first, ++result){
+                T next_val = val + *first;
+                *result = val;
+                val = std::move(next_val);
+            }
+            return result;
+        }
+
+    // specialize for pointer
+    // unlike partial_sum the scans may regroup +, so float and double get the
+    // vector prefix sums as well. With no kernel for the cpu, the loops above.
+    template<typename U, typename T>
+    struct __simd_scannable
+        : std::integral_constant<bool, std::is_same<typename std::remove_const<U>::type, T>::value &&
+                                       __has_simd_scan<T>::value> {};
+
+    template<typename U, typename T> inline
+        typename std::enable_if<__simd_scannable<U, T>::value, T*>::type
+        inclusive_scan(U* first, U* last, T* result, __plus<T>, T val)
+        {
+            if(__simd_scan<T, false>(first, result, last - first, val))
+                return result + (last - first);
+            return learnSTL::inclusive_scan<U*, T*, __plus<T>, T>(first, last, result, __plus<T>(), val);
+        }
+
+    template<typename U, typename T> inline
+        typename std::enable_if<__simd_scannable<U, T>::value, T*>::type
+        inclusive_scan(U* first, U* last, T* result, __plus<T> op)
+        {
+            if(first == last)
+                return result;
+            T val = *first;     // not 0 + *first, that would turn -0.0 into 0.0
+            *result = val;
+            return learnSTL::inclusive_scan(first + 1, last, result + 1, op, val);
+        }
+
+    template<typename U, typename T> inline
+        typename std::enable_if<__simd_scannable<U, T>::value, T*>::type
+        inclusive_scan(U* first, U* last, T* result)
+        {
+            return learnSTL::inclusive_scan(first, last, result, __plus<T>());
+        }
+
+    template<typename U, typename T> inline
+        typename std::enable_if<__simd_scannable<U, T>::value, T*>::type
+        exclusive_scan(U* first, U* last, T* result, T val, __plus<T>)
+        {
+            if(__simd_scan<T, true>(first, result, last - first, val))
+                return result + (last - first);
+            return learnSTL::exclusive_scan<U*, T*, T, __plus<T> >(first, last, result, val, __plus<T>());
+        }
+
+    template<typename U, typename T> inline
+        typename std::enable_if<__simd_scannable<U, T>::value, T*>::type
+        exclusive_scan(U* first, U* last, T* result, T val)
+        {
+            return learnSTL::exclusive_scan(first, last, result, val, __plus<T>());
+        }
+
+    // transform_inclusive_scan
+    template<typename InputIter, typename OutputIter, typename BinOP, typename UnaryOP, typename T> inline
+        OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                BinOP binary_op, UnaryOP unary_op, T val)
+        {
+            for(; first != last; ++first, ++result){
+                val = binary_op(val, unary_op(*first));
+                *result = val;
+            }
+            return result;
+        }
+
+    template<typename InputIter, typename OutputIter, typename BinOP, typename UnaryOP> inline
+        OutputIter transform_inclusive_scan(InputIter first, InputIter last, OutputIter result,
+                BinOP binary_op, UnaryOP unary_op)
+        {
+            if(first != last){
+                typename std::decay<decltype(unary_op(*first))>::type val(unary_op(*first));
+                *result = val;
+                return learnSTL::transform_inclusive_scan(++first, last, ++result, binary_op, unary_op, val);
+            }
+            return result;
+        }
+
+    // transform_exclusive_scan
+    template<typename InputIter, typename OutputIter, typename T, typename BinOP, typename UnaryOP> inline
+        OutputIter transform_exclusive_scan(InputIter first, InputIter last, OutputIter result,
+                T val, BinOP binary_op, UnaryOP unary_op)
+        {
+            for(; first != last; ++first, ++result){
+                T next_val = binary_op(val, unary_op(*first));
+                *result = val;
+                val = std::move(next_val);
+            }
+            return result;
+        }
 }
+
+#endif
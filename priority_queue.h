@@ -0,0 +1,115 @@
+#ifndef MY_PRIORITY_QUEUE_H
+#define MY_PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "vector.h"
+
+namespace learnSTL{
+    ///: ------------------------- priority_queue --------------------------------
+    // a max-heap over Container, each node with Arity children. The
+    // children of a node are adjacent, so with 4 of them one pop reads one
+    // cache line per level of a tree half as deep as the binary one. That
+    // pays off once the heap is larger than the cache; a small heap does
+    // fewer comparisons with Arity = 2.
+    template<typename T, typename Container = vector<T>,
+             typename Compare = std::less<typename Container::value_type>, std::size_t Arity = 4>
+    class priority_queue{
+        static_assert(Arity >= 2, "priority_queue needs at least two children per node");
+    public:
+        using container_type  = Container;
+        using value_compare   = Compare;
+        using value_type      = typename Container::value_type;
+        using size_type       = typename Container::size_type;
+        using reference       = typename Container::reference;
+        using const_reference = typename Container::const_reference;
+
+        static const std::size_t arity = Arity;
+
+        // constructor
+        priority_queue() : c(), comp() {}
+        explicit priority_queue(const Compare& cmp) : c(), comp(cmp) {}
+        priority_queue(const Compare& cmp, const Container& cont) : c(cont), comp(cmp)
+        {
+            __make_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+        }
+        priority_queue(const Compare& cmp, Container&& cont) : c(learnSTL::move(cont)), comp(cmp)
+        {
+            __make_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+        }
+        template<typename InputIter, typename = typename std::enable_if<__is_input_iterator<InputIter>::value>::type>
+        priority_queue(InputIter first, InputIter last, const Compare& cmp = Compare()) : c(), comp(cmp)
+        {
+            for(; first != last; ++first)
+                c.push_back(*first);
+            __make_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+        }
+        template<typename InputIter, typename = typename std::enable_if<__is_input_iterator<InputIter>::value>::type>
+        priority_queue(InputIter first, InputIter last, const Compare& cmp, Container&& cont)
+            : c(learnSTL::move(cont)), comp(cmp)
+        {
+            for(; first != last; ++first)
+                c.push_back(*first);
+            __make_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+        }
+        priority_queue(std::initializer_list<value_type> initlist, const Compare& cmp = Compare())
+            : priority_queue(initlist.begin(), initlist.end(), cmp) {}
+
+        // access
+        const_reference top() const { return c.front(); }
+        bool empty() const { return c.empty(); }
+        size_type size() const { return c.size(); }
+
+        // modifiers
+        void push(const value_type& val){
+            c.push_back(val);
+            __push_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+        }
+        void push(value_type&& val){
+            c.push_back(learnSTL::move(val));
+            __push_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+        }
+        template<typename ...Args>
+            void emplace(Args&&... args){
+                c.emplace_back(learnSTL::forward<Args>(args)...);
+                __push_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+            }
+
+        void pop(){
+            __pop_heap<Arity, Compare&>(c.begin(), c.end(), comp);
+            c.pop_back();
+        }
+
+        // pops the top and pushes val in one sift: the top's hole takes val
+        // instead of the last element. The queue must not be empty.
+        void replace_top(value_type val){
+            __heap_sift_down<Arity, Compare&>(c.begin(), typename Container::difference_type(0),
+                                               typename Container::difference_type(c.size()), learnSTL::move(val), comp);
+        }
+
+        void swap(priority_queue& q){
+            c.swap(q.c);
+            learnSTL::swap(comp, q.comp);
+        }
+
+    protected:
+        Container c;
+        Compare   comp;
+    };
+
+    template<typename T, typename Container, typename Compare, std::size_t Arity>
+        const std::size_t priority_queue<T, Container, Compare, Arity>::arity;
+
+    template<typename T, typename Container, typename Compare, std::size_t Arity>
+        void swap(priority_queue<T, Container, Compare, Arity>& q1, priority_queue<T, Container, Compare, Arity>& q2){
+            q1.swap(q2);
+        }
+    ///~ ------------------------- end priority_queue ----------------------------
+}
+
+#endif
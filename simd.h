@@ -0,0 +1,931 @@
+#ifndef MY_SIMD_H
+#define MY_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// x86-64 always has SSE2, AVX2 kernels are compiled with a target
+// attribute and only called when the cpu reports it at runtime.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define MY_SIMD_X86 1
+#include <immintrin.h>
+#define MY_TARGET_AVX2 __attribute__((target("avx2")))
+#define MY_TARGET_FMA __attribute__((target("avx2,fma")))
+#endif
+
+namespace learnSTL{
+    ///: ------------------------- cpu features --------------------------------
+    inline bool __cpu_has_avx2(){
+#ifdef MY_SIMD_X86
+        static const bool has = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+        return has;
+#else
+        return false;
+#endif
+    }
+
+    // fma always comes with avx2 here, the sum kernels need both
+    inline bool __cpu_has_fma(){
+#ifdef MY_SIMD_X86
+        static const bool has = __cpu_has_avx2() && __builtin_cpu_supports("fma") != 0;
+        return has;
+#else
+        return false;
+#endif
+    }
+    ///~ ------------------------- end cpu features ----------------------------
+
+
+    ///: ------------------------- lanes --------------------------------
+    // the unsigned integer holding one element of S bytes
+    template<size_t S> struct __simd_uint;
+    template<> struct __simd_uint<1> { typedef uint8_t  type; };
+    template<> struct __simd_uint<2> { typedef uint16_t type; };
+    template<> struct __simd_uint<4> { typedef uint32_t type; };
+    template<> struct __simd_uint<8> { typedef uint64_t type; };
+
+    // integral types the compare kernels work on: equality is equality of bits
+    template<typename T>
+    struct __is_simd_integral
+        : std::integral_constant<bool, std::is_integral<T>::value &&
+                                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+    template<typename T> inline
+        typename __simd_uint<sizeof(T)>::type __simd_bits(const T& x)
+        {
+            typename __simd_uint<sizeof(T)>::type u;
+            std::memcpy(&u, &x, sizeof(T));
+            return u;
+        }
+
+    // element i of a buffer of S byte elements
+    template<size_t S> inline
+        typename __simd_uint<S>::type __simd_lane(const void* p, size_t i)
+        {
+            typename __simd_uint<S>::type u;
+            std::memcpy(&u, static_cast<const char*>(p) + i * S, S);
+            return u;
+        }
+
+    template<size_t S> struct __simd_int;
+    template<> struct __simd_int<1> { typedef int8_t  type; };
+    template<> struct __simd_int<2> { typedef int16_t type; };
+    template<> struct __simd_int<4> { typedef int32_t type; };
+    template<> struct __simd_int<8> { typedef int64_t type; };
+
+    // arithmetic types the min/max kernels work on, everything but bool and long double
+    template<typename T>
+    struct __is_simd_arithmetic
+        : std::integral_constant<bool, (__is_simd_integral<T>::value &&
+                                        !std::is_same<typename std::remove_cv<T>::type, bool>::value) ||
+                                       std::is_same<typename std::remove_cv<T>::type, float>::value ||
+                                       std::is_same<typename std::remove_cv<T>::type, double>::value> {};
+
+    // the fixed width type a kernel is instantiated for, so that char, long
+    // and long long share the kernels of int8_t and int64_t
+    template<typename T, bool = std::is_floating_point<T>::value>
+    struct __simd_arith_type{
+        typedef typename std::conditional<std::is_signed<T>::value, typename __simd_int<sizeof(T)>::type,
+                                          typename __simd_uint<sizeof(T)>::type>::type type;
+    };
+    template<typename T>
+    struct __simd_arith_type<T, true>{
+        typedef typename std::remove_cv<T>::type type;
+    };
+
+    template<typename T> inline
+        T __simd_load(const T* p)
+        {
+            T x;
+            std::memcpy(&x, p, sizeof(T));
+            return x;
+        }
+    ///~ ------------------------- end lanes ----------------------------
+
+
+#ifdef MY_SIMD_X86
+    ///: ------------------------- sse2 --------------------------------
+    typedef std::integral_constant<size_t, 1> __lane1;
+    typedef std::integral_constant<size_t, 2> __lane2;
+    typedef std::integral_constant<size_t, 4> __lane4;
+    typedef std::integral_constant<size_t, 8> __lane8;
+
+    inline __m128i __sse2_set1(uint8_t v)  { return _mm_set1_epi8(static_cast<char>(v)); }
+    inline __m128i __sse2_set1(uint16_t v) { return _mm_set1_epi16(static_cast<short>(v)); }
+    inline __m128i __sse2_set1(uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+    inline __m128i __sse2_set1(uint64_t v) { return _mm_set1_epi64x(static_cast<long long>(v)); }
+
+    inline __m128i __sse2_cmpeq(__m128i a, __m128i b, __lane1) { return _mm_cmpeq_epi8(a, b); }
+    inline __m128i __sse2_cmpeq(__m128i a, __m128i b, __lane2) { return _mm_cmpeq_epi16(a, b); }
+    inline __m128i __sse2_cmpeq(__m128i a, __m128i b, __lane4) { return _mm_cmpeq_epi32(a, b); }
+    // no 64 bit compare in sse2: both 32 bit halves have to match
+    inline __m128i __sse2_cmpeq(__m128i a, __m128i b, __lane8){
+        __m128i eq = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+
+    // one bit per byte, so a matching element of S bytes sets S bits
+    template<size_t S> inline
+        unsigned __sse2_eq_mask(const char* p, __m128i v)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            return static_cast<unsigned>(_mm_movemask_epi8(__sse2_cmpeq(x, v, std::integral_constant<size_t, S>())));
+        }
+
+    template<size_t S> inline
+        unsigned __sse2_eq_mask(const char* p, const char* q)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+            return static_cast<unsigned>(_mm_movemask_epi8(__sse2_cmpeq(x, y, std::integral_constant<size_t, S>())));
+        }
+
+    template<size_t S> inline
+        size_t __find_sse2(const char* p, size_t n, typename __simd_uint<S>::type val)
+        {
+            const size_t W = 16 / S;
+            __m128i v = __sse2_set1(val);
+            size_t i = 0;
+            for(; i + W <= n; i += W){
+                unsigned m = __sse2_eq_mask<S>(p + i * S, v);
+                if(m)
+                    return i + __builtin_ctz(m) / S;
+            }
+            for(; i != n; ++i)
+                if(__simd_lane<S>(p, i) == val)
+                    break;
+            return i;
+        }
+
+    template<size_t S> inline
+        size_t __count_sse2(const char* p, size_t n, typename __simd_uint<S>::type val)
+        {
+            const size_t W = 16 / S;
+            __m128i v = __sse2_set1(val);
+            size_t cn = 0, i = 0;
+            for(; i + W <= n; i += W)
+                cn += __builtin_popcount(__sse2_eq_mask<S>(p + i * S, v));
+            cn /= S;
+            for(; i != n; ++i)
+                cn += __simd_lane<S>(p, i) == val;
+            return cn;
+        }
+
+    template<size_t S> inline
+        size_t __mismatch_sse2(const char* p, const char* q, size_t n)
+        {
+            const size_t W = 16 / S;
+            size_t i = 0;
+            for(; i + W <= n; i += W){
+                unsigned m = __sse2_eq_mask<S>(p + i * S, q + i * S) ^ 0xFFFFu;
+                if(m)
+                    return i + __builtin_ctz(m) / S;
+            }
+            for(; i != n; ++i)
+                if(__simd_lane<S>(p, i) != __simd_lane<S>(q, i))
+                    break;
+            return i;
+        }
+
+    // first i with p[i] == p[i + 1], or n
+    template<size_t S> inline
+        size_t __adjacent_find_sse2(const char* p, size_t n)
+        {
+            const size_t W = 16 / S;
+            size_t i = 0;
+            for(; i + W + 1 <= n; i += W){
+                unsigned m = __sse2_eq_mask<S>(p + i * S, p + (i + 1) * S);
+                if(m)
+                    return i + __builtin_ctz(m) / S;
+            }
+            for(; i + 1 < n; ++i)
+                if(__simd_lane<S>(p, i) == __simd_lane<S>(p, i + 1))
+                    return i;
+            return n;
+        }
+    ///~ ------------------------- end sse2 ----------------------------
+
+
+    ///: ------------------------- avx2 --------------------------------
+    MY_TARGET_AVX2 inline __m256i __avx2_set1(uint8_t v)  { return _mm256_set1_epi8(static_cast<char>(v)); }
+    MY_TARGET_AVX2 inline __m256i __avx2_set1(uint16_t v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+    MY_TARGET_AVX2 inline __m256i __avx2_set1(uint32_t v) { return _mm256_set1_epi32(static_cast<int>(v)); }
+    MY_TARGET_AVX2 inline __m256i __avx2_set1(uint64_t v) { return _mm256_set1_epi64x(static_cast<long long>(v)); }
+
+    MY_TARGET_AVX2 inline __m256i __avx2_cmpeq(__m256i a, __m256i b, __lane1) { return _mm256_cmpeq_epi8(a, b); }
+    MY_TARGET_AVX2 inline __m256i __avx2_cmpeq(__m256i a, __m256i b, __lane2) { return _mm256_cmpeq_epi16(a, b); }
+    MY_TARGET_AVX2 inline __m256i __avx2_cmpeq(__m256i a, __m256i b, __lane4) { return _mm256_cmpeq_epi32(a, b); }
+    MY_TARGET_AVX2 inline __m256i __avx2_cmpeq(__m256i a, __m256i b, __lane8) { return _mm256_cmpeq_epi64(a, b); }
+
+    template<size_t S> MY_TARGET_AVX2 inline
+        unsigned __avx2_eq_mask(const char* p, __m256i v)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            return static_cast<unsigned>(_mm256_movemask_epi8(__avx2_cmpeq(x, v, std::integral_constant<size_t, S>())));
+        }
+
+    template<size_t S> MY_TARGET_AVX2 inline
+        unsigned __avx2_eq_mask(const char* p, const char* q)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(q));
+            return static_cast<unsigned>(_mm256_movemask_epi8(__avx2_cmpeq(x, y, std::integral_constant<size_t, S>())));
+        }
+
+    template<size_t S> MY_TARGET_AVX2
+        size_t __find_avx2(const char* p, size_t n, typename __simd_uint<S>::type val)
+        {
+            const size_t W = 32 / S;
+            __m256i v = __avx2_set1(val);
+            size_t i = 0;
+            // two vectors a round, a hit is looked up after the loop
+            for(; i + 2 * W <= n; i += 2 * W){
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i * S));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + (i + W) * S));
+                __m256i eq = _mm256_or_si256(__avx2_cmpeq(x, v, std::integral_constant<size_t, S>()),
+                                             __avx2_cmpeq(y, v, std::integral_constant<size_t, S>()));
+                if(_mm256_movemask_epi8(eq))
+                    break;
+            }
+            for(; i + W <= n; i += W){
+                unsigned m = __avx2_eq_mask<S>(p + i * S, v);
+                if(m)
+                    return i + __builtin_ctz(m) / S;
+            }
+            for(; i != n; ++i)
+                if(__simd_lane<S>(p, i) == val)
+                    break;
+            return i;
+        }
+
+    template<size_t S> MY_TARGET_AVX2
+        size_t __count_avx2(const char* p, size_t n, typename __simd_uint<S>::type val)
+        {
+            const size_t W = 32 / S;
+            __m256i v = __avx2_set1(val);
+            size_t cn = 0, i = 0;
+            for(; i + W <= n; i += W)
+                cn += __builtin_popcount(__avx2_eq_mask<S>(p + i * S, v));
+            cn /= S;
+            for(; i != n; ++i)
+                cn += __simd_lane<S>(p, i) == val;
+            return cn;
+        }
+
+    template<size_t S> MY_TARGET_AVX2
+        size_t __mismatch_avx2(const char* p, const char* q, size_t n)
+        {
+            const size_t W = 32 / S;
+            size_t i = 0;
+            for(; i + W <= n; i += W){
+                unsigned m = ~__avx2_eq_mask<S>(p + i * S, q + i * S);
+                if(m)
+                    return i + __builtin_ctz(m) / S;
+            }
+            for(; i != n; ++i)
+                if(__simd_lane<S>(p, i) != __simd_lane<S>(q, i))
+                    break;
+            return i;
+        }
+
+    template<size_t S> MY_TARGET_AVX2
+        size_t __adjacent_find_avx2(const char* p, size_t n)
+        {
+            const size_t W = 32 / S;
+            size_t i = 0;
+            for(; i + W + 1 <= n; i += W){
+                unsigned m = __avx2_eq_mask<S>(p + i * S, p + (i + 1) * S);
+                if(m)
+                    return i + __builtin_ctz(m) / S;
+            }
+            for(; i + 1 < n; ++i)
+                if(__simd_lane<S>(p, i) == __simd_lane<S>(p, i + 1))
+                    return i;
+            return n;
+        }
+    ///~ ------------------------- end avx2 ----------------------------
+
+    ///: ------------------------- avx2 min/max --------------------------------
+    // per type operations of the min/max kernels, eq returns all ones in the
+    // bytes of matching lanes and nan the lanes that compare unordered.
+    template<typename N> struct __avx2_ops;
+
+    template<typename N>
+    struct __avx2_int_ops{
+        typedef __m256i vec;
+        static MY_TARGET_AVX2 vec load(const N* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static MY_TARGET_AVX2 void store(N* p, vec x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+        static MY_TARGET_AVX2 vec set1(N x) { return __avx2_set1(static_cast<typename __simd_uint<sizeof(N)>::type>(x)); }
+        static MY_TARGET_AVX2 __m256i eq(vec a, vec b) { return __avx2_cmpeq(a, b, std::integral_constant<size_t, sizeof(N)>()); }
+        static MY_TARGET_AVX2 __m256i nan(vec) { return _mm256_setzero_si256(); }
+    };
+
+    template<> struct __avx2_ops<int8_t> : __avx2_int_ops<int8_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_epi8(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_epi8(a, b); }
+    };
+    template<> struct __avx2_ops<uint8_t> : __avx2_int_ops<uint8_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_epu8(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_epu8(a, b); }
+    };
+    template<> struct __avx2_ops<int16_t> : __avx2_int_ops<int16_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_epi16(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+    };
+    template<> struct __avx2_ops<uint16_t> : __avx2_int_ops<uint16_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_epu16(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_epu16(a, b); }
+    };
+    template<> struct __avx2_ops<int32_t> : __avx2_int_ops<int32_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+    };
+    template<> struct __avx2_ops<uint32_t> : __avx2_int_ops<uint32_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_epu32(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_epu32(a, b); }
+    };
+    // no 64 bit min/max before avx512: compare and blend
+    template<> struct __avx2_ops<int64_t> : __avx2_int_ops<int64_t>{
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    };
+    // unsigned compare is a signed compare with the sign bits flipped
+    template<> struct __avx2_ops<uint64_t> : __avx2_int_ops<uint64_t>{
+        static MY_TARGET_AVX2 vec __gt(vec a, vec b){
+            const vec sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+            return _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(b, sign));
+        }
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_blendv_epi8(a, b, __gt(a, b)); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_blendv_epi8(b, a, __gt(a, b)); }
+    };
+
+    template<> struct __avx2_ops<float>{
+        typedef __m256 vec;
+        static MY_TARGET_AVX2 vec load(const float* p) { return _mm256_loadu_ps(p); }
+        static MY_TARGET_AVX2 void store(float* p, vec x) { _mm256_storeu_ps(p, x); }
+        static MY_TARGET_AVX2 vec set1(float x) { return _mm256_set1_ps(x); }
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+        static MY_TARGET_AVX2 __m256i eq(vec a, vec b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+        static MY_TARGET_AVX2 __m256i nan(vec a) { return _mm256_castps_si256(_mm256_cmp_ps(a, a, _CMP_UNORD_Q)); }
+    };
+    template<> struct __avx2_ops<double>{
+        typedef __m256d vec;
+        static MY_TARGET_AVX2 vec load(const double* p) { return _mm256_loadu_pd(p); }
+        static MY_TARGET_AVX2 void store(double* p, vec x) { _mm256_storeu_pd(p, x); }
+        static MY_TARGET_AVX2 vec set1(double x) { return _mm256_set1_pd(x); }
+        static MY_TARGET_AVX2 vec min(vec a, vec b) { return _mm256_min_pd(a, b); }
+        static MY_TARGET_AVX2 vec max(vec a, vec b) { return _mm256_max_pd(a, b); }
+        static MY_TARGET_AVX2 __m256i eq(vec a, vec b) { return _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+        static MY_TARGET_AVX2 __m256i nan(vec a) { return _mm256_castpd_si256(_mm256_cmp_pd(a, a, _CMP_UNORD_Q)); }
+    };
+
+    // smallest and largest of p[0, n), n > 0. false if a NaN was seen,
+    // the vector min/max and operator< disagree about those.
+    template<typename N> MY_TARGET_AVX2
+        bool __minmax_avx2(const N* p, size_t n, N& mn, N& mx)
+        {
+            typedef __avx2_ops<N> ops;
+            typedef typename ops::vec vec;
+            const size_t W = 32 / sizeof(N);
+            size_t i = 0;
+            mn = mx = __simd_load(p);
+            if(n >= 2 * W){
+                vec min0 = ops::load(p), min1 = ops::load(p + W);
+                vec max0 = min0, max1 = min1;
+                __m256i nan = _mm256_or_si256(ops::nan(min0), ops::nan(min1));
+                for(i = 2 * W; i + 2 * W <= n; i += 2 * W){
+                    vec x0 = ops::load(p + i), x1 = ops::load(p + i + W);
+                    min0 = ops::min(min0, x0);
+                    min1 = ops::min(min1, x1);
+                    max0 = ops::max(max0, x0);
+                    max1 = ops::max(max1, x1);
+                    nan = _mm256_or_si256(nan, _mm256_or_si256(ops::nan(x0), ops::nan(x1)));
+                }
+                if(!_mm256_testz_si256(nan, nan))
+                    return false;
+                N lanes[2][32 / sizeof(N)];
+                ops::store(lanes[0], ops::min(min0, min1));
+                ops::store(lanes[1], ops::max(max0, max1));
+                mn = lanes[0][0];
+                mx = lanes[1][0];
+                for(size_t j = 1; j != W; ++j){
+                    if(lanes[0][j] < mn)
+                        mn = lanes[0][j];
+                    if(mx < lanes[1][j])
+                        mx = lanes[1][j];
+                }
+            }
+            for(; i != n; ++i){
+                N x = __simd_load(p + i);
+                if(x != x)
+                    return false;
+                if(x < mn)
+                    mn = x;
+                if(mx < x)
+                    mx = x;
+            }
+            return true;
+        }
+
+    // first (or last) i with p[i] == val, n if there is none
+    template<typename N, bool Last> MY_TARGET_AVX2
+        size_t __find_equal_avx2(const N* p, size_t n, N val)
+        {
+            typedef __avx2_ops<N> ops;
+            const size_t W = 32 / sizeof(N);
+            typename ops::vec v = ops::set1(val);
+            if(!Last){
+                size_t i = 0;
+                for(; i + W <= n; i += W){
+                    unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(ops::eq(ops::load(p + i), v)));
+                    if(m)
+                        return i + __builtin_ctz(m) / sizeof(N);
+                }
+                for(; i != n; ++i)
+                    if(__simd_load(p + i) == val)
+                        return i;
+                return n;
+            }
+            size_t i = n;
+            for(; i >= W; i -= W){
+                unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(ops::eq(ops::load(p + i - W), v)));
+                if(m)
+                    return i - W + (31 - __builtin_clz(m)) / sizeof(N);
+            }
+            while(i != 0)
+                if(__simd_load(p + --i) == val)
+                    return i;
+            return n;
+        }
+    // first i with t < p[i] (with Less, p[i] < t), n if there is none. A
+    // lane is past t when max(x, t) (min(x, t)) is not t, which needs no
+    // greater-than per type and leaves NaN lanes out, as operator< does.
+    template<typename N, bool Less> MY_TARGET_AVX2
+        size_t __find_beyond_avx2(const N* p, size_t n, N t)
+        {
+            typedef __avx2_ops<N> ops;
+            typedef typename ops::vec vec;
+            const size_t W = 32 / sizeof(N);
+            const vec v = ops::set1(t);
+            size_t i = 0;
+            for(; i + 2 * W <= n; i += 2 * W){
+                vec x = ops::load(p + i), y = ops::load(p + i + W);
+                __m256i kept = _mm256_and_si256(ops::eq(Less ? ops::min(x, v) : ops::max(x, v), v),
+                                                ops::eq(Less ? ops::min(y, v) : ops::max(y, v), v));
+                if(_mm256_movemask_epi8(kept) != -1)
+                    break;
+            }
+            for(; i + W <= n; i += W){
+                vec x = ops::load(p + i);
+                unsigned m = ~static_cast<unsigned>(_mm256_movemask_epi8(ops::eq(Less ? ops::min(x, v) : ops::max(x, v), v)));
+                if(m)
+                    return i + __builtin_ctz(m) / sizeof(N);
+            }
+            for(; i != n; ++i){
+                N x = __simd_load(p + i);
+                if(Less ? x < t : t < x)
+                    return i;
+            }
+            return n;
+        }
+    ///~ ------------------------- end avx2 min/max ----------------------------
+
+    ///: ------------------------- avx2 sum --------------------------------
+    // per type operations of the sum kernels, fma(a, b, c) is a * b + c
+    template<typename N> struct __fma_ops;
+
+    template<> struct __fma_ops<float>{
+        typedef __m256 vec;
+        static MY_TARGET_FMA vec zero() { return _mm256_setzero_ps(); }
+        static MY_TARGET_FMA vec load(const float* p) { return _mm256_loadu_ps(p); }
+        static MY_TARGET_FMA void store(float* p, vec x) { _mm256_storeu_ps(p, x); }
+        static MY_TARGET_FMA vec add(vec a, vec b) { return _mm256_add_ps(a, b); }
+        static MY_TARGET_FMA vec sub(vec a, vec b) { return _mm256_sub_ps(a, b); }
+        static MY_TARGET_FMA vec fma(vec a, vec b, vec c) { return _mm256_fmadd_ps(a, b, c); }
+        static MY_TARGET_FMA vec fms(vec a, vec b, vec c) { return _mm256_fmsub_ps(a, b, c); }
+    };
+    template<> struct __fma_ops<double>{
+        typedef __m256d vec;
+        static MY_TARGET_FMA vec zero() { return _mm256_setzero_pd(); }
+        static MY_TARGET_FMA vec load(const double* p) { return _mm256_loadu_pd(p); }
+        static MY_TARGET_FMA void store(double* p, vec x) { _mm256_storeu_pd(p, x); }
+        static MY_TARGET_FMA vec add(vec a, vec b) { return _mm256_add_pd(a, b); }
+        static MY_TARGET_FMA vec sub(vec a, vec b) { return _mm256_sub_pd(a, b); }
+        static MY_TARGET_FMA vec fma(vec a, vec b, vec c) { return _mm256_fmadd_pd(a, b, c); }
+        static MY_TARGET_FMA vec fms(vec a, vec b, vec c) { return _mm256_fmsub_pd(a, b, c); }
+    };
+
+    template<typename N>
+    struct __fma_int_ops{
+        typedef __m256i vec;
+        static MY_TARGET_FMA vec zero() { return _mm256_setzero_si256(); }
+        static MY_TARGET_FMA vec load(const N* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        static MY_TARGET_FMA void store(N* p, vec x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+    };
+    // 32 bit integers wrap around, so signed and unsigned lanes add the same
+    template<> struct __fma_ops<int32_t> : __fma_int_ops<int32_t>{
+        static MY_TARGET_FMA vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+        static MY_TARGET_FMA vec fma(vec a, vec b, vec c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+    };
+    template<> struct __fma_ops<uint32_t> : __fma_int_ops<uint32_t>{
+        static MY_TARGET_FMA vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+        static MY_TARGET_FMA vec fma(vec a, vec b, vec c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+    };
+
+    // the lanes of x added as a balanced tree
+    template<typename N> MY_TARGET_FMA
+        N __fma_hsum(typename __fma_ops<N>::vec x)
+        {
+            const size_t W = 32 / sizeof(N);
+            N lanes[W];
+            __fma_ops<N>::store(lanes, x);
+            for(size_t w = W / 2; w != 0; w /= 2)
+                for(size_t j = 0; j != w; ++j)
+                    lanes[j] = lanes[j] + lanes[j + w];
+            return lanes[0];
+        }
+
+    // sum of p[0, n) (of p[i] * q[i] with Dot) in four independent
+    // vector accumulators, so that the adds do not wait on each other
+    template<typename N, bool Dot> MY_TARGET_FMA
+        N __sum_fma(const N* p, const N* q, size_t n)
+        {
+            typedef __fma_ops<N> ops;
+            typedef typename ops::vec vec;
+            const size_t W = 32 / sizeof(N);
+            vec a0 = ops::zero(), a1 = ops::zero(), a2 = ops::zero(), a3 = ops::zero();
+            size_t i = 0;
+            for(; i + 4 * W <= n; i += 4 * W){
+                if(Dot){
+                    a0 = ops::fma(ops::load(p + i), ops::load(q + i), a0);
+                    a1 = ops::fma(ops::load(p + i + W), ops::load(q + i + W), a1);
+                    a2 = ops::fma(ops::load(p + i + 2 * W), ops::load(q + i + 2 * W), a2);
+                    a3 = ops::fma(ops::load(p + i + 3 * W), ops::load(q + i + 3 * W), a3);
+                }
+                else{
+                    a0 = ops::add(a0, ops::load(p + i));
+                    a1 = ops::add(a1, ops::load(p + i + W));
+                    a2 = ops::add(a2, ops::load(p + i + 2 * W));
+                    a3 = ops::add(a3, ops::load(p + i + 3 * W));
+                }
+            }
+            for(; i + W <= n; i += W)
+                a0 = Dot ? ops::fma(ops::load(p + i), ops::load(q + i), a0) : ops::add(a0, ops::load(p + i));
+            N sum = __fma_hsum<N>(ops::add(ops::add(a0, a1), ops::add(a2, a3)));
+            N tail = N();
+            for(; i != n; ++i)
+                tail = Dot ? tail + p[i] * q[i] : tail + p[i];
+            return sum + tail;
+        }
+
+    // compensated sum of p[0, n) (of p[i] * q[i] with Dot), each lane runs
+    // its own Kahan sum, then the lanes and their lost low parts are folded
+    // into the running sum s and compensation c.
+    template<typename N, bool Dot> MY_TARGET_FMA
+        void __kahan_fma(const N* p, const N* q, size_t n, N& s, N& c)
+        {
+            typedef __fma_ops<N> ops;
+            typedef typename ops::vec vec;
+            const size_t W = 32 / sizeof(N);
+            vec s0 = ops::zero(), c0 = ops::zero(), s1 = ops::zero(), c1 = ops::zero();
+            size_t i = 0;
+            for(; i + 2 * W <= n; i += 2 * W){
+                // y = x - c, and with Dot the product is rounded once, together with it
+                vec y0 = Dot ? ops::fms(ops::load(p + i), ops::load(q + i), c0) : ops::sub(ops::load(p + i), c0);
+                vec y1 = Dot ? ops::fms(ops::load(p + i + W), ops::load(q + i + W), c1) : ops::sub(ops::load(p + i + W), c1);
+                vec t0 = ops::add(s0, y0);
+                vec t1 = ops::add(s1, y1);
+                c0 = ops::sub(ops::sub(t0, s0), y0);
+                c1 = ops::sub(ops::sub(t1, s1), y1);
+                s0 = t0;
+                s1 = t1;
+            }
+            N lanes[4][W];
+            ops::store(lanes[0], s0);
+            ops::store(lanes[1], s1);
+            ops::store(lanes[2], c0);
+            ops::store(lanes[3], c1);
+            for(size_t j = 0; j != W; ++j){
+                N terms[4] = {lanes[0][j], lanes[1][j], -lanes[2][j], -lanes[3][j]};
+                for(size_t k = 0; k != 4; ++k){
+                    N y = terms[k] - c;
+                    N t = s + y;
+                    c = (t - s) - y;
+                    s = t;
+                }
+            }
+            for(; i != n; ++i){
+                N y = (Dot ? p[i] * q[i] : p[i]) - c;
+                N t = s + y;
+                c = (t - s) - y;
+                s = t;
+            }
+        }
+    ///~ ------------------------- end avx2 sum ----------------------------
+
+    ///: ------------------------- avx2 scan --------------------------------
+    // prefix sums inside a register: shift and add within each 128 bit half,
+    // then the low half's total goes into the high half. Lanes stay in
+    // __m256i, only add and sub know the element type.
+    template<typename N> struct __scan_ops;
+
+    template<> struct __scan_ops<int32_t>{
+        static MY_TARGET_AVX2 __m256i add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+        static MY_TARGET_AVX2 __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+    };
+    template<> struct __scan_ops<uint32_t> : __scan_ops<int32_t> {};
+    template<> struct __scan_ops<int64_t>{
+        static MY_TARGET_AVX2 __m256i add(__m256i a, __m256i b) { return _mm256_add_epi64(a, b); }
+        static MY_TARGET_AVX2 __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi64(a, b); }
+    };
+    template<> struct __scan_ops<uint64_t> : __scan_ops<int64_t> {};
+    template<> struct __scan_ops<float>{
+        static MY_TARGET_AVX2 __m256i add(__m256i a, __m256i b)
+        { return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+        static MY_TARGET_AVX2 __m256i sub(__m256i a, __m256i b)
+        { return _mm256_castps_si256(_mm256_sub_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+    };
+    template<> struct __scan_ops<double>{
+        static MY_TARGET_AVX2 __m256i add(__m256i a, __m256i b)
+        { return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+        static MY_TARGET_AVX2 __m256i sub(__m256i a, __m256i b)
+        { return _mm256_castpd_si256(_mm256_sub_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b))); }
+    };
+
+    template<typename N> MY_TARGET_AVX2
+        __m256i __avx2_prefix(__m256i x, __lane4)
+        {
+            x = __scan_ops<N>::add(x, _mm256_slli_si256(x, 4));
+            x = __scan_ops<N>::add(x, _mm256_slli_si256(x, 8));
+            __m256i t = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+            return __scan_ops<N>::add(x, _mm256_permute2x128_si256(t, t, 0x08));
+        }
+    template<typename N> MY_TARGET_AVX2
+        __m256i __avx2_prefix(__m256i x, __lane8)
+        {
+            x = __scan_ops<N>::add(x, _mm256_slli_si256(x, 8));
+            __m256i t = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2));
+            return __scan_ops<N>::add(x, _mm256_permute2x128_si256(t, t, 0x08));
+        }
+
+    // every lane set to the last one
+    MY_TARGET_AVX2 inline __m256i __avx2_broadcast_last(__m256i x, __lane4)
+    { return _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(7)); }
+    MY_TARGET_AVX2 inline __m256i __avx2_broadcast_last(__m256i x, __lane8)
+    { return _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+
+    // lanes moved up by one, zero shifted in
+    MY_TARGET_AVX2 inline __m256i __avx2_shift_up(__m256i x, __lane4)
+    {
+        __m256i r = _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+        return _mm256_blend_epi32(r, _mm256_setzero_si256(), 0x01);
+    }
+    MY_TARGET_AVX2 inline __m256i __avx2_shift_up(__m256i x, __lane8)
+    {
+        __m256i r = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 3));
+        return _mm256_blend_epi32(r, _mm256_setzero_si256(), 0x03);
+    }
+
+    // out[i] = carry + in[0] + ... + in[i] (+ in[i - 1] with Exclusive),
+    // returns carry plus the whole sum. out may be in.
+    template<typename N, bool Exclusive> MY_TARGET_AVX2
+        N __scan_avx2(const N* in, N* out, size_t n, N carry)
+        {
+            typedef std::integral_constant<size_t, sizeof(N)> lane;
+            const size_t W = 32 / sizeof(N);
+            N lanes[W];
+            for(size_t j = 0; j != W; ++j)
+                lanes[j] = carry;
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+            size_t i = 0;
+            for(; i + W <= n; i += W){
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                __m256i p = __avx2_prefix<N>(x, lane());
+                __m256i r = __scan_ops<N>::add(c, Exclusive ? __avx2_shift_up(p, lane()) : p);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+                c = __scan_ops<N>::add(c, __avx2_broadcast_last(p, lane()));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), c);
+            carry = lanes[0];
+            for(; i != n; ++i){
+                N x = in[i];
+                if(Exclusive)
+                    out[i] = carry;
+                carry = carry + x;
+                if(!Exclusive)
+                    out[i] = carry;
+            }
+            return carry;
+        }
+
+    // out[0] = in[0], out[i] = in[i] - in[i - 1]. Runs from the back, so
+    // that out may be in.
+    template<typename N> MY_TARGET_AVX2
+        void __adjacent_difference_avx2(const N* in, N* out, size_t n)
+        {
+            const size_t W = 32 / sizeof(N);
+            size_t i = n;
+            for(; i >= W + 1; i -= W){
+                __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i - W));
+                __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i - W - 1));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i - W), __scan_ops<N>::sub(x, y));
+            }
+            for(; i > 1; --i)
+                out[i - 1] = in[i - 1] - in[i - 2];
+            if(n != 0)
+                out[0] = in[0];
+        }
+    ///~ ------------------------- end avx2 scan ----------------------------
+#endif
+
+
+    ///: ------------------------- dispatch --------------------------------
+    // the widest kernel the cpu runs, a plain loop off x86
+    template<size_t S> inline
+        size_t __simd_find(const void* p, size_t n, typename __simd_uint<S>::type val)
+        {
+#ifdef MY_SIMD_X86
+            if(__cpu_has_avx2())
+                return __find_avx2<S>(static_cast<const char*>(p), n, val);
+            return __find_sse2<S>(static_cast<const char*>(p), n, val);
+#else
+            size_t i = 0;
+            for(; i != n; ++i)
+                if(__simd_lane<S>(p, i) == val)
+                    break;
+            return i;
+#endif
+        }
+
+    template<size_t S> inline
+        size_t __simd_count(const void* p, size_t n, typename __simd_uint<S>::type val)
+        {
+#ifdef MY_SIMD_X86
+            if(__cpu_has_avx2())
+                return __count_avx2<S>(static_cast<const char*>(p), n, val);
+            return __count_sse2<S>(static_cast<const char*>(p), n, val);
+#else
+            size_t cn = 0;
+            for(size_t i = 0; i != n; ++i)
+                cn += __simd_lane<S>(p, i) == val;
+            return cn;
+#endif
+        }
+
+    template<size_t S> inline
+        size_t __simd_mismatch(const void* p, const void* q, size_t n)
+        {
+#ifdef MY_SIMD_X86
+            if(__cpu_has_avx2())
+                return __mismatch_avx2<S>(static_cast<const char*>(p), static_cast<const char*>(q), n);
+            return __mismatch_sse2<S>(static_cast<const char*>(p), static_cast<const char*>(q), n);
+#else
+            size_t i = 0;
+            for(; i != n; ++i)
+                if(__simd_lane<S>(p, i) != __simd_lane<S>(q, i))
+                    break;
+            return i;
+#endif
+        }
+
+    template<size_t S> inline
+        size_t __simd_adjacent_find(const void* p, size_t n)
+        {
+#ifdef MY_SIMD_X86
+            if(__cpu_has_avx2())
+                return __adjacent_find_avx2<S>(static_cast<const char*>(p), n);
+            return __adjacent_find_sse2<S>(static_cast<const char*>(p), n);
+#else
+            for(size_t i = 0; i + 1 < n; ++i)
+                if(__simd_lane<S>(p, i) == __simd_lane<S>(p, i + 1))
+                    return i;
+            return n;
+#endif
+        }
+
+    // index of the first minimum and of the first (or, with LastMax, the
+    // last) maximum of p[0, n), n > 0. The range is reduced block by block
+    // while it is in cache, and a block is searched for the index only when
+    // it beats the best value so far. false if there is no kernel for the
+    // cpu or the range holds a NaN, then the caller falls back to the loop.
+    template<typename N, bool WantMin, bool WantMax, bool LastMax> inline
+        bool __simd_minmax_element(const N* p, size_t n, size_t& imin, size_t& imax)
+        {
+#ifdef MY_SIMD_X86
+            if(!__cpu_has_avx2())
+                return false;
+            const size_t block = 8192 / sizeof(N);
+            N best_min = N(), best_max = N();
+            for(size_t b = 0; b < n; b += block){
+                size_t len = n - b < block ? n - b : block;
+                N mn, mx;
+                if(!__minmax_avx2(p + b, len, mn, mx))
+                    return false;
+                if(WantMin && (b == 0 || mn < best_min)){
+                    best_min = mn;
+                    imin = b + __find_equal_avx2<N, false>(p + b, len, mn);
+                }
+                if(WantMax && (b == 0 || best_max < mx || (LastMax && !(mx < best_max)))){
+                    best_max = mx;
+                    imax = b + __find_equal_avx2<N, LastMax>(p + b, len, mx);
+                }
+            }
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    // types with a sum kernel: the element type is also the type summed in
+    template<typename N>
+    struct __has_simd_sum
+        : std::integral_constant<bool, std::is_same<N, float>::value || std::is_same<N, double>::value ||
+                                       std::is_same<N, int32_t>::value || std::is_same<N, uint32_t>::value> {};
+
+    // sum of p[0, n), or of p[i] * q[i] when q is given. false if there is
+    // no kernel for the cpu, the caller then sums with a plain loop.
+    template<typename N> inline
+        bool __simd_sum(const N* p, const N* q, size_t n, N& sum)
+        {
+#ifdef MY_SIMD_X86
+            if(!__cpu_has_fma())
+                return false;
+            sum = q ? __sum_fma<N, true>(p, q, n) : __sum_fma<N, false>(p, q, n);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    // Kahan sum of p[0, n) (or of p[i] * q[i]) into s and c, float and double
+    template<typename N> inline
+        bool __simd_kahan(const N* p, const N* q, size_t n, N& s, N& c)
+        {
+#ifdef MY_SIMD_X86
+            if(!__cpu_has_fma())
+                return false;
+            if(q)
+                __kahan_fma<N, true>(p, q, n, s, c);
+            else
+                __kahan_fma<N, false>(p, q, n, s, c);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    // types with a scan kernel
+    template<typename N>
+    struct __has_simd_scan
+        : std::integral_constant<bool, std::is_same<N, float>::value || std::is_same<N, double>::value ||
+                                       std::is_same<N, int32_t>::value || std::is_same<N, uint32_t>::value ||
+                                       std::is_same<N, int64_t>::value || std::is_same<N, uint64_t>::value> {};
+
+    // inclusive (or exclusive) prefix sums of in[0, n) from carry into out,
+    // the total goes back to carry. false if there is no kernel for the cpu.
+    template<typename N, bool Exclusive> inline
+        bool __simd_scan(const N* in, N* out, size_t n, N& carry)
+        {
+#ifdef MY_SIMD_X86
+            if(!__cpu_has_avx2())
+                return false;
+            carry = __scan_avx2<N, Exclusive>(in, out, n, carry);
+            return true;
+#else
+            return false;
+#endif
+        }
+
+    template<typename N> inline
+        bool __simd_adjacent_difference(const N* in, N* out, size_t n)
+        {
+#ifdef MY_SIMD_X86
+            if(!__cpu_has_avx2())
+                return false;
+            __adjacent_difference_avx2(in, out, n);
+            return true;
+#else
+            return false;
+#endif
+        }
+    // index of the first element of p[0, n) past the threshold t: greater
+    // than t, or with Less smaller. false if there is no kernel for the cpu.
+    template<typename N, bool Less> inline
+        bool __simd_find_beyond(const N* p, size_t n, N t, size_t& i)
+        {
+#ifdef MY_SIMD_X86
+            if(!__cpu_has_avx2())
+                return false;
+            i = __find_beyond_avx2<N, Less>(p, n, t);
+            return true;
+#else
+            return false;
+#endif
+        }
+    ///~ ------------------------- end dispatch ----------------------------
+}
+
+#endif
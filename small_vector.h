@@ -0,0 +1,227 @@
+#ifndef MY_SMALL_VECTOR_H
+#define MY_SMALL_VECTOR_H
+
+#include <cstddef>
+#include <memory>
+#include <initializer_list>
+#include <type_traits>
+#include "iterator.h"
+#include "vector.h"
+
+namespace learnSTL{
+    ///: ------------------------- small buffer --------------------------------
+    // inline storage of a small_vector, handed out by __small_allocator
+    template<typename T, std::size_t N>
+    struct __small_buffer{
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type __data[N];
+        bool __used;
+
+        __small_buffer() : __used(false) {}
+        __small_buffer(const __small_buffer&) : __used(false) {}
+        __small_buffer& operator=(const __small_buffer&) { return *this; }
+
+        T* __ptr() { return reinterpret_cast<T*>(__data); }
+        const T* __ptr() const { return reinterpret_cast<const T*>(__data); }
+    };
+
+    // serves a request of at most N elements from the inline buffer when it is
+    // free, everything else from Allocator. vector's growth path copies this
+    // allocator into its temporaries, so they all see the same buffer.
+    template<typename T, std::size_t N, typename Allocator>
+    class __small_allocator{
+    private:
+        typedef std::allocator_traits<Allocator>  __heap_traits;
+    public:
+        typedef T                                 value_type;
+        typedef T*                                pointer;
+        typedef const T*                          const_pointer;
+        typedef std::size_t                       size_type;
+        typedef std::ptrdiff_t                    difference_type;
+        // the buffer belongs to one container, never hand it to another one
+        typedef std::false_type                   propagate_on_container_copy_assignment;
+        typedef std::false_type                   propagate_on_container_move_assignment;
+        typedef std::false_type                   propagate_on_container_swap;
+
+        __small_allocator(__small_buffer<T, N>* buf, const Allocator& a) : __buf(buf), __heap(a) {}
+
+        pointer allocate(size_type n){
+            if (n <= N && !__buf->__used){
+                __buf->__used = true;
+                return __buf->__ptr();
+            }
+            return __heap_traits::allocate(__heap, n);
+        }
+        void deallocate(pointer p, size_type n){
+            if (p == __buf->__ptr())
+                __buf->__used = false;
+            else
+                __heap_traits::deallocate(__heap, p, n);
+        }
+        size_type max_size() const{
+            return __heap_traits::max_size(__heap);
+        }
+
+        const Allocator& __heap_allocator() const { return __heap; }
+
+        friend bool operator==(const __small_allocator& a1, const __small_allocator& a2){
+            return a1.__buf == a2.__buf && a1.__heap == a2.__heap;
+        }
+        friend bool operator!=(const __small_allocator& a1, const __small_allocator& a2){
+            return !(a1 == a2);
+        }
+    private:
+        __small_buffer<T, N>*   __buf;
+        Allocator               __heap;
+    };
+    ///~ ------------------------- end small buffer ----------------------------
+
+
+    ///: ------------------------- small_vector --------------------------------
+    // a vector whose first N elements live inside the object. All the element
+    // handling is vector's own, only the storage comes from __small_allocator,
+    // so a small_vector allocates nothing until it outgrows N.
+    // __small_buffer is the first base, it is alive before vector allocates.
+    template<typename T, std::size_t N, typename Allocator = std::allocator<T> >
+    class small_vector : private __small_buffer<T, N>,
+                         public vector<T, __small_allocator<T, N, Allocator> >
+    {
+        static_assert(N > 0, "small_vector needs an inline capacity");
+    private:
+        typedef __small_buffer<T, N>                         __buffer;
+        typedef vector<T, __small_allocator<T, N, Allocator> > __base;
+    public:
+        typedef small_vector<T, N, Allocator>      self;
+        typedef Allocator                          heap_allocator_type;
+        typedef typename __base::allocator_type    allocator_type;
+        typedef typename __base::value_type        value_type;
+        typedef typename __base::size_type         size_type;
+        typedef typename __base::difference_type   difference_type;
+        typedef typename __base::reference         reference;
+        typedef typename __base::const_reference   const_reference;
+        typedef typename __base::pointer           pointer;
+        typedef typename __base::const_pointer     const_pointer;
+        typedef typename __base::iterator          iterator;
+        typedef typename __base::const_iterator    const_iterator;
+
+        //constructors
+        small_vector() : __base(__make_alloc(Allocator())) { __base::reserve(N); }
+        explicit small_vector(const Allocator& a) : __base(__make_alloc(a)) { __base::reserve(N); }
+        explicit small_vector(size_type n, const Allocator& a = Allocator()) : __base(__make_alloc(a))
+        {
+            __base::reserve(N);
+            __base::resize(n);
+        }
+        small_vector(size_type n, const_reference val, const Allocator& a = Allocator()) : __base(__make_alloc(a))
+        {
+            __base::reserve(N);
+            __base::assign(n, val);
+        }
+        template<typename InputIter>
+        small_vector(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value,
+                     InputIter>::type last, const Allocator& a = Allocator()) : __base(__make_alloc(a))
+        {
+            __base::reserve(N);
+            __base::assign(first, last);
+        }
+        small_vector(std::initializer_list<value_type> init_list, const Allocator& a = Allocator())
+            : __base(__make_alloc(a))
+        {
+            __base::reserve(N);
+            __base::assign(init_list.begin(), init_list.end());
+        }
+
+        // copy constructor
+        small_vector(const self& v)
+            : __buffer(), __base(__make_alloc(std::allocator_traits<Allocator>::
+                select_on_container_copy_construction(v.get_allocator().__heap_allocator())))
+        {
+            __base::reserve(N);
+            __base::assign(v.begin(), v.end());
+        }
+
+        // move constructor, a heap buffer is stolen, inline elements are moved one by one
+        small_vector(self&& rv) : __buffer(), __base(__make_alloc(rv.get_allocator().__heap_allocator()))
+        {
+            if (rv.is_inline()){
+                __base::reserve(N);
+                __base::assign(learnSTL::make_move_iterator(rv.begin()), learnSTL::make_move_iterator(rv.end()));
+                rv.clear();
+            }
+            else{
+                __steal(rv);
+            }
+        }
+
+        self& operator=(const self& v){
+            if (this != &v)
+                __base::assign(v.begin(), v.end());
+            return *this;
+        }
+        self& operator=(self&& rv){
+            if (this != &rv){
+                if (rv.is_inline() || !__same_heap(rv)){
+                    __base::assign(learnSTL::make_move_iterator(rv.begin()), learnSTL::make_move_iterator(rv.end()));
+                    rv.clear();
+                }
+                else{
+                    __release();
+                    __steal(rv);
+                }
+            }
+            return *this;
+        }
+        self& operator=(std::initializer_list<value_type> initlist){
+            __base::assign(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        void swap(self& v){
+            if (!is_inline() && !v.is_inline() && __same_heap(v)){
+                __base::swap(v);
+            }
+            else{
+                self temp(std::move(*this));
+                *this = std::move(v);
+                v = std::move(temp);
+            }
+        }
+
+        // true while the elements live in the inline buffer
+        bool is_inline() const{
+            return __base::data() == __buffer::__ptr();
+        }
+        static size_type inline_capacity() { return N; }
+
+        ~small_vector() {}
+    private:
+        allocator_type __make_alloc(const Allocator& a){
+            return allocator_type(static_cast<__buffer*>(this), a);
+        }
+
+        bool __same_heap(const self& v) const{
+            return this->get_allocator().__heap_allocator() == v.get_allocator().__heap_allocator();
+        }
+
+        // give the storage back, inline or not; this is left without any
+        void __release(){
+            __base empty(this->get_allocator());
+            __base::swap(empty);
+        }
+
+        // this has no storage and rv is on the heap: take rv's buffer.
+        // The allocators are not swapped, so rv falls back on its own inline buffer.
+        void __steal(self& rv){
+            __base::swap(rv);
+            rv.reserve(N);
+        }
+    };
+
+    template<typename T, std::size_t N, typename Allocator> inline
+        void swap(small_vector<T, N, Allocator>& v1, small_vector<T, N, Allocator>& v2)
+    {
+        v1.swap(v2);
+    }
+    ///~ ------------------------- end small_vector ----------------------------
+}
+
+#endif
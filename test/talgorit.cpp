@@ -3,10 +3,13 @@
 #include <cctype>
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
 #include <functional>
 #include <vector>
 #include <initializer_list>
 #include "../algorithm.h"
+#include "../numeric.h"
+#include "../vector.h"
 using namespace std;
 
 // FUNCTION OBJECTS
@@ -18,6 +21,11 @@ bool veccmp(vector<int>& v, initializer_list<int> initlist)
     return v.size() == initlist.size() && learnSTL::equal(v.begin(), v.end(), initlist.begin());
 }
 
+bool lveccmp(learnSTL::vector<int>& v, initializer_list<int> initlist)
+{
+    return v.size() == initlist.size() && learnSTL::equal(v.begin(), v.end(), initlist.begin());
+}
+
 // TEST RANGE-COMPARE TEMPLATE FUNCTIONS
 void test_range_compate(char* first, char* last)
 {
@@ -46,6 +54,152 @@ void test_copy(char* first, char* last)
     assert(veccmp(v, {1, 2, 3, 4, 5, 6}));
 }
 
+void test_sort()
+{
+    learnSTL::vector<int> v{5, 3, 9, 1, 7, 3, 8, 2, 6, 4, 0, 3, 11, 15, 13, 12, 14, 10, 3};
+    learnSTL::vector<int> sorted{0, 1, 2, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    learnSTL::vector<int> v1(v);
+    learnSTL::sort(v1.begin(), v1.end());
+    assert(v1 == sorted);
+    learnSTL::sort(v1.begin(), v1.end(), greater<int>());
+    assert(learnSTL::is_sorted(v1.begin(), v1.end(), greater<int>()));
+
+    // stable_sort keeps the order of equal keys
+    learnSTL::vector<int> v2(v);
+    learnSTL::stable_sort(v2.begin(), v2.end(), [](int x, int y){ return x / 4 < y / 4; });
+    assert(lveccmp(v2, {3, 1, 3, 2, 0, 3, 3, 5, 7, 6, 4, 9, 8, 11, 10, 15, 13, 12, 14}));
+
+    learnSTL::vector<int> v3(v);
+    learnSTL::partial_sort(v3.begin(), v3.begin() + 5, v3.end());
+    assert(learnSTL::equal(v3.begin(), v3.begin() + 5, sorted.begin()));
+
+    learnSTL::vector<int> v4(4);
+    assert(learnSTL::partial_sort_copy(v.begin(), v.end(), v4.begin(), v4.end()) == v4.end());
+    assert(lveccmp(v4, {0, 1, 2, 3}));
+
+    learnSTL::vector<int> v5(v);
+    learnSTL::nth_element(v5.begin(), v5.begin() + 9, v5.end());
+    assert(v5[9] == sorted[9]);
+    assert(learnSTL::all_of(v5.begin(), v5.begin() + 9, [&](int x){ return x <= v5[9]; }));
+    assert(learnSTL::all_of(v5.begin() + 9, v5.end(), [&](int x){ return x >= v5[9]; }));
+
+    learnSTL::vector<int> v6{1, 3, 5, 7, 2, 4, 6};
+    learnSTL::inplace_merge(v6.begin(), v6.begin() + 4, v6.end());
+    assert(lveccmp(v6, {1, 2, 3, 4, 5, 6, 7}));
+}
+
+void test_heap()
+{
+    learnSTL::vector<int> v{5, 3, 9, 1, 7, 3, 8, 2, 6, 4, 0, 3, 11, 15, 13, 12, 14, 10, 3};
+    learnSTL::vector<int> h(v);
+    learnSTL::make_heap(h.begin(), h.end());
+    assert(learnSTL::is_heap(h.begin(), h.end()) && h[0] == 15);
+    learnSTL::pop_heap(h.begin(), h.end());
+    assert(h.back() == 15 && learnSTL::is_heap(h.begin(), h.end() - 1) && h[0] == 14);
+    h.back() = 20;
+    learnSTL::push_heap(h.begin(), h.end());
+    assert(h[0] == 20 && learnSTL::is_heap(h.begin(), h.end()));
+    learnSTL::sort_heap(h.begin(), h.end());
+    assert(lveccmp(h, {0, 1, 2, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 20}));
+    assert(learnSTL::is_heap_until(h.begin(), h.end()) == h.begin() + 1);
+
+    // a min-heap, built one push at a time
+    learnSTL::vector<int> m;
+    for(int x : v){
+        m.push_back(x);
+        learnSTL::push_heap(m.begin(), m.end(), greater<int>());
+        assert(learnSTL::is_heap(m.begin(), m.end(), greater<int>()));
+    }
+    for(int i = 0; i < 5; ++i)
+        learnSTL::pop_heap(m.begin(), m.end() - i, greater<int>());
+    assert(m[14] == 3 && m[15] == 3 && m[16] == 2 && m[17] == 1 && m[18] == 0);
+    assert(learnSTL::is_heap(m.begin(), m.begin() + 14, greater<int>()) && m[0] == 3);
+
+    // every length, so the node with fewer children is hit at each place
+    for(int n = 0; n < 70; ++n){
+        learnSTL::vector<int> w(n);
+        for(int i = 0; i < n; ++i)
+            w[i] = (i * 37) % 11;
+        learnSTL::make_heap(w.begin(), w.end());
+        assert(learnSTL::is_heap(w.begin(), w.end()));
+        learnSTL::sort_heap(w.begin(), w.end());
+        assert(learnSTL::is_sorted(w.begin(), w.end()));
+    }
+}
+
+void test_radix_sort()
+{
+    learnSTL::vector<int> v(1000);
+    for(int i = 0; i < 1000; ++i)
+        v[i] = (i * 7919) % 1000 - 500;
+    learnSTL::radix_sort(v.begin(), v.end());
+    assert(v.front() == -500 && v.back() == 499 && learnSTL::is_sorted(v.begin(), v.end()));
+
+    double d[] = {2.5, -1.0, 0.0, -7.25, 3.0};
+    learnSTL::radix_sort(d, d + 5);
+    assert(d[0] == -7.25 && d[1] == -1.0 && d[2] == 0.0 && d[4] == 3.0);
+
+    // sort by key, equal keys keep their order
+    learnSTL::vector<pair<int, char>> p{{3, 'a'}, {1, 'b'}, {3, 'c'}, {2, 'd'}, {1, 'e'}};
+    learnSTL::radix_sort(p.begin(), p.end(), [](const pair<int, char>& x){ return x.first; });
+    assert(p[0].second == 'b' && p[1].second == 'e' && p[2].second == 'd' && p[3].second == 'a' && p[4].second == 'c');
+}
+
+// every length up to a few vectors, so that the scalar tails are hit too
+template<typename T>
+void test_simd_compare()
+{
+    T a[200], b[200];
+    for(int n = 0; n < 200; n += (n < 70 ? 1 : 13)){
+        for(int i = 0; i < n; ++i)
+            a[i] = b[i] = T(i % 50 + 1);
+        assert(learnSTL::find(a, a + n, T(0)) == a + n);
+        assert(learnSTL::count(a, a + n, 7) == n / 50 + (n % 50 > 6));
+        assert(learnSTL::equal(a, a + n, b));
+        assert(learnSTL::adjacent_find(a, a + n) == a + n);
+        for(int i = 0; i < n; i += 3){
+            const T* cb = b;
+            b[i] = T(0);
+            assert(learnSTL::find(b, b + n, 0) == b + i);
+            assert(learnSTL::count(cb, cb + n, T(0)) == 1);
+            assert(!learnSTL::equal(a, a + n, cb));
+            assert(learnSTL::mismatch(a, a + n, b).first == a + i);
+            if(i + 1 < n){
+                b[i + 1] = T(0);
+                assert(learnSTL::adjacent_find(b, b + n) == b + i);
+                b[i + 1] = a[i + 1];
+            }
+            b[i] = a[i];
+        }
+    }
+    // a value the element type cannot hold is never found
+    assert(learnSTL::find(a, a + 100, 1LL << 40) == a + 100 || sizeof(T) == 8);
+}
+
+// the pointer kernels against the plain loop, which a lambda comparator selects
+template<typename T>
+void test_simd_minmax()
+{
+    learnSTL::vector<T> v(5000);
+    auto lt = [](const T& a, const T& b){ return a < b; };
+    srand(1);
+    for(int n = 1; n < 5000; n += (n < 100 ? 1 : 997)){
+        for(int i = 0; i < n; ++i)
+            v[i] = T(rand() % 61) - T(20);    // lots of ties
+        T* first = v.begin();
+        assert(learnSTL::min_element(first, first + n) == learnSTL::min_element(first, first + n, lt));
+        assert(learnSTL::max_element(first, first + n) == learnSTL::max_element(first, first + n, lt));
+        assert(learnSTL::minmax_element(first, first + n) == learnSTL::minmax_element(first, first + n, lt));
+    }
+    // increasing and constant ranges beat the best value in every block
+    for(int i = 0; i < 5000; ++i)
+        v[i] = T(i % 100);
+    assert(learnSTL::max_element(v.begin(), v.end()) == v.begin() + 99);
+    assert(learnSTL::minmax_element(v.begin(), v.end()).second == v.begin() + 4999);
+    learnSTL::fill(v.begin(), v.end(), T(3));
+    assert(learnSTL::minmax_element(v.begin(), v.end()) == make_pair(v.begin(), v.end() - 1));
+}
+
 int main()
 {
     char buf[] = "abccefg";
@@ -54,6 +208,23 @@ int main()
     char *last = buf + 7;
     test_range_compate(first, last);
     test_copy(first, last);
+    test_sort();
+    test_heap();
+    test_radix_sort();
+    test_simd_compare<char>();
+    test_simd_compare<unsigned short>();
+    test_simd_compare<int>();
+    test_simd_compare<long long>();
+    test_simd_minmax<signed char>();
+    test_simd_minmax<unsigned char>();
+    test_simd_minmax<short>();
+    test_simd_minmax<unsigned>();
+    test_simd_minmax<long>();
+    test_simd_minmax<unsigned long long>();
+    test_simd_minmax<float>();
+    test_simd_minmax<double>();
+    double d[] = {3.0, 0.0 / 0.0, -1.0, 5.0, 5.0, -1.0};
+    assert(learnSTL::minmax_element(d, d + 6) == learnSTL::minmax_element(d, d + 6, [](double a, double b){ return a < b; }));
     cout << "SUCCESS TEST algorithm" << endl;
     return 0;
 }
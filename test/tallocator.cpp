@@ -0,0 +1,173 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include "../allocator.h"
+#include "../vector.h"
+#include "../forward_list.h"
+using namespace std;
+
+void test_arena()
+{
+    learnSTL::monotonic_arena arena(64);
+    void* p1 = arena.allocate(10, 1);
+    void* p2 = arena.allocate(8, 8);
+    assert(reinterpret_cast<uintptr_t>(p2) % 8 == 0);
+    assert(static_cast<char*>(p2) >= static_cast<char*>(p1) + 10);
+    void* p3 = arena.allocate(1000, 64);     // larger than a block
+    assert(reinterpret_cast<uintptr_t>(p3) % 64 == 0);
+    arena.deallocate(p3, 1000);
+    size_t left = arena.remaining();
+    arena.reset();
+    assert(arena.remaining() > left);
+    void* p4 = arena.allocate(1000, 64);      // the kept block is reused
+    assert(p4 == p3);
+    arena.release();
+    assert(arena.remaining() == 0);
+}
+
+void test_vector()
+{
+    typedef learnSTL::arena_allocator<int> Myal;
+    typedef learnSTL::vector<int, Myal> Mycont;
+    learnSTL::monotonic_arena a1, a2;
+    Mycont v1(Myal{ a1 }), v2(Myal{ a2 });
+    for (int i = 0; i < 100; ++i)
+        v1.push_back(i);
+    v1.insert(v1.begin(), 3, -1);
+    assert(v1.size() == 103 && v1.front() == -1 && v1.back() == 99);
+
+    // copy construction keeps the arena, copy assignment propagates it
+    Mycont v3(v1);
+    assert(v3 == v1 && v3.get_allocator() == v1.get_allocator());
+    v2.push_back(5);
+    v2 = v1;
+    assert(v2 == v1 && v2.get_allocator().arena() == &a1);
+
+    // move and swap take the arena along with the buffer
+    Mycont v4(Myal{ a2 });
+    const int* data = v1.data();
+    v4 = learnSTL::move(v1);
+    assert(v4.data() == data && v4.get_allocator().arena() == &a1);
+    Mycont v5(2, Myal{ a2 });
+    v5.swap(v4);
+    assert(v5.data() == data && v5.get_allocator().arena() == &a1);
+    assert(v4.size() == 2 && v4.get_allocator().arena() == &a2);
+}
+
+void test_forward_list()
+{
+    typedef learnSTL::arena_allocator<int> Myal;
+    typedef learnSTL::forward_list<int, Myal> Mycont;
+    learnSTL::monotonic_arena a1, a2;
+    Mycont f1({ 3, 1, 2 }, Myal{ a1 }), f2(Myal{ a2 });
+    f1.push_front(4);
+    f1.sort();
+    assert(f1.front() == 1);
+
+    Mycont f3(f1);
+    assert(f3 == f1 && f3.get_allocator() == f1.get_allocator());
+    f2.push_front(7);
+    f2 = f1;
+    assert(f2 == f1 && f2.get_allocator().arena() == &a1);
+
+    Mycont f4(learnSTL::move(f1), Myal{ a1 });
+    assert(f1.empty() && f4 == f2);
+    Mycont f5(Myal{ a2 });
+    f5 = learnSTL::move(f4);
+    assert(f4.empty() && f5 == f2 && f5.get_allocator().arena() == &a1);
+    Mycont f6(1, 9, Myal{ a2 });
+    learnSTL::swap(f5, f6);
+    assert(f6 == f2 && f6.get_allocator().arena() == &a1);
+    assert(f5.front() == 9 && f5.get_allocator().arena() == &a2);
+}
+
+void test_pool()
+{
+    typedef learnSTL::pool_allocator<int> Myal;
+    Myal al;
+    int* p1 = al.allocate(1);
+    al.deallocate(p1, 1);
+    int* p2 = al.allocate(1);
+    assert(p2 == p1);                       // the freed chunk comes back first
+    int* p3 = al.allocate(100);             // 400 bytes, not pooled
+    al.deallocate(p3, 100);
+    al.deallocate(p2, 1);
+
+    // nodes rebind through the list's node allocator
+    typedef learnSTL::forward_list<int, Myal> Mycont;
+    Mycont f1;
+    for (int i = 0; i < 1000; ++i)
+        f1.push_front(i);
+    Mycont f2(f1);
+    f1.sort();
+    assert(f1.front() == 0 && f2.front() == 999);
+    f2 = learnSTL::move(f1);
+    assert(f1.empty() && f2.front() == 0);
+
+    // chunks freed on another thread go through that thread's cache
+    learnSTL::forward_list<int, learnSTL::pool_allocator<int, false> > f3(100, 1);
+    std::thread t([&f2]{
+        Mycont f4(learnSTL::move(f2));
+        for (int i = 0; i < 500; ++i)
+            f4.pop_front();
+        assert(f4.front() == 500);
+    });
+    t.join();
+    assert(f2.empty() && f3.front() == 1);
+}
+
+// 48 bytes: every chunk below comes from one size class
+struct blob{
+    char b[48];
+};
+blob* late[40];
+
+// built before the thread's cache, so destroyed after the cache is given back
+struct late_user{
+    ~late_user(){
+        learnSTL::pool_allocator<blob> al;
+        for (blob*& p : late)
+            p = al.allocate(1);
+        al.deallocate(late[0], 1);
+        late[0] = al.allocate(1);
+    }
+};
+
+// a chunk given back when a thread ends is not handed out again by its cache
+void test_pool_exit()
+{
+    std::thread t([]{
+        static thread_local late_user u;
+        (void)u;
+        learnSTL::pool_allocator<blob> al;
+        blob* p[100];
+        for (blob*& q : p)
+            q = al.allocate(1);
+        for (blob* q : p)
+            al.deallocate(q, 1);
+    });
+    t.join();
+    learnSTL::pool_allocator<blob, false> al;
+    blob* p[200];
+    for (blob*& q : p)
+        q = al.allocate(1);
+    for (blob* q : p)
+        for (blob* l : late)
+            assert(q != l);
+    for (blob* q : p)
+        al.deallocate(q, 1);
+}
+
+int main()
+{
+    test_arena();
+    test_vector();
+    test_forward_list();
+    test_pool();
+    test_pool_exit();
+
+    cout << "SUCCESS testing allocator.h" << endl;
+
+    return 0;
+}
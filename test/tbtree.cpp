@@ -0,0 +1,355 @@
+#include "../btree.h"
+#include "../allocator.h"
+#include "../vector.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <map>
+#include <set>
+using namespace std;
+
+typedef learnSTL::btree_map<int, int> Mymap;
+typedef learnSTL::btree_multimap<int, int> Mymulti;
+
+// the tree agrees with the model: the same values in the same order, both ways
+template<typename M, typename U>
+bool same(const M& m, const U& u){
+    if(m.size() != u.size() || m.empty() != u.empty())
+        return false;
+    auto it = m.begin();
+    for(auto v = u.begin(); v != u.end(); ++v, ++it)
+        if(it == m.end() || it->first != v->first || it->second != v->second)
+            return false;
+    if(it != m.end())
+        return false;
+    auto r = m.rbegin();
+    for(auto v = u.rbegin(); v != u.rend(); ++v, ++r)
+        if(r->first != v->first || r->second != v->second)
+            return false;
+    return r == m.rend();
+}
+
+void test_basic(){
+    Mymap m1;
+    assert(m1.empty() && m1.size() == 0 && m1.begin() == m1.end());
+    assert(m1.find(3) == m1.end() && m1.count(3) == 0 && m1.erase(3) == 0 && m1.lower_bound(3) == m1.end());
+    auto r = m1.insert(learnSTL::make_pair(1, 10));
+    assert(r.second && r.first->first == 1 && r.first->second == 10);
+    r = m1.insert(learnSTL::make_pair(1, 11));
+    assert(!r.second && r.first->second == 10 && m1.size() == 1);
+    m1[2] = 20;
+    m1[3];
+    assert(m1.size() == 3 && m1.at(2) == 20 && m1[3] == 0 && m1.contains(3));
+    bool thrown = false;
+    try{
+        m1.at(4);
+    }
+    catch(const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown);
+    assert(m1.try_emplace(4, 40).second && !m1.try_emplace(4, 41).second && m1[4] == 40);
+    assert(!m1.insert_or_assign(4, 42).second && m1[4] == 42);
+
+    // in a full leaf a key that is there already neither splits it nor
+    // touches its arguments; a new key splits it
+    typedef learnSTL::btree_map<string, string> Smap;
+    Smap full;
+    for(size_t i = 0; i < Smap::node_capacity(); ++i)
+        full.try_emplace(string(1, char('a' + i % 26)) + to_string(i), "v");
+    const string* addr = &full.rbegin()->second;
+    string k = full.rbegin()->first, v = "other";
+    assert(!full.try_emplace(learnSTL::move(k), learnSTL::move(v)).second && !k.empty() && v == "other");
+    assert(!full.insert_or_assign(k, learnSTL::move(v)).second && full[k] == "other" && v.empty());
+    assert(&full.rbegin()->second == addr);
+    v = "new";
+    assert(full.try_emplace("~", learnSTL::move(v)).second && v.empty() && full.size() == Smap::node_capacity() + 1);
+    assert(full[k] == "other");
+
+    assert(m1.emplace(5, 50).second && !m1.emplace(5, 51).second);
+    assert(m1.lower_bound(5)->first == 5 && m1.upper_bound(5) == m1.end() && m1.upper_bound(0)->first == 1);
+    assert(m1.erase(5) == 1 && m1.erase(5) == 0 && m1.size() == 4);
+    assert(m1.value_comp()(*m1.begin(), *m1.find(2)) && m1.key_comp()(1, 2));
+
+    Mymap::const_iterator ci = m1.find(2);
+    Mymap::iterator it = m1.find(2);
+    assert(ci == it && it->second == 20);
+    it->second = 21;
+    assert(m1.at(2) == 21);
+
+    Mymap m2(m1), m3{{7, 70}, {8, 80}};
+    assert(m2 == m1 && m3 != m1 && m1 < m3 && m3 > m1 && m1 <= m2 && m1 >= m2);
+    m3 = m1;
+    assert(m3 == m1);
+    m3 = {{9, 90}};
+    assert(m3.size() == 1 && m3[9] == 90);
+    Mymap m4(learnSTL::move(m3));
+    assert(m3.empty() && m4.size() == 1);
+    m3 = learnSTL::move(m4);
+    assert(m4.empty() && m3.size() == 1);
+    m4[1] = 1;                              // a moved-from map is usable
+    learnSTL::swap(m3, m4);
+    assert(m3.size() == 1 && m3[1] == 1 && m4[9] == 90);
+    m1.clear();
+    assert(m1.empty() && m1.begin() == m1.end());
+    m1[2] = 2;
+    assert(m1.size() == 1);
+
+    learnSTL::btree_set<string> s{"b", "c", "a"};
+    assert(s.size() == 3 && *s.begin() == "a" && *s.rbegin() == "c" && !s.insert("b").second);
+    assert(s.emplace(3, 'd').second && s.count("ddd") == 1 && *--s.end() == "ddd");
+    learnSTL::btree_multiset<int> ms{3, 1, 3, 2, 3};
+    assert(ms.size() == 5 && ms.count(3) == 3 && *ms.lower_bound(2) == 2 && ms.erase(3) == 3 && ms.size() == 2);
+}
+
+void test_model(){
+    Mymap m;
+    std::map<int, int> u;
+    unsigned x = 77;
+    for(int step = 0; step < 200000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int k = static_cast<int>(r % 5000);
+        switch(r % 6){
+        case 0:
+        case 1:
+            m[k] = step;
+            u[k] = step;
+            break;
+        case 2:
+            assert(m.erase(k) == u.erase(k));
+            break;
+        case 3: {
+            auto it = m.lower_bound(k);
+            auto v = u.lower_bound(k);
+            assert((it == m.end()) == (v == u.end()));
+            if(it != m.end()){
+                assert(it->first == v->first);
+                it = m.erase(it);
+                v = u.erase(v);
+                assert((it == m.end()) == (v == u.end()) && (it == m.end() || it->first == v->first));
+            }
+            break;
+        }
+        case 4: {
+            auto it = m.upper_bound(k);
+            auto v = u.upper_bound(k);
+            assert((it == m.end()) == (v == u.end()) && (it == m.end() || it->first == v->first));
+            break;
+        }
+        case 5:
+            assert(m.count(k) == u.count(k));
+            break;
+        }
+        if(step % 5000 == 0)
+            assert(same(m, u));
+    }
+    assert(same(m, u));
+}
+
+void test_multi(){
+    Mymulti m;
+    std::multimap<int, int> u;
+    unsigned x = 5;
+    for(int step = 0; step < 100000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int k = static_cast<int>(r % 300);
+        if(r % 3 != 0){
+            auto it = m.emplace(k, step);
+            u.emplace(k, step);
+            assert(it->first == k && it->second == step);
+        }
+        else if(r % 2){
+            assert(m.erase(k) == u.erase(k));
+        }
+        else{
+            auto it = m.find(k);
+            auto v = u.find(k);
+            if(it != m.end()){
+                assert(it->second == v->second);
+                m.erase(it);
+                u.erase(v);
+            }
+        }
+        if(step % 5000 == 0)
+            assert(same(m, u) && m.count(k) == u.count(k));
+    }
+    assert(same(m, u));
+    Mymulti m2(m);
+    assert(m2 == m);
+}
+
+void test_bulk(){
+    // a sorted range loads by appending; the result is an ordinary tree
+    learnSTL::vector<learnSTL::pair<int, int> > sorted;
+    std::map<int, int> u;
+    for(int i = 0; i < 100000; ++i){
+        sorted.push_back(learnSTL::make_pair(2 * i, i));
+        u[2 * i] = i;
+    }
+    Mymap m(sorted.begin(), sorted.end());
+    assert(same(m, u));
+    for(int i = 0; i < 100000; i += 7){
+        m[2 * i + 1] = -i;
+        u[2 * i + 1] = -i;
+    }
+    assert(same(m, u));
+
+    // hints: end() appends, a wrong hint still puts the value in place
+    Mymap h;
+    for(int i = 0; i < 1000; ++i)
+        h.insert(h.end(), learnSTL::make_pair(i, i));
+    auto it = h.insert(h.begin(), learnSTL::make_pair(500, -1));
+    assert(it->first == 500 && it->second == 500 && h.size() == 1000);
+    it = h.insert(h.find(600), learnSTL::make_pair(-5, 0));
+    assert(it == h.begin() && h.size() == 1001);
+    for(int i = 999; i >= 0; --i)
+        h.emplace_hint(h.begin(), i + 2000, i);
+    assert(h.size() == 2001 && (--h.end())->first == 2999);
+
+    // descending input through the begin() hint
+    learnSTL::btree_set<int> d;
+    for(int i = 50000; i > 0; --i)
+        d.insert(d.begin(), i);
+    int expect = 1;
+    for(int v : d)
+        assert(v == expect++);
+}
+
+void test_range_erase(){
+    Mymap m;
+    std::map<int, int> u;
+    for(int i = 0; i < 20000; ++i){
+        m[i] = i;
+        u[i] = i;
+    }
+    unsigned x = 3;
+    while(m.size() > 10){
+        x = x * 1103515245 + 12345;
+        const size_t n = m.size();
+        const size_t a = (x >> 8) % n, len = (x >> 4) % (n / 4 + 1);
+        auto first = m.begin();
+        auto v = u.begin();
+        for(size_t i = 0; i < a; ++i, ++first, ++v)
+            ;
+        auto last = first;
+        auto w = v;
+        for(size_t i = 0; i < len && last != m.end(); ++i, ++last, ++w)
+            ;
+        auto it = m.erase(first, last);
+        auto vi = u.erase(v, w);
+        assert((it == m.end()) == (vi == u.end()) && (it == m.end() || it->first == vi->first));
+        assert(same(m, u));
+    }
+    auto it = m.erase(m.begin(), m.end());
+    assert(it == m.end() && m.empty());
+    m[1] = 1;
+    assert(m.size() == 1 && m.begin()->first == 1);
+}
+
+// the node search by bisection, for a key that is not arithmetic or a
+// comparator that is not std::less
+void test_compare(){
+    learnSTL::btree_set<int, std::greater<int> > g;
+    std::set<int, std::greater<int> > u;
+    for(int i = 0; i < 5000; ++i){
+        g.insert(i * 37 % 5003);
+        u.insert(i * 37 % 5003);
+    }
+    assert(g.size() == u.size());
+    auto gi = g.begin();
+    for(int x : u)
+        assert(*gi++ == x);
+    assert(*g.lower_bound(100) == *u.lower_bound(100) && *g.upper_bound(100) == *u.upper_bound(100));
+
+    learnSTL::btree_map<string, int> s;
+    std::map<string, int> v;
+    for(int i = 0; i < 3000; ++i){
+        s[to_string(i * 7)] = i;
+        v[to_string(i * 7)] = i;
+    }
+    for(int i = 0; i < 3000; i += 2){
+        s.erase(to_string(i * 7));
+        v.erase(to_string(i * 7));
+    }
+    assert(s.size() == v.size());
+    auto it = s.begin();
+    for(const auto& p : v){
+        assert(it->first == p.first && it->second == p.second);
+        ++it;
+    }
+}
+
+// a key whose copy throws once armed; moving it never does
+struct copy_bomb{
+    static bool armed;
+    int v;
+    copy_bomb(int x) : v(x) {}
+    copy_bomb(const copy_bomb& o) : v(o.v) { if(armed) throw 1; }
+    copy_bomb(copy_bomb&& o) noexcept : v(o.v) {}
+    copy_bomb& operator=(const copy_bomb&) = default;
+    bool operator<(const copy_bomb& o) const { return v < o.v; }
+};
+bool copy_bomb::armed = false;
+
+// a value that fails to build into a full leaf must not split it first.
+// Ascending inserts leave each leaf one short of full; topping one up makes
+// the next key land at the very end of a full leaf, the uneven split.
+void test_insert_throws(){
+    for(int k = 1; k < 400; k += 4){
+        learnSTL::btree_set<copy_bomb> s;
+        for(int i = 0; i < 100; ++i)
+            s.insert(copy_bomb(4 * i));
+        s.insert(copy_bomb(k));
+        const copy_bomb b(k + 1);
+        copy_bomb::armed = true;
+        bool thrown = false;
+        try{
+            s.insert(b);
+        }
+        catch(int){
+            thrown = true;
+        }
+        copy_bomb::armed = false;
+        assert(thrown && s.size() == 101 && learnSTL::distance(s.begin(), s.end()) == 101);
+        assert(s.insert(b).second && s.size() == 102 && learnSTL::distance(s.begin(), s.end()) == 102);
+        int prev = -1;
+        for(const copy_bomb& c : s){
+            assert(c.v > prev);
+            prev = c.v;
+        }
+    }
+}
+
+void test_allocator(){
+    typedef learnSTL::arena_allocator<learnSTL::pair<const int, string> > Myal;
+    typedef learnSTL::btree_map<int, string, std::less<int>, Myal> Amap;
+    learnSTL::monotonic_arena a1, a2;
+    Amap m1(std::less<int>(), Myal{a1}), m2(Myal{a2});
+    for(int i = 0; i < 1000; ++i)
+        m1[i] = to_string(i);
+    m2 = m1;
+    assert(m2 == m1 && m2.get_allocator().arena() == &a1);
+    Amap m3(learnSTL::move(m1), Myal{a2});
+    assert(m3.size() == 1000 && m3.get_allocator().arena() == &a2 && m3[42] == "42");
+
+    learnSTL::btree_set<int, std::less<int>, learnSTL::pool_allocator<int> > s;
+    for(int i = 0; i < 10000; ++i)
+        s.insert(i * 3 % 10007);
+    for(int i = 0; i < 10000; i += 2)
+        s.erase(i * 3 % 10007);
+    assert(s.size() == 5000 && s.contains(3) && !s.contains(0));
+}
+
+int main(){
+    test_basic();
+    test_model();
+    test_multi();
+    test_bulk();
+    test_range_erase();
+    test_compare();
+    test_insert_throws();
+    test_allocator();
+    cout << "SUCCESS test btree" << endl;
+}
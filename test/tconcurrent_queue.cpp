@@ -0,0 +1,248 @@
+#include "../concurrent_queue.h"
+#include "../vector.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// counts live objects, so leaks and double destruction show up
+struct Counted{
+    static int live;
+    int v;
+    Counted(int x = 0) noexcept : v(x) { ++live; }
+    Counted(const Counted& o) noexcept : v(o.v) { ++live; }
+    Counted(Counted&& o) noexcept : v(o.v) { o.v = -1; ++live; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() { --live; }
+};
+int Counted::live = 0;
+
+// an output iterator whose third write throws
+struct ThrowOnThird{
+    int* writes;
+    ThrowOnThird& operator*() { return *this; }
+    ThrowOnThird& operator++() { return *this; }
+    ThrowOnThird& operator=(const Counted&){
+        if(++*writes == 3)
+            throw 3;
+        return *this;
+    }
+};
+
+void test_ring_basic(){
+    learnSTL::mpmc_ring<string, 4> q;
+    assert(q.capacity() == 4 && q.empty_approx());
+    string s = "one";
+    assert(q.try_push(s) && s == "one");
+    assert(q.try_push(string("two")) && q.try_emplace(3, 'x') && q.try_push("four"));
+    assert(!q.try_push("five") && q.size_approx() == 4);
+    string out;
+    assert(q.try_pop(out) && out == "one");
+    assert(q.try_pop(out) && out == "two");
+    assert(q.try_push("five") && q.try_push("six") && !q.try_push("seven"));
+    const char* expect[] = {"xxx", "four", "five", "six"};
+    for(int i = 0; i < 4; ++i){
+        assert(q.try_pop(out) && out == expect[i]);
+    }
+    assert(!q.try_pop(out) && out == "six" && q.empty_approx());
+
+    // the destructor cleans up what is left
+    {
+        learnSTL::mpmc_ring<Counted, 8> c;
+        for(int i = 0; i < 5; ++i)
+            c.try_emplace(i);
+        Counted x;
+        c.try_pop(x);
+        assert(x.v == 0 && Counted::live == 5);
+    }
+    assert(Counted::live == 0);
+}
+
+void test_ring_batch(){
+    learnSTL::mpmc_ring<int, 8> q;
+    int in[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    auto r = q.try_push_n(in, 5);
+    assert(r.first == 5 && r.second == in + 5);
+    r = q.try_push_n(r.second, 6);              // only three fit
+    assert(r.first == 3 && r.second == in + 8 && q.size_approx() == 8);
+    r = q.try_push_n(r.second, 3);
+    assert(r.first == 0 && r.second == in + 8);
+
+    int out[16] = {};
+    auto p = q.try_pop_n(out, 3);
+    assert(p.first == 3 && p.second == out + 3 && out[2] == 2);
+    r = q.try_push_n(in + 8, 3);                // wraps around the end
+    assert(r.first == 3);
+    p = q.try_pop_n(p.second, 16);
+    assert(p.first == 8 && p.second == out + 11 && q.empty_approx());
+    for(int i = 0; i < 11; ++i)
+        assert(out[i] == i);
+    assert(q.try_pop_n(out, 4).first == 0 && q.try_push_n(in, 0).first == 0);
+
+    // moving a batch in, popping into a back_inserter
+    learnSTL::mpmc_ring<string, 4> s;
+    string words[] = {"a", "b", "c"};
+    auto m = s.try_push_n(learnSTL::make_move_iterator(words), 3);
+    assert(m.first == 3 && words[0].empty());
+    learnSTL::vector<string> got;
+    s.try_pop_n(learnSTL::back_inserter(got), 10);
+    assert(got.size() == 3 && got[0] == "a" && got[2] == "c");
+
+    // a throwing output drops the rest of the batch, the slots go back
+    {
+        learnSTL::mpmc_ring<Counted, 4> c;
+        for(int i = 0; i < 4; ++i)
+            c.try_emplace(i);
+        int writes = 0;
+        try{
+            c.try_pop_n(ThrowOnThird{&writes}, 4);
+            assert(false);
+        }
+        catch(int){}
+        assert(writes == 3 && Counted::live == 0 && c.empty_approx());
+        for(int i = 0; i < 4; ++i)
+            assert(c.try_emplace(i));
+    }
+    assert(Counted::live == 0);
+}
+
+// producers push disjoint ranges, consumers pop until everything is in;
+// every value must come out exactly once and in order per producer
+void test_ring_threads(){
+    const int producers = 4, consumers = 4, per_producer = 100000;
+    learnSTL::mpmc_ring<long, 64> q;
+    std::atomic<long> popped(0), sum(0);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<long> > last(consumers, std::vector<long>(producers, -1));
+    bool ordered = true;
+    std::vector<char> bad(consumers, 0);
+    for(int p = 0; p < producers; ++p)
+        threads.push_back(std::thread([&q, p, per_producer]{
+            long base = long(p) * per_producer;
+            long buf[7];
+            for(long i = 0; i < per_producer; ){
+                if(i % 3 == 0){
+                    long n = 0;
+                    for(; n < 7 && i + n < per_producer; ++n)
+                        buf[n] = base + i + n;
+                    i += q.try_push_n(buf, n).first;
+                }
+                else if(q.try_push(base + i))
+                    ++i;
+                else
+                    std::this_thread::yield();
+            }
+        }));
+    for(int c = 0; c < consumers; ++c)
+        threads.push_back(std::thread([&, c]{
+            long buf[5];
+            const long total = long(producers) * per_producer;
+            while(popped.load() < total){
+                size_t n = q.try_pop_n(buf, c % 2 ? 5 : 1).first;
+                if(n == 0){
+                    std::this_thread::yield();
+                    continue;
+                }
+                for(size_t i = 0; i < n; ++i){
+                    long p = buf[i] / per_producer;
+                    if(buf[i] <= last[c][p])
+                        bad[c] = 1;
+                    last[c][p] = buf[i];
+                    sum += buf[i];
+                }
+                popped += n;
+            }
+        }));
+    for(auto& t : threads)
+        t.join();
+    for(int c = 0; c < consumers; ++c)
+        ordered = ordered && !bad[c];
+    long n = long(producers) * per_producer;
+    assert(popped == n && sum == n * (n - 1) / 2 && ordered && q.empty_approx());
+}
+
+void test_spsc_basic(){
+    learnSTL::spsc_queue<string> q(5);
+    assert(q.capacity() == 8 && q.empty_approx());
+    auto w = q.reserve(3);
+    assert(w.size() == 3 && w[0].empty());
+    w[0] = "a";
+    w[1] = "b";
+    w[2] = "c";
+    assert(q.peek().empty());                   // nothing committed yet
+    q.commit(2);
+    auto r = q.peek();
+    assert(r.size() == 2 && r[0] == "a" && r[1] == "b" && q.size_approx() == 2);
+    q.release(1);
+    q.commit(1);                                // "c" was filled by the first reserve
+    r = q.peek(10);
+    assert(r.size() == 2 && r[0] == "b" && r[1] == "c");
+    q.release(2);
+    assert(q.empty_approx());
+
+    // free room wraps: one span up to the end of the buffer, then the rest
+    w = q.reserve(8);
+    assert(w.size() == 5 && w.data() == &r[0] + 2);
+    for(auto& x : w)
+        x = "x";
+    q.commit(5);
+    w = q.reserve(8);
+    assert(w.size() == 3 && w[0] == "a");      // the slot still holds its old record
+    w[0] = "z";
+    q.commit(3);
+    assert(q.reserve(1).empty() && q.size_approx() == 8 && !q.try_push("full"));
+    assert(q.peek().size() == 5);
+    q.release(5);
+    assert(q.peek().size() == 3 && q.reserve().size() == 5);
+
+    // released slots keep their objects for the producer to reuse
+    string s;
+    assert(q.try_pop(s) && s == "z" && q.try_push(string("y")));
+
+    {
+        learnSTL::spsc_queue<Counted> c(4);
+        assert(Counted::live == 4 && c.try_push(Counted(7)));
+    }
+    assert(Counted::live == 0);
+}
+
+// the producer writes records in place, the consumer sums them where they lie
+void test_spsc_threads(){
+    const long n = 1000000;
+    learnSTL::spsc_queue<long> q(256);
+    long sum = 0, next = 0;
+    bool ordered = true;
+    std::thread producer([&q, n]{
+        long i = 0;
+        while(i < n){
+            auto w = q.reserve(i % 2 ? 37 : 1);
+            size_t k = 0;
+            for(; k < w.size() && i < n; ++k)
+                w[k] = i++;
+            q.commit(k);
+        }
+    });
+    while(next < n){
+        auto r = q.peek(next % 3 ? 64 : 5);
+        for(long x : r){
+            ordered = ordered && x == next;
+            ++next;
+            sum += x;
+        }
+        q.release(r.size());
+    }
+    producer.join();
+    assert(ordered && sum == n * (n - 1) / 2 && q.empty_approx());
+}
+
+int main(){
+    test_ring_basic();
+    test_ring_batch();
+    test_ring_threads();
+    test_spsc_basic();
+    test_spsc_threads();
+    cout << "SUCCESS test concurrent_queue" << endl;
+}
@@ -0,0 +1,229 @@
+#include "../deque.h"
+#include "../allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <deque>
+#include <algorithm>
+using namespace std;
+
+// four elements a block, so short deques already span several blocks
+typedef learnSTL::deque<int, std::allocator<int>, 4> Mycont;
+
+template<typename D, typename M>
+bool same(const D& d, const M& m){
+    if(d.size() != m.size())
+        return false;
+    for(size_t i = 0; i < m.size(); ++i)
+        if(d[i] != m[i] || *(d.begin() + i) != m[i])
+            return false;
+    return learnSTL::distance(d.begin(), d.end()) == static_cast<ptrdiff_t>(m.size()) &&
+           std::equal(d.rbegin(), d.rend(), m.rbegin());
+}
+
+void test_basic(){
+    Mycont d1;
+    assert(d1.empty() && d1.size() == 0 && d1.begin() == d1.end());
+    d1.clear();
+    for(int i = 0; i < 10; ++i){
+        d1.push_back(i);
+        d1.push_front(-i - 1);
+    }
+    assert(d1.size() == 20 && d1.front() == -10 && d1.back() == 9 && d1[10] == 0 && d1.at(19) == 9);
+    bool thrown = false;
+    try{
+        d1.at(20);
+    }
+    catch(const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown);
+
+    // iterator arithmetic across blocks
+    Mycont::iterator i = d1.begin() + 13;
+    assert(*i == 3 && i - d1.begin() == 13 && d1.end() - i == 7);
+    i -= 11;
+    assert(*i == -8 && i[5] == -3 && *(2 + i) == -6);
+    Mycont::const_iterator ci = i;
+    assert(ci == i && ci < d1.cend() && d1.cbegin() <= ci && !(ci > d1.cend()));
+    assert(std::is_sorted(d1.begin(), d1.end()));
+
+    Mycont d2(d1), d3(3, 7), d4{1, 2, 3};
+    assert(d2 == d1 && d3 == (Mycont{7, 7, 7}) && d4 < d3 && d3 > d1);
+    d3 = d4;
+    assert(d3 == d4);
+    d3.assign(6, 5);
+    assert(d3 == (Mycont{5, 5, 5, 5, 5, 5}));
+    Mycont d5(learnSTL::move(d3));
+    assert(d3.empty() && d5.size() == 6);
+    d3 = learnSTL::move(d5);
+    assert(d5.empty() && d3.size() == 6);
+    d5.push_back(1);                        // a moved-from deque is usable
+    learnSTL::swap(d3, d5);
+    assert(d3 == (Mycont{1}) && d5.size() == 6);
+    d5.resize(2);
+    d5.resize(4, 9);
+    assert(d5 == (Mycont{5, 5, 9, 9}));
+    d5.clear();
+    assert(d5.empty());
+    d5.shrink_to_fit();
+    d5.push_front(3);
+    assert(d5 == (Mycont{3}));
+    d1.erase(d1.begin() + 2, d1.end() - 2);
+    d1.shrink_to_fit();
+    assert(d1 == (Mycont{-10, -9, 8, 9}));
+}
+
+// random edits checked against std::deque
+void test_model(){
+    learnSTL::deque<string, std::allocator<string>, 3> d;
+    std::deque<string> m;
+    unsigned x = 4242;
+    for(int step = 0; step < 20000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        size_t n = m.size();
+        string s = to_string(r % 1000);
+        size_t k = n == 0 ? 0 : r % (n + 1);
+        switch(r % 9){
+        case 0:
+            d.push_back(s);
+            m.push_back(s);
+            break;
+        case 1:
+            d.push_front(s);
+            m.push_front(s);
+            break;
+        case 2:
+            if(n > 0){
+                d.pop_back();
+                m.pop_back();
+            }
+            break;
+        case 3:
+            if(n > 0){
+                d.pop_front();
+                m.pop_front();
+            }
+            break;
+        case 4: {
+            auto it = d.insert(d.begin() + k, s);
+            m.insert(m.begin() + k, s);
+            assert(*it == s && it - d.begin() == static_cast<ptrdiff_t>(k));
+            break;
+        }
+        case 5: {
+            size_t c = 1 + r % 4;
+            auto it = d.insert(d.cbegin() + k, c, s);
+            m.insert(m.begin() + k, c, s);
+            assert(it - d.begin() == static_cast<ptrdiff_t>(k));
+            break;
+        }
+        case 6: {
+            string a[] = {s, s + "a", s + "b"};
+            d.insert(d.begin() + k, a, a + 3);
+            m.insert(m.begin() + k, a, a + 3);
+            break;
+        }
+        case 7:
+            if(k < n){
+                auto it = d.erase(d.begin() + k);
+                m.erase(m.begin() + k);
+                assert(it - d.begin() == static_cast<ptrdiff_t>(k));
+            }
+            break;
+        case 8:
+            if(k < n && r % 4 == 0){
+                size_t e = k + (r >> 4) % (n - k + 1);
+                d.erase(d.begin() + k, d.begin() + e);
+                m.erase(m.begin() + k, m.begin() + e);
+            }
+            break;
+        }
+        assert(same(d, m));
+    }
+}
+
+// ints take the gcd rotate, whose jumps must not step past end()
+void test_insert_trivial(){
+    std::deque<int> m;
+    Mycont d;
+    unsigned x = 99;
+    for(int step = 0; step < 3000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        size_t k = r % (m.size() + 1);
+        int v = static_cast<int>(r % 100);
+        if(r % 3 == 0){
+            int a[] = {v, v + 1, v + 2, v + 3, v + 4};
+            size_t c = 1 + r % 5;
+            d.insert(d.begin() + k, a, a + c);
+            m.insert(m.begin() + k, a, a + c);
+        }
+        else if(r % 3 == 1){
+            size_t c = 1 + r % 7;
+            d.insert(d.begin() + k, c, v);
+            m.insert(m.begin() + k, c, v);
+        }
+        else if(!m.empty()){
+            k = r % m.size();
+            d.erase(d.begin() + k);
+            m.erase(m.begin() + k);
+        }
+        assert(same(d, m));
+    }
+    for(size_t mid = 1; mid < d.size(); mid += 7){
+        learnSTL::rotate(d.begin(), d.begin() + mid, d.end());
+        std::rotate(m.begin(), m.begin() + mid, m.end());
+        assert(same(d, m));
+    }
+}
+
+void test_algorithms(){
+    // the random-access paths of the algorithms
+    Mycont d1;
+    for(int i = 0; i < 50; ++i)
+        d1.push_front(i);
+    learnSTL::rotate(d1.begin(), d1.begin() + 7, d1.end());
+    assert(d1.front() == 42 && d1.back() == 43);
+    learnSTL::fill(d1.begin() + 3, d1.begin() + 10, -1);
+    assert(d1[2] == 40 && d1[3] == -1 && d1[9] == -1 && d1[10] == 32);
+    int pat[] = {32, 31};
+    assert(learnSTL::search(d1.begin(), d1.end(), pat, pat + 2) == d1.begin() + 10);
+    learnSTL::sort(d1.begin(), d1.end());
+    assert(std::is_sorted(d1.begin(), d1.end()) && d1.front() == -1);
+    learnSTL::reverse(d1.begin(), d1.end());
+    assert(d1.back() == -1);
+}
+
+void test_allocator(){
+    typedef learnSTL::arena_allocator<int> Myal;
+    typedef learnSTL::deque<int, Myal, 8> Adeque;
+    learnSTL::monotonic_arena a1, a2;
+    Adeque d1({1, 2, 3}, Myal{a1}), d2(Myal{a2});
+    for(int i = 0; i < 100; ++i)
+        d1.push_front(i);
+    d2 = d1;
+    assert(d2 == d1 && d2.get_allocator().arena() == &a1);
+    Adeque d3(learnSTL::move(d1), Myal{a2});
+    assert(d3.size() == 103 && d3.get_allocator().arena() == &a2);
+
+    // references stay valid while the map grows
+    learnSTL::deque<int, learnSTL::pool_allocator<int> > d4;
+    d4.push_back(1);
+    int* p = &d4.front();
+    for(int i = 0; i < 100000; ++i){
+        d4.push_back(i);
+        d4.push_front(i);
+    }
+    assert(p == &d4[100000] && *p == 1);
+}
+
+int main(){
+    test_basic();
+    test_model();
+    test_insert_trivial();
+    test_algorithms();
+    test_allocator();
+    cout << "SUCCESS test deque" << endl;
+}
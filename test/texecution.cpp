@@ -0,0 +1,97 @@
+#include "../execution.h"
+#include <iostream>
+#include <functional>
+#include <cassert>
+#include <cstdlib>
+
+using namespace std;
+
+const size_t N = 100000;
+
+void test_elementwise()
+{
+    learnSTL::vector<long> v(N), w(N);
+    learnSTL::fill(learnSTL::execution::par, v.begin(), v.end(), 3L);
+    assert(learnSTL::count(learnSTL::execution::par, v.begin(), v.end(), 3L) == (long)N);
+    learnSTL::for_each(learnSTL::execution::par, v.begin(), v.end(), [](long& x){ x *= 2; });
+    learnSTL::transform(learnSTL::execution::par_unseq, v.begin(), v.end(), w.begin(), [](long x){ return x + 1; });
+    assert(learnSTL::all_of(learnSTL::execution::par, w.begin(), w.end(), [](long x){ return x == 7; }));
+    learnSTL::transform(learnSTL::execution::par, v.begin(), v.end(), w.begin(), w.begin(), plus<long>());
+    assert(learnSTL::none_of(learnSTL::execution::par, w.begin(), w.end(), [](long x){ return x != 13; }));
+
+    for(size_t i = 0; i < N; ++i)
+        v[i] = i;
+    learnSTL::copy(learnSTL::execution::par, v.begin(), v.end(), w.begin());
+    assert(learnSTL::equal(v.begin(), v.end(), w.begin()));
+    assert(learnSTL::count_if(learnSTL::execution::par, v.begin(), v.end(), [](long x){ return x % 3 == 0; }) == (long)(N + 2) / 3);
+    assert(learnSTL::find(learnSTL::execution::par, v.begin(), v.end(), 77777L) == v.begin() + 77777);
+    assert(learnSTL::find(learnSTL::execution::par, v.begin(), v.end(), -1L) == v.end());
+    assert(learnSTL::find_if(learnSTL::execution::par, v.begin(), v.end(), [](long x){ return x > 5000 && x % 1000 == 0; }) == v.begin() + 6000);
+    assert(learnSTL::any_of(learnSTL::execution::seq, v.begin(), v.end(), [](long x){ return x == 99999; }));
+}
+
+void test_numeric()
+{
+    learnSTL::vector<long> v(N), w(N);
+    for(size_t i = 0; i < N; ++i)
+        v[i] = i % 7;
+    long sum = learnSTL::accumulate(v.begin(), v.end(), 0L);
+    assert(learnSTL::reduce(learnSTL::execution::par, v.begin(), v.end()) == sum);
+    assert(learnSTL::reduce(learnSTL::execution::par, v.begin(), v.end(), 5L) == sum + 5);
+    assert(learnSTL::transform_reduce(learnSTL::execution::par, v.begin(), v.end(), v.begin(), 0L) ==
+           learnSTL::inner_product(v.begin(), v.end(), v.begin(), 0L));
+    assert(learnSTL::transform_reduce(learnSTL::execution::par, v.begin(), v.end(), 0L, plus<long>(),
+                                      [](long x){ return 2 * x; }) == 2 * sum);
+
+    learnSTL::vector<long> expect(N);
+    learnSTL::partial_sum(v.begin(), v.end(), expect.begin());
+    learnSTL::inclusive_scan(learnSTL::execution::par, v.begin(), v.end(), w.begin());
+    assert(learnSTL::equal(w.begin(), w.end(), expect.begin()));
+    learnSTL::inclusive_scan(learnSTL::execution::par, v.begin(), v.end(), w.begin(), plus<long>(), 10L);
+    for(size_t i = 0; i < N; ++i)
+        assert(w[i] == expect[i] + 10);
+    learnSTL::copy(v.begin(), v.end(), w.begin());
+    learnSTL::exclusive_scan(learnSTL::execution::par, w.begin(), w.end(), w.begin(), 10L);   // in place
+    assert(w[0] == 10);
+    for(size_t i = 1; i < N; ++i)
+        assert(w[i] == expect[i - 1] + 10);
+    learnSTL::transform_inclusive_scan(learnSTL::execution::par, v.begin(), v.end(), w.begin(), plus<long>(),
+                                       [](long x){ return 2 * x; });
+    for(size_t i = 0; i < N; ++i)
+        assert(w[i] == 2 * expect[i]);
+
+    learnSTL::vector<double> dv(N), dw(N);
+    learnSTL::copy(v.begin(), v.end(), dv.begin());
+    learnSTL::inclusive_scan(learnSTL::execution::par, dv.begin(), dv.end(), dw.begin());
+    for(size_t i = 0; i < N; ++i)
+        assert(dw[i] == expect[i]);     // small integers, every grouping is exact
+}
+
+void test_sort_merge()
+{
+    learnSTL::vector<int> v(N), w(N), m(2 * N);
+    srand(7);
+    for(size_t i = 0; i < N; ++i){
+        v[i] = rand() % 1000;
+        w[i] = rand() % 1000;
+    }
+    learnSTL::sort(learnSTL::execution::par, v.begin(), v.end());
+    assert(learnSTL::is_sorted(v.begin(), v.end()));
+    learnSTL::sort(learnSTL::execution::par, w.begin(), w.end(), greater<int>());
+    assert(learnSTL::is_sorted(w.begin(), w.end(), greater<int>()));
+    learnSTL::reverse(w.begin(), w.end());
+    learnSTL::merge(learnSTL::execution::par, v.begin(), v.end(), w.begin(), w.begin() + N / 3, m.begin());
+    assert(learnSTL::is_sorted(m.begin(), m.begin() + N + N / 3));
+    assert(learnSTL::reduce(learnSTL::execution::par, m.begin(), m.begin() + N + N / 3, 0L) ==
+           learnSTL::accumulate(v.begin(), v.end(), 0L) + learnSTL::accumulate(w.begin(), w.begin() + N / 3, 0L));
+}
+
+int main()
+{
+    test_elementwise();
+    test_numeric();
+    test_sort_merge();
+
+    cout << "SUCCESS testing execution.h" << endl;
+    return 0;
+}
@@ -0,0 +1,334 @@
+#include "../flat_hash_map.h"
+#include "../allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+using namespace std;
+
+typedef learnSTL::flat_hash_map<int, int> Mymap;
+
+// the allocation *left ends at throws, the ones before it go through
+template<typename T>
+struct FailAlloc{
+    typedef T value_type;
+    int* left;
+
+    explicit FailAlloc(int* l) : left(l) {}
+    template<typename U> FailAlloc(const FailAlloc<U>& a) : left(a.left) {}
+
+    T* allocate(size_t n){
+        if(*left >= 0 && (*left)-- == 0)
+            throw std::bad_alloc();
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p); }
+
+    template<typename U> bool operator==(const FailAlloc<U>& a) const { return left == a.left; }
+    template<typename U> bool operator!=(const FailAlloc<U>& a) const { return left != a.left; }
+};
+
+// the table agrees with the model, by lookup and by iteration
+template<typename M, typename U>
+bool same(const M& m, const U& u){
+    if(m.size() != u.size() || m.empty() != u.empty())
+        return false;
+    size_t n = 0;
+    for(auto it = m.begin(); it != m.end(); ++it, ++n){
+        auto f = u.find(it->first);
+        if(f == u.end() || f->second != it->second)
+            return false;
+    }
+    for(const auto& v : u){
+        auto f = m.find(v.first);
+        if(f == m.end() || f->second != v.second || !m.contains(v.first))
+            return false;
+    }
+    return n == u.size();
+}
+
+void test_basic(){
+    Mymap m1;
+    assert(m1.empty() && m1.size() == 0 && m1.begin() == m1.end() && m1.bucket_count() == 0);
+    assert(m1.find(3) == m1.end() && m1.count(3) == 0 && m1.erase(3) == 0);
+    auto r = m1.insert(learnSTL::make_pair(1, 10));
+    assert(r.second && r.first->first == 1 && r.first->second == 10);
+    r = m1.insert(learnSTL::make_pair(1, 11));
+    assert(!r.second && r.first->second == 10 && m1.size() == 1);
+    m1[2] = 20;
+    m1[3];
+    assert(m1.size() == 3 && m1.at(2) == 20 && m1[3] == 0);
+    bool thrown = false;
+    try{
+        m1.at(4);
+    }
+    catch(const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown);
+    assert(m1.try_emplace(4, 40).second && !m1.try_emplace(4, 41).second && m1[4] == 40);
+    assert(!m1.insert_or_assign(4, 42).second && m1[4] == 42);
+    assert(m1.emplace(5, 50).second && !m1.emplace(5, 51).second);
+    auto er = m1.equal_range(5);
+    assert(er.first->second == 50 && learnSTL::distance(er.first, er.second) == 1);
+    er = m1.equal_range(9);
+    assert(er.first == m1.end() && er.second == m1.end());
+    assert(m1.erase(5) == 1 && m1.erase(5) == 0 && m1.size() == 4);
+
+    Mymap::const_iterator ci = m1.find(2);
+    Mymap::iterator it = m1.find(2);
+    assert(ci == it && it->second == 20);
+    it->second = 21;
+    assert(m1.at(2) == 21);
+
+    Mymap m2(m1), m3{{7, 70}, {8, 80}};
+    assert(m2 == m1 && m3 != m1 && m3.size() == 2);
+    m3 = m1;
+    assert(m3 == m1);
+    m3 = {{9, 90}};
+    assert(m3.size() == 1 && m3[9] == 90);
+    Mymap m4(learnSTL::move(m3));
+    assert(m3.empty() && m4.size() == 1);
+    m3 = learnSTL::move(m4);
+    assert(m4.empty() && m3.size() == 1);
+    m4[1] = 1;                              // a moved-from map is usable
+    learnSTL::swap(m3, m4);
+    assert(m3.size() == 1 && m3[1] == 1 && m4[9] == 90);
+    m1.clear();
+    assert(m1.empty() && m1.begin() == m1.end() && m1.find(2) == m1.end());
+    m1[2] = 2;
+    assert(m1.size() == 1);
+
+    learnSTL::flat_hash_set<string> s1{"a", "b", "c"};
+    assert(s1.size() == 3 && s1.contains("b") && !s1.insert("b").second);
+    assert(s1.emplace(3, 'd').second && s1.count("ddd") == 1);
+    learnSTL::flat_hash_set<string> s2(s1.begin(), s1.end());
+    assert(s2 == s1);
+    s2.erase("a");
+    assert(s2 != s1 && s2.size() == 3);
+}
+
+void test_model(){
+    Mymap m;
+    std::unordered_map<int, int> u;
+    unsigned x = 77;
+    for(int step = 0; step < 200000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int k = static_cast<int>(r % 3000);
+        switch(r % 5){
+        case 0:
+        case 1:
+            m[k] = step;
+            u[k] = step;
+            break;
+        case 2:
+            assert(m.erase(k) == u.erase(k));
+            break;
+        case 3: {
+            auto it = m.find(k);
+            if(it != m.end()){
+                it = m.erase(it);
+                u.erase(k);
+            }
+            break;
+        }
+        case 4:
+            assert(m.count(k) == u.count(k));
+            break;
+        }
+        if(step % 1000 == 0)
+            assert(same(m, u));
+    }
+    assert(same(m, u));
+}
+
+// every key collides, so the probe runs are as long as the table is full
+struct bad_hash{
+    size_t operator()(int) const { return 42; }
+    size_t operator()(const string&) const { return 42; }
+};
+
+void test_collisions(){
+    learnSTL::flat_hash_map<int, int, bad_hash> m;
+    std::unordered_map<int, int> u;
+    for(int i = 0; i < 500; ++i){
+        m[i] = i;
+        u[i] = i;
+    }
+    assert(same(m, u));
+    for(int i = 0; i < 500; i += 3){
+        m.erase(i);
+        u.erase(i);
+    }
+    assert(same(m, u));
+    for(int i = 0; i < 500; i += 2){
+        m[i] = -i;
+        u[i] = -i;
+    }
+    assert(same(m, u));
+
+    // every key in one probe run: a key behind erased ones is still found
+    // and its arguments are left alone, an erased one is inserted again
+    learnSTL::flat_hash_map<string, string, bad_hash> run;
+    for(int i = 0; i < 6; ++i)
+        run.try_emplace(to_string(i), "v");
+    assert(run.erase("1") == 1 && run.erase("3") == 1);
+    string k = "4", v = "other";
+    assert(!run.try_emplace(learnSTL::move(k), learnSTL::move(v)).second && k == "4" && v == "other");
+    assert(!run.insert_or_assign(k, learnSTL::move(v)).second && run[k] == "other" && v.empty());
+    v = "back";
+    assert(run.try_emplace("3", learnSTL::move(v)).second && v.empty() && run.size() == 5 && run["3"] == "back");
+    assert(run.count("1") == 0 && run["5"] == "v");
+}
+
+void test_erase_iterating(){
+    // erasing while walking visits each element once, including the ones
+    // shifted back into the freed slots
+    Mymap m;
+    for(int i = 0; i < 5000; ++i)
+        m[i * 7] = i;
+    std::unordered_set<int> seen;
+    size_t erased = 0;
+    for(auto it = m.begin(); it != m.end(); ){
+        assert(seen.insert(it->first).second);
+        if(it->second % 3 != 0){
+            it = m.erase(it);
+            ++erased;
+        }
+        else
+            ++it;
+    }
+    assert(seen.size() == 5000 && m.size() == 5000 - erased);
+    for(const auto& v : m)
+        assert(v.second % 3 == 0 && m.find(v.first) != m.end());
+
+    // a range: everything from the fifth element to the end, then all
+    auto first = m.begin();
+    for(int i = 0; i < 5; ++i)
+        ++first;
+    auto it = m.erase(first, m.cend());
+    assert(it == m.end() && m.size() == 5);
+    for(const auto& v : m)
+        assert(m.find(v.first) != m.end());
+
+    learnSTL::flat_hash_map<int, int, bad_hash> c;
+    for(int i = 0; i < 100; ++i)
+        c[i] = i;
+    auto b = c.begin();
+    for(int i = 0; i < 10; ++i)
+        ++b;
+    auto e = b;
+    for(int i = 0; i < 30; ++i)
+        ++e;
+    std::unordered_set<int> gone;
+    for(auto i = b; i != e; ++i)
+        gone.insert(i->first);
+    c.erase(b, e);
+    assert(c.size() == 70 && gone.size() == 30);
+    for(int i = 0; i < 100; ++i)
+        assert(c.count(i) == !gone.count(i));
+    size_t n = 0;
+    for(const auto& v : c){
+        assert(c.at(v.first) == v.first);
+        ++n;
+    }
+    assert(n == 70);
+    m.erase(m.begin(), m.end());
+    assert(m.empty());
+}
+
+// string lookup without building a string
+struct str_hash{
+    typedef void is_transparent;
+    size_t operator()(const string& s) const { return std::hash<string>()(s); }
+    size_t operator()(const char* s) const { return std::hash<string>()(string(s)); }
+};
+struct str_equal{
+    typedef void is_transparent;
+    bool operator()(const string& a, const string& b) const { return a == b; }
+    bool operator()(const string& a, const char* b) const { return a == b; }
+};
+
+void test_heterogeneous(){
+    learnSTL::flat_hash_map<string, int, str_hash, str_equal> m;
+    m["apple"] = 1;
+    m["pear"] = 2;
+    const char* key = "pear";
+    assert(m.find(key)->second == 2 && m.count(key) == 1 && m.contains("apple") && !m.contains("plum"));
+    assert(m.equal_range(key).first == m.find(string("pear")));
+    const auto& cm = m;
+    assert(cm.find("apple")->second == 1);
+}
+
+void test_reserve(){
+    Mymap m;
+    m.reserve(1000);
+    const size_t buckets = m.bucket_count();
+    assert(buckets >= 1000);
+    for(int i = 0; i < 1000; ++i)
+        m[i] = i;
+    assert(m.bucket_count() == buckets && m.load_factor() <= m.max_load_factor());
+    m.rehash(0);                            // shrinks to what the elements need
+    assert(m.bucket_count() <= buckets && m.size() == 1000 && m[999] == 999);
+    m.clear();
+    m.rehash(0);
+    assert(m.bucket_count() == 0 && m.empty());
+    Mymap m2(100);
+    assert(m2.bucket_count() >= 100 && m2.empty());
+}
+
+void test_allocator(){
+    typedef learnSTL::arena_allocator<learnSTL::pair<const int, string> > Myal;
+    typedef learnSTL::flat_hash_map<int, string, std::hash<int>, std::equal_to<int>, Myal> Amap;
+    learnSTL::monotonic_arena a1, a2;
+    Amap m1(0, std::hash<int>(), std::equal_to<int>(), Myal{a1}), m2(Myal{a2});
+    for(int i = 0; i < 100; ++i)
+        m1[i] = to_string(i);
+    m2 = m1;
+    assert(m2 == m1 && m2.get_allocator().arena() == &a1);
+    Amap m3(learnSTL::move(m1), Myal{a2});
+    assert(m3.size() == 100 && m3.get_allocator().arena() == &a2 && m3[42] == "42");
+
+    learnSTL::flat_hash_set<int, std::hash<int>, std::equal_to<int>, learnSTL::pool_allocator<int> > s;
+    for(int i = 0; i < 1000; ++i)
+        s.insert(i);
+    assert(s.size() == 1000 && s.contains(999));
+}
+
+// a grow whose second allocation fails leaves the table as it was
+void test_failed_grow(){
+    int left = -1;
+    typedef learnSTL::flat_hash_map<int, int, std::hash<int>, std::equal_to<int>, FailAlloc<learnSTL::pair<const int, int> > > Fmap;
+    Fmap m(0, std::hash<int>(), std::equal_to<int>(), FailAlloc<learnSTL::pair<const int, int> >(&left));
+    for(int i = 0; i < 14; ++i)
+        m[i] = i;
+    const size_t buckets = m.bucket_count();
+    left = 1;                               // the control bytes, then not the slots
+    bool thrown = false;
+    try{
+        m[14] = 14;
+    }
+    catch(const std::bad_alloc&){
+        thrown = true;
+    }
+    assert(thrown && m.size() == 14 && m.bucket_count() == buckets && !m.contains(14));
+    for(int i = 0; i < 14; ++i)
+        assert(m.at(i) == i);
+    m[14] = 14;
+    assert(m.size() == 15 && m.bucket_count() > buckets && m[14] == 14 && m[0] == 0);
+}
+
+int main(){
+    test_basic();
+    test_model();
+    test_collisions();
+    test_erase_iterating();
+    test_heterogeneous();
+    test_reserve();
+    test_allocator();
+    test_failed_grow();
+    cout << "SUCCESS test flat_hash_map" << endl;
+}
@@ -0,0 +1,337 @@
+#include "../flat_map.h"
+#include "../vector.h"
+#include "../allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <map>
+#include <set>
+#include <algorithm>
+using namespace std;
+
+typedef learnSTL::flat_map<int, int> Mymap;
+typedef learnSTL::flat_set<int> Myset;
+
+// the map agrees with the model and both columns are in key order
+template<typename M, typename U>
+bool same(const M& m, const U& u){
+    if(m.size() != u.size() || m.keys().size() != m.values().size())
+        return false;
+    auto it = m.begin();
+    size_t i = 0;
+    for(auto v = u.begin(); v != u.end(); ++v, ++it, ++i)
+        if(it->first != v->first || it->second != v->second ||
+           m.keys()[i] != v->first || m.values()[i] != v->second)
+            return false;
+    return it == m.end();
+}
+
+void test_set(){
+    Myset s1;
+    assert(s1.empty() && s1.begin() == s1.end() && s1.find(1) == s1.end() && s1.erase(1) == 0);
+    assert(s1.insert(3).second && s1.insert(1).second && !s1.insert(3).second && s1.size() == 2);
+    assert(*s1.begin() == 1 && *s1.rbegin() == 3 && s1.contains(3) && s1.count(2) == 0);
+    auto it = s1.insert(s1.end(), 5);
+    assert(*it == 5 && s1.size() == 3);
+    it = s1.insert(s1.begin(), 4);          // a wrong hint still puts it in place
+    assert(*it == 4 && *(it - 1) == 3 && s1.size() == 4);
+    assert(*s1.lower_bound(2) == 3 && *s1.upper_bound(3) == 4 && s1.equal_range(4).second - s1.equal_range(4).first == 1);
+    assert(s1.emplace(2).second && *s1.emplace_hint(s1.end(), 2) == 2 && s1.size() == 5);
+
+    Myset s2{9, 7, 7, 8};
+    assert(s2.size() == 3 && *s2.begin() == 7 && s1 != s2 && s1 < s2);
+    s2.insert({1, 2, 3, 4, 5, 9});
+    int expect[] = {1, 2, 3, 4, 5, 7, 8, 9};
+    assert(learnSTL::equal(s2.begin(), s2.end(), expect));
+    assert(s2.erase(7) == 1 && s2.erase(s2.begin()) == s2.begin() && s2.size() == 6);
+    s2.erase(s2.begin(), s2.begin() + 2);
+    assert(s2.size() == 4 && *s2.begin() == 4);
+
+    learnSTL::vector<int> raw{5, 3, 5, 1};
+    Myset s3(raw);
+    assert(s3.size() == 3 && s3.keys()[0] == 1 && s3.keys()[2] == 5);
+    learnSTL::vector<int> keys = learnSTL::move(s3).extract();
+    assert(s3.empty() && keys.size() == 3);
+    keys.push_back(8);
+    s3.replace(learnSTL::move(keys));
+    assert(s3.size() == 4 && s3.contains(8));
+    Myset s4(learnSTL::sorted_unique, learnSTL::vector<int>{2, 4, 6});
+    assert(s4.size() == 3 && s4.contains(4));
+    learnSTL::swap(s3, s4);
+    assert(s3.size() == 3 && s4.size() == 4);
+
+    learnSTL::flat_set<string, std::greater<string> > g{"b", "c", "a"};
+    assert(*g.begin() == "c" && *g.rbegin() == "a" && g.find("b") != g.end());
+}
+
+void test_map(){
+    Mymap m1;
+    assert(m1.empty() && m1.size() == 0 && m1.begin() == m1.end());
+    assert(m1.find(3) == m1.end() && m1.count(3) == 0 && m1.erase(3) == 0 && m1.lower_bound(3) == m1.end());
+    auto r = m1.insert(learnSTL::make_pair(1, 10));
+    assert(r.second && r.first->first == 1 && r.first->second == 10);
+    r = m1.insert(learnSTL::make_pair(1, 11));
+    assert(!r.second && r.first->second == 10 && m1.size() == 1);
+    m1[2] = 20;
+    m1[3];
+    assert(m1.size() == 3 && m1.at(2) == 20 && m1[3] == 0 && m1.contains(3));
+    bool thrown = false;
+    try{
+        m1.at(4);
+    }
+    catch(const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown);
+    assert(m1.try_emplace(4, 40).second && !m1.try_emplace(4, 41).second && m1[4] == 40);
+    assert(!m1.insert_or_assign(4, 42).second && m1[4] == 42);
+    assert(m1.insert_or_assign(0, 1).second && m1.begin()->first == 0);
+    assert(m1.emplace(5, 50).second && !m1.emplace(5, 51).second);
+    assert(m1.lower_bound(5)->first == 5 && m1.upper_bound(5) == m1.end() && m1.upper_bound(0)->first == 1);
+    auto er = m1.equal_range(5);
+    assert(er.second - er.first == 1 && er.first->second == 50);
+    assert(m1.erase(5) == 1 && m1.erase(5) == 0 && m1.size() == 5);
+    assert(m1.value_comp()(*m1.begin(), *m1.find(2)) && m1.key_comp()(1, 2));
+
+    Mymap::const_iterator ci = m1.find(2);
+    Mymap::iterator it = m1.find(2);
+    assert(ci == it && it->second == 20 && (*ci).first == 2);
+    it->second = 21;
+    (*++it).second = 31;
+    assert(m1.at(2) == 21 && m1.at(3) == 31);
+    assert(it - m1.begin() == 3 && m1.begin()[3].second == 31 && (m1.begin() + 3) == it && it > ci);
+
+    Mymap m2(m1), m3{{7, 70}, {8, 80}, {7, 71}};
+    assert(m2 == m1 && m3 != m1 && m3.size() == 2 && m3[7] == 70);
+    m3 = m1;
+    assert(m3 == m1);
+    m3 = {{9, 90}};
+    assert(m3.size() == 1 && m3[9] == 90);
+    Mymap m4(learnSTL::move(m3));
+    assert(m4.size() == 1);
+    learnSTL::swap(m3, m4);
+    assert(m3.size() == 1 && m3[9] == 90);
+    m1.erase(m1.begin() + 1, m1.begin() + 3);
+    assert(m1.size() == 3 && m1.begin()->first == 0 && (m1.begin() + 1)->first == 3);
+    m1.clear();
+    assert(m1.empty() && m1.begin() == m1.end());
+
+    // the columns, in and out
+    Mymap m5(learnSTL::vector<int>{3, 1, 2, 1}, learnSTL::vector<int>{30, 10, 20, 11});
+    assert(m5.size() == 3 && m5[1] == 10 && m5.keys()[0] == 1 && m5.values()[2] == 30);
+    Mymap::containers c = m5.extract();
+    assert(m5.empty() && c.keys.size() == 3 && c.values[1] == 20);
+    c.keys.push_back(4);
+    c.values.push_back(40);
+    m5.replace(learnSTL::move(c.keys), learnSTL::move(c.values));
+    assert(m5.size() == 4 && m5.at(4) == 40);
+    Mymap m6(learnSTL::sorted_unique, learnSTL::vector<int>{1, 2}, learnSTL::vector<int>{5, 6});
+    assert(m6.at(2) == 6);
+
+    learnSTL::flat_map<string, string> s;
+    s["b"] = "2";
+    s.emplace("a", "1");
+    s.try_emplace("c", 3, 'x');
+    assert(s.size() == 3 && s.begin()->second == "1" && s.at("c") == "xxx");
+    for(auto p : s)
+        p.second += "!";
+    assert(s["a"] == "1!" && s["b"] == "2!");
+}
+
+void test_model(){
+    Mymap m;
+    std::map<int, int> u;
+    unsigned x = 77;
+    for(int step = 0; step < 20000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int k = static_cast<int>(r % 1000);
+        switch(r % 5){
+        case 0:
+            m[k] = step;
+            u[k] = step;
+            break;
+        case 1:
+            assert(m.insert(learnSTL::make_pair(k, step)).second == u.insert(std::make_pair(k, step)).second);
+            break;
+        case 2:
+            assert(m.erase(k) == u.erase(k));
+            break;
+        case 3: {
+            auto it = m.lower_bound(k);
+            auto v = u.lower_bound(k);
+            assert((it == m.end()) == (v == u.end()));
+            if(it != m.end()){
+                assert(it->first == v->first);
+                it = m.erase(it);
+                v = u.erase(v);
+                assert((it == m.end()) == (v == u.end()) && (it == m.end() || it->first == v->first));
+            }
+            break;
+        }
+        case 4:
+            assert(m.count(k) == u.count(k));
+            break;
+        }
+        if(step % 1000 == 0)
+            assert(same(m, u));
+    }
+    assert(same(m, u));
+}
+
+// a range goes in with one sort and one merge; of equal keys the one
+// already there, and then the first one of the range, stays
+void test_bulk(){
+    Mymap m;
+    std::map<int, int> u;
+    unsigned x = 5;
+    for(int round = 0; round < 50; ++round){
+        learnSTL::vector<learnSTL::pair<int, int> > batch;
+        const int n = static_cast<int>(x % 2000);
+        for(int i = 0; i < n; ++i){
+            x = x * 1103515245 + 12345;
+            int k = static_cast<int>((x >> 16) % 20000);
+            batch.push_back(learnSTL::make_pair(k, round * 10000 + i));
+            u.insert(std::make_pair(k, round * 10000 + i));
+        }
+        m.insert(batch.begin(), batch.end());
+        assert(same(m, u));
+    }
+
+    // ascending input past the end keeps every element in place
+    Mymap a;
+    learnSTL::vector<learnSTL::pair<int, int> > up;
+    for(int i = 0; i < 1000; ++i)
+        up.push_back(learnSTL::make_pair(i, -i));
+    a.insert(up.begin(), up.end());
+    a.insert(up.begin() + 500, up.end());
+    assert(a.size() == 1000 && a[999] == -999);
+
+    Myset s;
+    std::set<int> v;
+    for(int round = 0; round < 20; ++round){
+        learnSTL::vector<int> batch;
+        for(int i = 0; i < 500; ++i){
+            x = x * 1103515245 + 12345;
+            batch.push_back(static_cast<int>((x >> 16) % 5000));
+            v.insert(batch.back());
+        }
+        s.insert(batch.begin(), batch.end());
+        assert(s.size() == v.size());
+        auto it = s.begin();
+        for(int k : v)
+            assert(*it++ == k);
+    }
+}
+
+// the key goes back out when the value cannot be built
+struct thrower{
+    int v;
+    thrower(int x) : v(x) { if(x < 0) throw 1; }
+};
+
+// converts to a key, or throws for a negative one
+struct tokey{
+    int v;
+    operator int() const {
+        if(v < 0)
+            throw 1;
+        return v;
+    }
+};
+
+void test_exception(){
+    learnSTL::flat_map<int, thrower> m;
+    m.try_emplace(1, 1);
+    m.try_emplace(3, 3);
+    bool thrown = false;
+    try{
+        m.try_emplace(2, -1);
+    }
+    catch(int){
+        thrown = true;
+    }
+    assert(thrown && m.size() == 2 && m.keys().size() == m.values().size() && !m.contains(2));
+    assert(m.at(3).v == 3);
+
+    // a range insert that throws takes back what it appended
+    learnSTL::flat_set<int> s{1, 3};
+    tokey in[] = {{5}, {4}, {-1}};
+    thrown = false;
+    try{
+        s.insert(in, in + 3);
+    }
+    catch(int){
+        thrown = true;
+    }
+    assert(thrown && s.size() == 2 && !s.contains(5) && !s.contains(4));
+    s.insert(in, in + 2);
+    assert(s.size() == 4 && *(s.end() - 1) == 5);
+}
+
+// every copy or move spends one of budget, and throws when none is left
+struct budgeted{
+    static int budget;
+    int v;
+    budgeted(int x) : v(x) {}
+    budgeted(const budgeted& o) : v(o.v) { spend(); }
+    budgeted(budgeted&& o) : v(o.v) { spend(); }
+    budgeted& operator=(const budgeted& o) { v = o.v; return *this; }
+    static void spend(){
+        if(budget-- == 0)
+            throw 1;
+    }
+};
+int budgeted::budget = -1;
+
+// a merge that throws leaves each key with its own value
+void test_merge_throws(){
+    pair<int, budgeted> in[] = {{5, 50}, {1, 10}, {13, 130}, {7, 70}, {-2, -20}};
+    for(int n = 0; n < 60; ++n){
+        learnSTL::flat_map<int, budgeted> m;
+        for(int k = 0; k < 20; k += 2)
+            m.emplace(k, k * 10);
+        budgeted::budget = n;
+        bool thrown = false;
+        try{
+            m.insert(in, in + 5);
+        }
+        catch(int){
+            thrown = true;
+        }
+        budgeted::budget = -1;
+        assert(m.size() == (thrown ? 10u : 15u) && m.keys().size() == m.values().size());
+        assert(std::is_sorted(m.keys().begin(), m.keys().end()));
+        for(size_t i = 0; i != m.size(); ++i)
+            assert(m.values()[i].v == m.keys()[i] * 10);
+    }
+}
+
+// a merge rebuilds the columns with their own allocators
+void test_allocator(){
+    learnSTL::monotonic_arena a;
+    typedef learnSTL::vector<int, learnSTL::arena_allocator<int> > Avec;
+    learnSTL::arena_allocator<int> al(a);
+    learnSTL::flat_set<int, std::less<int>, Avec> s{Avec(al)};
+    int in[] = {5, 1, 4, 1, 3};
+    s.insert(in, in + 5);
+    s.insert(in, in + 2);
+    assert(s.size() == 4 && *s.begin() == 1 && s.keys().get_allocator().arena() == &a);
+
+    learnSTL::flat_map<int, int, std::less<int>, Avec, Avec> m{Avec(al), Avec(al)};
+    learnSTL::pair<int, int> kv[] = {{3, 30}, {1, 10}, {2, 20}};
+    m.insert(kv, kv + 3);
+    assert(m.size() == 3 && m.at(1) == 10 && m.keys().get_allocator().arena() == &a &&
+           m.values().get_allocator().arena() == &a);
+}
+
+int main(){
+    test_set();
+    test_map();
+    test_model();
+    test_bulk();
+    test_exception();
+    test_merge_throws();
+    test_allocator();
+    cout << "SUCCESS test flat_map" << endl;
+}
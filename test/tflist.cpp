@@ -1,12 +1,200 @@
 #include "../forward_list.h"
+#include "../execution.h"
 #include <iostream>
 #include <cassert>
 #include <algorithm>
+#include <atomic>
 using namespace std;
 
+struct key_less{
+    bool operator()(const pair<int, int>& a, const pair<int, int>& b) const { return a.first < b.first; }
+};
+
+// sorted by key and, within a key, in the order the elements were inserted
+template<typename List>
+bool stable_sorted(const List& f){
+    auto i = f.begin(), e = f.end();
+    if(i == e)
+        return true;
+    for(auto j = learnSTL::next(i); j != e; ++i, ++j)
+        if(j->first < i->first || (j->first == i->first && j->second < i->second))
+            return false;
+    return true;
+}
+
+void test_sort(){
+    learnSTL::forward_list<int> f0;
+    f0.sort();
+    assert(f0.empty());
+    learnSTL::forward_list<int> f1{5, 4, 3, 3, 2, 1, 7, 8, 9, 0};
+    f1.sort();
+    assert(f1 == (learnSTL::forward_list<int>{0, 1, 2, 3, 3, 4, 5, 7, 8, 9}));
+
+    // runs of every kind, with many equal keys
+    for(int n : {1, 2, 3, 100, 5000, 20000}){
+        learnSTL::forward_list<pair<int, int> > f2, f3, f4;
+        unsigned x = 12345;
+        for(int i = n; i > 0; --i){
+            x = x * 1103515245 + 12345;
+            f2.push_front(make_pair(int(x >> 16) % 97, i));
+            f3.push_front(make_pair(i / 3, i));
+            f4.push_front(make_pair((i / 50) % 2 ? i : n - i, i));
+        }
+        learnSTL::forward_list<pair<int, int> > p2(f2), p4(f4);
+        f2.sort(key_less());
+        f3.sort(key_less());
+        f4.sort(key_less());
+        assert(stable_sorted(f2) && stable_sorted(f3) && stable_sorted(f4));
+        p2.sort(learnSTL::execution::par, key_less());
+        p4.sort(learnSTL::execution::par, key_less());
+        assert(p2 == f2 && p4 == f4);
+    }
+
+    learnSTL::forward_list<int> f5;
+    for(int i = 0; i < 10000; ++i)
+        f5.push_front(i % 7);
+    f5.sort(learnSTL::execution::par);
+    assert(std::is_sorted(f5.begin(), f5.end()) && f5.front() == 0);
+}
+
+typedef learnSTL::forward_list<int, std::allocator<int>, learnSTL::track_size_and_tail> tracked_list;
+
+tracked_list::iterator nth(tracked_list& f, int n){
+    auto i = f.begin();
+    learnSTL::advance(i, n);
+    return i;
+}
+
+// size and back agree with a walk of the list
+bool consistent(const tracked_list& f){
+    size_t n = 0;
+    auto last = f.before_begin();
+    for(auto i = f.begin(); i != f.end(); ++i, ++last)
+        ++n;
+    return n == f.size() && (n == 0 || *last == f.back());
+}
+
+void test_track(){
+    assert(sizeof(learnSTL::forward_list<int>) == sizeof(void*) * 2);
+    tracked_list f1;
+    assert(f1.size() == 0 && consistent(f1));
+    f1.push_back(1);
+    f1.push_back(2);
+    f1.push_front(0);
+    f1.emplace_back(3);
+    assert(f1.size() == 4 && f1.back() == 3 && consistent(f1));
+    f1.insert_after(f1.before_begin(), 3, 9);
+    f1.insert_after(nth(f1, 6), {4, 5});
+    assert(f1.size() == 9 && f1.back() == 5 && consistent(f1));
+    f1.erase_after(nth(f1, 6), f1.end());
+    assert(f1.back() == 3 && consistent(f1));
+    f1.erase_after(nth(f1, 5));
+    assert(f1.back() == 2 && consistent(f1));
+    f1.remove(9);
+    assert(f1.size() == 3 && consistent(f1));
+    f1.pop_front();
+    f1.pop_front();
+    f1.pop_front();
+    assert(f1.empty() && consistent(f1));
+
+    // whole-list splice and append
+    tracked_list f2{1, 2, 3}, f3{4, 5}, f4{0};
+    f2.append(f3);
+    assert(f3.size() == 0 && consistent(f3) && f2.size() == 5 && f2.back() == 5 && consistent(f2));
+    f2.splice_after(f2.before_begin(), f4);
+    assert(f2.size() == 6 && f2.front() == 0 && consistent(f2) && consistent(f4));
+    f4.splice_after(f4.before_begin(), f2, nth(f2, 4));
+    assert(f4.size() == 1 && f4.back() == 5 && consistent(f4));
+    assert(f2.size() == 5 && f2.back() == 4 && consistent(f2));
+    f4.splice_after(f4.begin(), f2, f2.begin(), f2.end());
+    assert(f2.size() == 1 && consistent(f2) && f4.size() == 5 && f4.back() == 4 && consistent(f4));
+
+    // reordering keeps the tail
+    f4.reverse();
+    assert(f4.back() == 5 && consistent(f4));
+    f4.sort(learnSTL::execution::par);
+    assert(f4.back() == 5 && consistent(f4));
+    tracked_list f5{2, 6, 7};
+    f4.merge(f5);
+    assert(f4.size() == 8 && f4.back() == 7 && consistent(f4) && consistent(f5));
+    f4.unique();
+    assert(f4.size() == 7 && consistent(f4));
+    f4.resize(3);
+    assert(f4.back() == 3 && consistent(f4));
+
+    // move and swap carry the bookkeeping along
+    tracked_list f6(learnSTL::move(f4));
+    assert(f4.size() == 0 && consistent(f4) && f6.size() == 3 && consistent(f6));
+    f6.swap(f4);
+    assert(f6.size() == 0 && f4.size() == 3 && consistent(f6) && consistent(f4));
+    f6 = learnSTL::move(f4);
+    f6.push_back(8);
+    assert(f6.size() == 4 && f6.back() == 8 && consistent(f6));
+    f6.clear();
+    f6.push_back(1);
+    assert(f6.size() == 1 && f6.front() == 1 && consistent(f6));
+}
+
+// a comparator that throws partway leaves every node in the list, and
+// size and back still agree with it
+void test_sort_throws(){
+    for(int par = 0; par < 2; ++par)
+        for(long limit : {1L, 100L, 5000L, 50000L, 200000L}){
+            tracked_list f;
+            unsigned x = 3;
+            long sum = 0;
+            for(int i = 0; i < 20000; ++i){
+                x = x * 1103515245 + 12345;
+                f.push_front(int(x >> 16) % 1000);
+                sum += f.front();
+            }
+            std::atomic<long> calls(0);
+            auto comp = [&calls, limit](int a, int b){
+                if(++calls == limit)
+                    throw 1;
+                return a < b;
+            };
+            bool thrown = false;
+            try{
+                if(par)
+                    f.sort(learnSTL::execution::par, comp);
+                else
+                    f.sort(comp);
+            }
+            catch(int){
+                thrown = true;
+            }
+            assert(thrown && f.size() == 20000 && consistent(f));
+            long after = 0;
+            for(int v : f)
+                after += v;
+            assert(after == sum);
+            f.sort(learnSTL::execution::par);
+            assert(std::is_sorted(f.begin(), f.end()) && consistent(f));
+        }
+
+    tracked_list f1{1, 3, 5, 7}, f2{0, 2, 4, 6, 8, 9};
+    int calls = 0;
+    bool thrown = false;
+    try{
+        f1.merge(f2, [&calls](int a, int b){
+            if(++calls == 4)
+                throw 1;
+            return a < b;
+        });
+    }
+    catch(int){
+        thrown = true;
+    }
+    assert(thrown && f1.size() == 10 && consistent(f1) && f2.size() == 0 && consistent(f2));
+}
+
 int main(){
     learnSTL::forward_list<int> f1{2, 2, 3, 3, 60};
     learnSTL::forward_list<int> f2{2, 2, 3, 3 };
     cout << boolalpha << (f1 <= f2) << endl;
+    test_sort();
+    test_track();
+    test_sort_throws();
     cout << "SUCCESS test forward_list" << endl;
 }
@@ -0,0 +1,161 @@
+#include "../indexed_heap.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <set>
+#include <map>
+#include <utility>
+using namespace std;
+
+typedef learnSTL::indexed_heap<int, int> Myheap;
+
+void test_basic(){
+    Myheap h;
+    assert(h.empty() && h.size() == 0 && !h.contains(1) && h.erase(1) == 0 && h.arity == 4);
+    assert(h.push(1, 50) && h.push(2, 20) && h.push(3, 40) && !h.push(2, 5));
+    assert(h.size() == 3 && h.top() == 2 && h.top_priority() == 20 && h.priority(2) == 20);
+    h.decrease_key(3, 10);
+    assert(h.top() == 3 && h.priority(3) == 10);
+    h.update_priority(3, 60);               // away from the top
+    assert(h.top() == 2 && h.priority(3) == 60);
+    h.update_priority(1, 1);
+    assert(h.top() == 1);
+    assert(h.erase(1) == 1 && !h.contains(1) && h.size() == 2 && h.top() == 2);
+    h.pop();
+    assert(h.top() == 3 && h.size() == 1 && !h.contains(2));
+    assert(h.push(2, 70) && h.top() == 3);  // the slot of an erased key is used again
+    bool thrown = false;
+    try{
+        h.update_priority(9, 0);
+    }
+    catch(const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown && h.size() == 2);
+
+    // the largest first, with std::less
+    learnSTL::indexed_heap<string, double, std::less<double> > m;
+    m.push("a", 1.5);
+    m.push("b", 2.5);
+    m.push("c", 0.5);
+    assert(m.top() == "b");
+    m.decrease_key("c", 3.0);
+    assert(m.top() == "c" && m.top_priority() == 3.0);
+    Myheap g;
+    g.push(7, 7);
+    learnSTL::swap(g, h);
+    assert(g.size() == 2 && h.size() == 1 && h.top() == 7);
+    h.clear();
+    assert(h.empty() && !h.contains(7) && h.push(7, 1));
+}
+
+// the heap agrees with an ordered set of (priority, key)
+template<size_t D>
+void test_model(){
+    learnSTL::indexed_heap<int, int, std::greater<int>, std::hash<int>, std::equal_to<int>, D> h;
+    std::set<pair<int, int> > u;
+    std::map<int, int> prio;
+    unsigned x = 77;
+    for(int step = 0; step < 100000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int k = static_cast<int>(r % 1000), p = static_cast<int>((x >> 6) % 100000);
+        auto it = prio.find(k);
+        switch(r % 5){
+        case 0:
+            assert(h.push(k, p) == (it == prio.end()));
+            if(it == prio.end()){
+                prio[k] = p;
+                u.insert(make_pair(p, k));
+            }
+            break;
+        case 1:
+            if(it != prio.end()){
+                h.update_priority(k, p);
+                u.erase(make_pair(it->second, k));
+                u.insert(make_pair(p, k));
+                it->second = p;
+            }
+            break;
+        case 2:
+            if(it != prio.end()){
+                p = it->second - p % 100;
+                h.decrease_key(k, p);
+                u.erase(make_pair(it->second, k));
+                u.insert(make_pair(p, k));
+                it->second = p;
+            }
+            break;
+        case 3:
+            assert(h.erase(k) == (it != prio.end() ? 1u : 0u));
+            if(it != prio.end()){
+                u.erase(make_pair(it->second, k));
+                prio.erase(it);
+            }
+            break;
+        case 4:
+            if(!u.empty()){
+                // equal priorities may come out in any order
+                assert(h.top_priority() == u.begin()->first && prio[h.top()] == h.top_priority());
+                u.erase(make_pair(h.top_priority(), h.top()));
+                prio.erase(h.top());
+                h.pop();
+            }
+            break;
+        }
+        assert(h.size() == u.size() && (u.empty() || h.top_priority() == u.begin()->first));
+    }
+    for(const auto& kp : prio)
+        assert(h.contains(kp.first) && h.priority(kp.first) == kp.second);
+    for(int last = -1000000; !h.empty(); h.pop()){
+        assert(h.top_priority() >= last);
+        last = h.top_priority();
+    }
+}
+
+// shortest paths on a grid: each node is in the heap once, its distance
+// lowered in place
+void test_dijkstra(){
+    const int n = 60;
+    auto weight = [](int v){ return 1 + (v * 7919) % 13; };
+    learnSTL::indexed_heap<int, long> h;
+    learnSTL::vector<long> dist(n * n, -1);
+    h.push(0, 0);
+    size_t most = 0;
+    while(!h.empty()){
+        const int v = h.top();
+        const long d = h.top_priority();
+        h.pop();
+        dist[v] = d;
+        const int r = v / n, c = v % n;
+        const int next[] = {r > 0 ? v - n : -1, r + 1 < n ? v + n : -1, c > 0 ? v - 1 : -1, c + 1 < n ? v + 1 : -1};
+        for(int w : next){
+            if(w < 0 || dist[w] >= 0)
+                continue;
+            const long nd = d + weight(w);
+            if(!h.push(w, nd) && nd < h.priority(w))
+                h.decrease_key(w, nd);
+        }
+        most = most < h.size() ? h.size() : most;
+    }
+    assert(most < size_t(4 * n));
+    // every distance is the best over the neighbours
+    for(int v = 1; v < n * n; ++v){
+        const int r = v / n, c = v % n;
+        long best = -1;
+        const int prev[] = {r > 0 ? v - n : -1, r + 1 < n ? v + n : -1, c > 0 ? v - 1 : -1, c + 1 < n ? v + 1 : -1};
+        for(int w : prev)
+            if(w >= 0 && (best < 0 || dist[w] < best))
+                best = dist[w];
+        assert(dist[v] == best + weight(v));
+    }
+}
+
+int main(){
+    test_basic();
+    test_model<2>();
+    test_model<4>();
+    test_model<5>();
+    test_dijkstra();
+    cout << "SUCCESS test indexed_heap" << endl;
+}
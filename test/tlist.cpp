@@ -0,0 +1,216 @@
+#include "../list.h"
+#include "../allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <algorithm>
+using namespace std;
+
+typedef learnSTL::list<int> Mycont;
+
+Mycont::iterator nth(Mycont& l, int n){
+    auto i = l.begin();
+    learnSTL::advance(i, n);
+    return i;
+}
+
+// the prev links agree with the next links and with size()
+template<typename List>
+bool consistent(const List& l){
+    size_t n = 0;
+    auto i = l.begin();
+    for(; i != l.end(); ++i){
+        auto j = i;
+        ++j;
+        --j;
+        if(j != i)
+            return false;
+        ++n;
+    }
+    size_t m = 0;
+    for(auto r = l.rbegin(); r != l.rend(); ++r)
+        ++m;
+    return n == l.size() && m == n;
+}
+
+void test_basic(){
+    Mycont l1;
+    assert(l1.empty() && l1.size() == 0 && l1.begin() == l1.end() && consistent(l1));
+    l1.push_back(2);
+    l1.push_front(1);
+    l1.emplace_back(3);
+    assert(l1.size() == 3 && l1.front() == 1 && l1.back() == 3 && consistent(l1));
+    auto it = l1.insert(learnSTL::next(l1.begin()), 2, 9);
+    assert(*it == 9 && l1 == (Mycont{1, 9, 9, 2, 3}));
+    it = l1.insert(l1.end(), {4, 5});
+    assert(*it == 4 && l1.size() == 7 && l1.back() == 5 && consistent(l1));
+    it = l1.erase(learnSTL::next(l1.begin()), nth(l1, 3));
+    assert(*it == 2 && l1 == (Mycont{1, 2, 3, 4, 5}));
+    l1.pop_back();
+    l1.pop_front();
+    assert(l1 == (Mycont{2, 3, 4}) && consistent(l1));
+    assert(*l1.rbegin() == 4 && *learnSTL::prev(l1.end()) == 4);
+
+    Mycont l2(l1), l3(3, 7);
+    assert(l2 == l1 && l3.size() == 3 && l1 < l3);
+    l3 = l1;
+    assert(l3 == l1);
+    l3.assign(5, 1);
+    assert(l3 == (Mycont{1, 1, 1, 1, 1}));
+    l3.assign({6, 5});
+    assert(l3 == (Mycont{6, 5}) && consistent(l3));
+    Mycont l4(learnSTL::move(l3));
+    assert(l3.empty() && consistent(l3) && l4 == (Mycont{6, 5}) && consistent(l4));
+    l3 = learnSTL::move(l4);
+    assert(l4.empty() && l3 == (Mycont{6, 5}));
+    l3.swap(l4);
+    assert(l3.empty() && consistent(l3) && l4.size() == 2 && consistent(l4));
+    learnSTL::swap(l1, l4);
+    assert(l1 == (Mycont{6, 5}) && l4 == (Mycont{2, 3, 4}) && consistent(l1) && consistent(l4));
+    l4.resize(1);
+    l4.resize(3, 8);
+    assert(l4 == (Mycont{2, 8, 8}) && consistent(l4));
+    l4.resize(5);
+    assert(l4.size() == 5 && l4.back() == 0);
+    l4.clear();
+    assert(l4.empty() && consistent(l4));
+}
+
+void test_splice(){
+    Mycont l1{1, 2, 3}, l2{4, 5, 6, 7};
+    l1.splice(learnSTL::next(l1.begin()), l2);
+    assert(l2.empty() && l1 == (Mycont{1, 4, 5, 6, 7, 2, 3}) && consistent(l1) && consistent(l2));
+    l2.splice(l2.end(), l1, l1.begin());
+    assert(l2 == (Mycont{1}) && l1.size() == 6 && consistent(l1));
+    l2.splice(l2.begin(), l1, learnSTL::next(l1.begin()), learnSTL::prev(l1.end()));
+    assert(l2 == (Mycont{5, 6, 7, 2, 1}) && l1 == (Mycont{4, 3}) && consistent(l1) && consistent(l2));
+    // within one list
+    l2.splice(l2.begin(), l2, learnSTL::prev(l2.end()));
+    assert(l2 == (Mycont{1, 5, 6, 7, 2}) && consistent(l2));
+    l2.splice(l2.end(), l2, l2.begin(), nth(l2, 2));
+    assert(l2 == (Mycont{6, 7, 2, 1, 5}) && l2.size() == 5 && consistent(l2));
+    l2.splice(l2.begin(), l2, l2.begin());
+    assert(l2.front() == 6 && consistent(l2));
+}
+
+void test_algorithms(){
+    Mycont l1{1, 1, 2, 3, 3, 3, 1, 4, 4};
+    l1.unique();
+    assert(l1 == (Mycont{1, 2, 3, 1, 4}) && consistent(l1));
+    l1.remove(l1.front());      // the value lives in the list
+    assert(l1 == (Mycont{2, 3, 4}) && consistent(l1));
+    l1.remove_if([](int x){ return x % 2 == 0; });
+    assert(l1 == (Mycont{3}) && consistent(l1));
+    l1.reverse();
+    assert(l1 == (Mycont{3}));
+    Mycont l2{1, 2, 3, 4};
+    l2.reverse();
+    assert(l2 == (Mycont{4, 3, 2, 1}) && consistent(l2));
+
+    Mycont l3{1, 3, 5, 7}, l4{0, 2, 3, 8, 9};
+    l3.merge(l4);
+    assert(l4.empty() && l3 == (Mycont{0, 1, 2, 3, 3, 5, 7, 8, 9}) && consistent(l3) && consistent(l4));
+
+    // sort and merge are stable
+    typedef learnSTL::list<pair<int, int> > Pcont;
+    auto key_less = [](const pair<int, int>& a, const pair<int, int>& b){ return a.first < b.first; };
+    for(int n : {0, 1, 2, 3, 100, 5000}){
+        Pcont p1, p2;
+        unsigned x = 99;
+        for(int i = 0; i < n; ++i){
+            x = x * 1103515245 + 12345;
+            p1.push_back(make_pair(int(x >> 16) % 31, i));
+            p2.push_back(make_pair((i / 20) % 2 ? i : n - i, n + i));
+        }
+        p1.sort(key_less);
+        p2.sort(key_less);
+        assert(consistent(p1) && consistent(p2));
+        assert(std::is_sorted(p1.begin(), p1.end()));
+        p1.merge(p2, key_less);
+        assert(p1.size() == size_t(2 * n) && consistent(p1));
+        assert(std::is_sorted(p1.begin(), p1.end(), [](const pair<int, int>& a, const pair<int, int>& b){
+            return a.first < b.first || (a.first == b.first && a.second < b.second);
+        }));
+    }
+}
+
+// a comparator that throws partway leaves every element in a closed ring
+void test_sort_throws(){
+    for(int limit : {1, 5, 50, 300, 2000}){
+        Mycont l;
+        unsigned x = 7;
+        long sum = 0;
+        for(int i = 0; i < 500; ++i){
+            x = x * 1103515245 + 12345;
+            l.push_back(int(x >> 16) % 1000);
+            sum += l.back();
+        }
+        int calls = 0;
+        bool thrown = false;
+        try{
+            l.sort([&calls, limit](int a, int b){
+                if(++calls == limit)
+                    throw 1;
+                return a < b;
+            });
+        }
+        catch(int){
+            thrown = true;
+        }
+        assert(thrown && consistent(l) && l.size() == 500);
+        long after = 0;
+        for(int v : l)
+            after += v;
+        assert(after == sum);
+        l.sort();
+        assert(std::is_sorted(l.begin(), l.end()) && consistent(l));
+    }
+}
+
+void test_node_handle(){
+    typedef learnSTL::list<string, learnSTL::pool_allocator<string> > Slist;
+    Slist l1{"a", "b", "c"}, l2;
+    const string* addr = &l1.back();
+    Slist::node_type nh = l1.extract(learnSTL::prev(l1.end()));
+    assert(!nh.empty() && nh && nh.value() == "c" && l1.size() == 2 && consistent(l1));
+    nh.value() += "c";
+    auto it = l2.insert(l2.end(), learnSTL::move(nh));
+    assert(nh.empty() && !nh && *it == "cc" && &*it == addr && l2.size() == 1 && consistent(l2));
+    it = l2.insert(l2.begin(), Slist::node_type());
+    assert(it == l2.begin() && l2.size() == 1);
+
+    // moving an element to the front without a new node, as an LRU cache does
+    Slist::node_type nh2 = l1.extract(l1.begin());
+    Slist::node_type nh3(learnSTL::move(nh2));
+    assert(nh2.empty() && nh3.value() == "a");
+    learnSTL::swap(nh2, nh3);
+    assert(nh3.empty() && nh2.value() == "a");
+    l1.insert(l1.end(), learnSTL::move(nh2));
+    assert(l1 == (Slist{"b", "a"}) && consistent(l1));
+    Slist::node_type nh4 = l1.extract(l1.begin());  // freed by the handle
+    assert(nh4.get_allocator() == l1.get_allocator());
+}
+
+void test_allocator(){
+    typedef learnSTL::arena_allocator<int> Myal;
+    typedef learnSTL::list<int, Myal> Alist;
+    learnSTL::monotonic_arena a1, a2;
+    Alist l1({1, 2, 3}, Myal{a1}), l2(Myal{a2});
+    l2 = l1;
+    assert(l2 == l1 && l2.get_allocator().arena() == &a1);
+    Alist l3(learnSTL::move(l1), Myal{a2});
+    assert(l3.size() == 3 && l3.get_allocator().arena() == &a2 && consistent(l3));
+    Alist l4(Myal{a2});
+    l4 = learnSTL::move(l2);
+    assert(l2.empty() && l4.size() == 3 && l4.get_allocator().arena() == &a1 && consistent(l4));
+}
+
+int main(){
+    test_basic();
+    test_splice();
+    test_algorithms();
+    test_sort_throws();
+    test_node_handle();
+    test_allocator();
+    cout << "SUCCESS test list" << endl;
+}
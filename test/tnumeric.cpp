@@ -9,6 +9,70 @@ using namespace std;
 multiplies<char> multipliesf;
 plus<char> plusf;
 
+void test_fast_accumulate()
+{
+    // exact sums: every policy has to agree with accumulate
+    static int iv[10007];
+    for(int i = 0; i < 10007; ++i)
+        iv[i] = i % 97 - 40;
+    int isum = learnSTL::accumulate(iv, iv + 10007, 3);
+    assert(learnSTL::fast_accumulate(iv, iv + 10007, 3) == isum);
+    assert(learnSTL::fast_accumulate(iv, iv + 10007, 3, learnSTL::reassociation::strict) == isum);
+    assert(learnSTL::fast_accumulate(iv, iv + 10007, 3, learnSTL::reassociation::kahan) == isum);
+    assert(learnSTL::dot(iv, iv + 10007, iv, 0) == learnSTL::inner_product(iv, iv + 10007, iv, 0));
+    static double dv[10007];
+    for(int i = 0; i < 10007; ++i)
+        dv[i] = i % 16 * 0.25;
+    double dsum = learnSTL::accumulate(dv, dv + 10007, 1.0);
+    assert(learnSTL::fast_accumulate(dv, dv + 10007, 1.0) == dsum);
+    assert(learnSTL::fast_accumulate(dv, dv + 10007, 1.0, learnSTL::reassociation::kahan) == dsum);
+    assert(learnSTL::dot(dv, dv + 10007, dv, 0.0) == learnSTL::inner_product(dv, dv + 10007, dv, 0.0));
+    assert(learnSTL::dot(dv, dv + 10007, dv, 0.0, learnSTL::reassociation::kahan) ==
+           learnSTL::inner_product(dv, dv + 10007, dv, 0.0));
+
+    // 1 + many tiny terms: the strict float sum loses them all, the others do not
+    static float fv[100001];
+    fv[0] = 1.0f;
+    for(int i = 1; i < 100001; ++i)
+        fv[i] = 1e-8f;
+    assert(learnSTL::fast_accumulate(fv, fv + 100001, 0.0f, learnSTL::reassociation::strict) == 1.0f);
+    float k = learnSTL::fast_accumulate(fv, fv + 100001, 0.0f, learnSTL::reassociation::kahan);
+    float p = learnSTL::fast_accumulate(fv, fv + 100001, 0.0f, learnSTL::reassociation::pairwise);
+    assert(k > 1.00099f && k < 1.00101f);
+    assert(p > 1.00099f && p < 1.00101f);
+    assert(learnSTL::dot(fv, fv + 100001, fv, 0.0f, learnSTL::reassociation::kahan) == 1.0f);
+
+    // any input iterator
+    char buf[] = "\1\2\3\4\5\6";
+    assert(learnSTL::fast_accumulate(buf, buf + 6, 0L) == 21);
+    assert(learnSTL::fast_accumulate(buf, buf + 6, 0L, learnSTL::reassociation::kahan) == 21);
+    assert(learnSTL::dot(buf, buf + 6, buf, 0L) == 91);
+}
+
+// vector scans against the plain loops, lengths around the vector widths
+template<typename T>
+void test_simd_scan()
+{
+    T in[300], out[300], expect[300];
+    for(int n = 0; n < 300; n += (n < 40 ? 1 : 37)){
+        for(int i = 0; i < n; ++i)
+            in[i] = T(i % 13) - T(4);
+        learnSTL::partial_sum<T*, T*>(in, in + n, expect);      // explicit arguments pick the loop
+        assert(learnSTL::partial_sum(in, in + n, out) == out + n && std::equal(out, out + n, expect));
+        assert(learnSTL::inclusive_scan(in, in + n, out) == out + n && std::equal(out, out + n, expect));
+        learnSTL::inclusive_scan(in, in + n, out, learnSTL::__plus<T>(), T(5));
+        for(int i = 0; i < n; ++i)
+            assert(out[i] == expect[i] + T(5));
+        learnSTL::exclusive_scan(in, in + n, out, T(5));
+        for(int i = 0; i < n; ++i)
+            assert(out[i] == (i ? expect[i - 1] : T(0)) + T(5));
+        learnSTL::adjacent_difference<T*, T*>(in, in + n, expect);
+        assert(learnSTL::adjacent_difference(in, in + n, out) == out + n && std::equal(out, out + n, expect));
+        learnSTL::adjacent_difference(in, in + n, in);          // in place
+        assert(std::equal(in, in + n, expect));
+    }
+}
+
 int main()
 {
     char buf[] = "\1\2\3\4\5\6";
@@ -28,6 +92,34 @@ int main()
     learnSTL::adjacent_difference(first, last, dest, plusf);
     assert(strcmp(dest, "\1\3\5\7\11\13") == 0);
 
+    assert(learnSTL::reduce(first, last) == 21);
+    assert(learnSTL::reduce(first, last, val, plusf) == 21);
+    assert(learnSTL::transform_reduce(first, last, first, val) == 91);
+    assert(learnSTL::transform_reduce(first, last, val, plusf, [](char c){ return char(c * 2); }) == 42);
+    learnSTL::inclusive_scan(first, last, dest);
+    assert(strcmp(dest, "\1\3\6\12\17\25") == 0);
+    learnSTL::inclusive_scan(first, last, dest, plusf, char(1));
+    assert(strcmp(dest, "\2\4\7\13\20\26") == 0);
+    strcpy(dest, buf);
+    learnSTL::exclusive_scan(dest, dest + 6, dest, char(1));   // in place
+    assert(strcmp(dest, "\1\2\4\7\13\20") == 0);
+
+    test_fast_accumulate();
+    test_simd_scan<int>();
+    test_simd_scan<unsigned>();
+    test_simd_scan<long>();
+    test_simd_scan<float>();
+    test_simd_scan<double>();
+
+    int sq[] = {1, 2, 3, 4};
+    int sqs[4];
+    learnSTL::transform_inclusive_scan(sq, sq + 4, sqs, plus<int>(), [](int x){ return x * x; });
+    assert(sqs[0] == 1 && sqs[1] == 5 && sqs[2] == 14 && sqs[3] == 30);
+    learnSTL::transform_inclusive_scan(sq, sq + 4, sqs, plus<int>(), [](int x){ return x * x; }, 10);
+    assert(sqs[0] == 11 && sqs[3] == 40);
+    learnSTL::transform_exclusive_scan(sq, sq + 4, sqs, 10, plus<int>(), [](int x){ return x * x; });
+    assert(sqs[0] == 10 && sqs[1] == 11 && sqs[3] == 24);
+
     cout << "SUCCESS testing numeric.h" << endl;
     return 0;
 }
@@ -0,0 +1,78 @@
+#include "../priority_queue.h"
+#include "../vector.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <queue>
+using namespace std;
+
+void test_basic(){
+    learnSTL::priority_queue<int> q;
+    assert(q.empty() && q.size() == 0 && q.arity == 4);
+    for(int x : {5, 1, 9, 3, 7})
+        q.push(x);
+    assert(q.size() == 5 && q.top() == 9);
+    q.pop();
+    assert(q.top() == 7);
+    q.replace_top(2);                       // pop 7, push 2
+    assert(q.size() == 4 && q.top() == 5);
+    q.emplace(11);
+    assert(q.top() == 11);
+
+    learnSTL::priority_queue<int, learnSTL::vector<int>, greater<int> > m{4, 8, 2, 6};
+    assert(m.top() == 2);
+    m.pop();
+    assert(m.top() == 4 && m.size() == 3);
+
+    learnSTL::vector<int> v{3, 1, 4, 1, 5, 9, 2, 6};
+    learnSTL::priority_queue<int> r(v.begin(), v.end()), c(less<int>(), v);
+    assert(r.top() == 9 && c.top() == 9 && c.size() == 8);
+    learnSTL::swap(q, r);
+    assert(q.size() == 8 && r.size() == 5 && r.top() == 11);
+
+    learnSTL::priority_queue<string, learnSTL::vector<string>, less<string>, 2> s;
+    s.emplace(3, 'b');
+    s.push("a");
+    s.push("c");
+    assert(s.top() == "c");
+    s.pop();
+    assert(s.top() == "bbb");
+}
+
+// pops come out in the same order as the standard queue, for every arity
+template<size_t D>
+void test_model(){
+    learnSTL::priority_queue<int, learnSTL::vector<int>, less<int>, D> q;
+    std::priority_queue<int> u;
+    unsigned x = 77;
+    for(int step = 0; step < 100000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        if(r % 3 != 0 || u.empty()){
+            q.push(static_cast<int>(r % 10000));
+            u.push(static_cast<int>(r % 10000));
+        }
+        else if(r % 2){
+            q.pop();
+            u.pop();
+        }
+        else{
+            q.replace_top(static_cast<int>(r % 10000));
+            u.pop();
+            u.push(static_cast<int>(r % 10000));
+        }
+        assert(q.size() == u.size() && q.top() == u.top());
+    }
+    for(; !u.empty(); u.pop(), q.pop())
+        assert(q.top() == u.top());
+    assert(q.empty());
+}
+
+int main(){
+    test_basic();
+    test_model<2>();
+    test_model<3>();
+    test_model<4>();
+    test_model<8>();
+    cout << "SUCCESS test priority_queue" << endl;
+}
@@ -0,0 +1,84 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "../iterator.h"
+#include "../small_vector.h"
+using namespace std;
+
+// counts every call that reaches the heap
+static int allocations = 0;
+
+template<typename T>
+struct counting_allocator : std::allocator<T>{
+    template<typename U> struct rebind { typedef counting_allocator<U> other; };
+    counting_allocator() {}
+    template<typename U> counting_allocator(const counting_allocator<U>&) {}
+    T* allocate(size_t n) { ++allocations; return std::allocator<T>::allocate(n); }
+};
+
+// TEST small_vector
+int main()
+{
+    typedef learnSTL::small_vector<int, 4, counting_allocator<int> > Mycont;
+
+    // up to N elements never allocate
+    Mycont v0;
+    assert(v0.empty() && v0.is_inline() && v0.capacity() == 4);
+    for (int i = 0; i < 4; ++i)
+        v0.push_back(i);
+    assert(v0.size() == 4 && v0.is_inline() && allocations == 0);
+    v0.insert(v0.begin(), 9);
+    assert(!v0.is_inline() && allocations == 1);
+    assert(v0.size() == 5 && v0.front() == 9 && v0.back() == 3);
+    v0.erase(v0.begin(), v0.begin() + 3);
+    assert(v0.size() == 2 && v0[0] == 2 && v0[1] == 3);
+
+    Mycont v1(3, 7), v2{ 1, 2, 3 }, v3(v2.begin(), v2.end());
+    assert(allocations == 1);
+    assert(v1.size() == 3 && v1.back() == 7);
+    assert(v2 == v3 && v2.is_inline() && v3.is_inline());
+    Mycont v4(6);
+    assert(v4.size() == 6 && v4.back() == 0 && !v4.is_inline());
+
+    // copy and move
+    Mycont v5(v2);
+    assert(v5 == v2 && v5.is_inline());
+    int n = allocations;
+    Mycont v6(learnSTL::move(v4));
+    assert(allocations == n && v6.size() == 6 && !v6.is_inline());
+    assert(v4.empty() && v4.is_inline());
+    v4.push_back(1);
+    assert(allocations == n && v4.size() == 1);
+    Mycont v7(learnSTL::move(v2));
+    assert(v7 == v3 && v7.is_inline() && v2.empty());
+    v2 = v6;
+    assert(v2 == v6 && v2.size() == 6);
+    v7 = learnSTL::move(v6);
+    assert(v7 == v2 && v6.empty() && v6.is_inline());
+    v6 = { 4, 5 };
+    assert(v6.size() == 2 && v6.back() == 5);
+
+    // swap inline with heap
+    learnSTL::swap(v6, v7);
+    assert(v7.size() == 2 && v7.is_inline() && v6 == v2);
+    v6.swap(v2);
+    assert(v6 == v2);
+
+    // emplace and growth keep the elements
+    learnSTL::small_vector<string, 2> vs;
+    vs.emplace_back("a");
+    vs.emplace_back(3, 'b');
+    assert(vs.is_inline());
+    vs.emplace(vs.begin(), "c");
+    assert(!vs.is_inline() && vs[0] == "c" && vs[1] == "a" && vs[2] == "bbb");
+    learnSTL::small_vector<string, 2> vs2(vs);
+    vs.clear();
+    assert(vs.empty() && vs2.size() == 3 && vs2.back() == "bbb");
+    vs2.resize(1);
+    assert(vs2.size() == 1 && vs2.front() == "c");
+
+    cout << "SUCCESS testing small_vector.h" << endl;
+
+    return 0;
+}
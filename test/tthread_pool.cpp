@@ -0,0 +1,85 @@
+#include "../thread_pool.h"
+#include <iostream>
+#include <atomic>
+#include <stdexcept>
+#include <cassert>
+
+using namespace std;
+
+long fib(learnSTL::thread_pool& pool, int n)
+{
+    if(n < 12)
+        return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    long x, y;
+    pool.parallel_invoke([&]{ x = fib(pool, n - 1); }, [&]{ y = fib(pool, n - 2); });
+    return x + y;
+}
+
+void test_spawn_sync(learnSTL::thread_pool& pool)
+{
+    atomic<int> sum(0);
+    learnSTL::task_group g(pool);
+    for(int i = 1; i <= 1000; ++i)
+        g.spawn([&sum, i]{ sum += i; });
+    g.sync();
+    assert(sum == 500500);
+
+    // exceptions come out of sync, after every task has finished
+    for(int i = 0; i < 100; ++i)
+        g.spawn([&sum, i]{ if(i == 50) throw runtime_error("task"); ++sum; });
+    bool thrown = false;
+    try{
+        g.sync();
+    }
+    catch(runtime_error&){
+        thrown = true;
+    }
+    assert(thrown && sum == 500500 + 99);
+}
+
+void test_parallel_for(learnSTL::thread_pool& pool)
+{
+    const size_t n = 100003;
+    static atomic<int> hits[n];
+    for(size_t i = 0; i < n; ++i)
+        hits[i] = 0;
+    atomic<size_t> calls(0);
+    pool.parallel_for(0, n, 1000, [&](size_t b, size_t e){
+        assert(e - b <= 1000);
+        ++calls;
+        for(size_t i = b; i != e; ++i)
+            ++hits[i];
+    });
+    for(size_t i = 0; i < n; ++i)
+        assert(hits[i] == 1);
+    assert(calls >= n / 1000);
+
+    // nested loops share the same workers
+    atomic<long> total(0);
+    pool.parallel_for(0, 64, 1, [&](size_t b, size_t e){
+        for(size_t i = b; i != e; ++i)
+            pool.parallel_for(0, 1000, 10, [&](size_t b2, size_t e2){ total += e2 - b2; });
+    });
+    assert(total == 64000);
+}
+
+int main()
+{
+    learnSTL::thread_pool pool(3);
+    assert(pool.size() == 3 && pool.concurrency() == 4);
+    test_spawn_sync(pool);
+    test_parallel_for(pool);
+    assert(fib(pool, 25) == 75025);
+
+    learnSTL::thread_pool serial(0);        // no workers, everything runs on the caller
+    test_spawn_sync(serial);
+    test_parallel_for(serial);
+    assert(fib(serial, 20) == 6765);
+
+    long x = 0, y = 0;
+    learnSTL::parallel_invoke([&]{ x = 1; }, [&]{ y = 2; });
+    assert(x == 1 && y == 2);
+
+    cout << "SUCCESS testing thread_pool.h" << endl;
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "../top_k.h"
+#include "../vector.h"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <vector>
+using namespace std;
+
+void test_top_k(){
+    int a[] = {5, 3, 9, 1, 7, 3, 8, 2, 6, 4, 0, 3};
+    int out[12];
+    int* e = learnSTL::top_k(a, a + 12, 4, out);
+    assert(e == out + 4 && out[0] == 9 && out[1] == 8 && out[2] == 7 && out[3] == 6);
+    e = learnSTL::top_k(a, a + 12, 3, out, greater<int>());
+    assert(e == out + 3 && out[0] == 0 && out[1] == 1 && out[2] == 2);
+    assert(learnSTL::top_k(a, a + 12, 0, out) == out);
+    e = learnSTL::top_k(a, a + 3, 10, out);
+    assert(e == out + 3 && out[0] == 9 && out[2] == 3);
+
+    // an unbounded stream, read once
+    istringstream in("12 7 99 -4 31 7 58 0 99 3");
+    learnSTL::vector<int> best(3);
+    learnSTL::top_k(learnSTL::istream_iterator<int>(in), learnSTL::istream_iterator<int>(), 3, best.begin());
+    assert(best[0] == 99 && best[1] == 99 && best[2] == 58);
+
+    learnSTL::vector<string> s{"pear", "fig", "banana", "kiwi", "apple"};
+    learnSTL::vector<string> shortest(2);
+    learnSTL::top_k(s.begin(), s.end(), 2, shortest.begin(),
+                    [](const string& x, const string& y){ return x.size() > y.size(); });
+    assert(shortest[0] == "fig" && (shortest[1] == "pear" || shortest[1] == "kiwi"));
+}
+
+void test_accumulator(){
+    learnSTL::top_k_accumulator<int> acc(3);
+    assert(acc.empty() && acc.k() == 3 && !acc.full());
+    for(int x : {4, 1, 7})
+        acc.push(x);
+    assert(acc.full() && acc.threshold() == 1);
+    acc.push(0);
+    assert(acc.threshold() == 1);
+    acc.push(5);
+    assert(acc.threshold() == 4 && acc.size() == 3);
+    learnSTL::vector<int> more{9, 2, 8, 3};
+    acc.push(more.begin(), more.end());
+    learnSTL::vector<int> r = acc.sorted();
+    assert(r.size() == 3 && r[0] == 9 && r[1] == 8 && r[2] == 7 && acc.size() == 3);
+    r = acc.extract_sorted();
+    assert(r[0] == 9 && acc.empty());
+
+    learnSTL::top_k_accumulator<int> none(0);
+    none.push(1);
+    none.push(more.begin(), more.end());
+    assert(none.empty() && none.full());
+
+    learnSTL::top_k_accumulator<string, greater<string> > words(2);
+    words.push(string("b"));
+    words.push(string("c"));
+    words.push(string("a"));
+    assert(words.threshold() == "b" && words.sorted()[0] == "a");
+}
+
+// every arithmetic type through the vector kernel, against a full sort;
+// lengths around the register width hit the scalar tails too
+template<typename T, typename Compare>
+void test_kernel(){
+    unsigned x = 77;
+    for(size_t n : {0, 1, 5, 31, 32, 33, 64, 65, 100, 1000, 20000})
+        for(size_t k : {1, 3, 16, 100}){
+            learnSTL::vector<T> v(n);
+            for(size_t i = 0; i < n; ++i){
+                x = x * 1103515245 + 12345;
+                v[i] = static_cast<T>((x >> 12) % 2000) - static_cast<T>(std::is_signed<T>::value ? 1000 : 0);
+            }
+            // a rising run, so the threshold keeps moving while the kernel is in use
+            for(size_t i = n / 2; i < n / 2 + n / 8; ++i)
+                v[i] = static_cast<T>(i);
+            std::vector<T> u(v.begin(), v.end());
+            std::sort(u.begin(), u.end(), [](const T& a, const T& b){ return Compare()(b, a); });
+            u.resize(std::min(k, n));
+            learnSTL::top_k_accumulator<T, Compare> acc(k);
+            acc.push(v.begin(), v.end());
+            learnSTL::vector<T> r = acc.sorted();
+            assert(r.size() == u.size());
+            for(size_t i = 0; i < u.size(); ++i)
+                assert(r[i] == u[i]);
+        }
+}
+
+void test_nan(){
+    double d[] = {1.0, 0.0 / 0.0, 5.0, 3.0, 0.0 / 0.0, 4.0, 2.0, 6.0, 0.5, 7.0, 0.0 / 0.0, 1.5,
+                  8.0, 2.5, 0.0 / 0.0, 3.5, 9.0, 0.25, 4.5, 0.0 / 0.0, 5.5, 6.5, 0.0 / 0.0, 7.5};
+    learnSTL::top_k_accumulator<double> acc(2);
+    acc.push(d + 2, d + 24);                // the first two are no NaNs, one never gets past them
+    learnSTL::vector<double> r = acc.sorted();
+    assert(r[0] == 9.0 && r[1] == 8.0);
+
+    // a NaN that gets in first is the threshold: nothing compares past it,
+    // with the kernel or without
+    learnSTL::vector<double> v(1, 0.0 / 0.0);
+    for(int i = 1; i < 64; ++i)
+        v.push_back(i);
+    learnSTL::top_k_accumulator<double> fast(1), slow(1);
+    fast.push(v.data(), v.data() + v.size());
+    for(double x : v)
+        slow.push(x);
+    assert(fast.size() == 1 && fast.threshold() != fast.threshold() && slow.threshold() != slow.threshold());
+}
+
+int main(){
+    test_top_k();
+    test_accumulator();
+    test_kernel<int, less<int> >();
+    test_kernel<int, greater<int> >();
+    test_kernel<unsigned char, less<unsigned char> >();
+    test_kernel<signed char, greater<signed char> >();
+    test_kernel<short, less<short> >();
+    test_kernel<unsigned, greater<unsigned> >();
+    test_kernel<long long, less<long long> >();
+    test_kernel<unsigned long long, less<unsigned long long> >();
+    test_kernel<float, less<float> >();
+    test_kernel<double, greater<double> >();
+    test_nan();
+    cout << "SUCCESS test top_k" << endl;
+}
@@ -0,0 +1,304 @@
+#include "../unordered_map.h"
+#include "../allocator.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+typedef learnSTL::unordered_map<int, int> Mymap;
+typedef learnSTL::unordered_multimap<int, int> Mymulti;
+
+// the table agrees with the model: the same elements, each key's group in
+// one piece, every element in the bucket its key names
+template<typename M, typename U>
+bool same(const M& m, const U& u){
+    if(m.size() != u.size() || m.empty() != u.empty())
+        return false;
+    std::vector<pair<int, int> > a, b;
+    for(auto it = m.begin(); it != m.end(); ++it)
+        a.push_back(pair<int, int>(it->first, it->second));
+    for(const auto& v : u)
+        b.push_back(v);
+    std::unordered_set<int> done;
+    for(size_t i = 0; i < a.size(); ++i)
+        if(i == 0 || a[i].first != a[i - 1].first){
+            if(!done.insert(a[i].first).second)
+                return false;
+        }
+    size_t in_buckets = 0;
+    for(size_t n = 0; n < m.bucket_count(); ++n)
+        for(auto it = m.begin(n); it != m.end(n); ++it, ++in_buckets)
+            if(m.bucket(it->first) != n)
+                return false;
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b && in_buckets == m.size() && m.load_factor() <= m.max_load_factor();
+}
+
+void test_basic(){
+    Mymap m1;
+    assert(m1.empty() && m1.size() == 0 && m1.begin() == m1.end() && m1.bucket_count() == 0);
+    assert(m1.find(3) == m1.end() && m1.count(3) == 0 && m1.erase(3) == 0);
+    auto r = m1.insert(learnSTL::make_pair(1, 10));
+    assert(r.second && r.first->first == 1 && r.first->second == 10);
+    r = m1.insert(learnSTL::make_pair(1, 11));
+    assert(!r.second && r.first->second == 10 && m1.size() == 1);
+    m1[2] = 20;
+    m1[3];
+    assert(m1.size() == 3 && m1.at(2) == 20 && m1[3] == 0 && m1.contains(3));
+    bool thrown = false;
+    try{
+        m1.at(4);
+    }
+    catch(const std::out_of_range&){
+        thrown = true;
+    }
+    assert(thrown);
+    assert(m1.try_emplace(4, 40).second && !m1.try_emplace(4, 41).second && m1[4] == 40);
+    assert(!m1.insert_or_assign(4, 42).second && m1[4] == 42);
+    assert(m1.emplace(5, 50).second && !m1.emplace(5, 51).second);
+    auto er = m1.equal_range(5);
+    assert(er.first->second == 50 && learnSTL::distance(er.first, er.second) == 1);
+    assert(m1.erase(5) == 1 && m1.erase(5) == 0 && m1.size() == 4);
+
+    Mymap::const_iterator ci = m1.find(2);
+    Mymap::iterator it = m1.find(2);
+    assert(ci == it && it->second == 20);
+    it->second = 21;
+    assert(m1.at(2) == 21);
+
+    Mymap m2(m1), m3{{7, 70}, {8, 80}};
+    assert(m2 == m1 && m3 != m1 && m3.size() == 2);
+    m3 = m1;
+    assert(m3 == m1);
+    m3 = {{9, 90}};
+    assert(m3.size() == 1 && m3[9] == 90);
+    Mymap m4(learnSTL::move(m3));
+    assert(m3.empty() && m4.size() == 1 && m4[9] == 90);
+    m3 = learnSTL::move(m4);
+    assert(m4.empty() && m3.size() == 1);
+    m4[1] = 1;                              // a moved-from map is usable
+    learnSTL::swap(m3, m4);
+    assert(m3.size() == 1 && m3[1] == 1 && m4[9] == 90);
+    m1.clear();
+    assert(m1.empty() && m1.begin() == m1.end() && m1.find(2) == m1.end());
+    m1[2] = 2;
+    assert(m1.size() == 1);
+
+    // erase while walking
+    Mymap m5;
+    for(int i = 0; i < 100; ++i)
+        m5[i] = i;
+    for(auto i = m5.begin(); i != m5.end(); )
+        i = i->first % 2 ? m5.erase(i) : ++i;
+    assert(m5.size() == 50 && m5.count(4) == 1 && m5.count(5) == 0);
+    m5.erase(m5.begin(), m5.end());
+    assert(m5.empty());
+}
+
+void test_multi(){
+    Mymulti m{{1, 1}, {2, 2}, {1, 3}};
+    assert(m.size() == 3 && m.count(1) == 2 && m.count(2) == 1);
+    auto it = m.insert(learnSTL::make_pair(1, 4));
+    assert(it->first == 1 && it->second == 4 && m.count(1) == 3);
+    auto r = m.equal_range(1);
+    std::vector<int> vals;
+    for(; r.first != r.second; ++r.first)
+        vals.push_back(r.first->second);
+    std::sort(vals.begin(), vals.end());
+    assert(vals.size() == 3 && vals[0] == 1 && vals[2] == 4);
+
+    Mymulti m2{{1, 4}, {2, 2}, {1, 1}, {1, 3}};
+    assert(m2 == m);
+    m2.emplace(2, 2);
+    assert(m2 != m);
+    assert(m2.erase(1) == 3 && m2.size() == 2 && m2.count(2) == 2);
+}
+
+void test_model(){
+    Mymulti m;
+    std::unordered_multimap<int, int> u;
+    unsigned x = 77;
+    for(int step = 0; step < 100000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int k = static_cast<int>(r % 2000);
+        switch(r % 5){
+        case 0:
+        case 1:
+            m.emplace(k, step);
+            u.emplace(k, step);
+            break;
+        case 2:
+            assert(m.erase(k) == u.erase(k));
+            break;
+        case 3: {
+            auto it = m.find(k);
+            if(it != m.end()){
+                auto f = u.equal_range(k);
+                for(; f.first->second != it->second; ++f.first)
+                    ;
+                u.erase(f.first);
+                m.erase(it);
+            }
+            break;
+        }
+        case 4:
+            assert(m.count(k) == u.count(k));
+            break;
+        }
+        if(step % 1000 == 0)
+            assert(same(m, u));
+    }
+    assert(same(m, u));
+
+    Mymap s;
+    std::unordered_map<int, int> v;
+    for(int step = 0; step < 50000; ++step){
+        x = x * 1103515245 + 12345;
+        int k = static_cast<int>((x >> 16) % 3000);
+        if(x & 1){
+            s[k] = step;
+            v[k] = step;
+        }
+        else
+            assert(s.erase(k) == v.erase(k));
+    }
+    assert(same(s, v));
+}
+
+// the nodes stay where they are: pointers survive growth, rehash and reserve
+void test_stable(){
+    Mymulti m;
+    std::vector<learnSTL::pair<const int, int>*> ptrs;
+    for(int i = 0; i < 1000; ++i)
+        ptrs.push_back(&*m.emplace(i % 300, i));
+    m.rehash(5000);
+    m.max_load_factor(4.0f);
+    m.rehash(0);
+    assert(m.bucket_count() < 300);
+    m.reserve(20000);
+    for(int i = 0; i < 1000; ++i)
+        assert(ptrs[i]->first == i % 300 && ptrs[i]->second == i);
+    std::unordered_multimap<int, int> u;
+    for(int i = 0; i < 1000; ++i)
+        u.emplace(i % 300, i);
+    assert(same(m, u));
+}
+
+void test_buckets(){
+    Mymap m;
+    assert(m.max_load_factor() == 1.0f && m.load_factor() == 0.0f);
+    m.reserve(1000);
+    const size_t buckets = m.bucket_count();
+    assert(buckets >= 1000 && m.max_bucket_count() >= buckets);
+    for(int i = 0; i < 1000; ++i)
+        m[i] = i;
+    assert(m.bucket_count() == buckets && m.load_factor() <= 1.0f);
+
+    size_t total = 0;
+    for(size_t n = 0; n < m.bucket_count(); ++n){
+        size_t c = 0;
+        for(auto it = m.cbegin(n); it != m.cend(n); ++it)
+            ++c;
+        assert(c == m.bucket_size(n));
+        total += c;
+    }
+    assert(total == 1000);
+    const size_t b = m.bucket(7);
+    bool found = false;
+    for(auto it = m.begin(b); it != m.end(b); ++it)
+        if(it->first == 7){
+            it->second = -7;
+            found = true;
+        }
+    assert(found && m[7] == -7);
+
+    m.max_load_factor(0.5f);
+    assert(m.bucket_count() >= 2000 && m.load_factor() <= 0.5f);
+    m.max_load_factor(8.0f);
+    m.rehash(0);                            // shrinks to what the elements need
+    assert(m.bucket_count() < 200 && m.bucket_count() >= 125 && m.size() == 1000 && m[999] == 999);
+    m.clear();
+    m.rehash(0);
+    assert(m.bucket_count() == 0 && m.empty());
+    Mymap m2(100);
+    assert(m2.bucket_count() >= 100 && m2.empty());
+
+    // at the load limit a key that is there already neither rehashes nor
+    // touches its arguments; the next new key rehashes and nodes stay put
+    learnSTL::unordered_map<string, string> full;
+    full.max_load_factor(1.0f);
+    for(int i = 0; full.size() < full.bucket_count() || full.empty(); ++i)
+        full.try_emplace(to_string(i), "v");
+    const size_t limit = full.bucket_count();
+    const string* addr = &full["0"];
+    string k = "0", v = "other";
+    assert(!full.try_emplace(learnSTL::move(k), learnSTL::move(v)).second && k == "0" && v == "other");
+    assert(!full.insert_or_assign(k, learnSTL::move(v)).second && full[k] == "other" && v.empty());
+    assert(full.bucket_count() == limit);
+    v = "new";
+    assert(full.insert_or_assign(string("new"), learnSTL::move(v)).second && v.empty() && full.bucket_count() > limit);
+    assert(&full["0"] == addr && full["new"] == "new");
+}
+
+// every key collides, so each bucket walk goes through one long chain
+struct bad_hash{
+    size_t operator()(int) const { return 42; }
+};
+
+void test_collisions(){
+    learnSTL::unordered_map<int, int, bad_hash> m;
+    std::unordered_map<int, int> u;
+    for(int i = 0; i < 300; ++i){
+        m[i] = i;
+        u[i] = i;
+    }
+    assert(m.bucket_size(m.bucket(0)) == 300);
+    for(int i = 0; i < 300; i += 3){
+        m.erase(i);
+        u.erase(i);
+    }
+    for(int i = 0; i < 300; ++i)
+        assert(m.count(i) == u.count(i));
+    assert(m.size() == u.size());
+}
+
+void test_allocator(){
+    // the nodes come from the allocator rebound to the node type
+    typedef learnSTL::pool_allocator<learnSTL::pair<const int, string> > Mypool;
+    learnSTL::unordered_map<int, string, std::hash<int>, std::equal_to<int>, Mypool> p;
+    for(int i = 0; i < 1000; ++i)
+        p[i] = to_string(i);
+    for(int i = 0; i < 1000; i += 2)
+        p.erase(i);
+    for(int i = 0; i < 1000; i += 4)
+        p[i] = "again";
+    assert(p.size() == 750 && p[4] == "again" && p[5] == "5");
+
+    typedef learnSTL::arena_allocator<learnSTL::pair<const int, string> > Myal;
+    typedef learnSTL::unordered_map<int, string, std::hash<int>, std::equal_to<int>, Myal> Amap;
+    learnSTL::monotonic_arena a1, a2;
+    Amap m1(0, std::hash<int>(), std::equal_to<int>(), Myal{a1}), m2(Myal{a2});
+    for(int i = 0; i < 100; ++i)
+        m1[i] = to_string(i);
+    m2 = m1;
+    assert(m2 == m1 && m2.get_allocator().arena() == &a1);
+    Amap m3(learnSTL::move(m1), Myal{a2});
+    assert(m3.size() == 100 && m3.get_allocator().arena() == &a2 && m3[42] == "42");
+}
+
+int main(){
+    test_basic();
+    test_multi();
+    test_model();
+    test_stable();
+    test_buckets();
+    test_collisions();
+    test_allocator();
+    cout << "SUCCESS test unordered_map" << endl;
+}
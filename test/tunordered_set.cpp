@@ -0,0 +1,52 @@
+#include "../unordered_set.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <set>
+using namespace std;
+
+void test_set(){
+    learnSTL::unordered_set<string> s1{"a", "b", "c"};
+    assert(s1.size() == 3 && s1.contains("b") && !s1.insert("b").second);
+    assert(s1.emplace(3, 'd').second && s1.count("ddd") == 1);
+    learnSTL::unordered_set<string> s2(s1.begin(), s1.end());
+    assert(s2 == s1);
+    s2.erase("a");
+    assert(s2 != s1 && s2.size() == 3 && s2.find("a") == s2.end());
+
+    const string* p = &*s1.find("c");
+    for(int i = 0; i < 1000; ++i)
+        s1.insert(to_string(i));
+    assert(s1.size() == 1004 && p == &*s1.find("c") && *p == "c");
+
+    std::set<string> seen;
+    for(const auto& x : s1)
+        assert(seen.insert(x).second);
+    assert(seen.size() == 1004);
+    learnSTL::swap(s1, s2);
+    assert(s1.size() == 3 && s2.size() == 1004 && s2.contains("999"));
+}
+
+void test_multiset(){
+    learnSTL::unordered_multiset<int> s{3, 1, 3, 2, 3};
+    assert(s.size() == 5 && s.count(3) == 3 && s.count(4) == 0);
+    auto r = s.equal_range(3);
+    assert(learnSTL::distance(r.first, r.second) == 3);
+    for(; r.first != r.second; ++r.first)
+        assert(*r.first == 3);
+    for(int i = 0; i < 500; ++i)
+        s.insert(i % 50);
+    assert(s.count(3) == 13 && s.size() == 505);
+    learnSTL::unordered_multiset<int> t(s);
+    t.rehash(1000);
+    assert(t == s && t.bucket_count() >= 1000);
+    t.erase(t.find(3));
+    assert(t != s && t.count(3) == 12);
+    assert(s.erase(3) == 13 && s.size() == 492);
+}
+
+int main(){
+    test_set();
+    test_multiset();
+    cout << "SUCCESS test unordered_set" << endl;
+}
@@ -0,0 +1,176 @@
+#include "../unrolled_forward_list.h"
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <list>
+#include <algorithm>
+using namespace std;
+
+// three elements a node, so short lists already span several nodes
+typedef learnSTL::unrolled_forward_list<string, 3 * sizeof(string) + 2 * sizeof(void*)> Mycont;
+
+template<typename List>
+bool same(const List& f, const std::list<string>& l){
+    return std::equal(l.begin(), l.end(), f.begin()) &&
+           learnSTL::distance(f.begin(), f.end()) == static_cast<ptrdiff_t>(l.size());
+}
+
+Mycont::iterator nth(Mycont& f, int n){
+    auto i = f.before_begin();
+    learnSTL::advance(i, n + 1);
+    return i;
+}
+
+std::list<string>::iterator nth(std::list<string>& l, int n){
+    auto i = l.begin();
+    std::advance(i, n);
+    return i;
+}
+
+// random edits checked against std::list
+void test_model(){
+    Mycont f;
+    std::list<string> l;
+    unsigned x = 777;
+    for(int step = 0; step < 20000; ++step){
+        x = x * 1103515245 + 12345;
+        unsigned r = x >> 16;
+        int n = static_cast<int>(l.size());
+        string s = to_string(r % 50);
+        switch(r % 7){
+        case 0:
+            f.push_front(s);
+            l.push_front(s);
+            break;
+        case 1: case 2: {
+            int k = n == 0 ? 0 : r % (n + 1);
+            f.insert_after(k == 0 ? f.before_begin() : nth(f, k - 1), s);
+            l.insert(nth(l, k), s);
+            break;
+        }
+        case 3:
+            if(n > 0){
+                int k = r % n;
+                f.erase_after(k == 0 ? f.before_begin() : nth(f, k - 1));
+                l.erase(nth(l, k));
+            }
+            break;
+        case 4:
+            if(n > 0){
+                int a = r % n, b = a + 1 + (r >> 3) % (n - a);
+                auto it = f.erase_after(a == 0 ? f.before_begin() : nth(f, a - 1),
+                                        b == n ? f.end() : nth(f, b));
+                l.erase(nth(l, a), nth(l, b));
+                assert(b == n ? it == f.end() : *it == *nth(l, a));
+            }
+            break;
+        case 5:
+            if(n > 0 && r % 5 == 0){
+                f.pop_front();
+                l.pop_front();
+            }
+            break;
+        case 6:
+            if(r % 40 == 0){
+                f.remove(s);
+                l.remove(s);
+            }
+            break;
+        }
+        assert(same(f, l));
+    }
+}
+
+void test_basic(){
+    Mycont f1;
+    assert(f1.empty() && f1.begin() == f1.end());
+    Mycont f2{"a", "b", "c", "d", "e", "f", "g"};
+    Mycont f3(f2);
+    assert(f3 == f2 && f3.front() == "a");
+    f3.insert_after(f3.before_begin(), 2, "z");
+    f3.emplace_after(f3.begin(), 1, 'y');
+    assert(f3 > f2 && f3.front() == "z" && *learnSTL::next(f3.begin()) == "y");
+    Mycont f4(learnSTL::move(f3));
+    assert(f3.empty() && f4.front() == "z");
+    f3 = f4;
+    f4.assign({"q"});
+    assert(f4.front() == "q" && learnSTL::next(f4.begin()) == f4.end());
+    f3.resize(2);
+    assert(f3 == (Mycont{"z", "y"}));
+    f3.resize(5, "w");
+    assert(f3 == (Mycont{"z", "y", "w", "w", "w"}));
+    learnSTL::swap(f3, f4);
+    assert(f3.front() == "q" && f4.front() == "z");
+    f4.reverse();
+    assert(f4 == (Mycont{"w", "w", "w", "y", "z"}));
+    f4.unique();
+    assert(f4 == (Mycont{"w", "y", "z"}));
+    f4.remove_if([](const string& s){ return s != "y"; });
+    assert(f4 == (Mycont{"y"}));
+    f4.clear();
+    assert(f4.empty());
+
+    // a node is one cache line by default
+    assert((learnSTL::unrolled_forward_list<int>::node_capacity) == (64 - 2 * sizeof(void*)) / sizeof(int));
+    assert((learnSTL::unrolled_forward_list<double, 8>::node_capacity) == 2);
+}
+
+void test_splice(){
+    Mycont f1{"1", "2", "3", "4", "5"}, f2{"a", "b", "c", "d"};
+    f1.splice_after(nth(f1, 1), f2);
+    assert(f2.empty() && f1 == (Mycont{"1", "2", "a", "b", "c", "d", "3", "4", "5"}));
+    f2.splice_after(f2.before_begin(), f1, nth(f1, 0));
+    assert(f2 == (Mycont{"2"}) && f1.front() == "1" && *nth(f1, 1) == "a");
+    f2.splice_after(f2.begin(), f1, nth(f1, 1), nth(f1, 5));
+    assert(f2 == (Mycont{"2", "b", "c", "d"}));
+    assert(f1 == (Mycont{"1", "a", "3", "4", "5"}));
+
+    // within one list, forwards and backwards
+    f1.splice_after(f1.before_begin(), f1, nth(f1, 2), f1.end());
+    assert(f1 == (Mycont{"4", "5", "1", "a", "3"}));
+    f1.splice_after(nth(f1, 4), f1, f1.before_begin(), nth(f1, 2));
+    assert(f1 == (Mycont{"1", "a", "3", "4", "5"}));
+    f1.splice_after(nth(f1, 3), f1, f1.begin());
+    assert(f1 == (Mycont{"1", "3", "4", "a", "5"}));
+}
+
+void test_merge_sort(){
+    learnSTL::unrolled_forward_list<int> f0;
+    f0.sort();
+    assert(f0.empty());
+    learnSTL::unrolled_forward_list<int> f1{9, 1, 8, 2, 7, 3, 6, 4, 5, 0}, f2;
+    for(int i = 0; i < 100; ++i)
+        f2.push_front(i % 13);
+    f1.sort();
+    f2.sort();
+    assert(std::is_sorted(f1.begin(), f1.end()) && std::is_sorted(f2.begin(), f2.end()));
+    f1.merge(f2);
+    assert(f2.empty() && std::is_sorted(f1.begin(), f1.end()));
+    assert(learnSTL::distance(f1.begin(), f1.end()) == 110);
+
+    // merge and sort keep equal keys in order
+    Mycont f3, f4;
+    for(int i = 0; i < 60; ++i){
+        f3.push_front(to_string(i % 4) + "a" + to_string(99 - i));
+        f4.push_front(to_string(i % 3) + "b" + to_string(99 - i));
+    }
+    auto first_char = [](const string& s1, const string& s2){ return s1[0] < s2[0]; };
+    f3.sort(first_char);
+    f4.sort(first_char);
+    f3.merge(learnSTL::move(f4), first_char);
+    std::list<string> l;
+    for(int i = 59; i >= 0; --i)
+        l.push_back(to_string(i % 4) + "a" + to_string(99 - i));
+    for(int i = 59; i >= 0; --i)
+        l.push_back(to_string(i % 3) + "b" + to_string(99 - i));
+    l.sort(first_char);
+    assert(same(f3, l));
+}
+
+int main(){
+    test_basic();
+    test_model();
+    test_splice();
+    test_merge_sort();
+    cout << "SUCCESS test unrolled_forward_list" << endl;
+}
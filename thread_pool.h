@@ -0,0 +1,461 @@
+#ifndef MY_THREAD_POOL_H
+#define MY_THREAD_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <type_traits>
+#include "utility.h"
+
+namespace learnSTL{
+    class thread_pool;
+    class task_group;
+
+    ///: ------------------------- task --------------------------------
+    // a spawned closure, owned by whoever takes it out of a queue
+    struct __pool_task{
+        void (*__invoke)(__pool_task*);     // runs the closure and frees the task
+        task_group*  __group;
+        __pool_task* __next;                // link in the injection queue
+
+        explicit __pool_task(void (*invoke)(__pool_task*)) : __invoke(invoke), __group(nullptr), __next(nullptr) {}
+    };
+
+    template<typename F>
+    struct __pool_task_impl : __pool_task{
+        F __f;
+
+        explicit __pool_task_impl(F&& f) : __pool_task(&__call), __f(learnSTL::move(f)) {}
+        explicit __pool_task_impl(const F& f) : __pool_task(&__call), __f(f) {}
+
+        static void __call(__pool_task* t){
+            std::unique_ptr<__pool_task_impl> p(static_cast<__pool_task_impl*>(t));
+            p->__f();
+        }
+    };
+    ///~ ------------------------- end task ----------------------------
+
+
+    ///: ------------------------- work-stealing deque --------------------------------
+    // Chase-Lev deque: the owner pushes and pops at the bottom, thieves take
+    // from the top. Only a race for the last element needs a CAS.
+    class __ws_deque{
+    private:
+        struct __array{
+            std::ptrdiff_t               __cap;      // power of two
+            std::atomic<__pool_task*>*   __buf;
+            __array*                     __prev;     // retired arrays, a thief may still read them
+
+            explicit __array(std::ptrdiff_t cap) : __cap(cap), __buf(new std::atomic<__pool_task*>[cap]), __prev(nullptr) {}
+            ~__array() { delete[] __buf; }
+
+            __pool_task* get(std::ptrdiff_t i) const { return __buf[i & (__cap - 1)].load(std::memory_order_relaxed); }
+            void put(std::ptrdiff_t i, __pool_task* t) { __buf[i & (__cap - 1)].store(t, std::memory_order_relaxed); }
+        };
+
+        std::atomic<std::ptrdiff_t> __top;
+        std::atomic<std::ptrdiff_t> __bottom;
+        std::atomic<__array*>       __array_;
+
+        __array* __grow(__array* a, std::ptrdiff_t b, std::ptrdiff_t t){
+            __array* na = new __array(a->__cap * 2);
+            for(std::ptrdiff_t i = t; i != b; ++i)
+                na->put(i, a->get(i));
+            na->__prev = a;
+            __array_.store(na, std::memory_order_release);
+            return na;
+        }
+
+    public:
+        explicit __ws_deque(std::ptrdiff_t cap = 64) : __top(0), __bottom(0), __array_(new __array(cap)) {}
+
+        ~__ws_deque(){
+            __array* a = __array_.load(std::memory_order_relaxed);
+            while(a){
+                __array* prev = a->__prev;
+                delete a;
+                a = prev;
+            }
+        }
+
+        __ws_deque(const __ws_deque&) = delete;
+        __ws_deque& operator=(const __ws_deque&) = delete;
+
+        // owner only
+        void push(__pool_task* t){
+            std::ptrdiff_t b = __bottom.load(std::memory_order_relaxed);
+            std::ptrdiff_t top = __top.load(std::memory_order_acquire);
+            __array* a = __array_.load(std::memory_order_relaxed);
+            if(b - top > a->__cap - 1)
+                a = __grow(a, b, top);
+            a->put(b, t);
+            __bottom.store(b + 1, std::memory_order_release);
+        }
+
+        // owner only, newest task first
+        __pool_task* pop(){
+            std::ptrdiff_t b = __bottom.load(std::memory_order_relaxed) - 1;
+            __array* a = __array_.load(std::memory_order_relaxed);
+            __bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::ptrdiff_t t = __top.load(std::memory_order_relaxed);
+            if(t > b){                  // empty
+                __bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            __pool_task* task = a->get(b);
+            if(t == b){                 // last one, race the thieves for it
+                if(!__top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    task = nullptr;
+                __bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        // any thread, oldest task first
+        __pool_task* steal(){
+            std::ptrdiff_t t = __top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::ptrdiff_t b = __bottom.load(std::memory_order_acquire);
+            if(t >= b)
+                return nullptr;
+            __array* a = __array_.load(std::memory_order_acquire);
+            __pool_task* task = a->get(t);
+            if(!__top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;         // lost the race
+            return task;
+        }
+
+        bool empty() const {
+            return __bottom.load(std::memory_order_relaxed) <= __top.load(std::memory_order_relaxed);
+        }
+    };
+    ///~ ------------------------- end work-stealing deque ----------------------------
+
+
+    ///: ------------------------- thread pool --------------------------------
+    // Workers run the tasks of their own deque newest first, and steal the
+    // oldest task of a random victim when it runs dry. A thread that is not a
+    // worker pushes to a shared injection queue, and helps run tasks while it
+    // waits in task_group::sync, so nested fork/join never blocks a core.
+    class thread_pool{
+    public:
+        // workers besides the calling thread, the default keeps every core busy
+        explicit thread_pool(size_t workers = __default_workers())
+            : __workers(nullptr), __nworkers(workers), __injected_head(nullptr), __injected_tail(nullptr),
+              __injected(0), __queued(0), __sleeping(0), __stop(false)
+        {
+            if(__nworkers == 0)
+                return;
+            __workers = new __worker[__nworkers];
+            for(size_t i = 0; i < __nworkers; ++i){
+                __workers[i].__pool = this;
+                __workers[i].__index = i;
+                __workers[i].__seed = static_cast<uint32_t>(i * 2654435761u + 1);
+            }
+            for(size_t i = 0; i < __nworkers; ++i)
+                __workers[i].__handle = std::thread(&thread_pool::__worker_loop, this, &__workers[i]);
+        }
+
+        ~thread_pool(){
+            {
+                std::lock_guard<std::mutex> lock(__sleep_mutex);
+                __stop.store(true);
+            }
+            __sleep_cv.notify_all();
+            for(size_t i = 0; i < __nworkers; ++i)
+                __workers[i].__handle.join();
+            delete[] __workers;
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        // the pool shared by the parallel algorithms
+        static thread_pool& instance(){
+            static thread_pool pool;
+            return pool;
+        }
+
+        size_t size() const { return __nworkers; }
+
+        // threads that run tasks of one fork/join, the waiting caller included
+        size_t concurrency() const { return __nworkers + 1; }
+
+        // run f1 and f2, possibly at the same time
+        template<typename F1, typename F2>
+        void parallel_invoke(F1 f1, F2 f2);
+
+        // call f(begin, end) on pieces of [first, last) no longer than grain
+        template<typename F>
+        void parallel_for(size_t first, size_t last, size_t grain, F f);
+
+    private:
+        friend class task_group;
+
+        struct __worker{
+            thread_pool* __pool;
+            size_t       __index;
+            uint32_t     __seed;
+            __ws_deque   __deque;
+            std::thread  __handle;
+        };
+
+        __worker*               __workers;
+        size_t                  __nworkers;
+        std::mutex              __inject_mutex;
+        __pool_task*            __injected_head;
+        __pool_task*            __injected_tail;
+        std::atomic<size_t>     __injected;
+        std::atomic<size_t>     __queued;       // tasks sitting in a deque or the injection queue
+        std::atomic<size_t>     __sleeping;
+        std::mutex              __sleep_mutex;
+        std::condition_variable __sleep_cv;
+        std::atomic<bool>       __stop;
+
+        static size_t __default_workers(){
+            unsigned n = std::thread::hardware_concurrency();
+            return n > 1 ? n - 1 : 0;
+        }
+
+        // the worker running on this thread, or nullptr
+        static __worker*& __current(){
+            static thread_local __worker* w = nullptr;
+            return w;
+        }
+
+        __worker* __this_worker() const {
+            __worker* w = __current();
+            return w && w->__pool == this ? w : nullptr;
+        }
+
+        void __submit(__pool_task* t){
+            __queued.fetch_add(1);      // before the push, so a take never sees it negative
+            __worker* w = __this_worker();
+            if(w)
+                w->__deque.push(t);
+            else{
+                std::lock_guard<std::mutex> lock(__inject_mutex);
+                if(__injected_tail)
+                    __injected_tail->__next = t;
+                else
+                    __injected_head = t;
+                __injected_tail = t;
+                __injected.fetch_add(1);
+            }
+            if(__sleeping.load() != 0){
+                std::lock_guard<std::mutex> lock(__sleep_mutex);
+                __sleep_cv.notify_one();
+            }
+        }
+
+        __pool_task* __take_injected(){
+            if(__injected.load(std::memory_order_relaxed) == 0)
+                return nullptr;
+            std::lock_guard<std::mutex> lock(__inject_mutex);
+            __pool_task* t = __injected_head;
+            if(t){
+                __injected_head = t->__next;
+                if(!__injected_head)
+                    __injected_tail = nullptr;
+                __injected.fetch_sub(1);
+            }
+            return t;
+        }
+
+        __pool_task* __steal(uint32_t& seed, size_t self){
+            // xorshift, only has to spread the victims
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            size_t start = seed % __nworkers;
+            for(size_t i = 0; i < __nworkers; ++i){
+                size_t victim = (start + i) % __nworkers;
+                if(victim == self || __workers[victim].__deque.empty())
+                    continue;
+                __pool_task* t = __workers[victim].__deque.steal();
+                if(t)
+                    return t;
+            }
+            return nullptr;
+        }
+
+        // own deque first, then the injection queue, then the other workers
+        __pool_task* __find_task(__worker* w, uint32_t& seed){
+            if(__queued.load(std::memory_order_relaxed) == 0)
+                return nullptr;
+            __pool_task* t = w ? w->__deque.pop() : nullptr;
+            if(!t)
+                t = __take_injected();
+            if(!t)
+                t = __steal(seed, w ? w->__index : __nworkers);
+            if(t)
+                __queued.fetch_sub(1);
+            return t;
+        }
+
+        void __run(__pool_task* t);
+
+        void __worker_loop(__worker* w){
+            __current() = w;
+            while(true){
+                __pool_task* t = __find_task(w, w->__seed);
+                if(t){
+                    __run(t);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(__sleep_mutex);
+                __sleeping.fetch_add(1);
+                __sleep_cv.wait(lock, [this]{ return __stop.load() || __queued.load() != 0; });
+                __sleeping.fetch_sub(1);
+                if(__stop.load() && __queued.load() == 0)
+                    return;
+            }
+        }
+    };
+    ///~ ------------------------- end thread pool ----------------------------
+
+
+    ///: ------------------------- task group --------------------------------
+    // fork/join scope: spawn hands closures to the pool, sync runs pending
+    // tasks on the calling thread until every spawned one is finished, then
+    // rethrows the first exception any of them threw.
+    class task_group{
+    public:
+        explicit task_group(thread_pool& pool = thread_pool::instance())
+            : __pool(pool), __pending(0), __failed(false) {}
+
+        ~task_group(){
+            __wait();
+        }
+
+        task_group(const task_group&) = delete;
+        task_group& operator=(const task_group&) = delete;
+
+        template<typename F>
+        void spawn(F&& f){
+            typedef typename std::decay<F>::type closure;
+            if(__pool.size() == 0){     // nobody to hand it to
+                __run_here(f);
+                return;
+            }
+            __pool_task* t = new __pool_task_impl<closure>(learnSTL::forward<F>(f));
+            t->__group = this;
+            __pending.fetch_add(1);
+            __pool.__submit(t);
+        }
+
+        void sync(){
+            __wait();
+            if(__failed.load()){
+                std::exception_ptr e = __error;
+                __error = nullptr;
+                __failed.store(false);
+                std::rethrow_exception(e);
+            }
+        }
+
+    private:
+        friend class thread_pool;
+
+        thread_pool&        __pool;
+        std::atomic<size_t> __pending;
+        std::atomic<bool>   __failed;
+        std::exception_ptr  __error;
+        std::mutex          __error_mutex;
+
+        template<typename F>
+        void __run_here(F& f){
+            try{
+                f();
+            }
+            catch(...){
+                __set_error(std::current_exception());
+            }
+        }
+
+        void __set_error(std::exception_ptr e){
+            std::lock_guard<std::mutex> lock(__error_mutex);
+            if(!__failed.load()){
+                __error = e;
+                __failed.store(true);
+            }
+        }
+
+        void __wait(){
+            thread_pool::__worker* w = __pool.__this_worker();
+            uint32_t seed = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this) >> 4) | 1;
+            while(__pending.load(std::memory_order_acquire) != 0){
+                __pool_task* t = __pool.__find_task(w, w ? w->__seed : seed);
+                if(t)
+                    __pool.__run(t);
+                else
+                    std::this_thread::yield();
+            }
+        }
+    };
+
+    inline void thread_pool::__run(__pool_task* t){
+        task_group* g = t->__group;
+        try{
+            t->__invoke(t);
+        }
+        catch(...){
+            g->__set_error(std::current_exception());
+        }
+        g->__pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    template<typename F1, typename F2>
+    void thread_pool::parallel_invoke(F1 f1, F2 f2){
+        task_group g(*this);
+        g.spawn(learnSTL::move(f2));
+        f1();       // if it throws, ~task_group still waits for f2
+        g.sync();
+    }
+
+    template<typename F>
+    void thread_pool::parallel_for(size_t first, size_t last, size_t grain, F f){
+        if(grain == 0)
+            grain = 1;
+        if(last - first <= grain || __nworkers == 0){
+            for(; last - first > grain; first += grain)
+                f(first, first + grain);
+            if(first != last)
+                f(first, last);
+            return;
+        }
+        // keep halving: the right half goes to the pool, the left one stays here
+        task_group g(*this);
+        while(last - first > grain){
+            size_t mid = first + (last - first) / 2;
+            g.spawn([this, mid, last, grain, f]{ parallel_for(mid, last, grain, f); });
+            last = mid;
+        }
+        f(first, last);
+        g.sync();
+    }
+    ///~ ------------------------- end task group ----------------------------
+
+
+    ///: ------------------------- fork/join on the default pool --------------------------------
+    template<typename F1, typename F2> inline
+        void parallel_invoke(F1 f1, F2 f2)
+        {
+            thread_pool::instance().parallel_invoke(learnSTL::move(f1), learnSTL::move(f2));
+        }
+
+    template<typename F> inline
+        void parallel_for(size_t first, size_t last, size_t grain, F f)
+        {
+            thread_pool::instance().parallel_for(first, last, grain, learnSTL::move(f));
+        }
+    ///~ ------------------------- end fork/join on the default pool ----------------------------
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef MY_TOP_K_H
+#define MY_TOP_K_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace learnSTL{
+    ///: ------------------------- top_k --------------------------------
+    // a before b when a is the worse one under Compare, so that the top
+    // of the heap is the worst element kept
+    template<typename Compare>
+    struct __top_k_worse{
+        const Compare* __comp;
+
+        template<typename T1, typename T2>
+            bool operator()(const T1& a, const T2& b) const { return (*__comp)(b, a); }
+    };
+
+    // which way an element has to pass the threshold to get in, when the
+    // vector kernel can tell: 1 above it, -1 below it, 0 no kernel
+    template<typename T, typename Compare>
+    struct __top_k_direction : std::integral_constant<int, 0> {};
+    template<typename T>
+    struct __top_k_direction<T, std::less<T> > : std::integral_constant<int, 1> {};
+    template<typename T>
+    struct __top_k_direction<T, __less<T, T> > : std::integral_constant<int, 1> {};
+    template<typename T>
+    struct __top_k_direction<T, std::greater<T> > : std::integral_constant<int, -1> {};
+
+    // the k largest elements under Compare seen so far, in a heap of k whose
+    // top is the worst of them: the threshold an element has to beat. Once
+    // the heap is full most elements fail that one comparison, and over a
+    // contiguous range of arithmetic keys the vector kernel skips them a
+    // register at a time. Of equal elements the first ones stay.
+    template<typename T, typename Compare = std::less<T> >
+    class top_k_accumulator{
+    public:
+        using value_type      = T;
+        using value_compare   = Compare;
+        using size_type       = std::size_t;
+        using const_reference = const T&;
+
+        // constructor
+        explicit top_k_accumulator(size_type k, const Compare& comp = Compare()) : __heap(), __k(k), __comp(comp)
+        {
+            __heap.reserve(k);
+        }
+
+        // capacity
+        size_type size() const { return __heap.size(); }
+        size_type k() const { return __k; }
+        bool empty() const { return __heap.empty(); }
+        bool full() const { return __heap.size() == __k; }
+
+        // the worst element kept, not empty()
+        const_reference threshold() const { return __heap.front(); }
+        // the elements kept, in heap order
+        const vector<T>& data() const { return __heap; }
+
+        // modifiers
+        void push(const T& val){
+            if(!full())
+                __push_back(val);
+            else if(__k != 0 && __comp(__heap.front(), val))
+                __replace_top(val);
+        }
+        void push(T&& val){
+            if(!full())
+                __push_back(learnSTL::move(val));
+            else if(__k != 0 && __comp(__heap.front(), val))
+                __replace_top(learnSTL::move(val));
+        }
+
+        // a single pass, so an istream_iterator range works as well
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            push(InputIter first, InputIter last){
+                typedef typename iterator_traits<InputIter>::value_type v;
+                __push_range(first, last, std::integral_constant<bool, std::is_pointer<InputIter>::value &&
+                    std::is_same<v, T>::value && __is_simd_arithmetic<T>::value && __top_k_direction<T, Compare>::value != 0>());
+            }
+
+        // the elements kept, best first
+        vector<T> sorted() const {
+            vector<T> out(__heap);
+            __sort_heap<__top_k_worse<Compare> >(out.begin(), out.end(), __worse());
+            return out;
+        }
+        // the same, moved out; the accumulator is empty afterwards
+        vector<T> extract_sorted(){
+            __sort_heap<__top_k_worse<Compare> >(__heap.begin(), __heap.end(), __worse());
+            vector<T> out(learnSTL::move(__heap));
+            __heap.clear();
+            return out;
+        }
+
+        void clear() { __heap.clear(); }
+        void swap(top_k_accumulator& a){
+            __heap.swap(a.__heap);
+            learnSTL::swap(__k, a.__k);
+            learnSTL::swap(__comp, a.__comp);
+        }
+
+        value_compare value_comp() const { return __comp; }
+
+    private:
+        vector<T> __heap;
+        size_type __k;
+        Compare   __comp;
+
+        __top_k_worse<Compare> __worse() const { return __top_k_worse<Compare>{&__comp}; }
+
+        template<typename V>
+            void __push_back(V&& val){
+                __heap.push_back(learnSTL::forward<V>(val));
+                __push_heap<2, __top_k_worse<Compare> >(__heap.begin(), __heap.end(), __worse());
+            }
+
+        // val takes the place of the worst element
+        void __replace_top(T val){
+            typedef typename vector<T>::difference_type difference_type;
+            __heap_sift_down<2, __top_k_worse<Compare> >(__heap.begin(), difference_type(0),
+                                                         difference_type(__heap.size()), learnSTL::move(val), __worse());
+        }
+
+        template<typename InputIter>
+            void __push_range(InputIter first, InputIter last, std::false_type){
+                for(; first != last; ++first)
+                    push(*first);
+            }
+
+        // the kernel finds the next element past the threshold, everything
+        // before it cannot get in. A NaN threshold is past nothing under
+        // Compare but may be past everything in the kernel's compares, so
+        // then the rest goes through push.
+        template<typename P>
+            void __push_range(P first, P last, std::true_type){
+                typedef typename __simd_arith_type<T>::type N;
+                const bool less = __top_k_direction<T, Compare>::value < 0;
+                for(; first != last && !full(); ++first)
+                    push(*first);
+                if(__k == 0)
+                    return;
+                while(first != last){
+                    size_type i;
+                    const N t = static_cast<N>(__heap.front());
+                    if(t != t || !(less ? __simd_find_beyond<N, true>(reinterpret_cast<const N*>(first), last - first, t, i)
+                              : __simd_find_beyond<N, false>(reinterpret_cast<const N*>(first), last - first, t, i)))
+                        return __push_range(first, last, std::false_type());
+                    first += i;
+                    if(first == last)
+                        return;
+                    __replace_top(*first++);
+                }
+            }
+    };
+
+    template<typename T, typename Compare>
+        void swap(top_k_accumulator<T, Compare>& a1, top_k_accumulator<T, Compare>& a2){
+            a1.swap(a2);
+        }
+
+    // the k largest elements of [first, last) under comp, best first, to out.
+    // One pass over the input and O(k) memory, whatever the length of the
+    // input; returns the end of the output.
+    template<typename InputIter, typename OutputIter, typename Compare> inline
+        OutputIter top_k(InputIter first, InputIter last, std::size_t k, OutputIter out, Compare comp)
+        {
+            top_k_accumulator<typename iterator_traits<InputIter>::value_type, Compare> acc(k, comp);
+            acc.push(first, last);
+            vector<typename iterator_traits<InputIter>::value_type> best = acc.extract_sorted();
+            return learnSTL::move(best.begin(), best.end(), out);
+        }
+
+    template<typename InputIter, typename OutputIter> inline
+        OutputIter top_k(InputIter first, InputIter last, std::size_t k, OutputIter out)
+        {
+            return learnSTL::top_k(first, last, k, out, std::less<typename iterator_traits<InputIter>::value_type>());
+        }
+    ///~ ------------------------- end top_k ----------------------------
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef MY_UNORDERED_MAP_H
+#define MY_UNORDERED_MAP_H
+
+#include <stdexcept>
+#include "hash_table.h"
+
+namespace learnSTL{
+    ///: ------------------------- unordered_map --------------------------------
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<pair<const Key, T> > >
+    class unordered_map : public __hash_table<__hash_map_policy<Key, T>, Hash, KeyEqual, Allocator, false>{
+        using __base = __hash_table<__hash_map_policy<Key, T>, Hash, KeyEqual, Allocator, false>;
+    public:
+        using mapped_type    = T;
+        using key_type       = typename __base::key_type;
+        using value_type     = typename __base::value_type;
+        using size_type      = typename __base::size_type;
+        using iterator       = typename __base::iterator;
+        using const_iterator = typename __base::const_iterator;
+
+        using __base::__base;
+        using __base::operator=;
+
+        unordered_map() = default;
+        unordered_map(std::initializer_list<value_type> initlist) : __base(initlist) {}
+
+        // access
+        mapped_type& operator[](const key_type& k) { return try_emplace(k).first->second; }
+        mapped_type& operator[](key_type&& k) { return try_emplace(learnSTL::move(k)).first->second; }
+
+        mapped_type& at(const key_type& k){
+            iterator it = this->find(k);
+            if(it == this->end())
+                throw std::out_of_range("unordered_map::at");
+            return it->second;
+        }
+        const mapped_type& at(const key_type& k) const {
+            const_iterator it = this->find(k);
+            if(it == this->end())
+                throw std::out_of_range("unordered_map::at");
+            return it->second;
+        }
+
+        // allocates a node only when the key is new
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(const key_type& k, Args&&... args){
+                return __try_emplace(k, k, learnSTL::forward<Args>(args)...);
+            }
+        template<typename ...Args>
+            pair<iterator, bool> try_emplace(key_type&& k, Args&&... args){
+                return __try_emplace(k, learnSTL::move(k), learnSTL::forward<Args>(args)...);
+            }
+
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(const key_type& k, M&& m){
+                pair<iterator, bool> r = try_emplace(k, learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+        template<typename M>
+            pair<iterator, bool> insert_or_assign(key_type&& k, M&& m){
+                pair<iterator, bool> r = try_emplace(learnSTL::move(k), learnSTL::forward<M>(m));
+                if(!r.second)
+                    r.first->second = learnSTL::forward<M>(m);
+                return r;
+            }
+
+    private:
+        template<typename K, typename ...Args>
+            pair<iterator, bool> __try_emplace(const key_type& k, K&& key, Args&&... args){
+                iterator it = this->find(k);
+                if(it != this->end())
+                    return pair<iterator, bool>(it, false);
+                return pair<iterator, bool>(this->__emplace_new(learnSTL::forward<K>(key),
+                                                                mapped_type(learnSTL::forward<Args>(args)...)), true);
+            }
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        void swap(unordered_map<Key, T, Hash, KeyEqual, Alloc>& m1, unordered_map<Key, T, Hash, KeyEqual, Alloc>& m2){
+            m1.swap(m2);
+        }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& m1,
+                        const unordered_map<Key, T, Hash, KeyEqual, Alloc>& m2){
+            return __hash_table_equal(m1, m2);
+        }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& m1,
+                        const unordered_map<Key, T, Hash, KeyEqual, Alloc>& m2){
+            return !(m1 == m2);
+        }
+    ///~ ------------------------- end unordered_map ----------------------------
+
+
+    ///: ------------------------- unordered_multimap --------------------------------
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<pair<const Key, T> > >
+    class unordered_multimap : public __hash_table<__hash_map_policy<Key, T>, Hash, KeyEqual, Allocator, true>{
+        using __base = __hash_table<__hash_map_policy<Key, T>, Hash, KeyEqual, Allocator, true>;
+    public:
+        using mapped_type = T;
+        using value_type  = typename __base::value_type;
+
+        using __base::__base;
+        using __base::operator=;
+
+        unordered_multimap() = default;
+        unordered_multimap(std::initializer_list<value_type> initlist) : __base(initlist) {}
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        void swap(unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& m1, unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& m2){
+            m1.swap(m2);
+        }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator==(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& m1,
+                        const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& m2){
+            return __hash_table_equal(m1, m2);
+        }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator!=(const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& m1,
+                        const unordered_multimap<Key, T, Hash, KeyEqual, Alloc>& m2){
+            return !(m1 == m2);
+        }
+    ///~ ------------------------- end unordered_multimap ----------------------------
+}
+
+#endif
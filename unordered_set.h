@@ -0,0 +1,71 @@
+#ifndef MY_UNORDERED_SET_H
+#define MY_UNORDERED_SET_H
+
+#include "hash_table.h"
+
+namespace learnSTL{
+    ///: ------------------------- unordered_set --------------------------------
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<Key> >
+    class unordered_set : public __hash_table<__hash_set_policy<Key>, Hash, KeyEqual, Allocator, false>{
+        using __base = __hash_table<__hash_set_policy<Key>, Hash, KeyEqual, Allocator, false>;
+    public:
+        using __base::__base;
+        using __base::operator=;
+
+        unordered_set() = default;
+        unordered_set(std::initializer_list<Key> initlist) : __base(initlist) {}
+    };
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        void swap(unordered_set<Key, Hash, KeyEqual, Alloc>& s1, unordered_set<Key, Hash, KeyEqual, Alloc>& s2){
+            s1.swap(s2);
+        }
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& s1,
+                        const unordered_set<Key, Hash, KeyEqual, Alloc>& s2){
+            return __hash_table_equal(s1, s2);
+        }
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& s1,
+                        const unordered_set<Key, Hash, KeyEqual, Alloc>& s2){
+            return !(s1 == s2);
+        }
+    ///~ ------------------------- end unordered_set ----------------------------
+
+
+    ///: ------------------------- unordered_multiset --------------------------------
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+             typename Allocator = std::allocator<Key> >
+    class unordered_multiset : public __hash_table<__hash_set_policy<Key>, Hash, KeyEqual, Allocator, true>{
+        using __base = __hash_table<__hash_set_policy<Key>, Hash, KeyEqual, Allocator, true>;
+    public:
+        using __base::__base;
+        using __base::operator=;
+
+        unordered_multiset() = default;
+        unordered_multiset(std::initializer_list<Key> initlist) : __base(initlist) {}
+    };
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        void swap(unordered_multiset<Key, Hash, KeyEqual, Alloc>& s1, unordered_multiset<Key, Hash, KeyEqual, Alloc>& s2){
+            s1.swap(s2);
+        }
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator==(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& s1,
+                        const unordered_multiset<Key, Hash, KeyEqual, Alloc>& s2){
+            return __hash_table_equal(s1, s2);
+        }
+
+    template<typename Key, typename Hash, typename KeyEqual, typename Alloc>
+        bool operator!=(const unordered_multiset<Key, Hash, KeyEqual, Alloc>& s1,
+                        const unordered_multiset<Key, Hash, KeyEqual, Alloc>& s2){
+            return !(s1 == s2);
+        }
+    ///~ ------------------------- end unordered_multiset ----------------------------
+}
+
+#endif
@@ -0,0 +1,790 @@
+#ifndef MY_UNROLLED_FORWARD_LIST_H
+#define MY_UNROLLED_FORWARD_LIST_H
+
+#include <cstddef>
+#include <type_traits>
+#include <initializer_list>
+#include <memory>
+#include <limits>
+#include "iterator.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "vector.h"
+
+namespace learnSTL{
+    // link part of a node; the list head is a bare link
+    struct __unrolled_link{
+        __unrolled_link* __next;
+        unsigned         __count;
+
+        __unrolled_link() : __next(nullptr), __count(0) {}
+    };
+
+    // elements per node: as many as fit in NodeBytes after the link, at least two
+    template<typename T, std::size_t NodeBytes>
+    struct __unrolled_capacity{
+        static const std::size_t __offset = (sizeof(__unrolled_link) + alignof(T) - 1) / alignof(T) * alignof(T);
+        static const std::size_t __fit = NodeBytes > __offset ? (NodeBytes - __offset) / sizeof(T) : 0;
+        static const std::size_t value = __fit < 2 ? 2 : __fit;
+    };
+
+    template<typename T, std::size_t N>
+    struct __unrolled_node : __unrolled_link{
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type __slots[N];
+
+        T* __data() { return reinterpret_cast<T*>(__slots); }
+    };
+
+    template<typename T, std::size_t NodeBytes, typename Allocator> class unrolled_forward_list;
+
+    // a node and an index in it. before_begin is the head with index N - 1:
+    // the head claims N elements, so it is always full and ++ leaves it.
+    template<typename T, std::size_t N, bool Const>
+    class __unrolled_iterator{
+        using __node = __unrolled_node<T, N>;
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = typename std::conditional<Const, const T&, T&>::type;
+        using pointer           = typename std::conditional<Const, const T*, T*>::type;
+
+        __unrolled_iterator() : __n(nullptr), __i(0) {}
+        template<bool C, typename = typename std::enable_if<Const && !C>::type>
+        __unrolled_iterator(const __unrolled_iterator<T, N, C>& iter) : __n(iter.__n), __i(iter.__i) {}
+
+        reference operator*() const { return static_cast<__node*>(__n)->__data()[__i]; }
+        pointer operator->() const { return std::addressof(operator*()); }
+
+        __unrolled_iterator& operator++(){
+            if(++__i == __n->__count){
+                __n = __n->__next;
+                __i = 0;
+            }
+            return *this;
+        }
+        __unrolled_iterator operator++(int){
+            __unrolled_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+
+        friend bool operator==(const __unrolled_iterator& iter1, const __unrolled_iterator& iter2){
+            return iter1.__n == iter2.__n && iter1.__i == iter2.__i;
+        }
+        friend bool operator!=(const __unrolled_iterator& iter1, const __unrolled_iterator& iter2){
+            return !(iter1 == iter2);
+        }
+
+    private:
+        __unrolled_link* __n;
+        std::size_t      __i;
+
+        __unrolled_iterator(__unrolled_link* n, std::size_t i) : __n(n), __i(i) {}
+        template<typename, std::size_t, bool> friend class __unrolled_iterator;
+        template<typename, std::size_t, typename> friend class unrolled_forward_list;
+    };
+
+    // ------ unrolled_forward_list -----------
+    // a singly linked list whose nodes hold up to node_capacity elements, sized
+    // so a node fills NodeBytes. Traversal touches one cache line per node
+    // instead of one per element. Inserting or erasing moves the elements that
+    // follow in the same node, so it invalidates iterators into that node.
+    template<typename T, std::size_t NodeBytes = 64, typename Allocator = std::allocator<T> >
+    class unrolled_forward_list{
+    public:
+        static const std::size_t node_capacity = __unrolled_capacity<T, NodeBytes>::value;
+    private:
+        static const std::size_t N = node_capacity;
+        using __node          = __unrolled_node<T, N>;
+        using __node_alloc    = typename std::allocator_traits<Allocator>::template rebind_alloc<__node>;
+        using __node_traits   = std::allocator_traits<__node_alloc>;
+    public:
+        using value_type       = T;
+        using allocator_type   = Allocator;
+        using size_type        = std::size_t;
+        using difference_type  = std::ptrdiff_t;
+        using reference        = value_type&;
+        using const_reference  = const value_type&;
+        using pointer          = typename std::allocator_traits<allocator_type>::pointer;
+        using const_pointer    = typename std::allocator_traits<allocator_type>::const_pointer;
+
+        using iterator       = __unrolled_iterator<T, N, false>;
+        using const_iterator = __unrolled_iterator<T, N, true>;
+
+        // iterator
+        iterator before_begin() { return iterator(&__head, N - 1); }
+        const_iterator before_begin() const { return const_iterator(__head_link(), N - 1); }
+        const_iterator cbefore_begin() const { return before_begin(); }
+
+        iterator begin() { return iterator(__head.__next, 0); }
+        const_iterator begin() const { return const_iterator(__head.__next, 0); }
+        const_iterator cbegin() const { return begin(); }
+
+        iterator end() { return iterator(); }
+        const_iterator end() const { return const_iterator(); }
+        const_iterator cend() const { return const_iterator(); }
+
+        allocator_type get_allocator() const { return allocator_type(__alloc); }
+
+        reference front() { return *begin(); }
+        const_reference front() const { return *begin(); }
+
+        bool empty() const { return __head.__next == nullptr; }
+        size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+
+        // constructor
+        unrolled_forward_list() : __alloc() { __head.__count = N; }
+        explicit unrolled_forward_list(const allocator_type& a) : __alloc(a) { __head.__count = N; }
+
+        explicit unrolled_forward_list(size_type n, const allocator_type& a = allocator_type()) : __alloc(a)
+        {
+            __head.__count = N;
+            insert_after(before_begin(), n, value_type());
+        }
+        unrolled_forward_list(size_type n, const_reference val, const allocator_type& a = allocator_type())
+            : __alloc(a)
+        {
+            __head.__count = N;
+            insert_after(before_begin(), n, val);
+        }
+        template<typename InputIter>
+        unrolled_forward_list(InputIter first, typename std::enable_if<__is_input_iterator<InputIter>::value,
+                              InputIter>::type last, const allocator_type& a = allocator_type())
+            : __alloc(a)
+        {
+            __head.__count = N;
+            insert_after(before_begin(), first, last);
+        }
+        unrolled_forward_list(std::initializer_list<value_type> initlist, const allocator_type& a = allocator_type())
+            : __alloc(a)
+        {
+            __head.__count = N;
+            insert_after(before_begin(), initlist.begin(), initlist.end());
+        }
+
+        // copy-constructor
+        unrolled_forward_list(const unrolled_forward_list& f2)
+            : __alloc(__node_traits::select_on_container_copy_construction(f2.__alloc))
+        {
+            __head.__count = N;
+            insert_after(before_begin(), f2.begin(), f2.end());
+        }
+
+        // move-constructor
+        unrolled_forward_list(unrolled_forward_list&& rf) : __alloc(learnSTL::move(rf.__alloc))
+        {
+            __head.__count = N;
+            __head.__next = rf.__head.__next;
+            rf.__head.__next = nullptr;
+        }
+
+        ~unrolled_forward_list(){
+            clear();
+        }
+
+        // assignment
+        unrolled_forward_list& operator=(const unrolled_forward_list& f2){
+            if(this != &f2){
+                clear();
+                __copy_assign_alloc(f2, std::integral_constant<bool,
+                    __node_traits::propagate_on_container_copy_assignment::value>());
+                insert_after(before_begin(), f2.begin(), f2.end());
+            }
+            return *this;
+        }
+
+        unrolled_forward_list& operator=(unrolled_forward_list&& rf){
+            if(this != &rf){
+                clear();
+                if(__node_traits::propagate_on_container_move_assignment::value || __alloc == rf.__alloc){
+                    __move_assign_alloc(rf, std::integral_constant<bool,
+                        __node_traits::propagate_on_container_move_assignment::value>());
+                    __head.__next = rf.__head.__next;
+                    rf.__head.__next = nullptr;
+                }
+                else{
+                    using moveIter = move_iterator<iterator>;
+                    insert_after(before_begin(), moveIter(rf.begin()), moveIter(rf.end()));
+                }
+            }
+            return *this;
+        }
+
+        unrolled_forward_list& operator=(std::initializer_list<value_type> initlist){
+            assign(initlist.begin(), initlist.end());
+            return *this;
+        }
+
+        void assign(size_type n, const_reference val){
+            value_type copy(val);
+            clear();
+            insert_after(before_begin(), n, copy);
+        }
+
+        template<typename InputIter>
+        typename std::enable_if<__is_input_iterator<InputIter>::value, void>::type
+            assign(InputIter first, InputIter last){
+                clear();
+                insert_after(before_begin(), first, last);
+            }
+
+        void assign(std::initializer_list<value_type> initlist){
+            assign(initlist.begin(), initlist.end());
+        }
+
+        // push_front
+        void push_front(const_reference val){
+            __emplace_after_full(&__head, val);
+        }
+        void push_front(value_type&& val){
+            __emplace_after_full(&__head, learnSTL::move(val));
+        }
+        template<typename ...Args>
+            void emplace_front(Args&&... args){
+                __emplace_after_full(&__head, learnSTL::forward<Args>(args)...);
+            }
+
+        // insert_after
+        iterator insert_after(const_iterator pos, const_reference val){
+            return __emplace_at(pos.__n, pos.__i + 1, val);
+        }
+        iterator insert_after(const_iterator pos, value_type&& val){
+            return __emplace_at(pos.__n, pos.__i + 1, learnSTL::move(val));
+        }
+        iterator insert_after(const_iterator pos, size_type n, const_reference val){
+            iterator p(pos.__n, pos.__i);
+            if(n > 0){
+                value_type copy(val);   // val may live in this list and be moved
+                for(; n > 0; --n)
+                    p = insert_after(p, copy);
+            }
+            return p;
+        }
+        template<typename InputIter>
+            typename std::enable_if<__is_input_iterator<InputIter>::value, iterator>::type
+            insert_after(const_iterator pos, InputIter first, InputIter last){
+                iterator p(pos.__n, pos.__i);
+                for(; first != last; ++first)
+                    p = insert_after(p, *first);
+                return p;
+            }
+        iterator insert_after(const_iterator pos, std::initializer_list<value_type> initlist){
+            return insert_after(pos, initlist.begin(), initlist.end());
+        }
+
+        template<typename ...Args>
+            iterator emplace_after(const_iterator pos, Args&&... args){
+                return __emplace_at(pos.__n, pos.__i + 1, learnSTL::forward<Args>(args)...);
+            }
+
+        // pop_front
+        void pop_front(){
+            __erase_at(&__head, static_cast<__node*>(__head.__next), 0);
+        }
+
+        // erase_after
+        iterator erase_after(const_iterator pos){
+            __unrolled_link* n = pos.__n;
+            if(pos.__i + 1 < n->__count)
+                return __erase_at(n, static_cast<__node*>(n), pos.__i + 1);
+            return __erase_at(n, static_cast<__node*>(n->__next), 0);
+        }
+
+        iterator erase_after(const_iterator first, const_iterator last){
+            __unrolled_link* n = first.__n;
+            std::size_t i = first.__i + 1;
+            if(n == last.__n){
+                // both ends in one node
+                __node* nd = static_cast<__node*>(n);
+                T* d = nd->__data();
+                if(last.__i > i){
+                    std::size_t k = last.__i - i;
+                    learnSTL::move(d + last.__i, d + n->__count, d + i);
+                    __destroy(d + n->__count - k, d + n->__count);
+                    n->__count -= static_cast<unsigned>(k);
+                    __merge_next(nd);
+                }
+                return iterator(n, i);
+            }
+            // the tail of the first node, the whole nodes between, the head of the last
+            if(i < n->__count){
+                T* d = static_cast<__node*>(n)->__data();
+                __destroy(d + i, d + n->__count);
+                n->__count = static_cast<unsigned>(i);
+            }
+            __unrolled_link* m = n->__next;
+            while(m != last.__n){
+                __unrolled_link* next = m->__next;
+                __free_node(static_cast<__node*>(m));
+                m = next;
+            }
+            if(m != nullptr && last.__i > 0){
+                T* d = static_cast<__node*>(m)->__data();
+                learnSTL::move(d + last.__i, d + m->__count, d);
+                __destroy(d + m->__count - last.__i, d + m->__count);
+                m->__count -= static_cast<unsigned>(last.__i);
+            }
+            n->__next = m;
+            if(n != &__head)
+                __merge_next(static_cast<__node*>(n));
+            return iterator(n->__next == m ? m : n, n->__next == m ? 0 : i);
+        }
+
+        void clear(){
+            for(__unrolled_link* p = __head.__next; p != nullptr;){
+                __unrolled_link* next = p->__next;
+                __free_node(static_cast<__node*>(p));
+                p = next;
+            }
+            __head.__next = nullptr;
+        }
+
+        // resize
+        void resize(size_type n){
+            __resize(n, value_type());
+        }
+        void resize(size_type n, const_reference val){
+            __resize(n, val);
+        }
+
+        void swap(unrolled_forward_list& f2){
+            __swap_alloc(__alloc, f2.__alloc, std::integral_constant<bool,
+                __node_traits::propagate_on_container_swap::value>());
+            learnSTL::swap(__head.__next, f2.__head.__next);
+        }
+
+        // splice_after, the nodes of f2 are linked in as they are
+        void splice_after(const_iterator pos, unrolled_forward_list& f2){
+            if(this == &f2 || f2.empty())
+                return;
+            __unrolled_link* n = pos.__n;
+            __split_after(n, pos.__i + 1);
+            __unrolled_link* last = f2.__head.__next;
+            while(last->__next != nullptr)
+                last = last->__next;
+            last->__next = n->__next;
+            n->__next = f2.__head.__next;
+            f2.__head.__next = nullptr;
+        }
+        void splice_after(const_iterator pos, unrolled_forward_list&& f2){
+            splice_after(pos, f2);
+        }
+
+        void splice_after(const_iterator pos, unrolled_forward_list& f2, const_iterator it){
+            const_iterator last = learnSTL::next(it);
+            if(pos == it || pos == last || last == f2.end())
+                return;
+            splice_after(pos, f2, it, ++last);
+        }
+        void splice_after(const_iterator pos, unrolled_forward_list&& f2, const_iterator it){
+            splice_after(pos, f2, it);
+        }
+
+        // the elements in (first, last) are moved into fresh nodes; pos must
+        // not be in the range. Within one list the positions are found again
+        // by counting, so that costs a walk of the list.
+        void splice_after(const_iterator pos, unrolled_forward_list& f2, const_iterator first, const_iterator last){
+            if(pos == first || first == last || learnSTL::next(first) == last)
+                return;
+            using moveIter = move_iterator<iterator>;
+            unrolled_forward_list moved(get_allocator());
+            iterator from(first.__n, first.__i);
+            moved.insert_after(moved.before_begin(), moveIter(++from), moveIter(iterator(last.__n, last.__i)));
+            if(this != &f2){
+                f2.erase_after(first, last);
+                splice_after(pos, moved);
+                return;
+            }
+            size_type pos_at = 0, first_at = 0;
+            for(const_iterator i = before_begin(); i != pos; ++i)
+                ++pos_at;
+            for(const_iterator i = before_begin(); i != first; ++i)
+                ++first_at;
+            erase_after(first, last);
+            if(pos_at > first_at){
+                for(const_iterator i = moved.begin(); i != moved.end(); ++i)
+                    --pos_at;
+            }
+            const_iterator p = before_begin();
+            learnSTL::advance(p, pos_at);
+            splice_after(p, moved);
+        }
+        void splice_after(const_iterator pos, unrolled_forward_list&& f2, const_iterator first, const_iterator last){
+            splice_after(pos, f2, first, last);
+        }
+
+        // remove
+        void remove(const_reference val){
+            value_type copy(val);
+            __compact([&copy](const value_type*, const value_type& v){ return !(v == copy); });
+        }
+
+        template<typename UnaryPred>
+            void remove_if(UnaryPred pred){
+                __compact([&pred](const value_type*, const value_type& v){ return !pred(v); });
+            }
+
+        // unique
+        template<typename BinPred>
+            void unique(BinPred binaryPred){
+                __compact([&binaryPred](const value_type* kept, const value_type& v){
+                    return kept == nullptr || !binaryPred(*kept, v);
+                });
+            }
+
+        void unique(){
+            unique(__equal_to<value_type>());
+        }
+
+        // merge, both lists are moved into full nodes as they drain; once one
+        // side runs out, the other side's remaining nodes are linked as they are
+        template<typename Compare>
+            void merge(unrolled_forward_list& f2, Compare comp){
+                if(this == &f2)
+                    return;
+                __unrolled_link out;            // full, so the first element opens a node
+                out.__count = N;
+                __unrolled_link* tail = &out;
+                __unrolled_link* a = __head.__next;
+                __unrolled_link* b = f2.__head.__next;
+                std::size_t ai = 0, bi = 0;
+                __head.__next = f2.__head.__next = nullptr;
+                while(a != nullptr && b != nullptr){
+                    T* x = static_cast<__node*>(a)->__data() + ai;
+                    T* y = static_cast<__node*>(b)->__data() + bi;
+                    if(comp(*y, *x)){
+                        tail = __push_moved(tail, y);
+                        b = __drained(b, ++bi);
+                    }
+                    else{
+                        tail = __push_moved(tail, x);
+                        a = __drained(a, ++ai);
+                    }
+                }
+                __unrolled_link* rest = a != nullptr ? a : b;
+                std::size_t ri = a != nullptr ? ai : bi;
+                if(rest != nullptr && ri > 0){
+                    // the rest of a half-drained node first
+                    T* d = static_cast<__node*>(rest)->__data();
+                    for(; ri < rest->__count; ++ri)
+                        tail = __push_moved(tail, d + ri);
+                    rest = __drained(rest, ri);
+                }
+                tail->__next = rest;
+                __head.__next = out.__next;
+            }
+
+        template<typename Compare>
+            void merge(unrolled_forward_list&& f2, Compare comp){
+                merge(f2, learnSTL::move(comp));
+            }
+
+        void merge(unrolled_forward_list& f2){
+            merge(f2, __less<value_type>());
+        }
+
+        void merge(unrolled_forward_list&& f2){
+            merge(f2, __less<value_type>());
+        }
+
+        // reverse the node order and the elements in every node
+        void reverse(){
+            __unrolled_link* f = nullptr;
+            for(__unrolled_link* p = __head.__next; p != nullptr;){
+                __unrolled_link* next = p->__next;
+                T* d = static_cast<__node*>(p)->__data();
+                learnSTL::reverse(d, d + p->__count);
+                p->__next = f;
+                f = p;
+                p = next;
+            }
+            __head.__next = f;
+        }
+
+        // sort, stable. The elements are moved to a contiguous buffer, sorted
+        // there and moved back into the same slots.
+        template<typename Compare>
+            void sort(Compare comp){
+                size_type n = 0;
+                for(__unrolled_link* p = __head.__next; p != nullptr; p = p->__next)
+                    n += p->__count;
+                if(n < 2)
+                    return;
+                learnSTL::vector<value_type, allocator_type> buf(get_allocator());
+                buf.reserve(n);
+                for(iterator i = begin(); i != end(); ++i)
+                    buf.push_back(learnSTL::move(*i));
+                learnSTL::stable_sort(buf.begin(), buf.end(), comp);
+                learnSTL::move(buf.begin(), buf.end(), begin());
+            }
+
+        void sort(){
+            sort(__less<value_type>());
+        }
+
+    private:
+        __unrolled_link __head;     // __count is N, so the head is always full
+        __node_alloc    __alloc;
+
+        __unrolled_link* __head_link() const { return const_cast<__unrolled_link*>(&__head); }
+
+        __node* __new_node(){
+            __node* nd = __node_traits::allocate(__alloc, 1);
+            nd->__next = nullptr;
+            nd->__count = 0;
+            return nd;
+        }
+
+        void __destroy(T* first, T* last){
+            for(; first != last; ++first)
+                __node_traits::destroy(__alloc, first);
+        }
+
+        void __free_node(__node* nd){
+            __destroy(nd->__data(), nd->__data() + nd->__count);
+            __node_traits::deallocate(__alloc, nd, 1);
+        }
+
+        // construct an element at index p of node n, 0 <= p <= n->__count
+        template<typename ...Args>
+            iterator __emplace_at(__unrolled_link* n, std::size_t p, Args&&... args){
+                if(p == N)
+                    return __emplace_after_full(n, learnSTL::forward<Args>(args)...);
+                // p < N, so n is a node and not the head
+                if(n->__count < N){
+                    T* d = static_cast<__node*>(n)->__data();
+                    const std::size_t c = n->__count;
+                    if(p == c)
+                        __node_traits::construct(__alloc, d + c, learnSTL::forward<Args>(args)...);
+                    else{
+                        value_type temp(learnSTL::forward<Args>(args)...);
+                        __node_traits::construct(__alloc, d + c, learnSTL::move(d[c - 1]));
+                        learnSTL::move_backward(d + p, d + c - 1, d + c);
+                        d[p] = learnSTL::move(temp);
+                    }
+                    ++n->__count;
+                    return iterator(n, p);
+                }
+                // inside a full node: move its upper half to a new node
+                value_type temp(learnSTL::forward<Args>(args)...);
+                const std::size_t h = N / 2;
+                __split_after(n, h);
+                if(p <= h)
+                    return __emplace_at(n, p, learnSTL::move(temp));
+                return __emplace_at(n->__next, p - h, learnSTL::move(temp));
+            }
+
+        // construct an element after the full node or the head n: at the
+        // front of the next node, or in a new node; n itself is not touched
+        template<typename ...Args>
+            iterator __emplace_after_full(__unrolled_link* n, Args&&... args){
+                __unrolled_link* next = n->__next;
+                if(next != nullptr && next->__count < N)
+                    return __emplace_at(next, 0, learnSTL::forward<Args>(args)...);
+                __node* m = __new_node();
+                try{
+                    __node_traits::construct(__alloc, m->__data(), learnSTL::forward<Args>(args)...);
+                }
+                catch(...){
+                    __node_traits::deallocate(__alloc, m, 1);
+                    throw;
+                }
+                m->__count = 1;
+                m->__next = next;
+                n->__next = m;
+                return iterator(m, 0);
+            }
+
+        // move the elements of n from index i on to a new node after n
+        void __split_after(__unrolled_link* n, std::size_t i){
+            if(i >= n->__count)
+                return;
+            __node* m = __new_node();
+            T* d = static_cast<__node*>(n)->__data();
+            T* md = m->__data();
+            for(std::size_t k = i; k < n->__count; ++k){
+                __node_traits::construct(__alloc, md + (k - i), learnSTL::move(d[k]));
+                __node_traits::destroy(__alloc, d + k);
+            }
+            m->__count = n->__count - static_cast<unsigned>(i);
+            n->__count = static_cast<unsigned>(i);
+            m->__next = n->__next;
+            n->__next = m;
+        }
+
+        // two neighbours that together fill at most half a node become one
+        void __merge_next(__node* nd){
+            __unrolled_link* next = nd->__next;
+            if(next == nullptr || nd->__count + next->__count > N / 2)
+                return;
+            T* d = nd->__data();
+            T* nx = static_cast<__node*>(next)->__data();
+            for(std::size_t k = 0; k < next->__count; ++k)
+                __node_traits::construct(__alloc, d + nd->__count + k, learnSTL::move(nx[k]));
+            nd->__count += next->__count;
+            nd->__next = next->__next;
+            __free_node(static_cast<__node*>(next));
+        }
+
+        // erase element j of nd, prev is the link before nd
+        iterator __erase_at(__unrolled_link* prev, __node* nd, std::size_t j){
+            T* d = nd->__data();
+            learnSTL::move(d + j + 1, d + nd->__count, d + j);
+            __node_traits::destroy(__alloc, d + nd->__count - 1);
+            if(--nd->__count == 0){
+                prev->__next = nd->__next;
+                __node_traits::deallocate(__alloc, nd, 1);
+                return iterator(prev->__next, 0);
+            }
+            __merge_next(nd);
+            if(j == nd->__count)
+                return iterator(nd->__next, 0);
+            return iterator(nd, j);
+        }
+
+        // keeps the elements for which keep(last kept element, element) holds,
+        // sliding them to the front; the nodes left empty are freed
+        template<typename Keep>
+            void __compact(Keep keep){
+                __unrolled_link* wn = &__head;      // write position (wn, wi)
+                std::size_t wi = N;
+                T* kept = nullptr;
+                for(__unrolled_link* rn = __head.__next; rn != nullptr; rn = rn->__next){
+                    T* d = static_cast<__node*>(rn)->__data();
+                    for(std::size_t ri = 0; ri < rn->__count; ++ri){
+                        if(!keep(kept, d[ri]))
+                            continue;
+                        if(wi == wn->__count){
+                            wn = wn->__next;
+                            wi = 0;
+                        }
+                        T* w = static_cast<__node*>(wn)->__data() + wi;
+                        if(w != d + ri)
+                            *w = learnSTL::move(d[ri]);
+                        kept = w;
+                        ++wi;
+                    }
+                }
+                // drop everything after the write position
+                __unrolled_link* rest;
+                if(wn == &__head)
+                    rest = __head.__next;
+                else{
+                    T* d = static_cast<__node*>(wn)->__data();
+                    __destroy(d + wi, d + wn->__count);
+                    wn->__count = static_cast<unsigned>(wi);
+                    rest = wn->__next;
+                }
+                wn->__next = nullptr;
+                while(rest != nullptr){
+                    __unrolled_link* next = rest->__next;
+                    __free_node(static_cast<__node*>(rest));
+                    rest = next;
+                }
+            }
+
+        // move *x to the end of the chain ending at tail, returns the new tail
+        __unrolled_link* __push_moved(__unrolled_link* tail, T* x){
+            if(tail->__count == N){
+                __node* m = __new_node();
+                tail->__next = m;
+                tail = m;
+            }
+            __node_traits::construct(__alloc, static_cast<__node*>(tail)->__data() + tail->__count, learnSTL::move(*x));
+            ++tail->__count;
+            return tail;
+        }
+
+        // after taking index i - 1 of n: free n once it is used up
+        __unrolled_link* __drained(__unrolled_link* n, std::size_t& i){
+            if(i < n->__count)
+                return n;
+            __unrolled_link* next = n->__next;
+            __free_node(static_cast<__node*>(n));
+            i = 0;
+            return next;
+        }
+
+        void __resize(size_type n, const_reference val){
+            iterator bb = before_begin();
+            iterator b = begin();
+            iterator e = end();
+            for(; b != e && n > 0; ++bb, ++b, --n);
+            if(b != e)
+                erase_after(bb, e);
+            else
+                insert_after(bb, n, val);
+        }
+
+        void __copy_assign_alloc(const unrolled_forward_list& f2, std::true_type){
+            __alloc = f2.__alloc;
+        }
+        void __copy_assign_alloc(const unrolled_forward_list&, std::false_type) {}
+
+        void __move_assign_alloc(unrolled_forward_list& rf, std::true_type){
+            __alloc = learnSTL::move(rf.__alloc);
+        }
+        void __move_assign_alloc(unrolled_forward_list&, std::false_type) {}
+
+        void __swap_alloc(__node_alloc& a1, __node_alloc& a2, std::true_type){
+            learnSTL::swap(a1, a2);
+        }
+        void __swap_alloc(__node_alloc&, __node_alloc&, std::false_type) {}
+    };
+
+    template<typename T, std::size_t NodeBytes, typename Allocator>
+        const std::size_t unrolled_forward_list<T, NodeBytes, Allocator>::node_capacity;
+    template<typename T, std::size_t NodeBytes, typename Allocator>
+        const std::size_t unrolled_forward_list<T, NodeBytes, Allocator>::N;
+
+    // swap
+    template<typename T, std::size_t B, typename Alloc>
+        void swap(unrolled_forward_list<T, B, Alloc>& f1, unrolled_forward_list<T, B, Alloc>& f2){
+            f1.swap(f2);
+        }
+
+    // compare
+    template<typename T, std::size_t B, typename Alloc>
+        bool operator==(const unrolled_forward_list<T, B, Alloc>& f1, const unrolled_forward_list<T, B, Alloc>& f2)
+        {
+            auto b1 = f1.begin();
+            auto e1 = f1.end();
+            auto b2 = f2.begin();
+            auto e2 = f2.end();
+            for(; b1 != e1 && b2 != e2; ++b1, ++b2)
+                if(*b1 != *b2)
+                    return false;
+            return (b1 == e1) == (b2 == e2);
+        }
+
+    template<typename T, std::size_t B, typename Alloc>
+        bool operator!=(const unrolled_forward_list<T, B, Alloc>& f1, const unrolled_forward_list<T, B, Alloc>& f2){
+            return !(f1 == f2);
+        }
+
+    template<typename T, std::size_t B, typename Alloc>
+        bool operator<(const unrolled_forward_list<T, B, Alloc>& f1, const unrolled_forward_list<T, B, Alloc>& f2)
+        {
+            return learnSTL::lexicographical_compare(f1.begin(), f1.end(), f2.begin(), f2.end());
+        }
+
+    template<typename T, std::size_t B, typename Alloc>
+        bool operator>(const unrolled_forward_list<T, B, Alloc>& f1, const unrolled_forward_list<T, B, Alloc>& f2)
+        {
+            return f2 < f1;
+        }
+
+    template<typename T, std::size_t B, typename Alloc>
+        bool operator<=(const unrolled_forward_list<T, B, Alloc>& f1, const unrolled_forward_list<T, B, Alloc>& f2)
+        {
+            return !(f2 < f1);
+        }
+
+    template<typename T, std::size_t B, typename Alloc>
+        bool operator>=(const unrolled_forward_list<T, B, Alloc>& f1, const unrolled_forward_list<T, B, Alloc>& f2)
+        {
+            return !(f1 < f2);
+        }
+}
+#endif
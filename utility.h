@@ -39,9 +39,9 @@ namespace learnSTL{
 		void>::type
 		swap(T& x, T& y)
 	{
-		T temp(move(x));
-		x = move(y);
-		y = move(temp);
+		T temp(learnSTL::move(x));
+		x = learnSTL::move(y);
+		y = learnSTL::move(temp);
 	}
 
 	// swap array  
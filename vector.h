@@ -78,7 +78,7 @@ namespace learnSTL{
 		void __copy_assign_alloc_impl(const __vector_base&, std::false_type) {}
 
 		void __move_assign_alloc_impl(const __vector_base& c, std::true_type){
-			this->__alloc = move(c.__alloc);
+			this->__alloc = learnSTL::move(c.__alloc);
 		}
 
 		void __move_assign_alloc_impl(const __vector_base&, std::false_type){}
@@ -185,7 +185,7 @@ namespace learnSTL{
 		vector(ForwardIter first, typename std::enable_if<__is_forward_iterator<ForwardIter>::value,
                 ForwardIter>::type last, const allocator_type& a) : __base(a)
 		{
-			size_type n = static_cast<size_type>(distance(first, last));
+			size_type n = static_cast<size_type>(learnSTL::distance(first, last));
 			if (n > 0){
 				allocate(n);
 				__construct_at_end(first, last);
@@ -207,7 +207,7 @@ namespace learnSTL{
 		}
 
 		// copy constructor
-		vector(const self& v) : __base(v.__alloc)
+		vector(const self& v) : __base(__alloc_traits::select_on_container_copy_construction(v.__alloc))
 		{
 			size_type n = v.size();
 			if (n > 0){
@@ -254,11 +254,11 @@ namespace learnSTL{
 			if (n < capacity()){
 				size_type s = size();
 				if (n <= s){
-					fill_n(this->__begin, n, val);
+					learnSTL::fill_n(this->__begin, n, val);
 					this->__destruct_at_end(this->__begin + n);
 				}
 				else{
-					fill_n(this->__begin, s, val);
+					learnSTL::fill_n(this->__begin, s, val);
 					__construct_at_end(n - s, val);
 				}
 			}
@@ -286,17 +286,17 @@ namespace learnSTL{
 		typename std::enable_if<__is_forward_iterator<ForwardIter>::value, void>::type
 			assign(ForwardIter first, ForwardIter last)
 		{
-			size_type new_size = static_cast<size_type>(distance(first, last));
+			size_type new_size = static_cast<size_type>(learnSTL::distance(first, last));
 			if (new_size <= capacity()){
 				size_type sz = size();
 				if (new_size <= sz){
-					pointer endp = copy(first, last, this->__begin);
+					pointer endp = learnSTL::copy(first, last, this->__begin);
 					this->__destruct_at_end(endp);
 				}
 				else{
 					ForwardIter iter = first;
-					advance(iter, sz);
-					copy(first, iter, this->__begin);
+					learnSTL::advance(iter, sz);
+					learnSTL::copy(first, iter, this->__begin);
 					__construct_at_end(iter, last);
 				}
 			}
@@ -385,8 +385,7 @@ namespace learnSTL{
 				++this->__end;
 			}
 			else{
-				vector<value_type> temp;
-				temp.__alloc = this->__alloc;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(size() + 1));
 				temp.__construct_at_end(this->__begin, this->__end);
 				__alloc_traits::construct(temp.__alloc, temp.__end, val);
@@ -400,8 +399,7 @@ namespace learnSTL{
 				++this->__end;
 			}
 			else{
-				vector<value_type> temp;
-				temp.__alloc = this->__alloc;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(size() + 1));
 				temp.__construct_at_end(this->__begin, this->__end);
 				__alloc_traits::construct(temp.__alloc, temp.__end, std::move(rval));
@@ -428,12 +426,13 @@ namespace learnSTL{
 				}
 			}
 			else{
-				vector<value_type, allocator_type> temp;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(size() + 1));
 				temp.__construct_at_end(this->__begin, p);
 				temp.push_back(val);
 				temp.__construct_at_end(p, this->__end);
 				swap(temp);
+				p = this->__begin + (p - temp.__begin);
 			}
 			return p;
 		}
@@ -456,12 +455,13 @@ namespace learnSTL{
 				}
 			}
 			else{
-				vector<value_type, allocator_type> temp;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(size() + 1));
 				temp.__construct_at_end(this->__begin, p);
 				temp.push_back(std::move(val));
 				temp.__construct_at_end(p, this->__end);
 				swap(temp);
+				p = this->__begin + (p - temp.__begin);
 			}
 			return p;
 		}
@@ -482,16 +482,17 @@ namespace learnSTL{
 						const_pointer valPtr = std::pointer_traits<const_pointer>::pointer_to(val);
 						if (p <= valPtr && valPtr < old_last)
 							valPtr += old_n;
-						fill_n(p, n, *valPtr);
+						learnSTL::fill_n(p, n, *valPtr);
 					}
 				}
 				else{
-					vector<value_type, allocator_type> temp;
+					vector temp(this->__alloc);
 					temp.allocate(__grow_to(size() + n));
 					temp.__construct_at_end(this->__begin, p);
 					temp.__construct_at_end(n, val);
 					temp.__construct_at_end(p, this->__end);
 					swap(temp);
+					p = this->__begin + (p - temp.__begin);
 				}
 			}
 			return p;
@@ -512,7 +513,7 @@ namespace learnSTL{
 			}
 			// if end == end_cap but first != last, means
 			// capacity is not enough to hold all elements
-			vector<value_type> temp;
+			vector temp(this->__alloc);
 			if (first != last){
 				temp.assign(first, last);
 				// record size and off as reallocate will invalid old iterator
@@ -522,8 +523,8 @@ namespace learnSTL{
 				old_last = this->__begin + old_size;
 				p = this->__begin + old_off;
 			}
-			p = rotate(p, old_last, this->__end);
-			insert(p, make_move_iterator(temp.begin()), make_move_iterator(temp.end()));
+			p = learnSTL::rotate(p, old_last, this->__end);
+			insert(p, learnSTL::make_move_iterator(temp.begin()), learnSTL::make_move_iterator(temp.end()));
 
 			return this->__begin + (pos - this->__begin);
 		}
@@ -532,7 +533,7 @@ namespace learnSTL{
 		typename std::enable_if<__is_forward_iterator<ForwardIter>::value, iterator>::type
 			insert(const_iterator pos, ForwardIter first, ForwardIter last)
 		{
-			difference_type n = distance(first, last);
+			difference_type n = learnSTL::distance(first, last);
 			iterator p = this->__begin + (pos - this->__begin);
 			if (n > 0)
 			{
@@ -544,22 +545,23 @@ namespace learnSTL{
 					difference_type diff = this->__end - p;
 					if (n > diff){
 						m = first;
-						advance(m, diff);
+						learnSTL::advance(m, diff);
 						__construct_at_end(m, last);
 						n -= diff;
 					}
 					if (n > 0){
 						__move_range(p, old_last, p + old_n);
-						copy(first, m, p);
+						learnSTL::copy(first, m, p);
 					}
 				}
 				else{
-					vector<value_type, allocator_type> temp;
+					vector temp(this->__alloc);
 					temp.allocate(__grow_to(size() + n));
 					temp.__construct_at_end(this->__begin, p);
 					temp.__construct_at_end(first, last);
 					temp.__construct_at_end(p, this->__end);
 					swap(temp);
+					p = this->__begin + (p - temp.__begin);
 				}
 			}
 			return p;
@@ -586,12 +588,13 @@ namespace learnSTL{
 				}
 			}
 			else{
-				vector<value_type, allocator_type> temp;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(size() + 1));
 				temp.__construct_at_end(this->__begin, p);
 				temp.emplace_back(std::forward<Args>(args)...);
 				temp.__construct_at_end(p, this->__end);
 				swap(temp);
+				p = this->__begin + (p - temp.__begin);
 			}
 			return p;
 		}
@@ -604,7 +607,7 @@ namespace learnSTL{
 				++this->__end;
 			}
 			else{
-				vector<value_type, allocator_type> temp;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(size() + 1));
 				temp.__construct_at_end(this->__begin, this->__end);
 				__alloc_traits::construct(temp.__alloc, temp.__end, std::forward<Args>(args)...);
@@ -673,7 +676,7 @@ namespace learnSTL{
 				}
 			}
 			else{
-				vector<value_type> temp;
+				vector temp(this->__alloc);
 				temp.allocate(__grow_to(n));
 				temp.__construct_at_end(this->__begin, this->__end);
 				temp.__construct_at_end(n - sz, val);
@@ -789,7 +792,7 @@ namespace learnSTL{
 		bool operator==(const vector<T, Allocator>& v1, const vector<T, Allocator>& v2)
 	{
 		const typename vector<T, Allocator>::size_type sz = v1.size();
-		return sz == v2.size() && equal(v1.begin(), v1.end(), v2.begin());
+		return sz == v2.size() && learnSTL::equal(v1.begin(), v1.end(), v2.begin());
 	}
 	template<typename T, typename Allocator> inline
 		bool operator!=(const vector<T, Allocator>& v1, const vector<T, Allocator>& v2)
@@ -799,7 +802,7 @@ namespace learnSTL{
 	template<typename T, typename Allocator> inline
 		bool operator<(const vector<T, Allocator>& v1, const vector<T, Allocator>& v2)
 	{
-		return lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end());
+		return learnSTL::lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end());
 	}
 	template<typename T, typename Allocator> inline
 		bool operator>(const vector<T, Allocator>& v1, const vector<T, Allocator>& v2)